@@ -5967,9 +5967,8 @@ typedef struct
     GrB_Matrix A ;          // Matrix being iterated
     GrB_Index nvals ;       // Number of none zero values in matrix
     GrB_Index nnz_idx ;     // Index of current none zero value
-    int64_t p ;             // Number of none zero values in current column
-    int64_t row_idx ;       // Index of current row
-    GrB_Index nrows ;       // Total number of rows in matrix
+    int64_t row_idx ;       // Index of current vector, rows are vectors of a CSR matrix
+    GrB_Index nrows ;       // Number of vectors in matrix, non-empty rows only if hypersparse
 } GxB_MatrixTupleIter ;
 
 // Create a new matrix iterator
@@ -5986,6 +5985,14 @@ GrB_Info GxB_MatrixTupleIter_iterate_row
     GrB_Index rowIdx            // row index to iterate over
 ) ;
 
+// iterate over rows [startRowIdx, endRowIdx)
+GrB_Info GxB_MatrixTupleIter_iterate_range
+(
+    GxB_MatrixTupleIter *iter,  // iterator to use
+    GrB_Index startRowIdx,      // first row to iterate over
+    GrB_Index endRowIdx         // iteration stops before this row
+) ;
+
 // Advance iterator to the next none zero value
 GrB_Info GxB_MatrixTupleIter_next
 (
@@ -5995,6 +6002,17 @@ GrB_Info GxB_MatrixTupleIter_next
     bool *depleted                  // indicate if iterator depleted
 ) ;
 
+// Advance iterator to the next none zero value, retrieving its value,
+// matrix must be of type UINT64
+GrB_Info GxB_MatrixTupleIter_next_UINT64
+(
+    GxB_MatrixTupleIter *iter,      // iterator to consume
+    GrB_Index *row,                 // optional row index of current NNZ
+    GrB_Index *col,                 // optional column index of current NNZ
+    uint64_t *val,                  // optional value of current NNZ
+    bool *depleted                  // indicate if iterator depleted
+) ;
+
 // Reset iterator
 GrB_Info GxB_MatrixTupleIter_reset
 (
@@ -6014,6 +6032,22 @@ GrB_Info GxB_MatrixTupleIter_free
     GxB_MatrixTupleIter *iter        // iterator to free
 ) ;
 
+//------------------------------------------------------------------------------
+// GxB_Matrix_row_slice:  Direct access to the entries of a single row
+//------------------------------------------------------------------------------
+
+// Points cols (and optionally vals) at the column indices (values) of row's
+// entries within A's own arrays, no memory is allocated or copied.
+// A must be held by row, the slice is valid as long as A isn't modified.
+GrB_Info GxB_Matrix_row_slice
+(
+    const GrB_Index **cols,         // column indices of row's entries
+    const void **vals,              // optional values of row's entries
+    GrB_Index *nvals,               // number of entries in row
+    GrB_Matrix A,                   // matrix to access, held by row
+    GrB_Index rowIdx                // row to access
+) ;
+
 //------------------------------------------------------------------------------
 // GxB_kron:  Kronecker product
 //------------------------------------------------------------------------------
@@ -13,17 +13,13 @@ GrB_Info GxB_MatrixTupleIter_new
 	GB_WHERE("GxB_MatrixTupleIter_new (A)") ;
 	GB_RETURN_IF_NULL_OR_FAULTY(A) ;
 
-	GrB_Index nrows;
-	GrB_Matrix_nrows(&nrows, A);
-
 	*iter = NULL ;
 	GB_MALLOC_MEMORY(*iter, 1, sizeof(GxB_MatrixTupleIter)) ;
 	GrB_Matrix_nvals(&((*iter)->nvals), A) ;
 	(*iter)->A = A ;
 	(*iter)->nnz_idx = 0 ;
 	(*iter)->row_idx = 0 ;
-	(*iter)->nrows = nrows;
-	(*iter)->p = A->p[0] ;
+	(*iter)->nrows = A->nvec ;
 	return (GrB_SUCCESS) ;
 }
 
@@ -35,14 +31,85 @@ GrB_Info GxB_MatrixTupleIter_iterate_row
 	GB_WHERE("GxB_MatrixTupleIter_iterate_row (iter, rowIdx)");
 	GB_RETURN_IF_NULL(iter);
 
-	if(rowIdx < 0 && rowIdx >= iter->nrows) {
+	GrB_Matrix A = iter->A ;
+	if(rowIdx >= A->vdim) {
 		return (GB_ERROR(GrB_INVALID_INDEX, (GB_LOG, "Row index out of range")));
 	}
 
-	iter->nvals = iter->A->p[rowIdx + 1];
-	iter->nnz_idx = iter->A->p[rowIdx];
-	iter->row_idx = rowIdx;
-	iter->p = 0;
+	//--------------------------------------------------------------------------
+	// locate the vector holding row
+	//--------------------------------------------------------------------------
+
+	int64_t k = rowIdx ;
+	if(A->is_hyper) {
+		// A->h lists the matrix non-empty rows in ascending order.
+		int64_t lo = 0 ;
+		int64_t hi = iter->nrows ;
+		while(lo < hi) {
+			int64_t mid = lo + (hi - lo) / 2 ;
+			if(A->h[mid] < rowIdx) lo = mid + 1 ;
+			else hi = mid ;
+		}
+
+		if(lo == iter->nrows || A->h[lo] != rowIdx) {
+			// Row is empty.
+			iter->nvals = 0 ;
+			iter->nnz_idx = 0 ;
+			iter->row_idx = 0 ;
+			return (GrB_SUCCESS) ;
+		}
+		k = lo ;
+	}
+
+	iter->nvals = A->p[k + 1];
+	iter->nnz_idx = A->p[k];
+	iter->row_idx = k;
+	return (GrB_SUCCESS);
+}
+
+// Position of the first vector holding a row >= rowIdx
+static int64_t _MatrixTupleIter_LowerBound
+(
+	const GxB_MatrixTupleIter *iter,
+	GrB_Index rowIdx
+) {
+	GrB_Matrix A = iter->A ;
+	if(!A->is_hyper) return rowIdx ;
+
+	int64_t lo = 0 ;
+	int64_t hi = iter->nrows ;
+	while(lo < hi) {
+		int64_t mid = lo + (hi - lo) / 2 ;
+		if(A->h[mid] < rowIdx) lo = mid + 1 ;
+		else hi = mid ;
+	}
+	return lo ;
+}
+
+GrB_Info GxB_MatrixTupleIter_iterate_range
+(
+	GxB_MatrixTupleIter *iter,
+	GrB_Index startRowIdx,
+	GrB_Index endRowIdx
+) {
+	GB_WHERE("GxB_MatrixTupleIter_iterate_range (iter, startRowIdx, endRowIdx)");
+	GB_RETURN_IF_NULL(iter);
+
+	if(startRowIdx > endRowIdx) {
+		return (GB_ERROR(GrB_INVALID_INDEX, (GB_LOG, "Invalid row range")));
+	}
+
+	// Clamp range to matrix dimensions.
+	GrB_Matrix A = iter->A ;
+	if(endRowIdx > A->vdim) endRowIdx = A->vdim ;
+	if(startRowIdx > endRowIdx) startRowIdx = endRowIdx ;
+
+	int64_t kstart = _MatrixTupleIter_LowerBound(iter, startRowIdx) ;
+	int64_t kend = _MatrixTupleIter_LowerBound(iter, endRowIdx) ;
+
+	iter->nvals = A->p[kend];
+	iter->nnz_idx = A->p[kstart];
+	iter->row_idx = kstart;
 	return (GrB_SUCCESS);
 }
 
@@ -77,21 +144,15 @@ GrB_Info GxB_MatrixTupleIter_next
 	// extract the row indices
 	//--------------------------------------------------------------------------
 
+	// Advance to the vector holding the current none zero value,
+	// skipping empty vectors, A->p[k+1] is one past the last value of vector k.
 	const int64_t *Ap = A->p;
-	int64_t i = iter->row_idx;
-
-	for(; i < iter->nrows; i++) {
-		int64_t p = iter->p + Ap[i];
-		if(p < Ap[i + 1]) {
-			iter->p++;
-			if(row)
-				*row = i;
-			break;
-		}
-		iter->p = 0;
-	}
+	int64_t k = iter->row_idx;
+	while(Ap[k + 1] <= nnz_idx) k++;
+	iter->row_idx = k;
 
-	iter->row_idx = i;
+	if(row)
+		*row = (A->is_hyper) ? A->h[k] : k;
 
 	iter->nnz_idx++ ;
 
@@ -99,6 +160,32 @@ GrB_Info GxB_MatrixTupleIter_next
 	return (GrB_SUCCESS) ;
 }
 
+// Advance iterator to the next none zero value of a UINT64 matrix
+GrB_Info GxB_MatrixTupleIter_next_UINT64
+(
+	GxB_MatrixTupleIter *iter,      // iterator to consume
+	GrB_Index *row,                 // optional output row index
+	GrB_Index *col,                 // optional output column index
+	uint64_t *val,                  // optional output value
+	bool *depleted                  // indicate if iterator depleted
+) {
+	GB_WHERE("GxB_MatrixTupleIter_next_UINT64 (iter, row, col, val, depleted)") ;
+	GB_RETURN_IF_NULL(iter) ;
+	GB_RETURN_IF_NULL(depleted) ;
+
+	if(iter->A->type != GrB_UINT64) {
+		return (GB_ERROR(GrB_DOMAIN_MISMATCH, (GB_LOG, "Matrix must be of type UINT64")));
+	}
+
+	// Value of the current none zero, read before the iterator advances.
+	GrB_Index nnz_idx = iter->nnz_idx ;
+	GrB_Info info = GxB_MatrixTupleIter_next(iter, row, col, depleted) ;
+	if(info == GrB_SUCCESS && !*depleted && val) {
+		*val = ((const uint64_t *)iter->A->x)[nnz_idx] ;
+	}
+	return (info) ;
+}
+
 // Reset iterator
 GrB_Info GxB_MatrixTupleIter_reset
 (
@@ -108,7 +195,6 @@ GrB_Info GxB_MatrixTupleIter_reset
 	GB_RETURN_IF_NULL(iter) ;
 	iter->nnz_idx = 0 ;
 	iter->row_idx = 0 ;
-	iter->p = iter->A->p[0] ;
 	return (GrB_SUCCESS) ;
 }
 
@@ -122,12 +208,9 @@ GrB_Info GxB_MatrixTupleIter_reuse
 	GB_RETURN_IF_NULL(iter) ;
 	GB_RETURN_IF_NULL_OR_FAULTY(A) ;
 
-	GrB_Index nrows;
-	GrB_Matrix_nrows(&nrows, A);
-
 	iter->A = A ;
-	iter->nrows = nrows ;
 	GrB_Matrix_nvals(&iter->nvals, A) ;
+	iter->nrows = A->nvec ;
 	GxB_MatrixTupleIter_reset(iter) ;
 	return (GrB_SUCCESS) ;
 }
@@ -142,3 +225,56 @@ GrB_Info GxB_MatrixTupleIter_free
 	GB_FREE_MEMORY(iter, 1, sizeof(GxB_MatrixTupleIter)) ;
 	return (GrB_SUCCESS) ;
 }
+
+// Access the entries of a single row
+GrB_Info GxB_Matrix_row_slice
+(
+	const GrB_Index **cols,         // column indices of row's entries
+	const void **vals,              // optional values of row's entries
+	GrB_Index *nvals,               // number of entries in row
+	GrB_Matrix A,                   // matrix to access, held by row
+	GrB_Index rowIdx                // row to access
+) {
+	GB_WHERE("GxB_Matrix_row_slice (cols, vals, nvals, A, rowIdx)") ;
+	GB_RETURN_IF_NULL(cols) ;
+	GB_RETURN_IF_NULL(nvals) ;
+	GB_RETURN_IF_NULL_OR_FAULTY(A) ;
+
+	if(A->is_csc) {
+		return (GB_ERROR(GrB_INVALID_VALUE, (GB_LOG, "Matrix must be held by row")));
+	}
+	if(rowIdx >= A->vdim) {
+		return (GB_ERROR(GrB_INVALID_INDEX, (GB_LOG, "Row index out of range")));
+	}
+
+	// Slice must not expose pending tuples or zombies.
+	GB_WAIT(A) ;
+
+	*cols = NULL ;
+	*nvals = 0 ;
+	if(vals) *vals = NULL ;
+
+	//--------------------------------------------------------------------------
+	// locate the vector holding row
+	//--------------------------------------------------------------------------
+
+	int64_t k = rowIdx ;
+	if(A->is_hyper) {
+		int64_t lo = 0 ;
+		int64_t hi = A->nvec ;
+		while(lo < hi) {
+			int64_t mid = lo + (hi - lo) / 2 ;
+			if(A->h[mid] < rowIdx) lo = mid + 1 ;
+			else hi = mid ;
+		}
+		// Row is empty.
+		if(lo == A->nvec || A->h[lo] != rowIdx) return (GrB_SUCCESS) ;
+		k = lo ;
+	}
+
+	int64_t start = A->p[k] ;
+	*nvals = A->p[k + 1] - start ;
+	*cols = (const GrB_Index *)(A->i + start) ;
+	if(vals) *vals = (const GB_void *)A->x + start * A->type->size ;
+	return (GrB_SUCCESS) ;
+}
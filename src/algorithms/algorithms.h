@@ -10,5 +10,11 @@
 #include "./bfs.h"
 #include "./dfs.h"
 #include "./all_paths.h"
+#include "./bidirectional_bfs.h"
+#include "./shortest_path.h"
+#include "./pagerank.h"
+#include "./connected_components.h"
+#include "./triangle_count.h"
+#include "./kcore.h"
 
 #endif
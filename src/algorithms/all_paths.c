@@ -8,18 +8,9 @@
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 
-// Make sure context levels array have atleast 'level' entries,
-// Append given 'node' to given 'level' array.
-static void _AllPathsCtx_AddNodeToLevel(AllPathsCtx *ctx, uint level, Node *node) {
-	while(array_len(ctx->levels) <= level) {
-		ctx->levels = array_append(ctx->levels, array_new(Node, 1));
-	}
-	ctx->levels[level] = array_append(ctx->levels[level], *node);
-}
-
-// Check to see if context levels array has entries at position 'level'.
-static bool _AllPathsCtx_LevelNotEmpty(const AllPathsCtx *ctx, uint level) {
-	return (level < array_len(ctx->levels) && array_len(ctx->levels[level]) > 0);
+// Discover the path extending given 'path' by 'neighbor'.
+static void _AllPathsCtx_AddFrontier(AllPathsCtx *ctx, SharedPath *path, Node *neighbor) {
+	ctx->frontier = array_append(ctx->frontier, SharedPath_New(*neighbor, path));
 }
 
 AllPathsCtx *AllPathsCtx_New(Node *src, Graph *g, int *relationIDs, int relationCount,
@@ -37,84 +28,67 @@ AllPathsCtx *AllPathsCtx_New(Node *src, Graph *g, int *relationIDs, int relation
 	ctx->maxLen = maxLen + 1;
 	ctx->relationIDs = relationIDs;
 	ctx->relationCount = relationCount;
-	ctx->levels = array_new(Node *, 1);
-	ctx->path = array_new(Node, 1);
-	ctx->neighbors = array_new(Edge, 32);
-	_AllPathsCtx_AddNodeToLevel(ctx, 0, src);
+	ctx->frontier = array_new(SharedPath *, 1);
+	ctx->path = NULL;
+	_AllPathsCtx_AddFrontier(ctx, NULL, src);
 	return ctx;
 }
 
-Path AllPathsCtx_NextPath(AllPathsCtx *ctx) {
+SharedPath *AllPathsCtx_NextPath(AllPathsCtx *ctx) {
 	if(!ctx) return NULL;
-	// As long as path is not empty OR there are neighbors to traverse.
-	while(!Path_empty(ctx->path) || _AllPathsCtx_LevelNotEmpty(ctx, 0)) {
-		uint32_t depth = Path_len(ctx->path);
-
-		// Can we advance?
-		if(_AllPathsCtx_LevelNotEmpty(ctx, depth)) {
-			// Get a new frontier.
-			Node frontier = array_pop(ctx->levels[depth]);
-
-			/* See if frontier is already on path,
-			 * it is OK for a path to contain an entity twice,
-			 * such as in the case of a cycle, but in such case we
-			 * won't expand frontier.
-			 * i.e. closing a cycle and continuing traversal. */
-			bool frontierAlreadyOnPath = Path_containsNode(ctx->path, &frontier);
+	// As long as there are paths to visit.
+	while(array_len(ctx->frontier) > 0) {
+		/* Discard the previous path, paths discovered from it
+		 * retain it as their prefix. */
+		SharedPath_Release(ctx->path);
 
-			// Add frontier to path.
-			ctx->path = Path_append(ctx->path, frontier);
+		// Get a new frontier, the most recently discovered path.
+		ctx->path = array_pop(ctx->frontier);
+		Node frontier = SharedPath_Head(ctx->path);
+		uint32_t depth = SharedPath_Len(ctx->path);
 
-			// Update path depth.
-			depth++;
+		/* See if frontier is already on path,
+		 * it is OK for a path to contain an entity twice,
+		 * such as in the case of a cycle, but in such case we
+		 * won't expand frontier.
+		 * i.e. closing a cycle and continuing traversal. */
+		NodeID frontierID = ENTITY_GET_ID(&frontier);
+		bool frontierAlreadyOnPath = SharedPath_ContainsNode(ctx->path->prefix, frontierID);
 
-			/* Introduce neighbors only if path depth < maximum path length.
-			 * and frontier wasn't already expanded. */
-			if(depth < ctx->maxLen && !frontierAlreadyOnPath) {
-				// Get frontier neighbors.
-				for(int i = 0; i < ctx->relationCount; i++) {
-					Graph_GetNodeEdges(ctx->g, &frontier, ctx->dir, ctx->relationIDs[i], &ctx->neighbors);
-				}
+		/* Introduce neighbors only if path depth < maximum path length.
+		 * and frontier wasn't already expanded. */
+		if(depth < ctx->maxLen && !frontierAlreadyOnPath) {
+			// Extend path by frontier's neighbors, once per connecting edge.
+			for(int i = 0; i < ctx->relationCount; i++) {
+				NeighborCursor c;
+				Graph_NeighborCursor_Init(ctx->g, &c, frontierID, ctx->dir, ctx->relationIDs[i]);
+				for(uint64_t j = 0; j < c.count; j++) {
+					uint32_t edgeCount = Graph_NeighborCursor_Edges(ctx->g, &c, j, NULL);
+					if(edgeCount == 0) continue;
 
-				// Add unvisited neighbors to next level.
-				uint32_t neighborsCount = array_len(ctx->neighbors);
-				for(uint32_t i = 0; i < neighborsCount; i++) {
-					// TODO might need to check direction!
 					Node neighbor;
-					if(ctx->dir == GRAPH_EDGE_DIR_OUTGOING) {
-						Graph_GetNode(ctx->g, Edge_GetDestNodeID(ctx->neighbors + i), &neighbor);
-					} else {
-						Graph_GetNode(ctx->g, Edge_GetSrcNodeID(ctx->neighbors + i), &neighbor);
-					}
-
-					_AllPathsCtx_AddNodeToLevel(ctx, depth, &neighbor);
+					Graph_GetNode(ctx->g, c.neighbors[j], &neighbor);
+					for(uint32_t k = 0; k < edgeCount; k++) _AllPathsCtx_AddFrontier(ctx, ctx->path, &neighbor);
 				}
-				array_clear(ctx->neighbors);
 			}
-
-			// See if we can return path.
-			/* TODO Note that further calls to this function will continue to operate on
-			 * this path, so it is essential that the caller does not modify it (or creates
-			 * a copy beforehand). If future features like an algorithm API use this routine,
-			 * they should either be responsible for memory safety or a memory-safe boolean/routine
-			 * should be offered. */
-			if(depth >= ctx->minLen && depth <= ctx->maxLen) return ctx->path;
-		} else {
-			// No way to advance, backtrack.
-			Path_pop(ctx->path);
 		}
+
+		// See if we can return path.
+		if(depth >= ctx->minLen && depth <= ctx->maxLen) return ctx->path;
 	}
+
 	// Couldn't find a path.
+	SharedPath_Release(ctx->path);
+	ctx->path = NULL;
 	return NULL;
 }
 
 void AllPathsCtx_Free(AllPathsCtx *ctx) {
 	if(!ctx) return;
-	uint32_t levelsCount = array_len(ctx->levels);
-	for(int i = 0; i < levelsCount; i++) array_free(ctx->levels[i]);
-	array_free(ctx->levels);
-	Path_free(ctx->path);
-	array_free(ctx->neighbors);
+	uint32_t frontierCount = array_len(ctx->frontier);
+	for(uint32_t i = 0; i < frontierCount; i++) SharedPath_Release(ctx->frontier[i]);
+	array_free(ctx->frontier);
+	SharedPath_Release(ctx->path);
 	rm_free(ctx);
 	ctx = NULL;
 }
@@ -11,22 +11,23 @@
  * To implement this kind of iterative path fiding using DFS
  * we're keeping track after:
  * 1. the last path computed, which we'll try to expand
- * 2. neighboring nodes discovered, each placed within a "level"
- * array containing all nodes discovered at a specific level.
+ * 2. paths discovered but yet to be visited, each extending
+ * a visited path by a single neighbor.
+ * Paths are shared paths, a discovered path shares its prefix with
+ * every other path extending the same visited path.
  * */
 
 #ifndef _ALL_PATHS_H_
 #define _ALL_PATHS_H_
 
-#include "./path.h"
+#include "./shared_path.h"
 #include "../graph/graph.h"
 #include "../graph/entities/node.h"
 
 typedef struct {
-	Node **levels;          // Nodes reached at depth i.
-	Path path;              // Current path.
+	SharedPath **frontier;  // Paths discovered, yet to be visited.
+	SharedPath *path;       // Current path.
 	Graph *g;               // Graph to traverse.
-	Edge *neighbors;        // Reusable buffer of edges along the current path.
 	int *relationIDs;       // edge type(s) to traverse.
 	int relationCount;      // length of relationIDs.
 	GRAPH_EDGE_DIR dir;     // traverse direction.
@@ -47,7 +48,9 @@ AllPathsCtx *AllPathsCtx_New(
 
 // Tries to produce a new path from given context
 // If no additional path can be computed return NULL.
-Path AllPathsCtx_NextPath(
+// The returned path is valid until the next call to this function,
+// callers wishing to hold on to it should retain it.
+SharedPath *AllPathsCtx_NextPath(
 	AllPathsCtx *ctx
 );
 
@@ -0,0 +1,141 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./bidirectional_bfs.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+BidirectionalBFSCtx *BidirectionalBFS_New(void) {
+	BidirectionalBFSCtx *ctx = rm_malloc(sizeof(BidirectionalBFSCtx));
+	ctx->n = 0;
+	GrB_Vector_new(&ctx->src_frontier, GrB_BOOL, 0);
+	GrB_Vector_new(&ctx->src_visited, GrB_BOOL, 0);
+	GrB_Vector_new(&ctx->dest_frontier, GrB_BOOL, 0);
+	GrB_Vector_new(&ctx->dest_visited, GrB_BOOL, 0);
+	GrB_Vector_new(&ctx->meet, GrB_BOOL, 0);
+
+	// Newly discovered nodes are masked by the nodes already visited.
+	GrB_Descriptor_new(&ctx->desc);
+	GrB_Descriptor_set(ctx->desc, GrB_MASK, GrB_SCMP);
+	GrB_Descriptor_set(ctx->desc, GrB_OUTP, GrB_REPLACE);
+
+	GrB_Descriptor_new(&ctx->desc_tran);
+	GrB_Descriptor_set(ctx->desc_tran, GrB_MASK, GrB_SCMP);
+	GrB_Descriptor_set(ctx->desc_tran, GrB_OUTP, GrB_REPLACE);
+	GrB_Descriptor_set(ctx->desc_tran, GrB_INP1, GrB_TRAN);
+	return ctx;
+}
+
+// Clear search state, resizing vectors to the matrix dimension.
+static void _BidirectionalBFS_Clear(BidirectionalBFSCtx *ctx, GrB_Index n) {
+	if(ctx->n != n) {
+		GxB_Vector_resize(ctx->src_frontier, n);
+		GxB_Vector_resize(ctx->src_visited, n);
+		GxB_Vector_resize(ctx->dest_frontier, n);
+		GxB_Vector_resize(ctx->dest_visited, n);
+		GxB_Vector_resize(ctx->meet, n);
+		ctx->n = n;
+	}
+
+	GrB_Vector_clear(ctx->src_frontier);
+	GrB_Vector_clear(ctx->src_visited);
+	GrB_Vector_clear(ctx->dest_frontier);
+	GrB_Vector_clear(ctx->dest_visited);
+}
+
+/* Advance search by a single level:
+ * frontier<!visited> = frontier * A
+ * returns true if any of the newly discovered nodes were visited by the opposite search,
+ * sets frontier_size to the number of newly discovered nodes. */
+static bool _BidirectionalBFS_Expand(BidirectionalBFSCtx *ctx, GrB_Vector frontier,
+									 GrB_Vector visited, GrB_Vector opposite_visited, GrB_Matrix A, bool tran,
+									 GrB_Index *frontier_size) {
+	GrB_Descriptor desc = (tran) ? ctx->desc_tran : ctx->desc;
+	GrB_vxm(frontier, visited, NULL, GxB_LOR_LAND_BOOL, frontier, A, desc);
+	GrB_Vector_nvals(frontier_size, frontier);
+	if(*frontier_size == 0) return false;
+
+	GrB_Index meet_size;
+	GrB_eWiseMult_Vector_BinaryOp(ctx->meet, NULL, NULL, GrB_LAND, frontier, opposite_visited, NULL);
+	GrB_Vector_nvals(&meet_size, ctx->meet);
+	if(meet_size > 0) return true;
+
+	GrB_eWiseAdd_Vector_BinaryOp(visited, NULL, NULL, GrB_LOR, visited, frontier, NULL);
+	return false;
+}
+
+bool BidirectionalBFS_Reachable(BidirectionalBFSCtx *ctx, GrB_Matrix M, GrB_Matrix MT,
+								bool transpose, GrB_Index src, GrB_Index dest, unsigned int minHops,
+								unsigned int maxHops) {
+	assert(ctx && M && minHops <= 1);
+	if(minHops == 0 && src == dest) return true;
+	if(maxHops == 0) return false;
+
+	/* Forward search follows M, or M's transpose when traversing in reverse,
+	 * backward search follows the opposite orientation. */
+	GrB_Matrix fwd = M;
+	GrB_Matrix bwd = M;
+	bool fwd_tran = false;
+	bool bwd_tran = false;
+	if(transpose) {
+		if(MT) fwd = MT;
+		else fwd_tran = true;
+	} else {
+		if(MT) bwd = MT;
+		else bwd_tran = true;
+	}
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, M);
+	_BidirectionalBFS_Clear(ctx, n);
+
+	GrB_Vector_setElement_BOOL(ctx->src_frontier, true, src);
+	GrB_Vector_setElement_BOOL(ctx->dest_frontier, true, dest);
+	GrB_Vector_setElement_BOOL(ctx->dest_visited, true, dest);
+	// Source only counts as reached by an empty walk if minHops is 0.
+	if(minHops == 0) GrB_Vector_setElement_BOOL(ctx->src_visited, true, src);
+
+	bool found = false;
+	unsigned int src_depth = 0;
+	unsigned int dest_depth = 0;
+	GrB_Index src_size = 1;
+	GrB_Index dest_size = 1;
+
+	while(!found && src_depth + dest_depth < maxHops) {
+		// Both searches are exhausted.
+		if(src_size == 0 && dest_size == 0) break;
+
+		/* Expand the smaller frontier, a walk of at least one edge
+		 * must be discovered by the forward search, which therefore goes first. */
+		bool forward = (src_depth == 0 && minHops > 0) ||
+					   dest_size == 0 ||
+					   (src_size != 0 && src_size <= dest_size);
+
+		if(forward) {
+			found = _BidirectionalBFS_Expand(ctx, ctx->src_frontier, ctx->src_visited,
+											 ctx->dest_visited, fwd, fwd_tran, &src_size);
+			src_depth++;
+		} else {
+			found = _BidirectionalBFS_Expand(ctx, ctx->dest_frontier, ctx->dest_visited,
+											 ctx->src_visited, bwd, bwd_tran, &dest_size);
+			dest_depth++;
+		}
+	}
+
+	return found;
+}
+
+void BidirectionalBFS_Free(BidirectionalBFSCtx *ctx) {
+	if(!ctx) return;
+	GrB_Vector_free(&ctx->src_frontier);
+	GrB_Vector_free(&ctx->src_visited);
+	GrB_Vector_free(&ctx->dest_frontier);
+	GrB_Vector_free(&ctx->dest_visited);
+	GrB_Vector_free(&ctx->meet);
+	GrB_Descriptor_free(&ctx->desc);
+	GrB_Descriptor_free(&ctx->desc_tran);
+	rm_free(ctx);
+}
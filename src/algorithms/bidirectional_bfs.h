@@ -0,0 +1,56 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Bidirectional BFS determines whether a destination node is reachable
+ * from a source node within a bounded number of hops.
+ * Two frontiers are grown, one from the source following edges forward
+ * and one from the destination following edges backward, always expanding
+ * the smaller of the two, until they meet or the hop budget is exhausted.
+ * Each side only explores about half of the search depth, such that
+ * the work is roughly the square root of a single sided search.
+ *
+ * The context holds the vectors used by the search
+ * and can be reused for any number of searches. */
+
+typedef struct {
+	GrB_Index n;                // Dimension of vectors.
+	GrB_Vector src_frontier;    // Nodes discovered by the last forward level.
+	GrB_Vector src_visited;     // Nodes reachable from source.
+	GrB_Vector dest_frontier;   // Nodes discovered by the last backward level.
+	GrB_Vector dest_visited;    // Nodes reaching destination.
+	GrB_Vector meet;            // Nodes discovered by both searches.
+	GrB_Descriptor desc;        // Masked expansion.
+	GrB_Descriptor desc_tran;   // Masked expansion, transposing the matrix.
+} BidirectionalBFSCtx;
+
+// Create a new bidirectional BFS context.
+BidirectionalBFSCtx *BidirectionalBFS_New(void);
+
+/* Returns true if dest is reachable from src by a walk of at most maxHops edges.
+ * M is the traversed matrix, M[i,j] is set if there's an edge from i to j,
+ * if transpose is set edges are followed from j to i.
+ * MT is M's transpose, NULL if unavailable in which case it is computed on the fly.
+ * Walks of length 0 are only considered if minHops is 0.
+ * The shortest connecting walk is a path (or a cycle, if src is dest),
+ * as such dest is reachable iff a path of [minHops, maxHops] edges connects the two. */
+bool BidirectionalBFS_Reachable(
+	BidirectionalBFSCtx *ctx,
+	GrB_Matrix M,           // Traversed matrix.
+	GrB_Matrix MT,          // M's transpose, optional.
+	bool transpose,         // Follow M's edges in reverse.
+	GrB_Index src,          // Node from which forward search begins.
+	GrB_Index dest,         // Node from which backward search begins.
+	unsigned int minHops,   // Minimum walk length, 0 or 1.
+	unsigned int maxHops    // Maximum walk length.
+);
+
+// Free context.
+void BidirectionalBFS_Free(BidirectionalBFSCtx *ctx);
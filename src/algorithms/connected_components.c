@@ -0,0 +1,82 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./connected_components.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+GrB_Vector ConnectedComponents(GrB_Matrix A) {
+	assert(A);
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, A);
+
+	// Every node starts as its own parent.
+	GrB_Index *ids = rm_malloc(sizeof(GrB_Index) * n);
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * n);
+	uint64_t *V = rm_malloc(sizeof(uint64_t) * n);
+	uint64_t *parent = rm_malloc(sizeof(uint64_t) * n);
+	uint64_t *grandparent = rm_malloc(sizeof(uint64_t) * n);
+	for(GrB_Index i = 0; i < n; i++) {
+		ids[i] = i;
+		parent[i] = i;
+		grandparent[i] = i;
+	}
+
+	GrB_Vector gp;
+	GrB_Vector mngp;
+	GrB_Vector_new(&gp, GrB_UINT64, n);
+	GrB_Vector_new(&mngp, GrB_UINT64, n);
+
+	bool changed = true;
+	while(changed) {
+		// Smallest grandparent among each node's neighbors.
+		GrB_Vector_clear(gp);
+		GrB_Vector_build_UINT64(gp, ids, grandparent, n, GrB_FIRST_UINT64);
+		GrB_mxv(mngp, NULL, NULL, GxB_MIN_SECOND_UINT64, A, gp, NULL);
+
+		GrB_Index nvals;
+		GrB_Vector_nvals(&nvals, mngp);
+		GrB_Vector_extractTuples_UINT64(I, V, &nvals, mngp);
+
+		for(GrB_Index k = 0; k < nvals; k++) {
+			GrB_Index i = I[k];
+			uint64_t m = V[k];
+			// Stochastic hooking, hook node's parent onto m.
+			if(m < parent[parent[i]]) parent[parent[i]] = m;
+			// Aggressive hooking, hook node itself onto m.
+			if(m < parent[i]) parent[i] = m;
+		}
+
+		// Shortcutting.
+		for(GrB_Index i = 0; i < n; i++) {
+			if(grandparent[i] < parent[i]) parent[i] = grandparent[i];
+		}
+
+		// Recompute grandparents, done once they no longer change.
+		changed = false;
+		for(GrB_Index i = 0; i < n; i++) {
+			uint64_t g = parent[parent[i]];
+			if(g != grandparent[i]) {
+				grandparent[i] = g;
+				changed = true;
+			}
+		}
+	}
+
+	GrB_Vector components;
+	GrB_Vector_new(&components, GrB_UINT64, n);
+	GrB_Vector_build_UINT64(components, ids, parent, n, GrB_FIRST_UINT64);
+
+	GrB_Vector_free(&gp);
+	GrB_Vector_free(&mngp);
+	rm_free(ids);
+	rm_free(I);
+	rm_free(V);
+	rm_free(parent);
+	rm_free(grandparent);
+	return components;
+}
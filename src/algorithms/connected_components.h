@@ -0,0 +1,22 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Computes the connected components of an undirected graph using FastSV,
+ * a variant of the Shiloach-Vishkin algorithm in which every node keeps
+ * a parent pointer, parents are repeatedly hooked onto the smallest grandparent
+ * found among the node's neighbors:
+ * mngp = A min.second grandparents
+ * and trees are flattened by shortcutting, until grandparents no longer change.
+ * A must be symmetric, A[i,j] is set if i and j are adjacent.
+ * Returns a vector (UINT64) holding an entry for every node, the smallest
+ * node ID within its component, caller is responsible for freeing it. */
+GrB_Vector ConnectedComponents(
+	GrB_Matrix A    // Symmetric adjacency matrix.
+);
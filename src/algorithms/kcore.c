@@ -0,0 +1,78 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./kcore.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+GrB_Vector KCore(GrB_Matrix A) {
+	assert(A);
+
+	GrB_Index n;
+	GrB_Index nvals;
+	GrB_Matrix_nrows(&n, A);
+
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * n);
+	uint64_t *V = rm_malloc(sizeof(uint64_t) * n);
+	bool *flags = rm_malloc(sizeof(bool) * n);
+	bool *removed = rm_calloc(n, sizeof(bool));
+	uint64_t *core = rm_calloc(n, sizeof(uint64_t));
+	uint64_t *degree = rm_calloc(n, sizeof(uint64_t));
+	for(GrB_Index i = 0; i < n; i++) flags[i] = true;
+
+	GrB_Vector degrees;
+	GrB_Vector_new(&degrees, GrB_UINT64, n);
+	GrB_Matrix_reduce_Monoid(degrees, NULL, NULL, GxB_PLUS_UINT64_MONOID, A, NULL);
+	GrB_Vector_nvals(&nvals, degrees);
+	GrB_Vector_extractTuples_UINT64(I, V, &nvals, degrees);
+	for(GrB_Index k = 0; k < nvals; k++) degree[I[k]] = V[k];
+	GrB_Vector_free(&degrees);
+
+	GrB_Vector peeled;
+	GrB_Vector deltas;
+	GrB_Vector_new(&peeled, GrB_BOOL, n);
+	GrB_Vector_new(&deltas, GrB_UINT64, n);
+
+	GrB_Index remaining = n;
+	for(uint64_t k = 0; remaining > 0; k++) {
+		// Peel nodes with at most k neighbors, until none remain.
+		while(true) {
+			GrB_Index peeled_count = 0;
+			for(GrB_Index i = 0; i < n; i++) {
+				if(removed[i] || degree[i] > k) continue;
+				removed[i] = true;
+				core[i] = k;
+				I[peeled_count++] = i;
+			}
+			if(peeled_count == 0) break;
+			remaining -= peeled_count;
+
+			// Neighbors lose an edge to each peeled node.
+			GrB_Vector_clear(peeled);
+			GrB_Vector_build_BOOL(peeled, I, flags, peeled_count, GrB_LOR);
+			GrB_vxm(deltas, NULL, NULL, GxB_PLUS_TIMES_UINT64, peeled, A, NULL);
+
+			GrB_Vector_nvals(&nvals, deltas);
+			GrB_Vector_extractTuples_UINT64(I, V, &nvals, deltas);
+			for(GrB_Index j = 0; j < nvals; j++) degree[I[j]] -= V[j];
+		}
+	}
+
+	for(GrB_Index i = 0; i < n; i++) I[i] = i;
+	GrB_Vector cores;
+	GrB_Vector_new(&cores, GrB_UINT64, n);
+	GrB_Vector_build_UINT64(cores, I, core, n, GrB_FIRST_UINT64);
+
+	GrB_Vector_free(&peeled);
+	GrB_Vector_free(&deltas);
+	rm_free(I);
+	rm_free(V);
+	rm_free(flags);
+	rm_free(removed);
+	rm_free(core);
+	rm_free(degree);
+	return cores;
+}
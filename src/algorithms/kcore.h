@@ -0,0 +1,23 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Computes the core number of every node of an undirected graph,
+ * the largest k for which the node belongs to the k-core, the maximal
+ * subgraph in which every node has at least k neighbors.
+ * Nodes are peeled off in rounds, round k removes every remaining node
+ * with fewer than k + 1 remaining neighbors, until none are left,
+ * the degrees of the removed nodes' neighbors are decremented by
+ * deltas = removed plus.times A
+ * A must be symmetric with an empty diagonal, A[i,j] is set if i and j are adjacent.
+ * Returns a vector (UINT64) holding the core number of every node,
+ * caller is responsible for freeing it. */
+GrB_Vector KCore(
+	GrB_Matrix A    // Symmetric adjacency matrix.
+);
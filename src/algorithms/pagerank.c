@@ -0,0 +1,101 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./pagerank.h"
+#include "../util/rmalloc.h"
+#include <math.h>
+#include <assert.h>
+
+GrB_Vector PageRank(GrB_Matrix A, GrB_Vector nodes) {
+	assert(A && nodes);
+
+	GrB_Index n;
+	GrB_Index node_count;
+	GrB_Matrix_nrows(&n, A);
+	GrB_Vector_nvals(&node_count, nodes);
+
+	GrB_Vector ranks;
+	GrB_Vector_new(&ranks, GrB_FP64, n);
+	if(node_count == 0) return ranks;
+
+	GrB_Index *ids = rm_malloc(sizeof(GrB_Index) * node_count);
+	GrB_Vector_extractTuples_BOOL(ids, NULL, &node_count, nodes);
+
+	// Out degree of each node, row sums of A.
+	GrB_Index nvals;
+	GrB_Vector degrees;
+	GrB_Vector_new(&degrees, GrB_UINT64, n);
+	GrB_Matrix_reduce_Monoid(degrees, NULL, NULL, GxB_PLUS_UINT64_MONOID, A, NULL);
+	GrB_Vector_nvals(&nvals, degrees);
+
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * n);
+	double *X = rm_malloc(sizeof(double) * n);
+	uint64_t *D = rm_malloc(sizeof(uint64_t) * n);
+	uint64_t *degree = rm_calloc(n, sizeof(uint64_t));
+	GrB_Vector_extractTuples_UINT64(I, D, &nvals, degrees);
+	for(GrB_Index k = 0; k < nvals; k++) degree[I[k]] = D[k];
+	GrB_Vector_free(&degrees);
+	rm_free(D);
+
+	// Every node starts with an equal share.
+	double *rank = rm_calloc(n, sizeof(double));
+	double *next = rm_calloc(n, sizeof(double));
+	for(GrB_Index k = 0; k < node_count; k++) rank[ids[k]] = 1.0 / node_count;
+
+	GrB_Vector w;
+	GrB_Vector t;
+	GrB_Vector_new(&w, GrB_FP64, n);
+	GrB_Vector_new(&t, GrB_FP64, n);
+
+	for(int iter = 0; iter < PAGERANK_MAX_ITERATIONS; iter++) {
+		// w = damping * rank / out_degree, dangling nodes have no share to pass along edges.
+		double dangling = 0;
+		GrB_Index w_nvals = 0;
+		for(GrB_Index k = 0; k < node_count; k++) {
+			GrB_Index i = ids[k];
+			if(degree[i] == 0) {
+				dangling += rank[i];
+			} else {
+				I[w_nvals] = i;
+				X[w_nvals] = PAGERANK_DAMPING * rank[i] / degree[i];
+				w_nvals++;
+			}
+		}
+
+		GrB_Vector_clear(w);
+		GrB_Vector_build_FP64(w, I, X, w_nvals, GrB_PLUS_FP64);
+		GrB_vxm(t, NULL, NULL, GxB_PLUS_TIMES_FP64, w, A, NULL);
+
+		// Teleport and dangling ranks are spread evenly.
+		double base = (1 - PAGERANK_DAMPING + PAGERANK_DAMPING * dangling) / node_count;
+		for(GrB_Index k = 0; k < node_count; k++) next[ids[k]] = base;
+
+		GrB_Vector_nvals(&nvals, t);
+		GrB_Vector_extractTuples_FP64(I, X, &nvals, t);
+		for(GrB_Index k = 0; k < nvals; k++) next[I[k]] += X[k];
+
+		double diff = 0;
+		for(GrB_Index k = 0; k < node_count; k++) diff += fabs(next[ids[k]] - rank[ids[k]]);
+
+		double *tmp = rank;
+		rank = next;
+		next = tmp;
+		if(diff < PAGERANK_TOLERANCE) break;
+	}
+
+	for(GrB_Index k = 0; k < node_count; k++) X[k] = rank[ids[k]];
+	GrB_Vector_build_FP64(ranks, ids, X, node_count, GrB_PLUS_FP64);
+
+	GrB_Vector_free(&w);
+	GrB_Vector_free(&t);
+	rm_free(ids);
+	rm_free(degree);
+	rm_free(rank);
+	rm_free(next);
+	rm_free(I);
+	rm_free(X);
+	return ranks;
+}
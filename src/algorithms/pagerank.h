@@ -0,0 +1,25 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+#define PAGERANK_DAMPING 0.85           // Probability of following an edge rather than teleporting.
+#define PAGERANK_MAX_ITERATIONS 100     // Maximum number of power iterations.
+#define PAGERANK_TOLERANCE 1e-6         // Converged once ranks change less than this, L1 norm.
+
+/* Computes the PageRank of every node by power iteration,
+ * each iteration distributes ranks along edges with the plus.times semiring:
+ * ranks' = teleport + (damping * ranks / out_degree) plus.times A
+ * where dangling nodes (no outgoing edges) spread their rank evenly across all nodes.
+ * A[i,j] is set if there's an edge from i to j, nodes holds an entry for each node
+ * of the graph, slots of deleted nodes are left out.
+ * Returns a vector of ranks (FP64) summing to 1, caller is responsible for freeing it. */
+GrB_Vector PageRank(
+	GrB_Matrix A,       // Traversed matrix.
+	GrB_Vector nodes    // Nodes to rank.
+);
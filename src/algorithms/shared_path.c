@@ -0,0 +1,58 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./shared_path.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+SharedPath *SharedPath_New(Node n, SharedPath *prefix) {
+	SharedPath *p = rm_malloc(sizeof(SharedPath));
+	p->node = n;
+	p->prefix = (prefix) ? SharedPath_Retain(prefix) : NULL;
+	p->len = (prefix) ? prefix->len + 1 : 1;
+	p->refcount = 1;
+	return p;
+}
+
+SharedPath *SharedPath_Retain(SharedPath *p) {
+	assert(p);
+	// Paths may outlive the thread which created them, e.g. within a record.
+	__atomic_add_fetch(&p->refcount, 1, __ATOMIC_RELAXED);
+	return p;
+}
+
+void SharedPath_Release(SharedPath *p) {
+	// Free path and every prefix it was the last to reference.
+	while(p && __atomic_sub_fetch(&p->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+		SharedPath *prefix = p->prefix;
+		rm_free(p);
+		p = prefix;
+	}
+}
+
+Node SharedPath_Head(const SharedPath *p) {
+	return p->node;
+}
+
+uint32_t SharedPath_Len(const SharedPath *p) {
+	return p->len;
+}
+
+bool SharedPath_ContainsNode(const SharedPath *p, NodeID id) {
+	for(; p; p = p->prefix) {
+		if(ENTITY_GET_ID(&p->node) == id) return true;
+	}
+	return false;
+}
+
+Path SharedPath_Nodes(const SharedPath *p) {
+	uint32_t len = p->len;
+	Path nodes = array_newlen(Node, len);
+	// Walk from head back to source, filling in reverse order.
+	for(uint32_t i = len; i > 0; i--, p = p->prefix) nodes[i - 1] = p->node;
+	return nodes;
+}
@@ -0,0 +1,58 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+/*
+ * Persistent path representation.
+ * A shared path is a node in a tree of paths, it holds the last node
+ * of the path and a reference to the path's prefix, as such paths
+ * diverging from a common prefix share it rather than copying it.
+ * Once created a shared path is never modified, extending a path
+ * creates a new path in O(1), leaving the original intact.
+ * Shared paths are reference counted, a path retains its prefix
+ * and releasing the last reference to a path frees it along with
+ * every prefix no longer referenced.
+ * */
+
+#ifndef _SHARED_PATH_H_
+#define _SHARED_PATH_H_
+
+#include "./path.h"
+#include "../graph/entities/node.h"
+#include <stdint.h>
+
+typedef struct SharedPath SharedPath;
+
+struct SharedPath {
+	Node node;              // Last node on path.
+	SharedPath *prefix;     // Path leading to node, NULL if node is the path's source.
+	uint32_t len;           // Number of nodes on path.
+	uint32_t refcount;      // Number of references to path.
+};
+
+// Creates a new path, extending prefix by n, prefix may be NULL.
+// The returned path holds a single reference.
+SharedPath *SharedPath_New(Node n, SharedPath *prefix);
+
+// Acquire an additional reference to path.
+SharedPath *SharedPath_Retain(SharedPath *p);
+
+// Releases a reference to path, freeing it once no references remain.
+void SharedPath_Release(SharedPath *p);
+
+// Returns the last node on path.
+Node SharedPath_Head(const SharedPath *p);
+
+// Returns the number of nodes on path.
+uint32_t SharedPath_Len(const SharedPath *p);
+
+// Returns true if a node with the given ID is on path.
+bool SharedPath_ContainsNode(const SharedPath *p, NodeID id);
+
+// Materializes path, returns its nodes ordered from source to head,
+// caller is responsible for freeing the returned path.
+Path SharedPath_Nodes(const SharedPath *p);
+
+#endif
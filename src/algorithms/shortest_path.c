@@ -0,0 +1,290 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./shortest_path.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include <math.h>
+#include <assert.h>
+
+void ShortestPath_BFS(GrB_Matrix M, GrB_Index src, GrB_Index dest, GrB_Vector *distances,
+					  GrB_Vector *parents) {
+	assert(M && parents);
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, M);
+	assert(src < n);
+
+	GrB_Vector frontier;    // Nodes discovered by the last level, valued by their own ID.
+	GrB_Vector discovered;  // Nodes discovered by the current level, valued by their parent's ID.
+	GrB_Vector level;       // Nodes discovered by the current level.
+	GrB_Vector visited;     // Nodes discovered so far.
+	GrB_Vector_new(&frontier, GrB_UINT64, n);
+	GrB_Vector_new(&discovered, GrB_UINT64, n);
+	GrB_Vector_new(&level, GrB_BOOL, n);
+	GrB_Vector_new(&visited, GrB_BOOL, n);
+	GrB_Vector_new(parents, GrB_UINT64, n);
+	if(distances) GrB_Vector_new(distances, GrB_UINT64, n);
+
+	GrB_Vector_setElement_UINT64(frontier, src, src);
+	GrB_Vector_setElement_BOOL(visited, true, src);
+	GrB_Vector_setElement_UINT64(*parents, src, src);
+	if(distances) GrB_Vector_setElement_UINT64(*distances, 0, src);
+
+	GrB_Descriptor desc;
+	GrB_Descriptor_new(&desc);
+	GrB_Descriptor_set(desc, GrB_MASK, GrB_SCMP);
+	GrB_Descriptor_set(desc, GrB_OUTP, GrB_REPLACE);
+
+	// Buffers for the tuples of discovered nodes, grown as required.
+	GrB_Index cap = 0;
+	GrB_Index *ids = NULL;
+	uint64_t *vals = NULL;
+	bool *flags = NULL;
+
+	for(uint64_t depth = 1; src != dest; depth++) {
+		GrB_vxm(discovered, visited, NULL, GxB_MIN_FIRST_UINT64, frontier, M, desc);
+
+		GrB_Index nvals;
+		GrB_Vector_nvals(&nvals, discovered);
+		if(nvals == 0) break;
+
+		GrB_eWiseAdd_Vector_BinaryOp(*parents, NULL, NULL, GrB_FIRST_UINT64, *parents, discovered,
+									 NULL);
+
+		if(nvals > cap) {
+			rm_free(ids);
+			rm_free(vals);
+			rm_free(flags);
+			cap = nvals;
+			ids = rm_malloc(sizeof(GrB_Index) * cap);
+			vals = rm_malloc(sizeof(uint64_t) * cap);
+			flags = rm_malloc(sizeof(bool) * cap);
+			for(GrB_Index i = 0; i < cap; i++) flags[i] = true;
+		}
+		GrB_Vector_extractTuples_UINT64(ids, vals, &nvals, discovered);
+
+		// Discovered nodes form the next frontier, each valued by its own ID.
+		GrB_Vector_clear(frontier);
+		GrB_Vector_build_UINT64(frontier, ids, ids, nvals, GrB_FIRST_UINT64);
+		GrB_Vector_clear(level);
+		GrB_Vector_build_BOOL(level, ids, flags, nvals, GrB_LOR);
+
+		GrB_eWiseAdd_Vector_BinaryOp(visited, NULL, NULL, GrB_LOR, visited, level, NULL);
+		if(distances) GrB_Vector_assign_UINT64(*distances, level, NULL, depth, GrB_ALL, n, NULL);
+
+		bool found;
+		if(dest != SHORTEST_PATH_NO_DEST &&
+		   GrB_Vector_extractElement_BOOL(&found, level, dest) == GrB_SUCCESS) break;
+	}
+
+	rm_free(ids);
+	rm_free(vals);
+	rm_free(flags);
+	GrB_Descriptor_free(&desc);
+	GrB_Vector_free(&frontier);
+	GrB_Vector_free(&discovered);
+	GrB_Vector_free(&level);
+	GrB_Vector_free(&visited);
+}
+
+// Returns true if both vectors have the same pattern and values.
+static bool _VectorsEqual(GrB_Vector a, GrB_Vector b) {
+	GrB_Index a_nvals;
+	GrB_Index b_nvals;
+	GrB_Vector_nvals(&a_nvals, a);
+	GrB_Vector_nvals(&b_nvals, b);
+	if(a_nvals != b_nvals) return false;
+
+	GrB_Index n;
+	GrB_Index eq_nvals;
+	GrB_Vector eq;
+	GrB_Vector_size(&n, a);
+	GrB_Vector_new(&eq, GrB_BOOL, n);
+	GrB_eWiseMult_Vector_BinaryOp(eq, NULL, NULL, GrB_EQ_FP64, a, b, NULL);
+	GrB_Vector_nvals(&eq_nvals, eq);
+
+	bool equal = true;
+	if(eq_nvals != a_nvals) equal = false;
+	else GrB_Vector_reduce_BOOL(&equal, NULL, GxB_LAND_BOOL_MONOID, eq, NULL);
+
+	GrB_Vector_free(&eq);
+	return equal;
+}
+
+/* Builds the matrix of tight edges, edges (i,j) for which distances[i] + W[i,j] = distances[j],
+ * every lightest path is made of tight edges. */
+static GrB_Matrix _TightEdges(GrB_Matrix W, GrB_Vector distances) {
+	GrB_Index n;
+	GrB_Index nvals;
+	GrB_Matrix_nrows(&n, W);
+
+	// Densify distances, unreachable nodes are infinitely far.
+	double *dist = rm_malloc(sizeof(double) * n);
+	for(GrB_Index i = 0; i < n; i++) dist[i] = INFINITY;
+	GrB_Vector_nvals(&nvals, distances);
+	GrB_Index *ids = rm_malloc(sizeof(GrB_Index) * nvals);
+	double *vals = rm_malloc(sizeof(double) * nvals);
+	GrB_Vector_extractTuples_FP64(ids, vals, &nvals, distances);
+	for(GrB_Index i = 0; i < nvals; i++) dist[ids[i]] = vals[i];
+	rm_free(ids);
+	rm_free(vals);
+
+	GrB_Matrix_nvals(&nvals, W);
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * nvals);
+	GrB_Index *J = rm_malloc(sizeof(GrB_Index) * nvals);
+	double *X = rm_malloc(sizeof(double) * nvals);
+	bool *B = rm_malloc(sizeof(bool) * nvals);
+	GrB_Matrix_extractTuples_FP64(I, J, X, &nvals, W);
+
+	GrB_Index tight = 0;
+	for(GrB_Index k = 0; k < nvals; k++) {
+		if(dist[I[k]] == INFINITY || dist[I[k]] + X[k] != dist[J[k]]) continue;
+		I[tight] = I[k];
+		J[tight] = J[k];
+		B[tight] = true;
+		tight++;
+	}
+
+	GrB_Matrix T;
+	GrB_Matrix_new(&T, GrB_BOOL, n, n);
+	GrB_Matrix_build_BOOL(T, I, J, B, tight, GrB_LOR);
+
+	rm_free(dist);
+	rm_free(I);
+	rm_free(J);
+	rm_free(X);
+	rm_free(B);
+	return T;
+}
+
+bool ShortestPath_BellmanFord(GrB_Matrix W, GrB_Index src, GrB_Vector *distances,
+							  GrB_Vector *parents) {
+	assert(W && distances && parents);
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, W);
+	assert(src < n);
+
+	GrB_Vector d;
+	GrB_Vector t;
+	GrB_Vector_new(&d, GrB_FP64, n);
+	GrB_Vector_new(&t, GrB_FP64, n);
+	GrB_Vector_setElement_FP64(d, 0, src);
+
+	/* Without negative cycles, lightest paths are made of at most n - 1 edges,
+	 * distances must converge within n relaxations. */
+	bool converged = false;
+	for(GrB_Index i = 0; i < n && !converged; i++) {
+		// t = min(d, d min.plus W)
+		GrB_vxm(t, NULL, NULL, GxB_MIN_PLUS_FP64, d, W, NULL);
+		GrB_eWiseAdd_Vector_BinaryOp(t, NULL, NULL, GrB_MIN_FP64, t, d, NULL);
+		converged = _VectorsEqual(t, d);
+
+		GrB_Vector tmp = d;
+		d = t;
+		t = tmp;
+	}
+
+	GrB_Vector_free(&t);
+	if(!converged) {
+		GrB_Vector_free(&d);
+		return false;
+	}
+
+	// Lightest paths with the fewest edges, traced over tight edges.
+	GrB_Matrix T = _TightEdges(W, d);
+	ShortestPath_BFS(T, src, SHORTEST_PATH_NO_DEST, NULL, parents);
+	GrB_Matrix_free(&T);
+
+	*distances = d;
+	return true;
+}
+
+NodeID *ShortestPath_Trace(GrB_Vector parents, GrB_Index src, GrB_Index dest) {
+	assert(parents);
+
+	uint64_t parent;
+	if(GrB_Vector_extractElement_UINT64(&parent, parents, dest) != GrB_SUCCESS) return NULL;
+
+	// Collect path backwards, from dest to src.
+	NodeID *path = array_new(NodeID, 1);
+	path = array_append(path, dest);
+	for(GrB_Index v = dest; v != src; v = parent) {
+		GrB_Vector_extractElement_UINT64(&parent, parents, v);
+		path = array_append(path, parent);
+	}
+
+	uint len = array_len(path);
+	for(uint i = 0; i < len / 2; i++) {
+		NodeID tmp = path[i];
+		path[i] = path[len - 1 - i];
+		path[len - 1 - i] = tmp;
+	}
+
+	return path;
+}
+
+// Collect the weights of relation's edges.
+static void _CollectWeights(const Graph *g, int relation, Attribute_ID weight, GrB_Index **I,
+							GrB_Index **J, double **X) {
+	Edge e;
+	bool depleted = false;
+	NodeID src;
+	NodeID dest;
+	EdgeID entry;
+	GrB_Matrix M = Graph_GetRelationMap(g, relation);
+	GxB_MatrixTupleIter *it;
+	GxB_MatrixTupleIter_new(&it, M);
+
+	while(true) {
+		GxB_MatrixTupleIter_next(it, &src, &dest, &depleted);
+		if(depleted) break;
+
+		uint32_t edge_count;
+		GrB_Matrix_extractElement_UINT64(&entry, M, src, dest);
+		const EdgeID *edge_ids = Graph_ResolveRelationMapEntry(g, relation, &entry, &edge_count);
+		for(uint32_t i = 0; i < edge_count; i++) {
+			Graph_GetEdge(g, edge_ids[i], &e);
+			SIValue *v = GraphEntity_GetProperty((GraphEntity *)&e, weight);
+			if(v == PROPERTY_NOTFOUND || !(SI_TYPE(*v) & SI_NUMERIC)) continue;
+
+			*I = array_append(*I, src);
+			*J = array_append(*J, dest);
+			*X = array_append(*X, SI_GET_NUMERIC(*v));
+		}
+	}
+
+	GxB_MatrixTupleIter_free(it);
+}
+
+GrB_Matrix ShortestPath_WeightMatrix(const Graph *g, int relation, Attribute_ID weight) {
+	assert(g);
+
+	GrB_Index *I = array_new(GrB_Index, 0);
+	GrB_Index *J = array_new(GrB_Index, 0);
+	double *X = array_new(double, 0);
+
+	if(weight != ATTRIBUTE_NOTFOUND) {
+		if(relation == GRAPH_NO_RELATION) {
+			int relation_count = Graph_RelationTypeCount(g);
+			for(int r = 0; r < relation_count; r++) _CollectWeights(g, r, weight, &I, &J, &X);
+		} else {
+			_CollectWeights(g, relation, weight, &I, &J, &X);
+		}
+	}
+
+	// Multiple edges connecting the same pair of nodes, keep the lightest.
+	GrB_Matrix W;
+	GrB_Index n = Graph_RequiredMatrixDim(g);
+	GrB_Matrix_new(&W, GrB_FP64, n, n);
+	GrB_Matrix_build_FP64(W, I, J, X, array_len(I), GrB_MIN_FP64);
+
+	array_free(I);
+	array_free(J);
+	array_free(X);
+	return W;
+}
@@ -0,0 +1,63 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include "../graph/graph.h"
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+#define SHORTEST_PATH_NO_DEST UINT64_MAX     // Discover every node reachable from source.
+
+/* Single source shortest paths over matrix M, M[i,j] is set if there's an edge from i to j.
+ * Breadth first, level by level:
+ * frontier<!visited> = frontier min.first M
+ * frontier entries hold their own node ID, such that each newly discovered
+ * node learns the (minimal) ID of a node discovered on the previous level.
+ * On return distances (UINT64) holds the number of hops from src to each
+ * reachable node and parents (UINT64) holds each reachable node's predecessor
+ * on a shortest path, parents[src] = src.
+ * The search stops once dest is discovered, unless dest is SHORTEST_PATH_NO_DEST.
+ * Caller is responsible for freeing both vectors, distances is optional. */
+void ShortestPath_BFS(
+	GrB_Matrix M,           // Traversed matrix.
+	GrB_Index src,          // Node from which search begins.
+	GrB_Index dest,         // Node at which search stops.
+	GrB_Vector *distances,  // [output] Number of hops from src, optional.
+	GrB_Vector *parents     // [output] Predecessor on a shortest path.
+);
+
+/* Weighted single source shortest paths, Bellman-Ford over the min-plus semiring:
+ * distances = min(distances, distances min.plus W)
+ * until distances converge, W[i,j] is the weight of the edge from i to j.
+ * On return distances (FP64) holds the weight of the lightest path from src to each
+ * reachable node and parents (UINT64) holds each reachable node's predecessor on such path.
+ * Returns false if a negative cycle is reachable from src, in which case
+ * no vectors are returned. Caller is responsible for freeing both vectors. */
+bool ShortestPath_BellmanFord(
+	GrB_Matrix W,           // Weight matrix.
+	GrB_Index src,          // Node from which search begins.
+	GrB_Vector *distances,  // [output] Path weight from src.
+	GrB_Vector *parents     // [output] Predecessor on a lightest path.
+);
+
+/* Follows parents from dest back to src, returns an arr.h array holding the IDs
+ * of the nodes along the path from src to dest, NULL if dest isn't reachable. */
+NodeID *ShortestPath_Trace(
+	GrB_Vector parents,     // Predecessors computed by either search.
+	GrB_Index src,          // Path source.
+	GrB_Index dest          // Path destination.
+);
+
+/* Builds weight matrix W (FP64), W[i,j] holds the minimal weight of the edges
+ * of relation connecting i to j, the weight of an edge is its weight attribute.
+ * Edges lacking a numeric weight attribute aren't traversable.
+ * Pass GRAPH_NO_RELATION to consider edges of every relation type. */
+GrB_Matrix ShortestPath_WeightMatrix(
+	const Graph *g,         // Graph to build weight matrix from.
+	int relation,           // Relation type of traversable edges.
+	Attribute_ID weight     // Edge attribute holding weight.
+);
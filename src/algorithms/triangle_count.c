@@ -0,0 +1,42 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./triangle_count.h"
+#include <assert.h>
+
+static void _Halve(void *z, const void *x) {
+	*(uint64_t *)z = *(const uint64_t *)x / 2;
+}
+
+GrB_Vector TriangleCount(GrB_Matrix A) {
+	assert(A);
+
+	GrB_Index n;
+	GrB_Matrix_nrows(&n, A);
+
+	// A is symmetric, A' rows are A's columns, each entry is a dot product of two rows.
+	GrB_Matrix C;
+	GrB_Descriptor desc;
+	GrB_Matrix_new(&C, GrB_UINT64, n, n);
+	GrB_Descriptor_new(&desc);
+	GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
+	GrB_mxm(C, A, NULL, GxB_PLUS_TIMES_UINT64, A, A, desc);
+	GrB_Descriptor_free(&desc);
+
+	// Adjacent pairs without common neighbors produce no entry.
+	GrB_Vector triangles;
+	GrB_Vector_new(&triangles, GrB_UINT64, n);
+	GrB_Matrix_reduce_Monoid(triangles, NULL, NULL, GxB_PLUS_UINT64_MONOID, C, NULL);
+	GrB_Matrix_free(&C);
+
+	// Each triangle is accounted for by both of the node's edges participating in it.
+	GrB_UnaryOp halve;
+	GrB_UnaryOp_new(&halve, _Halve, GrB_UINT64, GrB_UINT64);
+	GrB_Vector_apply(triangles, NULL, NULL, halve, triangles, NULL);
+	GrB_UnaryOp_free(&halve);
+
+	return triangles;
+}
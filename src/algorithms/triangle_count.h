@@ -0,0 +1,22 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Counts the triangles each node of an undirected graph participates in.
+ * C<A> = A plus.times A'
+ * C[i,j] is the number of common neighbors of adjacent nodes i and j,
+ * masking by A only computes entries for adjacent pairs, such that the
+ * product is evaluated as a set of sparse dot products.
+ * Node i participates in rowsum(C)[i] / 2 triangles.
+ * A must be symmetric with an empty diagonal, A[i,j] is set if i and j are adjacent.
+ * Returns a vector (UINT64) holding the triangle count of every node
+ * participating in at least one triangle, caller is responsible for freeing it. */
+GrB_Vector TriangleCount(
+	GrB_Matrix A    // Symmetric adjacency matrix.
+);
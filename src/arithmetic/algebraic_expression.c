@@ -179,6 +179,7 @@ void AlgebraicExpression_AppendTerm(AlgebraicExpression *ae, GrB_Matrix m, bool
 	ae->operands[ae->operand_count].free = freeOp;
 	ae->operands[ae->operand_count].diagonal = diagonal;
 	ae->operands[ae->operand_count].transpose = transposeOp;
+	ae->operands[ae->operand_count].source = NULL;
 	ae->operand_count++;
 }
 
@@ -202,6 +203,7 @@ void AlgebraicExpression_PrependTerm(AlgebraicExpression *ae, GrB_Matrix m, bool
 	ae->operands[0].free = freeOp;
 	ae->operands[0].diagonal = diagonal;
 	ae->operands[0].transpose = transposeOp;
+	ae->operands[0].source = NULL;
 }
 
 void AlgebraicExpression_AppendOperand(AlgebraicExpression *ae, AlgebraicExpressionOperand op) {
@@ -334,6 +336,7 @@ static AlgebraicExpressionOperand _AlgebraicExpression_OperandFromNode(QGNode *n
 	op.free = false;
 	op.diagonal = true;
 	op.transpose = false;
+	op.source = NULL;
 	Graph *g = QueryCtx_GetGraph();
 	if(n->labelID == GRAPH_UNKNOWN_LABEL) {
 		op.operand = Graph_GetZeroMatrix(g);
@@ -390,6 +393,7 @@ static AlgebraicExpressionOperand _AlgebraicExpression_OperandFromEdge(
 	op.diagonal = false;
 	op.free = freeMatrix;
 	op.transpose = transpose;
+	op.source = NULL;
 	return op;
 }
 
@@ -397,6 +401,19 @@ AlgebraicExpression *AlgebraicExpression_Empty(void) {
 	return _AE_MUL(1);
 }
 
+AlgebraicExpression *AlgebraicExpression_Clone(const AlgebraicExpression *ae) {
+	AlgebraicExpression *clone = _AE_MUL(ae->operand_cap);
+	clone->op = ae->op;
+	clone->operand_count = ae->operand_count;
+	clone->src_node = ae->src_node;
+	clone->dest_node = ae->dest_node;
+	clone->edge = ae->edge;
+	memcpy(clone->operands, ae->operands, sizeof(AlgebraicExpressionOperand) * ae->operand_count);
+	// Operands are owned by the original expression.
+	for(size_t i = 0; i < clone->operand_count; i++) clone->operands[i].free = false;
+	return clone;
+}
+
 /* In case edge a and b share a node:
  * (a)-[E0]->(b)<-[e1]-(c)
  * than the shared entity is returned
@@ -595,12 +612,14 @@ AlgebraicExpression **AlgebraicExpression_FromQueryGraph(const QueryGraph *qg,
 /* Evaluates an algebraic expression.
  * The left most operand in the expression is a tiny extremely sparse matrix
  * this allows us to avoid computing multiplications of large matrices.
- * In the case an operand is marked for transpose, we will perform
- * the transpose once and update the expression. */
+ * In the case an operand is marked for transpose, the graph's maintained
+ * transpose is used, otherwise we will perform the transpose once
+ * and update the expression. */
 void AlgebraicExpression_Execute(AlgebraicExpression *ae, GrB_Matrix res) {
 	assert(ae && res);
 	size_t operand_count = ae->operand_count;
 	assert(operand_count > 1);
+	Graph *g = QueryCtx_GetGraph();
 
 	AlgebraicExpressionOperand leftTerm;
 	AlgebraicExpressionOperand rightTerm;
@@ -618,10 +637,18 @@ void AlgebraicExpression_Execute(AlgebraicExpression *ae, GrB_Matrix res) {
 		leftTerm = operands[i - 1];
 		rightTerm = operands[i];
 
-
 		/* Incase we're required to transpose right hand side operand
 		 * perform transpose once and update original expression. */
 
+		// Graph maintains operand's transpose, expression is left untouched.
+		if(rightTerm.transpose && !rightTerm.free) {
+			GrB_Matrix t = Graph_GetTransposedMatrix(g, rightTerm.operand);
+			if(t) {
+				rightTerm.operand = t;
+				rightTerm.transpose = false;
+			}
+		}
+
 		if(rightTerm.transpose) {
 			assert(!rightTerm.diagonal); // Never transpose diagonal matrix.
 			GrB_Matrix t = rightTerm.operand;
@@ -634,7 +661,8 @@ void AlgebraicExpression_Execute(AlgebraicExpression *ae, GrB_Matrix res) {
 			}
 			GrB_transpose(t, GrB_NULL, GrB_NULL, rightTerm.operand, GrB_NULL);
 
-			// Update local and original expressions.
+			// Update local and original expressions, retaining graph matrix.
+			if(!rightTerm.free) ae->operands[i].source = rightTerm.operand;
 			rightTerm.free = true;
 			rightTerm.operand = t;
 			rightTerm.transpose = false;
@@ -667,6 +695,19 @@ void AlgebraicExpression_RemoveTerm(AlgebraicExpression *ae, int idx,
 	ae->operand_count--;
 }
 
+void AlgebraicExpression_RestoreOperands(AlgebraicExpression *ae) {
+	assert(ae);
+	for(size_t i = 0; i < ae->operand_count; i++) {
+		AlgebraicExpressionOperand *op = ae->operands + i;
+		if(!op->source) continue;
+		GrB_Matrix_free(&op->operand);
+		op->operand = op->source;
+		op->source = NULL;
+		op->free = false;
+		op->transpose = true;
+	}
+}
+
 void AlgebraicExpression_Free(AlgebraicExpression *ae) {
 	for(int i = 0; i < ae->operand_count; i++) {
 		if(ae->operands[i].free) {
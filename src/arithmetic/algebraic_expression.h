@@ -59,6 +59,7 @@ typedef struct  {
 	bool transpose;         // Should the matrix be transposed.
 	bool free;              // Should the matrix be freed?
 	GrB_Matrix operand;
+	GrB_Matrix source;      // Graph matrix operand was transposed from, NULL if none.
 } AlgebraicExpressionOperand;
 
 // Algebraic expression e.g. A*B*C
@@ -75,6 +76,10 @@ typedef struct {
 /* Constructs an empty expression. */
 AlgebraicExpression *AlgebraicExpression_Empty(void);
 
+/* Clones expression, clone shares operand matrices with the original expression
+ * and never frees them, original expression must outlive the clone. */
+AlgebraicExpression *AlgebraicExpression_Clone(const AlgebraicExpression *ae);
+
 /* Construct algebraic expression(s) from query graph. */
 AlgebraicExpression **AlgebraicExpression_FromQueryGraph(
 	const QueryGraph *g,    // Graph to construct expression from.
@@ -101,6 +106,10 @@ void AlgebraicExpression_RemoveTerm(AlgebraicExpression *ae, int idx,
  * directly accessing expression transpose flag is forbidden. */
 void AlgebraicExpression_Transpose(AlgebraicExpression *ae);
 
+/* Discards transposed copies of graph matrices made by AlgebraicExpression_Execute,
+ * restoring the original operands such that the next evaluation reflects graph updates. */
+void AlgebraicExpression_RestoreOperands(AlgebraicExpression *ae);
+
 void AlgebraicExpression_Free(AlgebraicExpression *ae);
 
 #endif
@@ -0,0 +1,384 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./ar_program.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include <string.h>
+#include <assert.h>
+
+//------------------------------------------------------------------------------
+// Compilation
+//------------------------------------------------------------------------------
+
+static AR_Instruction _NewInstruction(AR_InstructionType type, uint16_t dst) {
+	AR_Instruction ins;
+	memset(&ins, 0, sizeof(AR_Instruction));
+	ins.type = type;
+	ins.dst = dst;
+	ins.attr = ATTRIBUTE_NOTFOUND;
+	ins.constant = SI_NullVal();
+	return ins;
+}
+
+// Appends instruction to program, returns its position.
+static uint _Emit(AR_Program *p, AR_Instruction ins) {
+	if(ins.dst >= p->reg_count) p->reg_count = ins.dst + 1;
+	p->instructions = array_append(p->instructions, ins);
+	return array_len(p->instructions) - 1;
+}
+
+static inline bool _IsConstant(const AR_ExpNode *exp) {
+	return exp->type == AR_EXP_OPERAND && exp->operand.type == AR_EXP_CONSTANT;
+}
+
+static inline bool _IsProperty(const AR_ExpNode *exp) {
+	return exp->type == AR_EXP_OPERAND && exp->operand.type == AR_EXP_VARIADIC &&
+		   exp->operand.variadic.entity_prop != NULL;
+}
+
+// Operator to apply once operands are swapped, a < b iff b > a.
+static AST_Operator _SwapOperands(AST_Operator op) {
+	switch(op) {
+	case OP_LT:
+		return OP_GT;
+	case OP_GT:
+		return OP_LT;
+	case OP_LE:
+		return OP_GE;
+	case OP_GE:
+		return OP_LE;
+	default:
+		return op;
+	}
+}
+
+/* Determines if arguments of the given types must be type checked upon invocation,
+ * types[i] is the set of types the ith argument might evaluate to. */
+static bool _RequiresValidation(const AR_FuncDesc *f, const SIType *types, uint argc) {
+	if(f->argc != VAR_ARG_LEN && f->argc != argc) return true;
+
+	// The last specified type of a variadic function is repeatable.
+	uint expected_types_count = (f->argc == VAR_ARG_LEN) ? array_len(f->types) : argc;
+	SIType expected = T_NULL;
+	for(uint i = 0; i < argc; i++) {
+		if(i < expected_types_count) expected = f->types[i];
+		if((types[i] & expected) != types[i]) return true;
+	}
+	return false;
+}
+
+/* Emits instructions evaluating exp into register dst,
+ * registers following dst are used as scratch space.
+ * Returns the set of types exp might evaluate to. */
+static SIType _CompileExpression(AR_Program *p, const AR_ExpNode *exp, uint16_t dst) {
+	AR_Instruction ins;
+
+	if(exp->type == AR_EXP_OPERAND) {
+		switch(exp->operand.type) {
+		case AR_EXP_CONSTANT:
+			ins = _NewInstruction(AR_INS_LOAD_CONST, dst);
+			ins.constant = exp->operand.constant;
+			_Emit(p, ins);
+			return SI_TYPE(exp->operand.constant);
+		case AR_EXP_PARAM:
+			ins = _NewInstruction(AR_INS_LOAD_PARAM, dst);
+			ins.name = exp->operand.param.name;
+			_Emit(p, ins);
+			return SI_ALL;
+		case AR_EXP_VARIADIC:
+			ins = _NewInstruction((exp->operand.variadic.entity_prop) ? AR_INS_LOAD_PROP : AR_INS_LOAD_ENTRY,
+								  dst);
+			ins.entry = exp->operand.variadic.entity_alias_idx;
+			ins.name = exp->operand.variadic.entity_prop;
+			ins.attr = exp->operand.variadic.entity_prop_idx;
+			_Emit(p, ins);
+			return SI_ALL;
+		default:
+			assert(false);
+		}
+	}
+
+	assert(exp->type == AR_EXP_OP);
+
+	// Aggregation results are computed by the aggregate operation.
+	if(exp->op.type == AR_OP_AGGREGATE) {
+		ins = _NewInstruction(AR_INS_LOAD_AGG, dst);
+		ins.agg = exp->op.agg_func;
+		_Emit(p, ins);
+		return SI_ALL;
+	}
+
+	// Arguments are evaluated into consecutive registers starting at dst.
+	uint16_t argc = exp->op.child_count;
+	SIType types[argc + 1];
+	for(uint16_t i = 0; i < argc; i++) {
+		types[i] = _CompileExpression(p, exp->op.children[i], dst + i);
+	}
+
+	ins = _NewInstruction(AR_INS_CALL, dst);
+	ins.f = exp->op.f;
+	ins.argc = argc;
+	ins.validate = _RequiresValidation(exp->op.f, types, argc);
+	_Emit(p, ins);
+	return SI_ALL;
+}
+
+// Boolean interpretation of a filter expression's value.
+static inline bool _Truthy(SIValue v) {
+	// Null, and numerics or booleans equal to 0 are false.
+	if(SIValue_IsNull(v)) return false;
+	if(SI_TYPE(v) & (SI_NUMERIC | T_BOOL)) return SI_GET_NUMERIC(v) != 0;
+	// String, Node, Edge, Ptr all evaluate to true.
+	return true;
+}
+
+// Determines if filter passes regardless of the evaluated record, setting pass accordingly.
+static bool _ConstantFilter(const FT_FilterNode *f, int *pass) {
+	switch(f->t) {
+	case FT_N_PRED:
+		if(!_IsConstant(f->pred.lhs) || !_IsConstant(f->pred.rhs)) return false;
+		*pass = FilterTree_CompareValues(&f->pred.lhs->operand.constant,
+										 &f->pred.rhs->operand.constant, f->pred.op);
+		return true;
+	case FT_N_EXP:
+		if(!_IsConstant(f->exp.exp)) return false;
+		*pass = _Truthy(f->exp.exp->operand.constant) ? FILTER_PASS : FILTER_FAIL;
+		return true;
+	case FT_N_COND:
+		if(!_ConstantFilter(f->cond.left, pass)) return false;
+		// Left operand decides the condition.
+		if(f->cond.op == OP_AND && *pass == FILTER_FAIL) return true;
+		if(f->cond.op == OP_OR && *pass == FILTER_PASS) return true;
+		return _ConstantFilter(f->cond.right, pass);
+	default:
+		assert(false);
+	}
+	return false;
+}
+
+static void _CompilePredicate(AR_Program *p, const FT_FilterNode *f, uint16_t dst) {
+	const AR_ExpNode *lhs = f->pred.lhs;
+	const AR_ExpNode *rhs = f->pred.rhs;
+	AST_Operator op = f->pred.op;
+
+	// Property compared against a constant, fetch and compare within a single instruction.
+	if(_IsConstant(lhs) && _IsProperty(rhs)) {
+		const AR_ExpNode *tmp = lhs;
+		lhs = rhs;
+		rhs = tmp;
+		op = _SwapOperands(op);
+	}
+	if(_IsProperty(lhs) && _IsConstant(rhs)) {
+		AR_Instruction ins = _NewInstruction(AR_INS_CMP_PROP_CONST, dst);
+		ins.op = op;
+		ins.entry = lhs->operand.variadic.entity_alias_idx;
+		ins.name = lhs->operand.variadic.entity_prop;
+		ins.attr = lhs->operand.variadic.entity_prop_idx;
+		ins.constant = rhs->operand.constant;
+		_Emit(p, ins);
+		return;
+	}
+
+	_CompileExpression(p, lhs, dst);
+	_CompileExpression(p, rhs, dst + 1);
+	AR_Instruction ins = _NewInstruction(AR_INS_CMP, dst);
+	ins.op = op;
+	_Emit(p, ins);
+}
+
+// Emits instructions evaluating filter f into a boolean at register dst.
+static void _CompileFilter(AR_Program *p, const FT_FilterNode *f, uint16_t dst) {
+	int pass;
+	if(_ConstantFilter(f, &pass)) {
+		AR_Instruction ins = _NewInstruction(AR_INS_LOAD_CONST, dst);
+		ins.constant = SI_BoolVal(pass);
+		_Emit(p, ins);
+		return;
+	}
+
+	switch(f->t) {
+	case FT_N_PRED:
+		_CompilePredicate(p, f, dst);
+		break;
+	case FT_N_EXP: {
+		_CompileExpression(p, f->exp.exp, dst);
+		_Emit(p, _NewInstruction(AR_INS_TEST, dst));
+		break;
+	}
+	case FT_N_COND: {
+		assert(f->cond.op == OP_AND || f->cond.op == OP_OR);
+		bool conjunction = (f->cond.op == OP_AND);
+
+		/* The condition isn't constant, as such a constant operand doesn't decide it,
+		 * the condition reduces to its other operand. */
+		if(_ConstantFilter(f->cond.left, &pass)) {
+			_CompileFilter(p, f->cond.right, dst);
+			break;
+		}
+		if(_ConstantFilter(f->cond.right, &pass) && pass == (conjunction ? FILTER_PASS : FILTER_FAIL)) {
+			_CompileFilter(p, f->cond.left, dst);
+			break;
+		}
+
+		// Skip right operand once left operand decides the condition.
+		_CompileFilter(p, f->cond.left, dst);
+		uint jump = _Emit(p, _NewInstruction((conjunction) ? AR_INS_JUMP_IF_FALSE : AR_INS_JUMP_IF_TRUE, dst));
+		_CompileFilter(p, f->cond.right, dst);
+		p->instructions[jump].target = array_len(p->instructions);
+		break;
+	}
+	default:
+		assert(false);
+	}
+}
+
+static AR_Program *_NewProgram(void) {
+	AR_Program *p = rm_malloc(sizeof(AR_Program));
+	p->instructions = array_new(AR_Instruction, 8);
+	p->reg_count = 1;
+	return p;
+}
+
+AR_Program *AR_Program_Compile(const AR_ExpNode *exp) {
+	assert(exp);
+	AR_Program *p = _NewProgram();
+	_CompileExpression(p, exp, 0);
+	return p;
+}
+
+AR_Program *AR_Program_CompileFilter(const FT_FilterNode *root) {
+	assert(root);
+	AR_Program *p = _NewProgram();
+	_CompileFilter(p, root, 0);
+	return p;
+}
+
+//------------------------------------------------------------------------------
+// Evaluation
+//------------------------------------------------------------------------------
+
+// Frees a consumed register.
+static inline void _Release(SIValue *reg) {
+	SIValue_Free(reg);
+	*reg = SI_NullVal();
+}
+
+/* Runs program against r, leaving its result at the first register,
+ * returns false if an error was encountered. */
+static bool _Run(AR_Program *p, const Record r, SIValue *regs) {
+	uint count = array_len(p->instructions);
+	for(uint16_t i = 0; i < p->reg_count; i++) regs[i] = SI_NullVal();
+
+	uint pc = 0;
+	while(pc < count) {
+		AR_Instruction *ins = p->instructions + pc++;
+		SIValue *dst = regs + ins->dst;
+
+		switch(ins->type) {
+		case AR_INS_LOAD_CONST:
+			// The value is constant and is shared with the caller.
+			*dst = SI_ShareValue(ins->constant);
+			break;
+		case AR_INS_LOAD_PARAM: {
+			// Parameter values are owned by the query context.
+			SIValue *param = QueryCtx_GetParam(ins->name);
+			if(param == NULL) {
+				char *error;
+				asprintf(&error, "Missing parameter: $%s", ins->name);
+				QueryCtx_SetError(error); // Set the query-level error.
+				return false;
+			}
+			*dst = SI_ShareValue(*param);
+			break;
+		}
+		case AR_INS_LOAD_ENTRY:
+			// The value was not created here; share with the caller.
+			*dst = SI_ShareValue(Record_Get(r, ins->entry));
+			break;
+		case AR_INS_LOAD_PROP:
+			if(AR_EXP_GetEntityProperty(r, ins->entry, ins->name, &ins->attr, dst) != EVAL_OK) return false;
+			break;
+		case AR_INS_LOAD_AGG:
+			// The AggCtx will ultimately free its result.
+			*dst = SI_ShareValue(ins->agg->result);
+			break;
+		case AR_INS_CALL: {
+			if(ins->validate && !AR_EXP_ValidateInvocation(ins->f, dst, ins->argc)) return false;
+			SIValue v = ins->f->func(dst, ins->argc);
+			for(uint16_t i = 0; i < ins->argc; i++) _Release(dst + i);
+			*dst = v;
+			/* An error was encountered while evaluating this function,
+			 * and has already been set in the QueryCtx. */
+			if(SIValue_IsNull(v) && QueryCtx_EncounteredError()) return false;
+			break;
+		}
+		case AR_INS_CMP: {
+			int pass = FilterTree_CompareValues(dst, dst + 1, ins->op);
+			_Release(dst);
+			_Release(dst + 1);
+			*dst = SI_BoolVal(pass);
+			break;
+		}
+		case AR_INS_CMP_PROP_CONST: {
+			SIValue v;
+			if(AR_EXP_GetEntityProperty(r, ins->entry, ins->name, &ins->attr, &v) != EVAL_OK) return false;
+			int pass = FilterTree_CompareValues(&v, &ins->constant, ins->op);
+			SIValue_Free(&v);
+			*dst = SI_BoolVal(pass);
+			break;
+		}
+		case AR_INS_TEST: {
+			bool pass = _Truthy(*dst);
+			_Release(dst);
+			*dst = SI_BoolVal(pass);
+			break;
+		}
+		case AR_INS_JUMP_IF_FALSE:
+			if(!dst->longval) pc = ins->target;
+			break;
+		case AR_INS_JUMP_IF_TRUE:
+			if(dst->longval) pc = ins->target;
+			break;
+		default:
+			assert(false);
+		}
+	}
+
+	return true;
+}
+
+// Frees registers left behind by a failed evaluation and raises the encountered error.
+static void _Fail(AR_Program *p, SIValue *regs) {
+	for(uint16_t i = 0; i < p->reg_count; i++) SIValue_Free(regs + i);
+	QueryCtx_RaiseRuntimeException();  // Raise an exception if we're in a run-time context.
+}
+
+SIValue AR_Program_Evaluate(AR_Program *program, const Record r) {
+	SIValue regs[program->reg_count];
+	if(!_Run(program, r, regs)) {
+		_Fail(program, regs);
+		return SI_NullVal(); // The query-level error will be emitted after cleanup.
+	}
+	// Every other register was consumed, hand the result to the caller.
+	return regs[0];
+}
+
+int AR_Program_ApplyFilter(AR_Program *program, const Record r) {
+	SIValue regs[program->reg_count];
+	if(!_Run(program, r, regs)) {
+		_Fail(program, regs);
+		return FILTER_FAIL;
+	}
+	return (regs[0].longval) ? FILTER_PASS : FILTER_FAIL;
+}
+
+void AR_Program_Free(AR_Program *program) {
+	if(!program) return;
+	array_free(program->instructions);
+	rm_free(program);
+}
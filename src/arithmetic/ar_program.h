@@ -0,0 +1,75 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "./arithmetic_expression.h"
+#include "../filter_tree/filter_tree.h"
+
+/* AR_Program is a compiled form of an arithmetic expression or a filter tree,
+ * a linear sequence of instructions operating on an array of registers.
+ * Evaluating a program avoids the recursive walk over expression trees:
+ * leaves become single load instructions with pre-resolved attribute IDs,
+ * function arguments are only type checked when their types can't be
+ * determined upfront, constant predicates are folded and
+ * predicates comparing a property against a constant are fused into
+ * a single instruction.
+ *
+ * A program references the constants, functions and aggregation contexts
+ * of the tree it was compiled from, the tree must outlive the program.
+ * Programs hold mutable state and must not be evaluated concurrently. */
+
+typedef enum {
+	AR_INS_LOAD_CONST,      // dst = constant.
+	AR_INS_LOAD_PARAM,      // dst = query parameter.
+	AR_INS_LOAD_ENTRY,      // dst = record entry.
+	AR_INS_LOAD_PROP,       // dst = record entry's property.
+	AR_INS_LOAD_AGG,        // dst = aggregation result.
+	AR_INS_CALL,            // dst = f(dst, dst + 1, ..., dst + argc - 1).
+	AR_INS_CMP,             // dst = dst op dst + 1.
+	AR_INS_CMP_PROP_CONST,  // dst = record entry's property op constant.
+	AR_INS_TEST,            // dst = dst evaluates to true.
+	AR_INS_JUMP_IF_FALSE,   // Continue at target if dst is false.
+	AR_INS_JUMP_IF_TRUE,    // Continue at target if dst is true.
+} AR_InstructionType;
+
+typedef struct {
+	AR_InstructionType type;
+	uint16_t dst;               // Destination register.
+	uint16_t argc;              // Number of arguments, CALL.
+	bool validate;              // Arguments must be type checked, CALL.
+	AST_Operator op;            // Comparison operator, CMP.
+	uint target;                // Instruction to continue at, JUMP.
+	int entry;                  // Record entry, LOAD_ENTRY and property access.
+	Attribute_ID attr;          // Attribute ID, ATTRIBUTE_NOTFOUND until resolved.
+	const char *name;           // Attribute or parameter name.
+	SIValue constant;           // Constant value, LOAD_CONST and CMP_PROP_CONST.
+	union {
+		AR_FuncDesc *f;         // Function to invoke, CALL.
+		AggCtx *agg;            // Aggregation context, LOAD_AGG.
+	};
+} AR_Instruction;
+
+typedef struct {
+	AR_Instruction *instructions;   // Instructions, arr.h array.
+	uint16_t reg_count;             // Number of registers required for evaluation.
+} AR_Program;
+
+/* Compiles arithmetic expression. */
+AR_Program *AR_Program_Compile(const AR_ExpNode *exp);
+
+/* Compiles filter tree into a program evaluating to a boolean. */
+AR_Program *AR_Program_CompileFilter(const FT_FilterNode *root);
+
+/* Evaluates compiled expression against r, equivalent to AR_EXP_Evaluate. */
+SIValue AR_Program_Evaluate(AR_Program *program, const Record r);
+
+/* Evaluates compiled filter against r, returns FILTER_PASS or FILTER_FAIL,
+ * equivalent to FilterTree_applyFilters. */
+int AR_Program_ApplyFilter(AR_Program *program, const Record r);
+
+/* Free program. */
+void AR_Program_Free(AR_Program *program);
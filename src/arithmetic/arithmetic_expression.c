@@ -21,17 +21,38 @@
 #include <ctype.h>
 #include <assert.h>
 
-/* Update arithmetic expression variable node by setting node's property index.
- * when constructing an arithmetic expression we'll delay setting graph entity
- * attribute index to the first execution of the expression, this is due to
- * entity aliasing where we lose track over which entity is aliased, consider
- * MATCH (n:User) WITH n AS x RETURN x.name
- * When constructing the arithmetic expression x.name, we don't know
- * who X is referring to. */
-static void _AR_EXP_UpdatePropIdx(AR_ExpNode *root, const Record r) {
-	GraphContext *gc = QueryCtx_GetGraphCtx();
-	root->operand.variadic.entity_prop_idx = GraphContext_GetAttributeID(gc,
-																		 root->operand.variadic.entity_prop);
+AR_EXP_Result AR_EXP_GetEntityProperty(const Record r, int idx, const char *attr_name,
+										Attribute_ID *attr, SIValue *result) {
+	RecordEntryType t = Record_GetType(r, idx);
+	// Property requested on a scalar value.
+	if(!(t & (REC_TYPE_NODE | REC_TYPE_EDGE))) {
+		/* Attempted to access a scalar value as a map.
+		 * Set an error and invoke the exception handler. */
+		char *error;
+		SIValue v = Record_GetScalar(r, idx);
+		asprintf(&error, "Type mismatch: expected a map but was %s", SIType_ToString(SI_TYPE(v)));
+		QueryCtx_SetError(error); // Set the query-level error.
+		return EVAL_ERR;
+	}
+
+	/* Graph entity attribute index is resolved upon first evaluation, this is due to
+	 * entity aliasing where we lose track over which entity is aliased, consider
+	 * MATCH (n:User) WITH n AS x RETURN x.name
+	 * When constructing the arithmetic expression x.name, we don't know
+	 * who X is referring to. */
+	if(*attr == ATTRIBUTE_NOTFOUND) {
+		*attr = GraphContext_GetAttributeID(QueryCtx_GetGraphCtx(), attr_name);
+	}
+
+	GraphEntity *ge = Record_GetGraphEntity(r, idx);
+	SIValue *property = GraphEntity_GetProperty(ge, *attr);
+	if(property == PROPERTY_NOTFOUND) {
+		*result = SI_NullVal();
+	} else {
+		// The value belongs to a graph property, and can be accessed safely during the query lifetime.
+		*result = SI_ConstValue(*property);
+	}
+	return EVAL_OK;
 }
 
 static AR_ExpNode *_AR_EXP_CloneOperand(AR_ExpNode *exp) {
@@ -40,7 +61,8 @@ static AR_ExpNode *_AR_EXP_CloneOperand(AR_ExpNode *exp) {
 	switch(exp->operand.type) {
 	case AR_EXP_CONSTANT:
 		clone->operand.type = AR_EXP_CONSTANT;
-		clone->operand.constant = exp->operand.constant;
+		// Clone owns its constant, the original expression may be freed first.
+		clone->operand.constant = SI_CloneValue(exp->operand.constant);
 		break;
 	case AR_EXP_VARIADIC:
 		clone->operand.type = exp->operand.type;
@@ -51,6 +73,10 @@ static AR_ExpNode *_AR_EXP_CloneOperand(AR_ExpNode *exp) {
 		}
 		clone->operand.variadic.entity_prop_idx = exp->operand.variadic.entity_prop_idx;
 		break;
+	case AR_EXP_PARAM:
+		clone->operand.type = AR_EXP_PARAM;
+		clone->operand.param.name = exp->operand.param.name;
+		break;
 	default:
 		assert(false);
 		break;
@@ -121,6 +147,14 @@ AR_ExpNode *AR_EXP_NewConstOperandNode(SIValue constant) {
 	return node;
 }
 
+AR_ExpNode *AR_EXP_NewParameterOperandNode(const char *param_name) {
+	AR_ExpNode *node = rm_malloc(sizeof(AR_ExpNode));
+	node->type = AR_EXP_OPERAND;
+	node->operand.type = AR_EXP_PARAM;
+	node->operand.param.name = param_name;
+	return node;
+}
+
 int AR_EXP_GetOperandType(AR_ExpNode *exp) {
 	if(exp->type == AR_EXP_OPERAND) return exp->operand.type;
 	return -1;
@@ -136,7 +170,9 @@ bool AR_EXP_ReduceToScalar(AR_ExpNode **root) {
 			// Root is already a constant
 			return true;
 		}
-		// Root is variadic, no way to reduce.
+		/* Root is either variadic or a parameter, no way to reduce,
+		 * parameters are not reduced such that a plan can be reused
+		 * with different parameter values. */
 		return false;
 	} else {
 		// root represents an operation.
@@ -173,7 +209,7 @@ bool AR_EXP_ReduceToScalar(AR_ExpNode **root) {
 	}
 }
 
-static bool _AR_EXP_ValidateInvocation(AR_FuncDesc *fdesc, SIValue *argv, uint argc) {
+bool AR_EXP_ValidateInvocation(const AR_FuncDesc *fdesc, const SIValue *argv, uint argc) {
 	SIType actual_type;
 	SIType expected_type = T_NULL;
 
@@ -263,7 +299,7 @@ static AR_EXP_Result _AR_EXP_Evaluate(AR_ExpNode *root, const Record r, SIValue
 			}
 
 			/* Validate before evaluation. */
-			if(!_AR_EXP_ValidateInvocation(root->op.f, sub_trees, root->op.child_count)) {
+			if(!AR_EXP_ValidateInvocation(root->op.f, sub_trees, root->op.child_count)) {
 				// The expression tree failed its validations and set an error message.
 				// Free all associated memory.
 				_AR_EXP_FreeResultsArray(sub_trees, root->op.child_count);
@@ -284,32 +320,22 @@ static AR_EXP_Result _AR_EXP_Evaluate(AR_ExpNode *root, const Record r, SIValue
 		if(root->operand.type == AR_EXP_CONSTANT) {
 			// The value is constant or has been computed elsewhere, and is shared with the caller.
 			*result = SI_ShareValue(root->operand.constant);
+		} else if(root->operand.type == AR_EXP_PARAM) {
+			// Parameter values are owned by the query context.
+			SIValue *param = QueryCtx_GetParam(root->operand.param.name);
+			if(param == NULL) {
+				char *error;
+				asprintf(&error, "Missing parameter: $%s", root->operand.param.name);
+				QueryCtx_SetError(error); // Set the query-level error.
+				return EVAL_ERR;
+			}
+			*result = SI_ShareValue(*param);
 		} else {
 			// Fetch entity property value.
 			if(root->operand.variadic.entity_prop != NULL) {
-				RecordEntryType t = Record_GetType(r, root->operand.variadic.entity_alias_idx);
-				// Property requested on a scalar value.
-				if(!(t & (REC_TYPE_NODE | REC_TYPE_EDGE))) {
-					/* Attempted to access a scalar value as a map.
-					 * Set an error and invoke the exception handler. */
-					char *error;
-					SIValue v = Record_GetScalar(r, root->operand.variadic.entity_alias_idx);
-					asprintf(&error, "Type mismatch: expected a map but was %s", SIType_ToString(SI_TYPE(v)));
-					QueryCtx_SetError(error); // Set the query-level error.
-					return EVAL_ERR;
-				}
-
-				GraphEntity *ge = Record_GetGraphEntity(r, root->operand.variadic.entity_alias_idx);
-				if(root->operand.variadic.entity_prop_idx == ATTRIBUTE_NOTFOUND) {
-					_AR_EXP_UpdatePropIdx(root, r);
-				}
-				SIValue *property = GraphEntity_GetProperty(ge, root->operand.variadic.entity_prop_idx);
-				if(property == PROPERTY_NOTFOUND) {
-					*result = SI_NullVal();
-				} else {
-					// The value belongs to a graph property, and can be accessed safely during the query lifetime.
-					*result = SI_ConstValue(*property);
-				}
+				return AR_EXP_GetEntityProperty(r, root->operand.variadic.entity_alias_idx,
+												root->operand.variadic.entity_prop,
+												&root->operand.variadic.entity_prop_idx, result);
 			} else {
 				// Alias doesn't necessarily refers to a graph entity,
 				// it could also be a constant.
@@ -474,6 +500,8 @@ void _AR_EXP_ToString(const AR_ExpNode *root, char **str, size_t *str_size,
 		// Concat Operand node.
 		if(root->operand.type == AR_EXP_CONSTANT) {
 			SIValue_ToString(root->operand.constant, str, str_size, bytes_written);
+		} else if(root->operand.type == AR_EXP_PARAM) {
+			*bytes_written += sprintf((*str + *bytes_written), "$%s", root->operand.param.name);
 		} else {
 			if(root->operand.variadic.entity_prop != NULL) {
 				*bytes_written += sprintf(
@@ -32,11 +32,13 @@ typedef enum {
 } AR_OPType;
 
 /* AR_OperandNodeType type of leaf node,
- * either a constant: 3, or a variable: node.property. */
+ * either a constant: 3, a variable: node.property,
+ * or a query parameter: $param. */
 typedef enum {
 	AR_EXP_OP_UNKNOWN,
 	AR_EXP_CONSTANT,
 	AR_EXP_VARIADIC,
+	AR_EXP_PARAM,
 } AR_OperandNodeType;
 
 /* Success of an evaluation. */
@@ -61,7 +63,7 @@ typedef struct {
 } AR_OpNode;
 
 /* OperandNode represents either a constant numeric value,
- * or a graph entity property. */
+ * a graph entity property or a query parameter. */
 typedef struct {
 	union {
 		SIValue constant;
@@ -71,6 +73,9 @@ typedef struct {
 			int entity_alias_idx;
 			Attribute_ID entity_prop_idx;
 		} variadic;
+		struct {
+			const char *name;   // Parameter name, resolved upon evaluation.
+		} param;
 	};
 	AR_OperandNodeType type;
 } AR_OperandNode;
@@ -100,12 +105,26 @@ AR_ExpNode *AR_EXP_NewVariableOperandNode(RecordMap *record_map, const char *ali
 /* Creates a new Arithmetic expression constant operand node */
 AR_ExpNode *AR_EXP_NewConstOperandNode(SIValue constant);
 
+/* Creates a new Arithmetic expression parameter operand node */
+AR_ExpNode *AR_EXP_NewParameterOperandNode(const char *param_name);
+
 /* Return AR_OperandNodeType for operands and -1 for operations. */
 int AR_EXP_GetOperandType(AR_ExpNode *exp);
 
 /* Compact tree by evaluating all contained functions that can be resolved right now. */
 bool AR_EXP_ReduceToScalar(AR_ExpNode **root);
 
+/* Fetches attribute attr of the graph entity held at record entry idx,
+ * attr is resolved from attr_name if it is ATTRIBUTE_NOTFOUND.
+ * The value is shared with the graph, a missing attribute evaluates to null.
+ * Returns EVAL_ERR and sets the query error if the entry isn't a graph entity. */
+AR_EXP_Result AR_EXP_GetEntityProperty(const Record r, int idx, const char *attr_name,
+									   Attribute_ID *attr, SIValue *result);
+
+/* Validates argv are acceptable arguments to function fdesc,
+ * sets the query error and returns false otherwise. */
+bool AR_EXP_ValidateInvocation(const AR_FuncDesc *fdesc, const SIValue *argv, uint argc);
+
 /* Evaluate arithmetic expression tree. */
 SIValue AR_EXP_Evaluate(AR_ExpNode *root, const Record r);
 
@@ -50,10 +50,20 @@ SIValue AR_EXISTS(SIValue *argv, int argc) {
 	return SI_BoolVal(1);
 }
 
+// Counts edges of type r connecting node to its neighbors, without materializing them.
+static uint64_t _AR_CountNodeEdges(const Graph *g, NodeID id, GRAPH_EDGE_DIR dir, int r) {
+	NeighborCursor c;
+	uint64_t count = 0;
+	Graph_NeighborCursor_Init(g, &c, id, dir, r);
+	for(uint64_t i = 0; i < c.count; i++) count += Graph_NeighborCursor_Edges(g, &c, i, NULL);
+	return count;
+}
+
 SIValue _AR_NodeDegree(SIValue *argv, int argc, GRAPH_EDGE_DIR dir) {
 	Node *n = (Node *)argv[0].ptrval;
-	Edge *edges = array_new(Edge, 0);
+	NodeID id = ENTITY_GET_ID(n);
 	GraphContext *gc = QueryCtx_GetGraphCtx();
+	uint64_t degree = 0;
 
 	if(argc > 1) {
 		// We're interested in specific relationship type(s).
@@ -65,16 +75,14 @@ SIValue _AR_NodeDegree(SIValue *argv, int argc, GRAPH_EDGE_DIR dir) {
 			if(!s) continue;
 
 			// Accumulate edges.
-			Graph_GetNodeEdges(gc->g, n, dir, s->id, &edges);
+			degree += _AR_CountNodeEdges(gc->g, id, dir, s->id);
 		}
 	} else {
 		// Get all relations, regardless of their type.
-		Graph_GetNodeEdges(gc->g, n, dir, GRAPH_NO_RELATION, &edges);
+		degree = _AR_CountNodeEdges(gc->g, id, dir, GRAPH_NO_RELATION);
 	}
 
-	SIValue res = SI_LongVal(array_len(edges));
-	array_free(edges);
-	return res;
+	return SI_LongVal(degree);
 }
 
 /* Returns the number of incoming edges for given node. */
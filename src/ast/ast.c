@@ -7,11 +7,13 @@
 #include "ast.h"
 #include <assert.h>
 #include <pthread.h>
+#include <limits.h>
 
 #include "../util/arr.h"
 #include "../query_ctx.h"
 #include "../util/qsort.h"
 #include "../arithmetic/repository.h"
+#include "ast_build_ar_exp.h"
 #include "../arithmetic/arithmetic_expression.h"
 
 // TODO duplicated logic, find shared place for it
@@ -71,6 +73,40 @@ bool AST_ReadOnly(const cypher_parse_result_t *result) {
 	return true;
 }
 
+rax *AST_BuildParams(const cypher_parse_result_t *result) {
+	const cypher_astnode_t *root = cypher_parse_result_get_root(result, 0);
+	uint noptions = cypher_ast_statement_noptions(root);
+	if(noptions == 0) return NULL;
+
+	rax *params = raxNew();
+	for(uint i = 0; i < noptions; i++) {
+		const cypher_astnode_t *option = cypher_ast_statement_get_option(root, i);
+		if(cypher_astnode_type(option) != CYPHER_AST_CYPHER_OPTION) continue;
+
+		uint nparams = cypher_ast_cypher_option_nparams(option);
+		for(uint j = 0; j < nparams; j++) {
+			const cypher_astnode_t *param = cypher_ast_cypher_option_get_param(option, j);
+			const char *name = cypher_ast_string_get_value(cypher_ast_cypher_option_param_get_name(param));
+			const cypher_astnode_t *value = cypher_ast_cypher_option_param_get_value(param);
+
+			// Validations guarantee value is constant, evaluate it once.
+			AR_ExpNode *exp = AR_EXP_FromExpression(NULL, value);
+			SIValue *v = rm_malloc(sizeof(SIValue));
+			*v = SI_CloneValue(AR_EXP_Evaluate(exp, NULL));
+			AR_EXP_Free(exp);
+
+			// Last assignment wins.
+			SIValue *prev = NULL;
+			if(!raxInsert(params, (unsigned char *)name, strlen(name), v, (void **)&prev)) {
+				SIValue_Free(prev);
+				rm_free(prev);
+			}
+		}
+	}
+
+	return params;
+}
+
 bool AST_ContainsClause(const AST *ast, cypher_astnode_type_t clause) {
 	return AST_GetClause(ast, clause) != NULL;
 }
@@ -274,19 +310,24 @@ bool AST_ClauseContainsAggregation(const cypher_astnode_t *clause) {
 	return aggregated;
 }
 
-// Determine the maximum number of records
-// which will be considered when evaluating an algebraic expression.
-int TraverseRecordCap(const AST *ast) {
-	int recordsCap = 16;    // Default.
+// Returns the LIMIT of the query's RETURN clause, INT_MAX if no LIMIT is specified.
+static int _ReturnLimit(const AST *ast) {
 	const cypher_astnode_t *ret_clause = AST_GetClause(ast, CYPHER_AST_RETURN);
-	if(ret_clause == NULL) return recordsCap;
+	if(ret_clause == NULL) return INT_MAX;
 	// TODO Consider storing this number somewhere, as this logic is also in ExecutionPlan
 	const cypher_astnode_t *limit_clause = cypher_ast_return_get_limit(ret_clause);
-	if(limit_clause) {
-		int limit = AST_ParseIntegerNode(limit_clause);
-		recordsCap = MIN(recordsCap, limit);
-	}
-	return recordsCap;
+	if(limit_clause == NULL) return INT_MAX;
+	return AST_ParseIntegerNode(limit_clause);
+}
+
+// Determine the maximum number of records
+// which will be considered when evaluating an algebraic expression.
+int TraverseRecordCap(const AST *ast) {
+	return MIN(TRAVERSE_DEFAULT_RECORD_CAP, _ReturnLimit(ast));
+}
+
+int TraverseRecordMax(const AST *ast) {
+	return _ReturnLimit(ast);
 }
 
 void AST_Free(AST *ast) {
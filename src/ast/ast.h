@@ -14,6 +14,7 @@
 typedef const void *AST_IDENTIFIER;
 
 #define IDENTIFIER_NOT_FOUND UINT_MAX
+#define TRAVERSE_DEFAULT_RECORD_CAP 16  // Default number of records considered by a single traversal.
 
 typedef enum {
 	AST_VALID,
@@ -32,9 +33,19 @@ bool AST_ContainsErrors(const cypher_parse_result_t *result);
 // Make sure the parse result and the AST tree pass all validations.
 AST_Validation AST_Validate(RedisModuleCtx *ctx, const cypher_parse_result_t *result);
 
+/* Validates the parameters specified by result, if any, against
+ * the parameters referred to by an already validated AST.
+ * Unlike AST_Validate, errors are not reported to the client. */
+AST_Validation AST_ValidateParams(const cypher_parse_result_t *result, const AST *ast);
+
 // Checks if the parse result represents a read-only query.
 bool AST_ReadOnly(const cypher_parse_result_t *result);
 
+/* Evaluates the parameters specified by the query: CYPHER name=value ... query
+ * returns a mapping of parameter name to a heap-allocated SIValue,
+ * or NULL if no parameters were specified. */
+rax *AST_BuildParams(const cypher_parse_result_t *result);
+
 // Checks to see if AST contains specified clause.
 bool AST_ContainsClause(const AST *ast, cypher_astnode_type_t clause);
 
@@ -67,10 +78,14 @@ long AST_ParseIntegerNode(const cypher_astnode_t *int_node);
 // Returns true if the given clause contains an aggregate function.
 bool AST_ClauseContainsAggregation(const cypher_astnode_t *clause);
 
-// Determine the maximum number of records
+// Determine the initial number of records
 // which will be considered when evaluating an algebraic expression.
 int TraverseRecordCap(const AST *ast);
 
+// Determine the number of records a traversal's batches may grow to,
+// bounded by the query's LIMIT, INT_MAX if no LIMIT is specified.
+int TraverseRecordMax(const AST *ast);
+
 /* AST Map API */
 
 // Retrieve an AST ID from an AST pointer
@@ -341,6 +341,9 @@ static AR_ExpNode *_AR_EXP_FromExpression(RecordMap *record_map, const cypher_as
 		return _AR_ExpFromSubscriptExpression(record_map, expr);
 	} else if(type == CYPHER_AST_SLICE_OPERATOR) {
 		return _AR_ExpFromSliceExpression(record_map, expr);
+		/* Query parameters, resolved at evaluation time */
+	} else if(type == CYPHER_AST_PARAMETER) {
+		return AR_EXP_NewParameterOperandNode(cypher_ast_parameter_get_name(expr));
 	} else {
 		/*
 		   Unhandled types:
@@ -348,7 +351,6 @@ static AR_ExpNode *_AR_EXP_FromExpression(RecordMap *record_map, const cypher_as
 		   CYPHER_AST_LIST_COMPREHENSION
 		   CYPHER_AST_MAP
 		   CYPHER_AST_MAP_PROJECTION
-		   CYPHER_AST_PARAMETER
 		   CYPHER_AST_PATTERN_COMPREHENSION
 		   CYPHER_AST_REDUCE
 		*/
@@ -340,7 +340,8 @@ static AST_Validation _ValidatePattern(rax *projections, const cypher_astnode_t
 static bool _ValueIsConstant(const cypher_astnode_t *root) {
 	cypher_astnode_type_t type = cypher_astnode_type(root);
 	if(type == CYPHER_AST_PROPERTY_OPERATOR ||
-	   type == CYPHER_AST_IDENTIFIER
+	   type == CYPHER_AST_IDENTIFIER ||
+	   type == CYPHER_AST_PARAMETER
 	  ) {
 		return false;
 	}
@@ -358,7 +359,7 @@ static bool _ValueIsConstant(const cypher_astnode_t *root) {
 static AST_Validation _ValidateInlinedProperties(const cypher_astnode_t *props, char **reason) {
 	cypher_astnode_type_t type = cypher_astnode_type(props);
 	if(type == CYPHER_AST_PARAMETER) {
-		asprintf(reason, "Parameters are not currently supported in RedisGraph.");
+		asprintf(reason, "Parameters cannot currently be used as inlined property maps in RedisGraph.");
 		return AST_INVALID;
 	}
 
@@ -1461,6 +1462,72 @@ cleanup:
 	return res;
 }
 
+// Collect the names of all parameters referred to by the query.
+static void _AST_GetReferredParams(const cypher_astnode_t *node, rax *params) {
+	if(cypher_astnode_type(node) == CYPHER_AST_PARAMETER) {
+		const char *name = cypher_ast_parameter_get_name(node);
+		raxInsert(params, (unsigned char *)name, strlen(name), NULL, NULL);
+		return;
+	}
+
+	uint child_count = cypher_astnode_nchildren(node);
+	for(uint i = 0; i < child_count; i++) {
+		_AST_GetReferredParams(cypher_astnode_get_child(node, i), params);
+	}
+}
+
+/* Validate query parameters, specified as: CYPHER name=value ... query
+ * parameter values must be constant and every parameter referred to
+ * by the query's body must be specified, statement may be NULL
+ * if no parameters were specified. */
+static AST_Validation _ValidateParams(const cypher_astnode_t *statement,
+									  const cypher_astnode_t *body, char **reason) {
+	AST_Validation res = AST_VALID;
+	rax *defined = raxNew();
+	rax *referred = raxNew();
+
+	uint noptions = (statement) ? cypher_ast_statement_noptions(statement) : 0;
+	for(uint i = 0; i < noptions; i++) {
+		const cypher_astnode_t *option = cypher_ast_statement_get_option(statement, i);
+		if(cypher_astnode_type(option) != CYPHER_AST_CYPHER_OPTION) continue;
+
+		uint nparams = cypher_ast_cypher_option_nparams(option);
+		for(uint j = 0; j < nparams; j++) {
+			const cypher_astnode_t *param = cypher_ast_cypher_option_get_param(option, j);
+			const char *name = cypher_ast_string_get_value(cypher_ast_cypher_option_param_get_name(param));
+			const cypher_astnode_t *value = cypher_ast_cypher_option_param_get_value(param);
+			if(!_ValueIsConstant(value)) {
+				asprintf(reason, "Parameter '%s' must be assigned a constant value.", name);
+				res = AST_INVALID;
+				goto cleanup;
+			}
+			// Map values are not supported.
+			res = _ValidateMaps(value, reason);
+			if(res != AST_VALID) goto cleanup;
+			raxInsert(defined, (unsigned char *)name, strlen(name), NULL, NULL);
+		}
+	}
+
+	_AST_GetReferredParams(body, referred);
+
+	raxIterator it;
+	raxStart(&it, referred);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) {
+		if(raxFind(defined, it.key, it.key_len) == raxNotFound) {
+			asprintf(reason, "Missing parameter: $%.*s", (int)it.key_len, it.key);
+			res = AST_INVALID;
+			break;
+		}
+	}
+	raxStop(&it);
+
+cleanup:
+	raxFree(defined);
+	raxFree(referred);
+	return res;
+}
+
 // Checks to see if libcypher-parser reported any errors.
 bool AST_ContainsErrors(const cypher_parse_result_t *result) {
 	return cypher_parse_result_nerrors(result) > 0;
@@ -1502,6 +1569,12 @@ AST_Validation AST_Validate(RedisModuleCtx *ctx, const cypher_parse_result_t *re
 		return AST_INVALID;
 	}
 
+	if(_ValidateParams(root, cypher_ast_statement_get_body(root), &reason) != AST_VALID) {
+		RedisModule_ReplyWithError(ctx, reason);
+		free(reason);
+		return AST_INVALID;
+	}
+
 	const cypher_astnode_t *body = cypher_ast_statement_get_body(root);
 	cypher_astnode_type_t body_type = cypher_astnode_type(body);
 	if(body_type == CYPHER_AST_CREATE_NODE_PROPS_INDEX ||
@@ -1520,3 +1593,18 @@ AST_Validation AST_Validate(RedisModuleCtx *ctx, const cypher_parse_result_t *re
 	return res;
 }
 
+AST_Validation AST_ValidateParams(const cypher_parse_result_t *result, const AST *ast) {
+	const cypher_astnode_t *statement = NULL;
+	if(result) {
+		if(AST_ContainsErrors(result)) return AST_INVALID;
+		statement = cypher_parse_result_get_root(result, 0);
+		if(statement == NULL || cypher_astnode_type(statement) != CYPHER_AST_STATEMENT) return AST_INVALID;
+	}
+
+	char *reason = NULL;
+	AST_Validation res = AST_VALID;
+	if(statement) res = CypherWhitelist_ValidateQuery(statement, &reason);
+	if(res == AST_VALID) res = _ValidateParams(statement, ast->root, &reason);
+	if(res != AST_VALID) free(reason);
+	return res;
+}
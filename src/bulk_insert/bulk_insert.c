@@ -79,10 +79,10 @@ static inline SIValue _BulkInsert_ReadProperty(const char *data, size_t *data_id
 		*data_idx += sizeof(double);
 		v = SI_DoubleVal(d);
 	} else if(t == BI_STRING) {
-		char *s = rm_strdup(data + *data_idx);
+		char *s = (char *)data + *data_idx;
 		*data_idx += strlen(s) + 1;
-		// Ownership of the string will be passed to the GraphEntity properties
-		v = SI_TransferStringVal(s);
+		// String is interned within the graph's string pool once added as a property.
+		v = SI_ConstStringVal(s);
 	} else {
 		assert(0);
 	}
@@ -97,6 +97,7 @@ int _BulkInsert_ProcessNodeFile(RedisModuleCtx *ctx, GraphContext *gc, const cha
 	unsigned int prop_count;
 	Attribute_ID *prop_indicies = _BulkInsert_ReadHeader(gc, SCHEMA_NODE, data, &data_idx, &label_id,
 														 &prop_count);
+	Schema *s = GraphContext_GetSchemaByID(gc, label_id, SCHEMA_NODE);
 
 	while(data_idx < data_len) {
 		Node n;
@@ -105,6 +106,7 @@ int _BulkInsert_ProcessNodeFile(RedisModuleCtx *ctx, GraphContext *gc, const cha
 			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
 			GraphEntity_AddProperty((GraphEntity *)&n, prop_indicies[i], value);
 		}
+		SchemaStats_AddEntity(s->stats, (GraphEntity *)&n);
 	}
 
 	free(prop_indicies);
@@ -120,6 +122,7 @@ int _BulkInsert_ProcessRelationFile(RedisModuleCtx *ctx, GraphContext *gc, const
 	// Read property keys from header and update schema
 	Attribute_ID *prop_indicies = _BulkInsert_ReadHeader(gc, SCHEMA_EDGE, data, &data_idx, &reltype_id,
 														 &prop_count);
+	Schema *s = GraphContext_GetSchemaByID(gc, reltype_id, SCHEMA_EDGE);
 	NodeID src;
 	NodeID dest;
 
@@ -141,6 +144,7 @@ int _BulkInsert_ProcessRelationFile(RedisModuleCtx *ctx, GraphContext *gc, const
 			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
 			GraphEntity_AddProperty((GraphEntity *)&e, prop_indicies[i], value);
 		}
+		SchemaStats_AddEntity(s->stats, (GraphEntity *)&e);
 	}
 
 	free(prop_indicies);
@@ -19,8 +19,11 @@ GraphContext *_empty_graph_context() {
 	gc->attributes = NULL;
 	gc->node_schemas = NULL;
 	gc->string_mapping = NULL;
+	gc->string_pool = NULL;
 	gc->relation_schemas = NULL;
 	gc->graph_name = rm_strdup("");
+	gc->version = 0;
+	gc->plan_cache = NULL;
 
 	QueryCtx_SetGraphCtx(gc);
 	return gc;
@@ -53,6 +56,8 @@ void _MGraph_Explain(void *args) {
 
 	// Prepare the constructed AST for accesses from the module
 	ast = AST_Build(parse_result);
+	// Evaluate query parameters, if any.
+	QueryCtx_SetParams(AST_BuildParams(parse_result));
 
 	// Handle replies for index creation/deletion
 	const cypher_astnode_type_t root_type = cypher_astnode_type(ast->root);
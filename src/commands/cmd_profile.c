@@ -36,6 +36,8 @@ void _MGraph_Profile(void *args) {
 
 	// Prepare the constructed AST for accesses from the module
 	ast = AST_Build(parse_result);
+	// Evaluate query parameters, if any.
+	QueryCtx_SetParams(AST_BuildParams(parse_result));
 
 	// Try to access the GraphContext
 	CommandCtx_ThreadSafeContextLock(qctx);
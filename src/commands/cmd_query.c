@@ -11,8 +11,13 @@
 #include "../query_ctx.h"
 #include "../graph/graph.h"
 #include "../util/rmalloc.h"
+#include "../execution_plan/plan_cache.h"
 #include "../execution_plan/execution_plan.h"
 #include "cypher-parser.h"
+#include <ctype.h>
+
+// Flag indicating whether node storage is compacted after write queries (defined in module.c)
+extern bool node_compaction;
 
 static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc,
 							 const cypher_astnode_t *index_op) {
@@ -65,22 +70,191 @@ static inline bool _check_compact_flag(CommandCtx *qctx) {
 			!strcasecmp(RedisModule_StringPtrLen(qctx->argv[3], NULL), "--compact"));
 }
 
+// Skips whitespace and comments.
+static const char *_skip_space(const char *c) {
+	while(true) {
+		if(isspace(*c)) {
+			c++;
+		} else if(c[0] == '/' && c[1] == '/') {
+			while(*c && *c != '\n') c++;
+		} else if(c[0] == '/' && c[1] == '*') {
+			const char *close = strstr(c + 2, "*/");
+			if(!close) return c;
+			c = close + 2;
+		} else {
+			return c;
+		}
+	}
+}
+
+// Skips an identifier, returns c if it doesn't point to one.
+static inline const char *_skip_identifier(const char *c) {
+	if(!isalpha(*c) && *c != '_') return c;
+	while(isalnum(*c) || *c == '_') c++;
+	return c;
+}
+
+// Skips a literal parameter value, returns NULL if value isn't recognized.
+static const char *_skip_value(const char *c) {
+	int depth = 0;  // Nesting level of lists and maps.
+	do {
+		c = _skip_space(c);
+		if(*c == '[' || *c == '{') {
+			depth++;
+			c++;
+		} else if(*c == ']' || *c == '}') {
+			if(depth == 0) return NULL;
+			depth--;
+			c++;
+		} else if(*c == ',' || *c == ':') {
+			if(depth == 0) return NULL;
+			c++;
+		} else if(*c == '\'' || *c == '"') {
+			char quote = *c++;
+			while(*c && *c != quote) {
+				if(*c == '\\' && c[1]) c++;
+				c++;
+			}
+			if(!*c) return NULL;
+			c++;
+		} else if(isalnum(*c) || *c == '_' || *c == '.' || *c == '-' || *c == '+') {
+			// Number, boolean, null or map key.
+			while(isalnum(*c) || *c == '_' || *c == '.' || *c == '-' || *c == '+') c++;
+		} else {
+			return NULL;
+		}
+	} while(depth > 0);
+	return c;
+}
+
+/* Lexically locates the query text following the CYPHER parameters prefix,
+ * such that a cached plan can be looked up before the query is parsed.
+ * Sets params if a prefix was found, returns NULL if the prefix isn't recognized.
+ * The parser has the final say, see _statement_body. */
+static const char *_query_body(const char *query, bool *params) {
+	*params = false;
+	const char *c = _skip_space(query);
+	while(strncasecmp(c, "CYPHER", 6) == 0 && isspace(c[6])) {
+		*params = true;
+		c = _skip_space(c + 6);
+		// name=value pairs.
+		while(true) {
+			const char *name_end = _skip_identifier(c);
+			if(name_end == c) break;
+			const char *assign = _skip_space(name_end);
+			if(*assign != '=') break;
+			c = _skip_value(assign + 1);
+			if(!c) return NULL;
+			c = _skip_space(c);
+		}
+	}
+	return c;
+}
+
+// Returns the query text following the CYPHER parameters prefix, as determined by the parser.
+static inline const char *_statement_body(const char *query,
+										  const cypher_parse_result_t *parse_result) {
+	const cypher_astnode_t *statement = cypher_parse_result_get_root(parse_result, 0);
+	const cypher_astnode_t *body = cypher_ast_statement_get_body(statement);
+	return query + cypher_astnode_range(body).start.offset;
+}
+
+/* Parses the parameters prefix of a query, len bytes long,
+ * the prefix is completed into a statement by a trivial body. */
+static cypher_parse_result_t *_parse_params(const char *query, size_t len) {
+	const char *body = " RETURN 0";
+	size_t body_len = strlen(body);
+	char *statement = rm_malloc(len + body_len + 1);
+	memcpy(statement, query, len);
+	memcpy(statement + len, body, body_len + 1);
+	cypher_parse_result_t *result = cypher_parse(statement, NULL, NULL, CYPHER_PARSE_ONLY_STATEMENTS);
+	rm_free(statement);
+	return result;
+}
+
+// Binds a checked out cached plan to the current query.
+static void _use_cached_plan(RedisModuleCtx *ctx, GraphContext *gc, PlanCacheEntry *cached,
+							 bool compact) {
+	// Reuse cached plan, operations refer to the cached AST.
+	QueryCtx_SetAST(cached->ast);
+	ResultSet_Reset(cached->result_set, ctx, compact);
+	// Matrices might have been modified since plan was last executed.
+	Graph_SynchronizeMatrices(gc->g);
+}
+
+/* Executes plan and replies with its result-set,
+ * a cached plan is returned to the cache unless it encountered an error. */
+static void _execute_plan(GraphContext *gc, ExecutionPlan *plan, PlanCacheEntry *cached) {
+	ExecutionPlan_Execute(plan);
+	ResultSet_Replay(plan->result_set);    // Send result-set back to client.
+
+	if(cached) {
+		// Plans which encountered a run-time error are not reused.
+		if(QueryCtx_EncounteredError()) PlanCacheEntry_Free(cached);
+		else PlanCache_Release(gc->plan_cache, cached, __atomic_load_n(&gc->version, __ATOMIC_RELAXED));
+	} else {
+		ExecutionPlan_Free(plan);
+	}
+}
+
 void _MGraph_Query(void *args) {
 	AST *ast = NULL;
+	GraphContext *gc = NULL;
+	bool readonly = false;
+	char *cache_key = NULL;
 	bool lockAcquired = false;
 	ResultSet *result_set = NULL;
+	cypher_parse_result_t *parse_result = NULL;
 	CommandCtx *qctx = (CommandCtx *)args;
 	RedisModuleCtx *ctx = CommandCtx_GetRedisCtx(qctx);
 
 	QueryCtx_BeginTimer(); // Start query timing.
 	QueryCtx_SetRedisModuleCtx(ctx);
 
+	bool compact = _check_compact_flag(qctx);
+
+	/* Look up a cached plan by query text before parsing,
+	 * on a hit only the parameters prefix is parsed.
+	 * Replicas skip read-only queries, which are the only ones cached. */
+	bool params = false;
+	const char *body = _query_body(qctx->query, &params);
+	if(body && !qctx->replicated_command) {
+		CommandCtx_ThreadSafeContextLock(qctx);
+		gc = GraphContext_Retrieve(ctx, qctx->graphName, true);
+		CommandCtx_ThreadSafeContextUnlock(qctx);
+
+		if(gc && gc->plan_cache) {
+			cache_key = PlanCache_Key(body);
+			Graph_AcquireReadLock(gc->g);
+			uint64_t version = __atomic_load_n(&gc->version, __ATOMIC_RELAXED);
+			PlanCacheEntry *cached = PlanCache_Checkout(gc->plan_cache, cache_key, body, NULL, version);
+			if(cached) {
+				if(params) parse_result = _parse_params(qctx->query, body - qctx->query);
+				if((!params || parse_result) &&
+				   AST_ValidateParams(parse_result, cached->ast) == AST_VALID) {
+					readonly = true;
+					lockAcquired = true;
+					if(parse_result) QueryCtx_SetParams(AST_BuildParams(parse_result));
+					_use_cached_plan(ctx, gc, cached, compact);
+					_execute_plan(gc, cached->plan, cached);
+					goto cleanup;
+				}
+				// Invalid parameters are reported by the complete validation below.
+				PlanCache_Release(gc->plan_cache, cached, version);
+				if(parse_result) {
+					cypher_parse_result_free(parse_result);
+					parse_result = NULL;
+				}
+			}
+			Graph_ReleaseLock(gc->g);
+		}
+	}
+
 	// Parse the query to construct an AST
-	cypher_parse_result_t *parse_result = cypher_parse(qctx->query, NULL, NULL,
-													   CYPHER_PARSE_ONLY_STATEMENTS);
+	parse_result = cypher_parse(qctx->query, NULL, NULL, CYPHER_PARSE_ONLY_STATEMENTS);
 	if(parse_result == NULL) goto cleanup;
 
-	bool readonly = AST_ReadOnly(parse_result);
+	readonly = AST_ReadOnly(parse_result);
 	// If we are a replica and the query is read-only, no work needs to be done.
 	if(readonly && qctx->replicated_command) goto cleanup;
 
@@ -89,10 +263,12 @@ void _MGraph_Query(void *args) {
 
 	// Prepare the constructed AST for accesses from the module
 	ast = AST_Build(parse_result);
+	// Evaluate query parameters, if any.
+	QueryCtx_SetParams(AST_BuildParams(parse_result));
 
 	// Try to access the GraphContext
 	CommandCtx_ThreadSafeContextLock(qctx);
-	GraphContext *gc = GraphContext_Retrieve(ctx, qctx->graphName, readonly);
+	gc = GraphContext_Retrieve(ctx, qctx->graphName, readonly);
 	if(!gc) {
 		if(!AST_ContainsClause(ast, CYPHER_AST_CREATE) &&
 		   !AST_ContainsClause(ast, CYPHER_AST_MERGE)) {
@@ -111,8 +287,6 @@ void _MGraph_Query(void *args) {
 	}
 	CommandCtx_ThreadSafeContextUnlock(qctx);
 
-	bool compact = _check_compact_flag(qctx);
-
 	// Acquire the appropriate lock.
 	if(readonly) Graph_AcquireReadLock(gc->g);
 	else Graph_WriterEnter(gc->g);  // Single writer.
@@ -120,12 +294,50 @@ void _MGraph_Query(void *args) {
 
 	const cypher_astnode_type_t root_type = cypher_astnode_type(ast->root);
 	if(root_type == CYPHER_AST_QUERY) {  // query operation
-		result_set = NewResultSet(ctx, compact);
-		ExecutionPlan *plan = NewExecutionPlan(ctx, gc, result_set);
-		if(!plan) goto cleanup;
-		result_set = ExecutionPlan_Execute(plan);
-		ExecutionPlan_Free(plan);
-		ResultSet_Replay(result_set);    // Send result-set back to client.
+		ExecutionPlan *plan = NULL;
+		PlanCacheEntry *cached = NULL;
+		// Capture version before planning, plans built against a modified schema are not cached.
+		uint64_t version = __atomic_load_n(&gc->version, __ATOMIC_RELAXED);
+		/* Only read-only plans are reused, write operations are not reset-safe.
+		 * Plans are cached under the lexically located query body,
+		 * as long as it agrees with the parser. */
+		if(readonly && gc->plan_cache && body == _statement_body(qctx->query, parse_result)) {
+			if(!cache_key) cache_key = PlanCache_Key(body);
+			cached = PlanCache_Checkout(gc->plan_cache, cache_key, body, ast, version);
+		} else if(cache_key) {
+			rm_free(cache_key);
+			cache_key = NULL;
+		}
+
+		if(cached) {
+			_use_cached_plan(ctx, gc, cached, compact);
+			plan = cached->plan;
+		} else {
+			result_set = NewResultSet(ctx, compact);
+			plan = NewExecutionPlan(ctx, gc, result_set);
+			if(!plan) goto cleanup;
+			if(cache_key && ExecutionPlan_Cacheable(plan)) {
+				// Entry takes ownership over the plan and all objects it refers to.
+				cached = PlanCacheEntry_New(cache_key, body, version, parse_result, ast, result_set, plan);
+				parse_result = NULL;
+				result_set = NULL;
+				ast = NULL;
+			}
+		}
+
+		_execute_plan(gc, plan, cached);
+
+		/* No references to graph entities or matrices remain,
+		 * compact node storage in a single pass
+		 * and re-evaluate matrices representation.
+		 * Compaction renumbers nodes, as such it is opt-in
+		 * and never follows a query which failed midway. */
+		if(!readonly) {
+			Graph_AcquireWriteLock(gc->g);
+			if(node_compaction && !QueryCtx_EncounteredError()) GraphContext_CompactNodes(gc);
+			Graph_ConformMatrixFormats(gc->g);
+			Graph_ReleaseLock(gc->g);
+		}
 	} else if(root_type == CYPHER_AST_CREATE_NODE_PROPS_INDEX ||
 			  root_type == CYPHER_AST_DROP_NODE_PROPS_INDEX) {
 		_index_operation(ctx, gc, ast->root);
@@ -144,6 +356,7 @@ cleanup:
 	}
 
 	ResultSet_Free(result_set);
+	if(cache_key) rm_free(cache_key);
 	AST_Free(ast);
 	if(parse_result) cypher_parse_result_free(parse_result);
 	CommandCtx_Free(qctx);
@@ -9,23 +9,44 @@
 #include <string.h>
 #include <assert.h>
 
+// Returns the value following key within the configuration arguments,
+// NULL if key isn't specified.
+static RedisModuleString *_Config_FindArg(RedisModuleString **argv, int argc, const char *key) {
+	// Expecting configuration to be in the form of key value pairs.
+	if(argc % 2 != 0) return NULL;
+
+	for(int i = 0; i < argc; i += 2) {
+		const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+		if(strcasecmp(param, key) == 0) return argv[i + 1];
+	}
+
+	return NULL;
+}
+
+// Parses a "yes" / "no" configuration value,
+// returns default_value if key isn't specified or its value is invalid.
+static bool _Config_GetBool(RedisModuleCtx *ctx, RedisModuleString **argv, int argc,
+							const char *key, bool default_value) {
+	RedisModuleString *arg = _Config_FindArg(argv, argc, key);
+	if(arg == NULL) return default_value;
+
+	const char *val = RedisModule_StringPtrLen(arg, NULL);
+	if(strcasecmp(val, "yes") == 0) return true;
+	if(strcasecmp(val, "no") == 0) return false;
+
+	RedisModule_Log(ctx, "warning", "Invalid value: %s for %s, expecting yes or no, using %s.",
+					val, key, (default_value) ? "yes" : "no");
+	return default_value;
+}
+
 long long Config_GetThreadCount(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	// Default.
 	int CPUCount = sysconf(_SC_NPROCESSORS_ONLN);
 	long long threadCount = (CPUCount != -1) ? CPUCount : 1;
 
 	// Number of thread specified in configuration?
-	// Expecting configuration to be in the form of key value pairs.
-	if(argc % 2 == 0) {
-		// Scan arguments for THREAD_COUNT.
-		for(int i = 0; i < argc; i += 2) {
-			const char *param = RedisModule_StringPtrLen(argv[i], NULL);
-			if(strcasecmp(param, THREAD_COUNT) == 0) {
-				RedisModule_StringToLongLong(argv[i + 1], &threadCount);
-				break;
-			}
-		}
-	}
+	RedisModuleString *arg = _Config_FindArg(argv, argc, THREAD_COUNT);
+	if(arg) RedisModule_StringToLongLong(arg, &threadCount);
 
 	// Sanity.
 	assert(threadCount > 0);
@@ -38,3 +59,52 @@ long long Config_GetThreadCount(RedisModuleCtx *ctx, RedisModuleString **argv, i
 
 	return threadCount;
 }
+
+long long Config_GetPlanCacheSize(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+	// Default.
+	long long cacheSize = PLAN_CACHE_SIZE_DEFAULT;
+
+	RedisModuleString *arg = _Config_FindArg(argv, argc, PLAN_CACHE_SIZE);
+	if(arg) RedisModule_StringToLongLong(arg, &cacheSize);
+
+	// Sanity.
+	if(cacheSize < 0) {
+		RedisModule_Log(ctx, "warning", "Invalid plan cache size: %lld, disabling plan cache.", cacheSize);
+		cacheSize = 0;
+	}
+
+	return cacheSize;
+}
+
+long long Config_GetQueryParallelism(RedisModuleCtx *ctx, RedisModuleString **argv, int argc,
+									 long long thread_count) {
+	// Default.
+	long long parallelism = thread_count;
+
+	RedisModuleString *arg = _Config_FindArg(argv, argc, QUERY_PARALLELISM);
+	if(arg) RedisModule_StringToLongLong(arg, &parallelism);
+
+	// Sanity.
+	if(parallelism < 1) {
+		RedisModule_Log(ctx, "warning", "Invalid query parallelism: %lld, using a single thread.",
+						parallelism);
+		parallelism = 1;
+	}
+	// Helper threads are taken from the thread pool.
+	if(parallelism > thread_count) {
+		RedisModule_Log(ctx, "warning", "Query parallelism: %lld greater then number of threads: %lld.",
+						parallelism, thread_count);
+		parallelism = thread_count;
+	}
+
+	return parallelism;
+}
+
+bool Config_GetMaintainTransposedMatrices(RedisModuleCtx *ctx, RedisModuleString **argv,
+										  int argc) {
+	return _Config_GetBool(ctx, argv, argc, MAINTAIN_TRANSPOSED_MATRICES, true);
+}
+
+bool Config_GetNodeCompaction(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+	return _Config_GetBool(ctx, argv, argc, NODE_COMPACTION, false);
+}
@@ -7,9 +7,15 @@
 #ifndef _REDISGRAPH_CONFIG_
 #define _REDISGRAPH_CONFIG_
 
+#include <stdbool.h>
 #include "redismodule.h"
 
 #define THREAD_COUNT "THREAD_COUNT" // Config param, number of threads in thread pool
+#define PLAN_CACHE_SIZE "PLAN_CACHE_SIZE" // Config param, number of cached execution plans per graph
+#define PLAN_CACHE_SIZE_DEFAULT 64 // Default number of cached execution plans per graph
+#define QUERY_PARALLELISM "QUERY_PARALLELISM" // Config param, maximum number of threads executing a single query
+#define MAINTAIN_TRANSPOSED_MATRICES "MAINTAIN_TRANSPOSED_MATRICES" // Config param, maintain transposed relation matrices
+#define NODE_COMPACTION "NODE_COMPACTION" // Config param, compact node storage after write queries
 
 // Tries to fetch number of threads from
 // command line arguments if specified
@@ -21,4 +27,41 @@ long long Config_GetThreadCount(
 	int argc
 );
 
+// Tries to fetch the number of execution plans
+// cached per graph from command line arguments
+// defaults to PLAN_CACHE_SIZE_DEFAULT, 0 disables caching.
+long long Config_GetPlanCacheSize(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+);
+
+// Tries to fetch the maximum number of threads
+// taking part in the execution of a single query
+// from command line arguments, defaults to thread_count.
+long long Config_GetQueryParallelism(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc,
+	long long thread_count
+);
+
+// Tries to fetch whether graphs should maintain
+// a transposed copy of each relation matrix from
+// command line arguments, defaults to true.
+bool Config_GetMaintainTransposedMatrices(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+);
+
+// Tries to fetch whether fragmented node storage
+// should be compacted following write queries
+// from command line arguments, defaults to false.
+bool Config_GetNodeCompaction(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+);
+
 #endif
@@ -234,7 +234,7 @@ static AR_ExpNode **_BuildCallProjections(RecordMap *record_map,
 	return expressions;
 }
 
-/* Strings enclosed in the parentheses of a CALL clause represent the arguments to the procedure.
+/* Strings and integers enclosed in the parentheses of a CALL clause represent the arguments to the procedure.
  * _BuildCallArguments creates a string array holding all of these arguments. */
 static const char **_BuildCallArguments(RecordMap *record_map,
 										const cypher_astnode_t *call_clause) {
@@ -243,16 +243,18 @@ static const char **_BuildCallArguments(RecordMap *record_map,
 	const char **arguments = array_new(const char *, arg_count);
 	for(uint i = 0; i < arg_count; i ++) {
 		/* For the timebeing we're only supporting procedures that accept
-		 * string argument, as such we can quickly transfer AST procedure
-		 * call arguments to strings.
+		 * string and integer literal arguments, as such we can quickly transfer
+		 * AST procedure call arguments to strings.
 		 * TODO: create an arithmetic expression for each argument
 		 * evaluate it and pass SIValues as arguments to procedure. */
 		const cypher_astnode_t *exp = cypher_ast_call_get_argument(call_clause, i);
 		const cypher_astnode_type_t type = cypher_astnode_type(exp);
 
-		if(type != CYPHER_AST_STRING) continue;
+		const char *arg;
+		if(type == CYPHER_AST_STRING) arg = cypher_ast_string_get_value(exp);
+		else if(type == CYPHER_AST_INTEGER) arg = cypher_ast_integer_get_valuestr(exp);
+		else continue;
 
-		const char *arg = cypher_ast_string_get_value(exp);
 		arguments = array_append(arguments, arg);
 		// AR_ExpNode *arg = AR_EXP_FromExpression(record_map, ast_exp);
 		// SIValue si_arg = AR_EXP_Evaluate(arg, NULL);
@@ -298,11 +300,11 @@ static void _ExecutionPlanSegment_ProcessQueryGraph(ExecutionPlanSegment *segmen
 			uint expCount = 0;
 			AlgebraicExpression **exps = AlgebraicExpression_FromQueryGraph(cc, segment->record_map, &expCount);
 
-			// Reorder exps, to the most performant arrangement of evaluation.
-			orderExpressions(exps, expCount, segment->record_map, ft);
+			/* Reorder exps, to the most performant arrangement of evaluation,
+			 * the first expression's source node is the traversal's entry point. */
+			orderExpressions(exps, expCount, segment->record_map, ft, gc);
 
 			AlgebraicExpression *exp = exps[0];
-			selectEntryPoint(exp, segment->record_map, ft);
 
 			// Retrieve the AST ID for the source node
 			uint ast_id = exp->src_node->id;
@@ -333,7 +335,8 @@ static void _ExecutionPlanSegment_ProcessQueryGraph(ExecutionPlanSegment *segmen
 				if(exp->edge && QGEdge_VariableLength(exp->edge)) {
 					root = NewCondVarLenTraverseOp(gc->g, segment->record_map, exp);
 				} else {
-					root = NewCondTraverseOp(gc->g, segment->record_map, exp, TraverseRecordCap(ast));
+					root = NewCondTraverseOp(gc->g, segment->record_map, exp, TraverseRecordCap(ast),
+											 TraverseRecordMax(ast));
 				}
 				// Insert the new traversal op at the root of the chain.
 				ExecutionPlan_AddOp(root, tail);
@@ -982,8 +985,14 @@ ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan) {
 		return plan->result_set;
 	}
 
-	// Execute the root operation and free the processed Record until the data stream is depleted.
-	while((r = OpBase_Consume(plan->root)) != NULL) Record_Free(r);
+	if(plan->root->consumeBatch) {
+		/* Execute the root operation a batch at a time until the data stream is depleted,
+		 * batches are owned and recycled by the operations producing them. */
+		while(OpBase_ConsumeBatch(plan->root) != NULL);
+	} else {
+		// Execute the root operation and free the processed Record until the data stream is depleted.
+		while((r = OpBase_Consume(plan->root)) != NULL) Record_Free(r);
+	}
 
 	// Return the result set.
 	return plan->result_set;
@@ -1022,6 +1031,62 @@ ResultSet *ExecutionPlan_Profile(ExecutionPlan *plan) {
 	return rs;
 }
 
+static void _ExecutionPlan_ResetOperations(OpBase *op) {
+	assert(op->reset(op) == OP_OK);
+	op->op_initialized = false;
+	// Transposed operands are snapshots, transpose again upon next execution.
+	if(op->type == OPType_CONDITIONAL_TRAVERSE) {
+		AlgebraicExpression_RestoreOperands(((CondTraverse *)op)->ae);
+	} else if(op->type == OPType_EXPAND_INTO) {
+		AlgebraicExpression_RestoreOperands(((OpExpandInto *)op)->ae);
+	}
+	// Release values held by the last batch.
+	if(op->batch) RecordBatch_Reset(op->batch);
+	for(int i = 0; i < op->childCount; i++) _ExecutionPlan_ResetOperations(op->children[i]);
+}
+
+void ExecutionPlan_Reset(ExecutionPlan *plan) {
+	assert(plan);
+	_ExecutionPlan_ResetOperations(plan->root);
+}
+
+/* Temporary operands, e.g. the sum of several relation matrices,
+ * are built while planning and do not reflect later updates.
+ * Transposed operands are restored when the plan is reset. */
+static bool _AlgebraicExpression_Reusable(const AlgebraicExpression *ae) {
+	for(uint i = 0; i < ae->operand_count; i++) {
+		if(ae->operands[i].free) return false;
+	}
+	return true;
+}
+
+static bool _ExecutionPlan_OpCacheable(const OpBase *op) {
+	switch(op->type) {
+	case OPType_PROC_CALL:
+		// Procedures are invoked upon initialization.
+		return false;
+	case OPType_CONDITIONAL_TRAVERSE:
+		if(!_AlgebraicExpression_Reusable(((const CondTraverse *)op)->ae)) return false;
+		break;
+	case OPType_EXPAND_INTO:
+		if(!_AlgebraicExpression_Reusable(((const OpExpandInto *)op)->ae)) return false;
+		break;
+	default:
+		break;
+	}
+
+	for(int i = 0; i < op->childCount; i++) {
+		if(!_ExecutionPlan_OpCacheable(op->children[i])) return false;
+	}
+	return true;
+}
+
+bool ExecutionPlan_Cacheable(const ExecutionPlan *plan) {
+	assert(plan);
+	if(plan->embeds_graph_data) return false;
+	return _ExecutionPlan_OpCacheable(plan->root);
+}
+
 void _ExecutionPlan_FreeOperations(OpBase *op) {
 	for(int i = 0; i < op->childCount; i++) {
 		_ExecutionPlan_FreeOperations(op->children[i]);
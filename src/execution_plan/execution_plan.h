@@ -36,6 +36,7 @@ typedef struct {
 	**segments;   // The segments contained in this ExecutionPlan (only stored for proper freeing).
 	ResultSet *result_set;             // ResultSet populated by this query.
 	uint segment_count;                // Number of segments in query.
+	bool embeds_graph_data;            // Plan holds values computed from the graph while planning.
 } ExecutionPlan;
 
 /* execution_plan_modify.c
@@ -47,6 +48,9 @@ void ExecutionPlan_RemoveOp(ExecutionPlan *plan, OpBase *op);
 /* Adds operation to execution plan as a child of parent. */
 void ExecutionPlan_AddOp(OpBase *parent, OpBase *newOp);
 
+/* Detaches op from its parent, op's children remain attached to op. */
+void ExecutionPlan_DetachOp(OpBase *op);
+
 /* Push b right below a. */
 void ExecutionPlan_PushBelow(OpBase *a, OpBase *b);
 
@@ -94,6 +98,14 @@ ResultSet *ExecutionPlan_Execute(ExecutionPlan *plan);
 /* Profile executes plan */
 ResultSet *ExecutionPlan_Profile(ExecutionPlan *plan);
 
+/* Reset execution plan such that it can be executed again,
+ * operations are reinitialized on next execution. */
+void ExecutionPlan_Reset(ExecutionPlan *plan);
+
+/* Returns true if plan can be reused by later invocations of the same query,
+ * must be called before plan is executed. */
+bool ExecutionPlan_Cacheable(const ExecutionPlan *plan);
+
 /* Free execution plan */
 void ExecutionPlan_Free(ExecutionPlan *plan);
 
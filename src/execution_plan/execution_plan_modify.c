@@ -139,6 +139,11 @@ void ExecutionPlan_AddOp(OpBase *parent, OpBase *newOp) {
 	_OpBase_AddChild(parent, newOp);
 }
 
+void ExecutionPlan_DetachOp(OpBase *op) {
+	if(op->parent == NULL) return;
+	_OpBase_RemoveChild(op->parent, op);
+}
+
 void _ExecutionPlan_LocateOps(OpBase *root, OPType type, OpBase ***ops) {
 	if(!root) return;
 
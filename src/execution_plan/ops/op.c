@@ -19,13 +19,16 @@ void OpBase_Init(OpBase *op) {
 	op->record_map = NULL;
 	op->op_initialized = false;
 	op->dangling_records = NULL;
+	op->batch = NULL;
 
 	// Function pointers.
 	op->init = NULL;
 	op->free = NULL;
 	op->reset = NULL;
 	op->consume = NULL;
+	op->consumeBatch = NULL;
 	op->toString = NULL;
+	op->clone = NULL;
 }
 
 inline Record OpBase_Consume(OpBase *op) {
@@ -34,6 +37,7 @@ inline Record OpBase_Consume(OpBase *op) {
 
 void OpBase_PropagateReset(OpBase *op) {
 	assert(op->reset(op) == OP_OK);
+	if(op->batch) RecordBatch_Reset(op->batch);
 	for(int i = 0; i < op->childCount; i++) OpBase_PropagateReset(op->children[i]);
 }
 
@@ -67,6 +71,11 @@ int OpBase_ToString(const OpBase *op, char *buff, uint buff_len) {
 	return bytes_written;
 }
 
+OpBase *OpBase_Clone(const OpBase *op) {
+	assert(op->clone);
+	return op->clone(op);
+}
+
 Record OpBase_Profile(OpBase *op) {
 	double tic [2];
 	// Start timer.
@@ -78,6 +87,46 @@ Record OpBase_Profile(OpBase *op) {
 	return r;
 }
 
+RecordBatch *OpBase_GetBatch(OpBase *op, uint record_len) {
+	if(op->batch == NULL) op->batch = RecordBatch_New(record_len);
+	return op->batch;
+}
+
+/* Batch adapter for operations producing a single record at a time,
+ * consumed records are owned by the batch. */
+static RecordBatch *_OpBase_AccumulateBatch(OpBase *op) {
+	RecordBatch *batch = OpBase_GetBatch(op, op->record_map->record_len);
+	RecordBatch_Clear(batch);
+	// Don't consume a depleted operation again.
+	if(batch->depleted) return NULL;
+
+	while(!RecordBatch_IsFull(batch)) {
+		Record r = OpBase_Consume(op);
+		if(!r) {
+			batch->depleted = true;
+			break;
+		}
+		RecordBatch_Append(batch, r);
+	}
+
+	return (batch->selected) ? batch : NULL;
+}
+
+RecordBatch *OpBase_ConsumeBatch(OpBase *op) {
+	// Profiling of adapted operations is performed by their consume function.
+	if(!op->consumeBatch) return _OpBase_AccumulateBatch(op);
+	if(!op->stats) return op->consumeBatch(op);
+
+	double tic [2];
+	// Start timer.
+	simple_tic(tic);
+	RecordBatch *batch = op->consumeBatch(op);
+	// Stop timer and accumulate.
+	op->stats->profileExecTime += simple_toc(tic);
+	if(batch) op->stats->profileRecordCount += batch->selected;
+	return batch;
+}
+
 void OpBase_AddVolatileRecord(OpBase *op, const Record r) {
 	if(op->dangling_records == NULL) op->dangling_records = array_new(Record, 1);
 	op->dangling_records = array_append(op->dangling_records, r);
@@ -95,6 +144,7 @@ void OpBase_Free(OpBase *op) {
 	if(op->children) rm_free(op->children);
 	if(op->modifies) array_free(op->modifies);
 	if(op->stats) rm_free(op->stats);
+	if(op->batch) RecordBatch_Free(op->batch);
 	// If we are storing dangling references to Records, free them now.
 	if(op->dangling_records) {
 		uint count = array_len(op->dangling_records);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "../record.h"
+#include "../record_batch.h"
 #include "../record_map.h"
 #include "../../redismodule.h"
 #include "../../graph/query_graph.h"
@@ -44,6 +45,7 @@ typedef enum {
 	OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO = (1 << 22),
 	OPType_VALUE_HASH_JOIN = (1 << 23),
 	OPType_APPLY = (1 << 24),
+	OPType_GATHER = (1 << 25),
 } OPType;
 
 #define OP_SCAN (OPType_ALL_NODE_SCAN | OPType_NODE_BY_LABEL_SCAN | OPType_INDEX_SCAN | OPType_NODE_BY_ID_SEEK)
@@ -61,8 +63,10 @@ struct OpBase;
 typedef void (*fpFree)(struct OpBase *);
 typedef OpResult(*fpInit)(struct OpBase *);
 typedef Record(*fpConsume)(struct OpBase *);
+typedef RecordBatch *(*fpConsumeBatch)(struct OpBase *);
 typedef OpResult(*fpReset)(struct OpBase *);
 typedef int (*fpToString)(const struct OpBase *, char *, uint);
+typedef struct OpBase *(*fpClone)(const struct OpBase *);
 
 // Execution plan operation statistics.
 typedef struct {
@@ -74,10 +78,12 @@ struct OpBase {
 	OPType type;                // Type of operation
 	fpInit init;                // Called once before execution.
 	fpConsume consume;          // Produce next record.
+	fpConsumeBatch consumeBatch; // Produce next batch of records, optional.
 	fpConsume profile;          // Profiled version of consume.
 	fpReset reset;              // Reset operation state.
 	fpFree free;                // Free operation.
 	fpToString toString;        // operation string representation.
+	fpClone clone;              // Create an uninitialized copy of the operation, optional.
 	char *name;                 // Operation name.
 	uint *modifies;             // List of Record indices this op modifies.
 	RecordMap *record_map;      // Mapping of entities into Record IDs in the scope of this ExecutionPlanSegment.
@@ -86,6 +92,7 @@ struct OpBase {
 	bool op_initialized;        // True if the operation has already been initialized.
 	OpStats *stats;             // Profiling statistics.
 	Record *dangling_records;   // Records allocated by this operation that must be freed.
+	RecordBatch *batch;         // Batch produced by this operation, reused across calls.
 	struct OpBase *parent;      // Parent operations.
 };
 typedef struct OpBase OpBase;
@@ -96,6 +103,19 @@ Record OpBase_Consume(OpBase *op);  // Consume op.
 Record OpBase_Profile(OpBase *op);  // Profile op.
 int OpBase_ToString(const OpBase *op, char *buff, uint buff_len);
 
+/* Create an uninitialized copy of op, which doesn't share state with op
+ * and can be executed by a different thread, op must be clonable. */
+OpBase *OpBase_Clone(const OpBase *op);
+
+/* Consume the next batch of records, returns NULL once op is depleted.
+ * Returned batch and its records are owned by the producing operation and are valid
+ * until op is consumed again. Operations which don't implement consumeBatch
+ * are adapted by accumulating the records produced by their consume function. */
+RecordBatch *OpBase_ConsumeBatch(OpBase *op);
+
+// Returns the batch owned by op, creating one holding records of length record_len if missing.
+RecordBatch *OpBase_GetBatch(OpBase *op, uint record_len);
+
 /* If an operation holds the sole reference to a Record it is evaluating,
  * that reference should be tracked so that it may be freed in the event of a run-time error. */
 void OpBase_AddVolatileRecord(OpBase *op, const Record r);
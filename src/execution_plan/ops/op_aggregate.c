@@ -80,24 +80,18 @@ static AR_ExpNode **_build_aggregated_expressions(OpAggregate *op) {
 	return agg_exps;
 }
 
-static Group *_CreateGroup(OpAggregate *op, Record r) {
+static Group *_CreateGroup(OpAggregate *op, Record r, uint64_t hash) {
 	/* Create a new group
 	 * Get a fresh copy of aggregation functions. */
 	AR_ExpNode **agg_exps = _build_aggregated_expressions(op);
 
-	/* Clone group keys. */
+	/* Persist group keys, group takes ownership over them. */
 	uint key_count = array_len(op->non_aggregated_expressions);
-	SIValue *group_keys = rm_malloc(sizeof(SIValue) * key_count);
-
-	for(uint i = 0; i < key_count; i++) {
-		SIValue key = op->group_keys[i];
-		SIValue_Persist(&key);
-		group_keys[i] = key;
-	}
+	for(uint i = 0; i < key_count; i++) SIValue_Persist(&op->group_keys[i]);
 
 	/* There's no need to keep a reference to record if we're not sorting groups. */
-	if(!op->order_exps) op->group = NewGroup(key_count, group_keys, agg_exps, NULL);
-	else op->group = NewGroup(key_count, group_keys, agg_exps, r);
+	if(!op->order_exps) r = NULL;
+	op->group = CacheGroupAdd(op->groups, op->group_keys, hash, agg_exps, r);
 
 	return op->group;
 }
@@ -111,65 +105,34 @@ static void _ComputeGroupKey(OpAggregate *op, Record r) {
 	}
 }
 
-static void _ComputeGroupKeyStr(OpAggregate *op, char **key) {
-	uint non_agg_exp_count = array_len(op->non_aggregated_expressions);
-	if(non_agg_exp_count == 0) {
-		*key = rm_strdup("SINGLE_GROUP");
-		return;
-	}
-
-	// Determine required size for group key string representation.
-	size_t key_len = SIValue_StringJoinLen(op->group_keys, non_agg_exp_count, ",");
-	*key = rm_malloc(sizeof(char) * key_len);
-	size_t bytesWritten = 0;
-	SIValue_StringJoin(op->group_keys, non_agg_exp_count, ",", key, &key_len, &bytesWritten);
+// Release group keys computed for a record which joined an existing group.
+static void _FreeGroupKey(OpAggregate *op) {
+	uint exp_count = array_len(op->non_aggregated_expressions);
+	for(uint i = 0; i < exp_count; i++) SIValue_Free(&op->group_keys[i]);
 }
 
 /* Retrieves group under which given record belongs to,
  * creates group if one doesn't exists. */
 static Group *_GetGroup(OpAggregate *op, Record r) {
-	char *group_key_str;
 	// Construct group key.
 	_ComputeGroupKey(op, r);
 
-	// First group created.
-	if(!op->group) {
-		op->group = _CreateGroup(op, r);
-		Group_KeyStr(op->group, &group_key_str);
-		CacheGroupAdd(op->groups, group_key_str, op->group);
-		rm_free(group_key_str);
+	// See if we can reuse last accessed group.
+	if(op->group && Group_KeysMatch(op->group, op->group_keys)) {
+		_FreeGroupKey(op);
 		return op->group;
 	}
 
-	// Evaluate non-aggregated fields, see if they match
-	// the last accessed group.
-	bool reuseLastAccessedGroup = true;
-	uint exp_count = array_len(op->non_aggregated_expressions);
-	for(uint i = 0; i < exp_count; i++) {
-		if(reuseLastAccessedGroup &&
-		   SIValue_Compare(op->group->keys[i], op->group_keys[i], NULL) == 0) {
-			reuseLastAccessedGroup = true;
-		} else {
-			reuseLastAccessedGroup = false;
-		}
-	}
-
-	// See if we can reuse last accessed group.
-	if(reuseLastAccessedGroup) return op->group;
-
-	// Can't reuse last accessed group, lookup group by identifier key.
-	_ComputeGroupKeyStr(op, &group_key_str);
-	op->group = CacheGroupGet(op->groups, group_key_str);
+	// Can't reuse last accessed group, lookup group by its keys.
+	uint64_t hash = CacheGroupHash(op->groups, op->group_keys);
+	op->group = CacheGroupGet(op->groups, op->group_keys, hash);
 	if(op->group) {
-		rm_free(group_key_str);
+		_FreeGroupKey(op);
 		return op->group;
 	}
 
 	// Group does not exists, create it.
-	op->group = _CreateGroup(op, r);
-	CacheGroupAdd(op->groups, group_key_str, op->group);
-	rm_free(group_key_str);
-	return op->group;
+	return _CreateGroup(op, r, hash);
 }
 
 static void _aggregateRecord(OpAggregate *op, Record r) {
@@ -183,25 +146,13 @@ static void _aggregateRecord(OpAggregate *op, Record r) {
 		AR_ExpNode *exp = group->aggregationFunctions[i];
 		AR_EXP_Aggregate(exp, r);
 	}
-
-	/* Free record, incase it is not group representative.
-	 * group representative will be freed once group is freed. */
-	Record_Free(r);
 }
 
-/* Returns a record populated with group data. */
-static Record _handoff(OpAggregate *op) {
-	char *key;
-	Group *group;
-	if(!CacheGroupIterNext(op->group_iter, &key, &group)) return NULL;
-
+/* Populates record with group data. */
+static void _populateRecord(OpAggregate *op, Group *group, Record r) {
 	uint exp_count = array_len(op->exps);
 	uint order_exp_count = array_len(op->order_exps);
-	Record r = Record_New(exp_count + order_exp_count);
-	// Track the newly-allocated Record so that they may be freed if execution fails.
-	OpBase_AddVolatileRecord((OpBase *)op, r);
 
-	// Populate record.
 	uint aggIdx = 0; // Index into group aggregated exps.
 	uint keyIdx = 0; // Index into group keys.
 	SIValue res;
@@ -238,6 +189,20 @@ static Record _handoff(OpAggregate *op) {
 			Record_AddScalar(r, exp_count + i, res);
 		}
 	}
+}
+
+/* Returns a record populated with group data. */
+static Record _handoff(OpAggregate *op) {
+	Group *group;
+	if(!CacheGroupIterNext(op->group_iter, &group)) return NULL;
+
+	uint exp_count = array_len(op->exps);
+	uint order_exp_count = array_len(op->order_exps);
+	Record r = Record_New(exp_count + order_exp_count);
+	// Track the newly-allocated Record so that they may be freed if execution fails.
+	OpBase_AddVolatileRecord((OpBase *)op, r);
+
+	_populateRecord(op, group, r);
 
 	OpBase_RemoveVolatileRecords((OpBase *)op);
 	return r;
@@ -251,7 +216,7 @@ OpBase *NewAggregateOp(AR_ExpNode **exps, uint *modifies) {
 	aggregate->group_iter = NULL;
 	aggregate->group_keys = NULL;
 	aggregate->ast = QueryCtx_GetAST();
-	aggregate->groups = CacheGroupNew();
+	aggregate->groups = NULL;
 	aggregate->expression_classification = NULL;
 	aggregate->non_aggregated_expressions = NULL;
 
@@ -259,6 +224,7 @@ OpBase *NewAggregateOp(AR_ExpNode **exps, uint *modifies) {
 	aggregate->op.name = "Aggregate";
 	aggregate->op.type = OPType_AGGREGATE;
 	aggregate->op.consume = AggregateConsume;
+	aggregate->op.consumeBatch = AggregateConsumeBatch;
 	aggregate->op.init = AggregateInit;
 	aggregate->op.reset = AggregateReset;
 	aggregate->op.free = AggregateFree;
@@ -270,6 +236,9 @@ OpBase *NewAggregateOp(AR_ExpNode **exps, uint *modifies) {
 
 OpResult AggregateInit(OpBase *opBase) {
 	OpAggregate *op = (OpAggregate *)opBase;
+	// Expressions are classified once, a cached plan might be initialized again.
+	if(op->expression_classification) return OP_OK;
+
 	AR_ExpNode **order_exps = _getOrderExpressions(opBase->parent);
 	if(order_exps) {
 		op->order_exps = order_exps;
@@ -280,6 +249,7 @@ OpResult AggregateInit(OpBase *opBase) {
 	/* Allocate memory for group keys. */
 	uint nonAggExpCount = array_len(op->non_aggregated_expressions);
 	if(nonAggExpCount) op->group_keys = rm_malloc(sizeof(SIValue) * nonAggExpCount);
+	op->groups = CacheGroupNew(nonAggExpCount);
 	return OP_OK;
 }
 
@@ -290,17 +260,50 @@ Record AggregateConsume(OpBase *opBase) {
 	if(op->group_iter) return _handoff(op);
 
 	Record r;
-	while((r = OpBase_Consume(child))) _aggregateRecord(op, r);
+	while((r = OpBase_Consume(child))) {
+		_aggregateRecord(op, r);
+		/* Free record, incase it is not group representative.
+		 * group representative will be freed once group is freed. */
+		Record_Free(r);
+	}
 
 	op->group_iter = CacheGroupIter(op->groups);
 	return _handoff(op);
 }
 
+RecordBatch *AggregateConsumeBatch(OpBase *opBase) {
+	OpAggregate *op = (OpAggregate *)opBase;
+	OpBase *child = op->op.children[0];
+
+	if(!op->group_iter) {
+		// Aggregate entire input, child's records are owned by its batches.
+		RecordBatch *batch;
+		while((batch = OpBase_ConsumeBatch(child))) {
+			for(uint i = 0; i < batch->selected; i++) _aggregateRecord(op, RecordBatch_Get(batch, i));
+		}
+		op->group_iter = CacheGroupIter(op->groups);
+	}
+
+	uint exp_count = array_len(op->exps);
+	uint order_exp_count = array_len(op->order_exps);
+	RecordBatch *groups = OpBase_GetBatch(opBase, exp_count + order_exp_count);
+	RecordBatch_Clear(groups);
+
+	Group *group;
+	while(!RecordBatch_IsFull(groups) && CacheGroupIterNext(op->group_iter, &group)) {
+		_populateRecord(op, group, RecordBatch_NewRecord(groups));
+	}
+
+	return (groups->selected) ? groups : NULL;
+}
+
 OpResult AggregateReset(OpBase *opBase) {
 	OpAggregate *op = (OpAggregate *)opBase;
 
-	FreeGroupCache(op->groups);
-	op->groups = CacheGroupNew();
+	// Groups are freed, arena is retained for the next execution.
+	if(op->groups) CacheGroupClear(op->groups);
+	// Last accessed group was freed along with the cache.
+	op->group = NULL;
 
 	if(op->group_iter) {
 		CacheGroupIterator_Free(op->group_iter);
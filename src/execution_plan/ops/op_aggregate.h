@@ -31,7 +31,7 @@ typedef struct {
 	ExpClassification
 	*expression_classification;  /* classifies expression as aggregated/non-aggregated. */
 	Group *group;                                  /* Last accessed group. */
-	rax *groups;
+	CacheGroup *groups;                            /* Groups hashed by their keys. */
 	SIValue *group_keys;                           /* Array of values composing an aggregated group. */
 	CacheGroupIterator *group_iter;
 	Record last_record;
@@ -40,6 +40,7 @@ typedef struct {
 OpBase *NewAggregateOp(AR_ExpNode **expressions, uint *modifies);
 OpResult AggregateInit(OpBase *opBase);
 Record AggregateConsume(OpBase *opBase);
+RecordBatch *AggregateConsumeBatch(OpBase *opBase);
 OpResult AggregateReset(OpBase *opBase);
 void AggregateFree(OpBase *opBase);
 
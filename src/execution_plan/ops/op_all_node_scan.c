@@ -16,8 +16,9 @@ int AllNodeScanToString(const OpBase *ctx, char *buff, uint buff_len) {
 
 OpBase *NewAllNodeScanOp(const Graph *g, QGNode *n, uint node_idx) {
 	AllNodeScan *allNodeScan = malloc(sizeof(AllNodeScan));
+	allNodeScan->g = g;
 	allNodeScan->n = n;
-	allNodeScan->iter = Graph_ScanNodes(g);
+	allNodeScan->iter = NULL;
 	allNodeScan->nodeRecIdx = node_idx;
 
 	// Set our Op operations
@@ -25,10 +26,12 @@ OpBase *NewAllNodeScanOp(const Graph *g, QGNode *n, uint node_idx) {
 	allNodeScan->op.name = "All Node Scan";
 	allNodeScan->op.type = OPType_ALL_NODE_SCAN;
 	allNodeScan->op.consume = AllNodeScanConsume;
+	allNodeScan->op.consumeBatch = AllNodeScanConsumeBatch;
 	allNodeScan->op.init = AllNodeScanInit;
 	allNodeScan->op.reset = AllNodeScanReset;
 	allNodeScan->op.toString = AllNodeScanToString;
 	allNodeScan->op.free = AllNodeScanFree;
+	allNodeScan->op.clone = AllNodeScanClone;
 
 	allNodeScan->op.modifies = array_new(uint, 1);
 	allNodeScan->op.modifies = array_append(allNodeScan->op.modifies, node_idx);
@@ -37,6 +40,10 @@ OpBase *NewAllNodeScanOp(const Graph *g, QGNode *n, uint node_idx) {
 }
 
 OpResult AllNodeScanInit(OpBase *opBase) {
+	AllNodeScan *op = (AllNodeScan *)opBase;
+	// Scan nodes as of execution time, a cached plan outlives its first execution.
+	if(op->iter) DataBlockIterator_Free(op->iter);
+	op->iter = Graph_ScanNodes(op->g);
 	return OP_OK;
 }
 
@@ -53,12 +60,38 @@ Record AllNodeScanConsume(OpBase *opBase) {
 	return r;
 }
 
+RecordBatch *AllNodeScanConsumeBatch(OpBase *opBase) {
+	AllNodeScan *op = (AllNodeScan *)opBase;
+	RecordBatch *batch = OpBase_GetBatch(opBase, opBase->record_map->record_len);
+	RecordBatch_Clear(batch);
+
+	Entity *en;
+	while(!RecordBatch_IsFull(batch) && (en = (Entity *)DataBlockIterator_Next(op->iter))) {
+		Record r = RecordBatch_NewRecord(batch);
+		Node *n = Record_GetNode(r, op->nodeRecIdx);
+		n->entity = en;
+	}
+
+	return (batch->selected) ? batch : NULL;
+}
+
 OpResult AllNodeScanReset(OpBase *op) {
 	AllNodeScan *allNodeScan = (AllNodeScan *)op;
 	DataBlockIterator_Reset(allNodeScan->iter);
 	return OP_OK;
 }
 
+OpBase *AllNodeScanClone(const OpBase *opBase) {
+	const AllNodeScan *op = (const AllNodeScan *)opBase;
+	return NewAllNodeScanOp(op->g, op->n, op->nodeRecIdx);
+}
+
+void AllNodeScanSetRange(OpBase *opBase, NodeID start, NodeID end) {
+	AllNodeScan *op = (AllNodeScan *)opBase;
+	if(op->iter) DataBlockIterator_Free(op->iter);
+	op->iter = Graph_ScanNodesRange(op->g, start, end);
+}
+
 void AllNodeScanFree(OpBase *ctx) {
 	AllNodeScan *op = (AllNodeScan *)ctx;
 	if(op->iter) {
@@ -17,6 +17,7 @@
  * Scans entire graph */
 typedef struct {
 	OpBase op;
+	const Graph *g;
 	QGNode *n;
 	DataBlockIterator *iter;
 	uint nodeRecIdx;
@@ -24,8 +25,12 @@ typedef struct {
 
 OpBase *NewAllNodeScanOp(const Graph *g, QGNode *n, uint rec_idx);
 Record AllNodeScanConsume(OpBase *opBase);
+RecordBatch *AllNodeScanConsumeBatch(OpBase *opBase);
 OpResult AllNodeScanInit(OpBase *opBase);
 OpResult AllNodeScanReset(OpBase *op);
+OpBase *AllNodeScanClone(const OpBase *opBase);
+// Restrict scan to nodes with IDs in the range [start, end).
+void AllNodeScanSetRange(OpBase *opBase, NodeID start, NodeID end);
 void AllNodeScanFree(OpBase *ctx);
 
 #endif
@@ -88,6 +88,14 @@ Record ApplyConsume(OpBase *opBase) {
 OpResult ApplyReset(OpBase *opBase) {
 	Apply *op = (Apply *)opBase;
 	op->init = true;
+	// Drop buffered records, the right-hand stream is re-read on next consume.
+	if(op->lhs_record) {
+		Record_Free(op->lhs_record);
+		op->lhs_record = NULL;
+	}
+	uint len = array_len(op->rhs_records);
+	for(uint i = 0; i < len; i ++) Record_Free(op->rhs_records[i]);
+	array_clear(op->rhs_records);
 	return OP_OK;
 }
 
@@ -5,11 +5,15 @@
 */
 
 #include "op_cartesian_product.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
 
 OpBase *NewCartesianProductOp(void) {
 	CartesianProduct *cp = malloc(sizeof(CartesianProduct));
 	cp->init = true;
 	cp->r = NULL;
+	cp->last_record = NULL;
+	cp->streams = NULL;
 
 	// Set our Op operations
 	OpBase_Init(&cp->op);
@@ -23,33 +27,91 @@ OpBase *NewCartesianProductOp(void) {
 	return (OpBase *)cp;
 }
 
+// Forget materialized records, streams will be consumed again.
+static void _ClearStreams(CartesianProduct *op) {
+	if(op->last_record) {
+		Record_Free(op->last_record);
+		op->last_record = NULL;
+	}
+	if(!op->streams) return;
+	uint stream_count = array_len(op->streams);
+	for(uint i = 0; i < stream_count; i++) {
+		CartesianProductStream *s = op->streams + i;
+		uint record_count = array_len(s->records);
+		for(uint j = 0; j < record_count; j++) Record_Free(s->records[j]);
+		array_clear(s->records);
+		s->cursor = 0;
+		s->materialized = false;
+	}
+}
+
+/* Pull next record from stream idx into op's record,
+ * a materialized stream is replayed from memory. */
+static bool _PullStream(CartesianProduct *op, int idx) {
+	OpBase *child = op->op.children[idx];
+
+	// Last stream is never rewound, there's no need to keep its records.
+	if(idx == op->op.childCount - 1) {
+		Record childRecord = OpBase_Consume(child);
+		if(!childRecord) return false;
+		// Record is kept until the stream advances, its entries are shared with op's record.
+		if(op->last_record) Record_Free(op->last_record);
+		op->last_record = childRecord;
+		Record_Merge(&op->r, childRecord);
+		return true;
+	}
+
+	CartesianProductStream *s = op->streams + idx;
+	Record childRecord;
+	if(s->materialized) {
+		if(s->cursor == array_len(s->records)) return false;
+		childRecord = s->records[s->cursor++];
+	} else {
+		childRecord = OpBase_Consume(child);
+		if(!childRecord) {
+			s->materialized = true;
+			return false;
+		}
+		/* Stream owns its records, persist scalars as the child
+		 * operation might release values it shared. */
+		Record_PersistScalars(childRecord);
+		s->records = array_append(s->records, childRecord);
+		s->cursor++;
+	}
+
+	// Record entries are shared with the materialized record.
+	Record_Merge(&op->r, childRecord);
+	return true;
+}
+
+// Rewind each stream in [0, streamIdx), streams are replayed from memory.
 static void _ResetStreams(CartesianProduct *cp, int streamIdx) {
-	// Reset each child stream, Reset propagates upwards.
-	for(int i = 0; i < streamIdx; i++) OpBase_PropagateReset(cp->op.children[i]);
+	for(int i = 0; i < streamIdx; i++) {
+		// A stream is rewound only once it's depleted.
+		assert(cp->streams[i].materialized);
+		cp->streams[i].cursor = 0;
+	}
+}
+
+/* Pass down a clone of op's record, the clone shares scalars
+ * with the last stream's record, which is freed once that stream advances,
+ * while parent operations might still hold on to the clone. */
+static Record _EmitRecord(CartesianProduct *op) {
+	Record r = Record_Clone(op->r);
+	Record_PersistScalars(r);
+	return r;
 }
 
 static int _PullFromStreams(CartesianProduct *op) {
 	for(int i = 1; i < op->op.childCount; i++) {
-		OpBase *child = op->op.children[i];
-		Record childRecord = OpBase_Consume(child);
-
-		if(childRecord) {
-			Record_TransferEntries(&op->r, childRecord);
-			Record_Free(childRecord);
+		if(_PullStream(op, i)) {
 			/* Managed to get new data
 			 * Reset streams [0-i] */
 			_ResetStreams(op, i);
 
 			// Pull from resetted streams.
 			for(int j = 0; j < i; j++) {
-				child = op->op.children[j];
-				childRecord = OpBase_Consume(child);
-				if(childRecord) {
-					Record_TransferEntries(&op->r, childRecord);
-					Record_Free(childRecord);
-				} else {
-					return 0;
-				}
+				if(!_PullStream(op, j)) return 0;
 			}
 			// Ready to continue.
 			return 1;
@@ -63,57 +125,59 @@ static int _PullFromStreams(CartesianProduct *op) {
 
 OpResult CartesianProductInit(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
-	op->r = Record_New(opBase->record_map->record_len);
+	if(!op->r) op->r = Record_New(opBase->record_map->record_len);
+	if(!op->streams) {
+		uint stream_count = opBase->childCount - 1;
+		op->streams = array_new(CartesianProductStream, stream_count);
+		for(uint i = 0; i < stream_count; i++) {
+			CartesianProductStream s = {.records = array_new(Record, 1), .cursor = 0, .materialized = false};
+			op->streams = array_append(op->streams, s);
+		}
+	}
 	return OP_OK;
 }
 
 Record CartesianProductConsume(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
-	OpBase *child;
-	Record childRecord;
 
 	if(op->init) {
 		op->init = false;
 
 		for(int i = 0; i < op->op.childCount; i++) {
-			child = op->op.children[i];
-			childRecord = OpBase_Consume(child);
-			if(!childRecord) {
-				// TODO: leak childRecord.
-				return NULL;
-			}
-			Record_TransferEntries(&op->r, childRecord);
-			Record_Free(childRecord);
+			if(!_PullStream(op, i)) return NULL;
 		}
-		return Record_Clone(op->r);
+		return _EmitRecord(op);
 	}
 
 	// Pull from first stream.
-	child = op->op.children[0];
-	childRecord = OpBase_Consume(child);
-
-	if(childRecord) {
-		// Managed to get data from first stream.
-		Record_TransferEntries(&op->r, childRecord);
-		Record_Free(childRecord);
-	} else {
+	if(!_PullStream(op, 0)) {
 		// Failed to get data from first stream,
 		// try pulling other streams for data.
 		if(!_PullFromStreams(op)) return NULL;
 	}
 
 	// Pass down a clone of record.
-	return Record_Clone(op->r);
+	return _EmitRecord(op);
 }
 
 OpResult CartesianProductReset(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
 	op->init = true;
+	// Children are reset as well, their output might differ.
+	_ClearStreams(op);
 	return OP_OK;
 }
 
 void CartesianProductFree(OpBase *opBase) {
 	CartesianProduct *op = (CartesianProduct *)opBase;
+	_ClearStreams(op);
+	if(op->streams) {
+		uint stream_count = array_len(op->streams);
+		for(uint i = 0; i < stream_count; i++) array_free(op->streams[i].records);
+		array_free(op->streams);
+		op->streams = NULL;
+	}
+
 	if(op->r) {
 		Record_Free(op->r);
 		op->r = NULL;
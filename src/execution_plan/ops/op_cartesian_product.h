@@ -9,11 +9,23 @@
 
 #include "op.h"
 
-/* Cartesian product AKA Join. */
+/* Records produced by a rewound child stream,
+ * once depleted the stream is replayed from memory. */
+typedef struct {
+	Record *records;        // Records produced by stream.
+	uint cursor;            // Position of next record to replay.
+	bool materialized;      // Stream was consumed entirely.
+} CartesianProductStream;
+
+/* Cartesian product AKA Join.
+ * Streams [0, childCount - 1) are rewound each time a later stream advances,
+ * their records are kept such that child operations execute only once. */
 typedef struct {
 	OpBase op;
 	bool init;
 	Record r;
+	Record last_record;                 // Current record of the last stream.
+	CartesianProductStream *streams;    // Streams [0, childCount - 1).
 } CartesianProduct;
 
 OpBase *NewCartesianProductOp(void);
@@ -22,4 +34,4 @@ Record CartesianProductConsume(OpBase *opBase);
 OpResult CartesianProductReset(OpBase *opBase);
 void CartesianProductFree(OpBase *opBase);
 
-#endif
\ No newline at end of file
+#endif
@@ -7,6 +7,7 @@
 #include <assert.h>
 
 #include "../../util/arr.h"
+#include "../../util/rmalloc.h"
 #include "../../ast/ast.h"
 #include "../../arithmetic/arithmetic_expression.h"
 #include "../../graph/graphcontext.h"
@@ -30,6 +31,7 @@ int CondVarLenTraverseToString(const OpBase *ctx, char *buff, uint buff_len) {
 
 	int offset = 0;
 	offset += snprintf(buff + offset, buff_len - offset, "%s | ", op->op.name);
+	if(op->reachability) offset += snprintf(buff + offset, buff_len - offset, "Reachability | ");
 	offset += QGNode_ToString(op->ae->src_node, buff + offset, buff_len - offset);
 	if(op->ae->edge) {
 		offset += snprintf(buff + offset, buff_len - offset, "-");
@@ -50,6 +52,11 @@ void CondVarLenTraverseOp_ExpandInto(CondVarLenTraverse *op) {
 	op->op.name = "Conditional Variable Length Traverse (Expand Into)";
 }
 
+void CondVarLenTraverseOp_SetReachability(CondVarLenTraverse *op) {
+	assert(op->minHops <= 1);
+	op->reachability = true;
+}
+
 OpBase *NewCondVarLenTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpression *ae) {
 	assert(ae && ae->edge->minHops <= ae->edge->maxHops && g && ae->operand_count == 1);
 
@@ -69,6 +76,16 @@ OpBase *NewCondVarLenTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpres
 	condVarLenTraverse->traverseDir = (ae->operands[0].transpose) ? GRAPH_EDGE_DIR_INCOMING :
 									  GRAPH_EDGE_DIR_OUTGOING;
 	condVarLenTraverse->r = NULL;
+	condVarLenTraverse->reachability = false;
+	condVarLenTraverse->records = NULL;
+	condVarLenTraverse->recordsLen = 0;
+	condVarLenTraverse->rows = NULL;
+	condVarLenTraverse->cols = NULL;
+	condVarLenTraverse->vals = NULL;
+	condVarLenTraverse->frontier = NULL;
+	condVarLenTraverse->visited = NULL;
+	condVarLenTraverse->iter = NULL;
+	condVarLenTraverse->bfs = NULL;
 
 	_setupTraversedRelations(condVarLenTraverse, ae->edge);
 
@@ -88,10 +105,150 @@ OpBase *NewCondVarLenTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpres
 	return (OpBase *)condVarLenTraverse;
 }
 
+// Allocate batch buffers and matrices, sized to the graph's current dimensions.
+static void _ReachabilityInit(CondVarLenTraverse *op) {
+	uint cap = VAR_LEN_REACHABILITY_BATCH_SIZE;
+	op->records = rm_calloc(cap, sizeof(Record));
+	op->rows = rm_malloc(sizeof(GrB_Index) * cap);
+	op->cols = rm_malloc(sizeof(GrB_Index) * cap);
+	op->vals = rm_malloc(sizeof(bool) * cap);
+	for(uint i = 0; i < cap; i++) {
+		op->rows[i] = i;
+		op->vals[i] = true;
+	}
+
+	GrB_Index n = Graph_RequiredMatrixDim(op->g);
+	GrB_Matrix_new(&op->frontier, GrB_BOOL, cap, n);
+	GrB_Matrix_new(&op->visited, GrB_BOOL, cap, n);
+}
+
+/* Discover the nodes reachable from each record in the batch within
+ * [minHops, maxHops] hops, level by level:
+ * frontier<!visited> = frontier * A
+ * visited += frontier
+ * every node is expanded at most once per record. */
+static void _ReachabilityBFS(CondVarLenTraverse *op) {
+	GrB_Matrix_clear(op->frontier);
+	GrB_Matrix_clear(op->visited);
+
+	// Graph might have grown since matrices were allocated.
+	GrB_Index ncols;
+	GrB_Index n = Graph_RequiredMatrixDim(op->g);
+	GrB_Matrix_ncols(&ncols, op->frontier);
+	if(ncols != n) {
+		GxB_Matrix_resize(op->frontier, VAR_LEN_REACHABILITY_BATCH_SIZE, n);
+		GxB_Matrix_resize(op->visited, VAR_LEN_REACHABILITY_BATCH_SIZE, n);
+	}
+
+	GrB_Info res = GrB_Matrix_build_BOOL(op->frontier, op->rows, op->cols, op->vals, op->recordsLen,
+										 GrB_LOR);
+	assert(res == GrB_SUCCESS);
+
+	// With no minimum, each source reaches itself.
+	if(op->minHops == 0) GrB_Matrix_apply(op->visited, NULL, NULL, GrB_IDENTITY_BOOL, op->frontier, NULL);
+
+	GrB_Descriptor desc;
+	GrB_Descriptor_new(&desc);
+	GrB_Descriptor_set(desc, GrB_MASK, GrB_SCMP);
+	GrB_Descriptor_set(desc, GrB_OUTP, GrB_REPLACE);
+
+	// The expression's sole operand, read through its maintained transpose if required.
+	GrB_Matrix A = op->ae->operands[0].operand;
+	if(op->ae->operands[0].transpose) {
+		GrB_Matrix t = Graph_GetTransposedMatrix(op->g, A);
+		if(t) A = t;
+		else GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
+	}
+
+	for(uint depth = 1; depth <= op->maxHops; depth++) {
+		GrB_mxm(op->frontier, op->visited, NULL, GxB_LOR_LAND_BOOL, op->frontier, A, desc);
+
+		GrB_Index nvals;
+		GrB_Matrix_nvals(&nvals, op->frontier);
+		if(nvals == 0) break;
+
+		GrB_eWiseAdd_Matrix_BinaryOp(op->visited, NULL, NULL, GrB_LOR, op->visited, op->frontier, NULL);
+	}
+
+	GrB_Descriptor_free(&desc);
+
+	if(op->iter) GxB_MatrixTupleIter_reuse(op->iter, op->visited);
+	else GxB_MatrixTupleIter_new(&op->iter, op->visited);
+}
+
+// Consume a batch of source records, returns false if child is depleted.
+static bool _ReachabilityNextBatch(CondVarLenTraverse *op) {
+	OpBase *child = op->op.children[0];
+	for(uint i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+
+	for(op->recordsLen = 0; op->recordsLen < VAR_LEN_REACHABILITY_BATCH_SIZE; op->recordsLen++) {
+		Record childRecord = OpBase_Consume(child);
+		if(!childRecord) break;
+		op->records[op->recordsLen] = childRecord;
+		Node *srcNode = Record_GetNode(childRecord, op->srcNodeIdx);
+		op->cols[op->recordsLen] = ENTITY_GET_ID(srcNode);
+	}
+
+	if(op->recordsLen == 0) return false;
+	_ReachabilityBFS(op);
+	return true;
+}
+
+static Record _ReachabilityConsume(CondVarLenTraverse *op) {
+	if(op->records == NULL) _ReachabilityInit(op);
+
+	while(true) {
+		if(op->recordsLen > 0) {
+			GrB_Index row;
+			GrB_Index col;
+			bool depleted = false;
+			while(true) {
+				GxB_MatrixTupleIter_next(op->iter, &row, &col, &depleted);
+				if(depleted) break;
+
+				Record r = op->records[row];
+				Node n;
+				Graph_GetNode(op->g, col, &n);
+				Record_AddNode(r, op->destNodeIdx, n);
+				return Record_Clone(r);
+			}
+		}
+
+		if(!_ReachabilityNextBatch(op)) return NULL;
+	}
+}
+
+/* Returns true if record's dest node is reachable from its src node within maxHops,
+ * a necessary condition for a path of [minHops, maxHops] edges to connect the two,
+ * and a sufficient one if minHops <= 1. */
+static bool _DestReachable(CondVarLenTraverse *op, Record r) {
+	if(op->bfs == NULL) op->bfs = BidirectionalBFS_New();
+
+	Node *srcNode = Record_GetNode(r, op->srcNodeIdx);
+	Node *destNode = Record_GetNode(r, op->destNodeIdx);
+	GrB_Matrix M = op->ae->operands[0].operand;
+	GrB_Matrix MT = Graph_GetTransposedMatrix(op->g, M);
+	unsigned int minHops = (op->minHops > 1) ? 1 : op->minHops;
+
+	return BidirectionalBFS_Reachable(op->bfs, M, MT, op->ae->operands[0].transpose,
+									  ENTITY_GET_ID(srcNode), ENTITY_GET_ID(destNode), minHops, op->maxHops);
+}
+
+// Produce each record whose dest node is reachable from its src node once.
+static Record _ReachableIntoConsume(CondVarLenTraverse *op) {
+	OpBase *child = op->op.children[0];
+	Record childRecord;
+	while((childRecord = OpBase_Consume(child))) {
+		if(_DestReachable(op, childRecord)) return childRecord;
+		Record_Free(childRecord);
+	}
+	return NULL;
+}
+
 Record CondVarLenTraverseConsume(OpBase *opBase) {
 	CondVarLenTraverse *op = (CondVarLenTraverse *)opBase;
 	OpBase *child = op->op.children[0];
-	Path p = NULL;
+	SharedPath *p = NULL;
 
 	/* Incase we don't have any relations to traverse we can return quickly
 	 * Consider: MATCH (S)-[:L*]->(M) RETURN M
@@ -100,6 +257,11 @@ Record CondVarLenTraverseConsume(OpBase *opBase) {
 		return NULL;
 	}
 
+	if(op->reachability) {
+		if(op->expandInto) return _ReachableIntoConsume(op);
+		return _ReachabilityConsume(op);
+	}
+
 compute_path:
 	while(!(p = AllPathsCtx_NextPath(op->allPathsCtx))) {
 		Record childRecord = OpBase_Consume(child);
@@ -108,9 +270,13 @@ compute_path:
 		if(op->r) Record_Free(op->r);
 		op->r = childRecord;
 
-		Node *srcNode = Record_GetNode(op->r, op->srcNodeIdx);
-
 		AllPathsCtx_Free(op->allPathsCtx);
+		op->allPathsCtx = NULL;
+
+		// Don't bother enumerating paths from src if none of them reaches dest.
+		if(op->expandInto && !_DestReachable(op, op->r)) continue;
+
+		Node *srcNode = Record_GetNode(op->r, op->srcNodeIdx);
 		op->allPathsCtx = AllPathsCtx_New(srcNode,
 										  op->g,
 										  op->edgeRelationTypes,
@@ -121,7 +287,7 @@ compute_path:
 	}
 
 	// For the timebeing we only care for the last node in path
-	Node n = Path_head(p);
+	Node n = SharedPath_Head(p);
 
 	if(op->expandInto) {
 		/* Dest node is already resolved
@@ -142,6 +308,9 @@ OpResult CondVarLenTraverseReset(OpBase *ctx) {
 	op->r = NULL;
 	AllPathsCtx_Free(op->allPathsCtx);
 	op->allPathsCtx = NULL;
+
+	for(uint i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+	op->recordsLen = 0;
 	return OP_OK;
 }
 
@@ -167,5 +336,34 @@ void CondVarLenTraverseFree(OpBase *ctx) {
 		AllPathsCtx_Free(op->allPathsCtx);
 		op->allPathsCtx = NULL;
 	}
+
+	if(op->records) {
+		for(uint i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+		rm_free(op->records);
+		rm_free(op->rows);
+		rm_free(op->cols);
+		rm_free(op->vals);
+		op->records = NULL;
+	}
+
+	if(op->iter) {
+		GxB_MatrixTupleIter_free(op->iter);
+		op->iter = NULL;
+	}
+
+	if(op->frontier) {
+		GrB_Matrix_free(&op->frontier);
+		op->frontier = NULL;
+	}
+
+	if(op->visited) {
+		GrB_Matrix_free(&op->visited);
+		op->visited = NULL;
+	}
+
+	if(op->bfs) {
+		BidirectionalBFS_Free(op->bfs);
+		op->bfs = NULL;
+	}
 }
 
@@ -11,6 +11,11 @@
 #include "../../graph/graph.h"
 #include "../../algorithms/algorithms.h"
 #include "../../arithmetic/algebraic_expression.h"
+#include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Number of source records whose reachable nodes are
+ * discovered together, in reachability mode. */
+#define VAR_LEN_REACHABILITY_BATCH_SIZE 64
 
 /* OP Traverse */
 typedef struct {
@@ -27,6 +32,16 @@ typedef struct {
 	unsigned int maxHops;           /* Maximum number of hops to perform. */
 	AllPathsCtx *allPathsCtx;
 	Record r;
+	bool reachability;              /* Produce each reachable destination once. */
+	Record *records;                /* Batch of source records, reachability mode. */
+	uint recordsLen;                /* Number of records in batch. */
+	GrB_Index *rows;                /* Row indices of frontier's initial entries. */
+	GrB_Index *cols;                /* Column indices of frontier's initial entries, source node IDs. */
+	bool *vals;                     /* Values of frontier's initial entries. */
+	GrB_Matrix frontier;            /* Nodes discovered by the last BFS level, row per record. */
+	GrB_Matrix visited;             /* Nodes reached by each record. */
+	GxB_MatrixTupleIter *iter;      /* Iterator over visited. */
+	BidirectionalBFSCtx *bfs;       /* Checks dest is reachable from src, expand into. */
 } CondVarLenTraverse;
 
 OpBase *NewCondVarLenTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpression *ae);
@@ -34,7 +49,18 @@ Record CondVarLenTraverseConsume(OpBase *opBase);
 OpResult CondVarLenTraverseReset(OpBase *ctx);
 
 /* Transform operation from Conditional Variable Length Traverse
- * to Expand Into Conditional Variable Length Traverse */
+ * to Expand Into Conditional Variable Length Traverse
+ * Before enumerating paths between src and dest, a bidirectional BFS
+ * makes sure dest is reachable from src within maxHops. */
 void CondVarLenTraverseOp_ExpandInto(CondVarLenTraverse *op);
+
+/* Switch operation to produce each node reachable from a source record once,
+ * rather than once per path leading to it. Nodes are discovered by a
+ * level synchronous BFS over the relation matrix, processing a batch of
+ * source records at a time. Only valid if minHops <= 1, in which case
+ * the set of reachable nodes equals the set of path end points.
+ * In expand into mode, records are produced once if the bidirectional BFS
+ * connects src and dest, paths are never enumerated. */
+void CondVarLenTraverseOp_SetReachability(CondVarLenTraverse *op);
 void CondVarLenTraverseFree(OpBase *ctx);
 #endif
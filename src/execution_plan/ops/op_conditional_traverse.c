@@ -6,8 +6,12 @@
 
 #include "op_conditional_traverse.h"
 #include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include "../../ast/ast.h"
+#include "../../query_ctx.h"
 #include "../../GraphBLASExt/GxB_Delete.h"
 #include "../../arithmetic/arithmetic_expression.h"
+#include <assert.h>
 
 static void _setupTraversedRelations(CondTraverse *op, QGEdge *e) {
 	uint reltype_count = array_len(e->reltypeIDs);
@@ -48,22 +52,170 @@ static int _CondTraverse_SetEdge(CondTraverse *op, Record r) {
  * prepends filter matrix as the left most operand
  * perform multiplications
  * set iterator over result matrix
- * removed filter matrix from original expression
- * clears filter matrix. */
+ * removed filter matrix from original expression.
+ * Filter matrix is kept until the next batch, edges are collected against it. */
 void _traverse(CondTraverse *op) {
 	// Prepend matrix to algebraic expression, as the left most operand.
 	AlgebraicExpression_PrependTerm(op->ae, op->F, false, false, false);
 	// Evaluate expression.
 	AlgebraicExpression_Execute(op->ae, op->M);
+	GrB_Matrix_nvals(&op->produced, op->M);
 
 	// Remove operand.
 	AlgebraicExpression_RemoveTerm(op->ae, 0, NULL);
 
+	// Edges are consumed through E rather than M.
+	op->relationIdx = 0;
+	op->edgeTupleIdx = 0;
+	op->edgeTupleCount = 0;
+	if(op->ae->edge) return;
+
 	if(op->iter == NULL) GxB_MatrixTupleIter_new(&op->iter, op->M);
 	else GxB_MatrixTupleIter_reuse(op->iter, op->M);
+}
 
-	// Clear filter matrix.
-	GrB_Matrix_clear(op->F);
+/* Number of relation types edges are collected from,
+ * edges of any type are collected from every relation map. */
+static inline int _CondTraverse_RelationCount(const CondTraverse *op) {
+	if(op->edgeRelationTypes[0] == GRAPH_NO_RELATION) return Graph_RelationTypeCount(op->graph);
+	return op->edgeRelationCount;
+}
+
+static inline int _CondTraverse_RelationAt(const CondTraverse *op, int idx) {
+	if(op->edgeRelationTypes[0] == GRAPH_NO_RELATION) return idx;
+	return op->edgeRelationTypes[idx];
+}
+
+/* Collects the entries of the next relation map connecting the batch's records
+ * to their destinations:
+ * E<M> = F min.second map
+ * each row of F holds a single entry, such that E[i, dest] is the relation map entry
+ * connecting record i's source node to dest, edge IDs are produced alongside
+ * destinations rather than looked up per (source, destination) pair.
+ * Returns false once edges of every relation type were collected. */
+static bool _CondTraverse_CollectEdges(CondTraverse *op) {
+	if(op->produced == 0) return false;
+
+	int relation_count = _CondTraverse_RelationCount(op);
+	while(op->relationIdx < relation_count) {
+		int r = _CondTraverse_RelationAt(op, op->relationIdx++);
+		// Invalid relation type specified, e.g. MATCH ()-[:real_type|fake_type]->()
+		if(r == GRAPH_UNKNOWN_RELATION) continue;
+
+		GrB_Matrix map = Graph_GetRelationMap(op->graph, r);
+		GrB_Matrix_clear(op->E);
+		GrB_Info res = GrB_mxm(op->E, op->M, NULL, GxB_MIN_SECOND_UINT64, op->F, map, op->edgeDesc);
+		assert(res == GrB_SUCCESS);
+
+		GrB_Index nvals;
+		GrB_Matrix_nvals(&nvals, op->E);
+		if(nvals == 0) continue;
+
+		if(nvals > op->edgeTupleCap) {
+			op->edgeTupleCap = nvals;
+			op->edgeRows = rm_realloc(op->edgeRows, sizeof(GrB_Index) * nvals);
+			op->edgeCols = rm_realloc(op->edgeCols, sizeof(GrB_Index) * nvals);
+			op->edgeEntries = rm_realloc(op->edgeEntries, sizeof(uint64_t) * nvals);
+		}
+		GrB_Matrix_extractTuples_UINT64(op->edgeRows, op->edgeCols, op->edgeEntries, &nvals, op->E);
+
+		op->relation = r;
+		op->edgeTupleIdx = 0;
+		op->edgeTupleCount = nvals;
+		return true;
+	}
+
+	return false;
+}
+
+/* Advances to the next (record, destination) pair of the current batch,
+ * when an edge is bound, the edges connecting the pair are pushed onto op->edges.
+ * Returns false once the batch is depleted. */
+static bool _CondTraverse_NextTuple(CondTraverse *op, GrB_Index *row, GrB_Index *col) {
+	if(!op->ae->edge) {
+		bool depleted = true;
+		if(op->iter) GxB_MatrixTupleIter_next(op->iter, row, col, &depleted);
+		return !depleted;
+	}
+
+	while(op->edgeTupleIdx >= op->edgeTupleCount) {
+		if(!_CondTraverse_CollectEdges(op)) return false;
+	}
+
+	GrB_Index k = op->edgeTupleIdx++;
+	*row = op->edgeRows[k];
+	*col = op->edgeCols[k];
+
+	// Record's source node is the column of its entry in F.
+	Edge e;
+	e.relationID = op->relation;
+	if(op->transposed_edge) {
+		e.srcNodeID = *col;
+		e.destNodeID = op->cols[*row];
+	} else {
+		e.srcNodeID = op->cols[*row];
+		e.destNodeID = *col;
+	}
+
+	uint32_t edge_count;
+	EdgeID entry = op->edgeEntries[k];
+	const EdgeID *edge_ids = Graph_ResolveRelationMapEntry(op->graph, op->relation, &entry,
+															&edge_count);
+	for(uint32_t i = 0; i < edge_count; i++) {
+		Graph_GetEdge(op->graph, edge_ids[i], &e);
+		op->edges = array_append(op->edges, e);
+	}
+
+	return true;
+}
+
+// Reallocates batch buffers and matrices to hold cap records.
+static void _CondTraverse_SetBatchCap(CondTraverse *op, int cap) {
+	op->records = rm_realloc(op->records, sizeof(Record) * cap);
+	op->rows = rm_realloc(op->rows, sizeof(GrB_Index) * cap);
+	op->cols = rm_realloc(op->cols, sizeof(GrB_Index) * cap);
+	op->vals = rm_realloc(op->vals, sizeof(bool) * cap);
+	for(int i = op->recordsCap; i < cap; i++) {
+		op->records[i] = NULL;
+		op->rows[i] = i;
+		op->vals[i] = true;
+	}
+
+	GrB_Index ncols;
+	GrB_Matrix_ncols(&ncols, op->M);
+	GxB_Matrix_resize(op->M, cap, ncols);
+	GxB_Matrix_resize(op->F, cap, ncols);
+	if(op->E) GxB_Matrix_resize(op->E, cap, ncols);
+	op->recordsCap = cap;
+}
+
+/* Graph might have grown since matrices were last sized,
+ * e.g. nodes created by upstream operations,
+ * resize matrices to match graph's current dimensions. */
+static void _CondTraverse_ConformDim(CondTraverse *op) {
+	GrB_Index ncols;
+	size_t required_dim = Graph_RequiredMatrixDim(op->graph);
+	GrB_Matrix_ncols(&ncols, op->M);
+	if(ncols == required_dim) return;
+
+	GxB_Matrix_resize(op->M, op->recordsCap, required_dim);
+	GxB_Matrix_resize(op->F, op->recordsCap, required_dim);
+	if(op->E) GxB_Matrix_resize(op->E, op->recordsCap, required_dim);
+}
+
+/* Doubles the batch size once child operations filled the previous batch,
+ * such that the fixed cost of evaluating the expression is amortized over
+ * more records, growth is bounded by the observed fan-out,
+ * keeping the expected number of entries in M within COND_TRAVERSE_MAX_BATCH_TUPLES. */
+static void _CondTraverse_GrowBatch(CondTraverse *op) {
+	if(op->recordsLen < op->recordsCap || op->recordsCap >= op->recordsMax) return;
+
+	int cap = MIN(op->recordsCap * 2, op->recordsMax);
+	double fanout = (double)op->produced / op->recordsLen;
+	if(fanout * cap > COND_TRAVERSE_MAX_BATCH_TUPLES) {
+		cap = MAX(op->recordsCap, (int)(COND_TRAVERSE_MAX_BATCH_TUPLES / fanout));
+	}
+	if(cap > op->recordsCap) _CondTraverse_SetBatchCap(op, cap);
 }
 
 int CondTraverseToString(const OpBase *ctx, char *buff, uint buff_len) {
@@ -92,12 +244,14 @@ int CondTraverseToString(const OpBase *ctx, char *buff, uint buff_len) {
 }
 
 OpBase *NewCondTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpression *ae,
-						  uint records_cap) {
+						  uint records_cap, uint records_max) {
 	CondTraverse *traverse = calloc(1, sizeof(CondTraverse));
 	traverse->graph = g;
 	traverse->ae = ae;
 	traverse->edgeRelationTypes = NULL;
 	traverse->F = NULL;
+	traverse->E = NULL;
+	traverse->edgeDesc = NULL;
 	traverse->iter = NULL;
 	traverse->edges = NULL;
 	traverse->r = NULL;
@@ -108,12 +262,29 @@ OpBase *NewCondTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpression *
 	traverse->edgeRecIdx = IDENTIFIER_NOT_FOUND;
 
 	traverse->recordsLen = 0;
+	traverse->produced = 0;
 	traverse->transposed_edge = false;
-	traverse->recordsCap = records_cap;
-	traverse->records = rm_calloc(traverse->recordsCap, sizeof(Record));
+	traverse->recordsCap = 0;
+	traverse->recordsInit = records_cap;
+	// Batches never grow beyond the number of records required by a LIMIT.
+	traverse->recordsMax = MAX(records_cap, MIN(records_max, COND_TRAVERSE_MAX_BATCH_SIZE));
+	traverse->records = NULL;
+	traverse->rows = NULL;
+	traverse->cols = NULL;
+	traverse->vals = NULL;
+	traverse->relationIdx = 0;
+	traverse->relation = GRAPH_NO_RELATION;
+	traverse->edgeTupleIdx = 0;
+	traverse->edgeTupleCount = 0;
+	traverse->edgeTupleCap = 0;
+	traverse->edgeRows = NULL;
+	traverse->edgeCols = NULL;
+	traverse->edgeEntries = NULL;
 	size_t required_dim = Graph_RequiredMatrixDim(g);
-	GrB_Matrix_new(&traverse->M, GrB_BOOL, traverse->recordsCap, required_dim);
-	GrB_Matrix_new(&traverse->F, GrB_BOOL, traverse->recordsCap, required_dim);
+	GrB_Matrix_new(&traverse->M, GrB_BOOL, records_cap, required_dim);
+	GrB_Matrix_new(&traverse->F, GrB_BOOL, records_cap, required_dim);
+	if(ae->edge) GrB_Matrix_new(&traverse->E, GrB_UINT64, records_cap, required_dim);
+	_CondTraverse_SetBatchCap(traverse, records_cap);
 
 	// Set our Op operations
 	OpBase_Init(&traverse->op);
@@ -124,6 +295,7 @@ OpBase *NewCondTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpression *
 	traverse->op.reset = CondTraverseReset;
 	traverse->op.toString = CondTraverseToString;
 	traverse->op.free = CondTraverseFree;
+	traverse->op.clone = CondTraverseClone;
 	traverse->op.modifies = array_new(uint, 1);
 	traverse->op.modifies = array_append(traverse->op.modifies, traverse->destNodeIdx);
 
@@ -141,12 +313,21 @@ OpResult CondTraverseInit(OpBase *opBase) {
 	CondTraverse *op = (CondTraverse *)opBase;
 	AlgebraicExpression *exp = op->ae;
 
+	_CondTraverse_ConformDim(op);
+
 	// Nothing needs to be done if we're not populating an edge.
 	if(exp->edge == NULL) return OP_OK;
 	// If this operation traverses a transposed edge, the source and destination nodes
 	// will be swapped in the Record.
 	op->transposed_edge = _expressionContainsTranspose(exp);
 
+	/* Relation maps are only maintained in their original orientation,
+	 * E[i, dest] = map[dest, src] is computed as a masked dot product of F and map rows. */
+	if(op->transposed_edge && !op->edgeDesc) {
+		GrB_Descriptor_new(&op->edgeDesc);
+		GrB_Descriptor_set(op->edgeDesc, GrB_INP1, GrB_TRAN);
+	}
+
 	return OP_OK;
 }
 
@@ -166,38 +347,45 @@ Record CondTraverseConsume(OpBase *opBase) {
 		}
 	}
 
-	bool depleted = true;
 	NodeID src_id = INVALID_ENTITY_ID;
 	NodeID dest_id = INVALID_ENTITY_ID;
 
-	while(true) {
-		if(op->iter) GxB_MatrixTupleIter_next(op->iter, &src_id, &dest_id, &depleted);
-
-		// Managed to get a tuple, break.
-		if(!depleted) break;
-
+	// Consume current batch, ask for a new one once depleted.
+	while(!_CondTraverse_NextTuple(op, &src_id, &dest_id)) {
 		/* Run out of tuples, try to get new data.
 		 * Free old records. */
 		op->r = NULL;
 		for(int i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+		_CondTraverse_GrowBatch(op);
 
 		// Ask child operations for data.
 		for(op->recordsLen = 0; op->recordsLen < op->recordsCap; op->recordsLen++) {
 			Record childRecord = OpBase_Consume(child);
 			if(!childRecord) break;
 
-			// Store received record.
+			// Store received record, record i starts at its source node.
 			op->records[op->recordsLen] = childRecord;
-			/* Update filter matrix F, set column i at position srcId
-			 * F[srcId, i] = true. */
 			Node *n = Record_GetNode(childRecord, op->srcNodeIdx);
-			NodeID srcId = ENTITY_GET_ID(n);
-			GrB_Matrix_setElement_BOOL(op->F, true, op->recordsLen, srcId);
+			op->cols[op->recordsLen] = ENTITY_GET_ID(n);
 		}
 
 		// No data.
 		if(op->recordsLen == 0) return NULL;
 
+		/* Build filter matrix F at once, F[i, srcId] = true,
+		 * rather than accumulating pending entries one by one. */
+		_CondTraverse_ConformDim(op);
+		GrB_Matrix_clear(op->F);
+		GrB_Info res = GrB_Matrix_build_BOOL(op->F, op->rows, op->cols, op->vals, op->recordsLen,
+											 GrB_LOR);
+		if(res != GrB_SUCCESS) {
+			char *error;
+			asprintf(&error, "Conditional Traverse failed to build filter matrix: %s", GrB_error());
+			QueryCtx_SetError(error);
+			QueryCtx_RaiseRuntimeException();
+			return NULL;
+		}
+
 		_traverse(op);
 	}
 
@@ -206,45 +394,41 @@ Record CondTraverseConsume(OpBase *opBase) {
 	Node *destNode = Record_GetNode(op->r, op->destNodeIdx);
 	Graph_GetNode(op->graph, dest_id, destNode);
 
-	if(op->ae->edge) {
-		// We're guarantee to have at least one edge.
-		Node *srcNode;
-		Node *destNode;
-
-		if(op->transposed_edge) {
-			srcNode = Record_GetNode(op->r, op->destNodeIdx);
-			destNode = Record_GetNode(op->r, op->srcNodeIdx);
-		} else {
-			srcNode = Record_GetNode(op->r, op->srcNodeIdx);
-			destNode = Record_GetNode(op->r, op->destNodeIdx);
-		}
-
-		for(int i = 0; i < op->edgeRelationCount; i++) {
-			Graph_GetEdgesConnectingNodes(op->graph,
-										  ENTITY_GET_ID(srcNode),
-										  ENTITY_GET_ID(destNode),
-										  op->edgeRelationTypes[i],
-										  &op->edges);
-		}
-
-		_CondTraverse_SetEdge(op, op->r);
-	}
+	// We're guarantee to have at least one edge.
+	if(op->ae->edge) _CondTraverse_SetEdge(op, op->r);
 
 	return Record_Clone(op->r);
 }
 
 OpResult CondTraverseReset(OpBase *ctx) {
 	CondTraverse *op = (CondTraverse *)ctx;
-	if(op->r) Record_Free(op->r);
+	// Current record is one of the buffered records.
+	op->r = NULL;
+	for(int i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+	op->recordsLen = 0;
+	op->produced = 0;
+	op->relationIdx = 0;
+	op->edgeTupleIdx = 0;
+	op->edgeTupleCount = 0;
 	if(op->edges) array_clear(op->edges);
 	if(op->iter) {
 		GxB_MatrixTupleIter_free(op->iter);
 		op->iter = NULL;
 	}
 	if(op->F) GrB_Matrix_clear(op->F);
+	// Restart from the initial batch size, batches grow again as records are consumed.
+	if(op->recordsCap != op->recordsInit) _CondTraverse_SetBatchCap(op, op->recordsInit);
 	return OP_OK;
 }
 
+/* Creates an uninitialized copy of CondTraverse. */
+OpBase *CondTraverseClone(const OpBase *opBase) {
+	const CondTraverse *op = (const CondTraverse *)opBase;
+	// Clone shares operand matrices with the original expression.
+	AlgebraicExpression *ae = AlgebraicExpression_Clone(op->ae);
+	return NewCondTraverseOp(op->graph, op->op.record_map, ae, op->recordsInit, op->recordsMax);
+}
+
 /* Frees CondTraverse */
 void CondTraverseFree(OpBase *ctx) {
 	CondTraverse *op = (CondTraverse *)ctx;
@@ -263,6 +447,16 @@ void CondTraverseFree(OpBase *ctx) {
 		op->M = NULL;
 	}
 
+	if(op->E) {
+		GrB_Matrix_free(&op->E);
+		op->E = NULL;
+	}
+
+	if(op->edgeDesc) {
+		GrB_Descriptor_free(&op->edgeDesc);
+		op->edgeDesc = NULL;
+	}
+
 	if(op->edges) {
 		array_free(op->edges);
 		op->edges = NULL;
@@ -283,4 +477,34 @@ void CondTraverseFree(OpBase *ctx) {
 		rm_free(op->records);
 		op->records = NULL;
 	}
+
+	if(op->rows) {
+		rm_free(op->rows);
+		op->rows = NULL;
+	}
+
+	if(op->cols) {
+		rm_free(op->cols);
+		op->cols = NULL;
+	}
+
+	if(op->vals) {
+		rm_free(op->vals);
+		op->vals = NULL;
+	}
+
+	if(op->edgeRows) {
+		rm_free(op->edgeRows);
+		op->edgeRows = NULL;
+	}
+
+	if(op->edgeCols) {
+		rm_free(op->edgeCols);
+		op->edgeCols = NULL;
+	}
+
+	if(op->edgeEntries) {
+		rm_free(op->edgeEntries);
+		op->edgeEntries = NULL;
+	}
 }
@@ -12,6 +12,11 @@
 #include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
 #include "../../util/vector.h"
 
+// Maximum number of records processed by a single batch.
+#define COND_TRAVERSE_MAX_BATCH_SIZE 1024
+// Maximum number of (record, destination) pairs a batch is expected to produce, bounds batch growth.
+#define COND_TRAVERSE_MAX_BATCH_TUPLES 65536
+
 /* OP Traverse */
 typedef struct {
 	OpBase op;
@@ -23,19 +28,37 @@ typedef struct {
 	int edgeRelationCount;      // length of edgeRelationTypes.
 	GrB_Matrix F;               // Filter matrix.
 	GrB_Matrix M;               // Algebraic expression result.
+	GrB_Matrix E;               // Relation map entries of traversed edges, E<M> = F min.second map.
+	GrB_Descriptor edgeDesc;    // Transposes relation map when traversing a transposed edge.
+	int relationIdx;            // Index of next relation type to collect edges of.
+	int relation;               // Relation type of collected edges.
+	GrB_Index edgeTupleIdx;     // Next entry of E to consume.
+	GrB_Index edgeTupleCount;   // Number of entries in E.
+	GrB_Index edgeTupleCap;     // Capacity of edge tuple buffers.
+	GrB_Index *edgeRows;        // Row indices of E's entries, records.
+	GrB_Index *edgeCols;        // Column indices of E's entries, destination node IDs.
+	uint64_t *edgeEntries;      // Values of E's entries, relation map entries.
 	Edge *edges;                // Discovered edges.
 	GxB_MatrixTupleIter *iter;  // Iterator over M.
 	int edgeRecIdx;             // Index into record.
+	int recordsInit;            // Initial number of records to process, recordsCap is reset to.
 	int recordsCap;             // Max number of records to process.
+	int recordsMax;             // Max number of records to process recordsCap may grow to.
 	int recordsLen;             // Number of records to process.
+	GrB_Index *rows;            // Row indices of F's entries, 0 to recordsCap - 1.
+	GrB_Index *cols;            // Column indices of F's entries, source node IDs.
+	bool *vals;                 // Values of F's entries.
+	GrB_Index produced;         // Number of entries in M produced by the last batch.
 	bool transposed_edge;       // Track whether the expression references a transposed edge.
 	Record *records;            // Array of records.
 	Record r;                   // Current selected record.
 } CondTraverse;
 
-/* Creates a new Traverse operation */
+/* Creates a new Traverse operation, processing batches of records_cap records,
+ * batches grow as long as child operations fill them, up to records_max records,
+ * e.g. a LIMIT. */
 OpBase *NewCondTraverseOp(Graph *g, RecordMap *record_map, AlgebraicExpression *ae,
-						  uint records_cap);
+						  uint records_cap, uint records_max);
 
 /* One-time setup of Traverse operation. */
 OpResult CondTraverseInit(OpBase *opBase);
@@ -48,6 +71,10 @@ Record CondTraverseConsume(OpBase *opBase);
 /* Restart iterator */
 OpResult CondTraverseReset(OpBase *ctx);
 
+/* Creates an uninitialized copy of Traverse,
+ * must be called before the original operation evaluated its expression. */
+OpBase *CondTraverseClone(const OpBase *opBase);
+
 /* Frees Traverse*/
 void CondTraverseFree(OpBase *ctx);
 
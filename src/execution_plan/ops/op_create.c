@@ -177,6 +177,7 @@ static void _CommitNodes(OpCreate *op) {
 
 		if(op->node_properties[i]) _AddProperties(op, (GraphEntity *)n, op->node_properties[i]);
 
+		if(s) SchemaStats_AddEntity(s->stats, (GraphEntity *)n);
 		if(s && Schema_HasIndices(s)) Schema_AddNodeToIndices(s, n, false);
 	}
 }
@@ -231,6 +232,7 @@ static void _CommitEdges(OpCreate *op) {
 		relationships_created++;
 
 		if(op->edge_properties[i]) _AddProperties(op, (GraphEntity *)e, op->edge_properties[i]);
+		SchemaStats_AddEntity(schema->stats, (GraphEntity *)e);
 	}
 
 	op->stats->relationships_created += relationships_created;
@@ -10,6 +10,11 @@
 #include "../../arithmetic/arithmetic_expression.h"
 #include <assert.h>
 
+// Removes a deleted edge from its relationship's statistics.
+static void _EdgeDeleted(const Edge *e, void *gc) {
+	GraphContext_DeleteEdgeFromStatistics((GraphContext *)gc, (Edge *)e);
+}
+
 void _DeleteEntities(OpDelete *op) {
 	Graph *g = op->gc->g;
 	uint node_deleted = 0;
@@ -30,8 +35,14 @@ void _DeleteEntities(OpDelete *op) {
 		}
 	}
 
+	for(int i = 0; i < node_count; i++) {
+		Node *n = op->deleted_nodes + i;
+		GraphContext_DeleteNodeFromStatistics(op->gc, n);
+	}
+
+	// Edges are removed from statistics as they're deleted, including edges of deleted nodes.
 	Graph_BulkDelete(g, op->deleted_nodes, node_count, op->deleted_edges,
-					 edge_count, &node_deleted, &relationships_deleted);
+					 edge_count, &node_deleted, &relationships_deleted, _EdgeDeleted, op->gc);
 
 	/* Release lock. */
 	Graph_ReleaseLock(g);
@@ -7,10 +7,293 @@
 #include "op_distinct.h"
 #include "xxhash.h"
 #include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../util/rmalloc.h"
+#include "../../datatypes/array.h"
+#include <assert.h>
+
+// Initial number of hash table slots.
+#define DISTINCT_INITIAL_SLOTS 64
+
+static void _Write(OpDistinct *op, const void *data, uint64_t len) {
+	if(op->buf_len + len > op->buf_cap) {
+		while(op->buf_len + len > op->buf_cap) op->buf_cap *= 2;
+		op->buf = rm_realloc(op->buf, op->buf_cap);
+	}
+	memcpy(op->buf + op->buf_len, data, len);
+	op->buf_len += len;
+}
+
+/* Serialize value, each value is tagged with its type.
+ * Integral doubles are written as integers, such that values which compare
+ * as equal share a representation.
+ * Returns false if value, or one of its elements, is of an unsupported type,
+ * which is reported through unsupported. */
+static bool _SerializeValue(OpDistinct *op, SIValue v, SIType *unsupported) {
+	SIType t = v.type;
+	// Range check precedes the conversion, which is undefined for NaN and out of range values.
+	if(t == T_DOUBLE && v.doubleval >= -0x1p63 && v.doubleval < 0x1p63 &&
+	   v.doubleval == (double)(int64_t)v.doubleval) {
+		v = SI_LongVal((int64_t)v.doubleval);
+		t = T_INT64;
+	}
+	_Write(op, &t, sizeof(t));
+
+	switch(t) {
+	case T_NULL:
+		break;
+	case T_INT64:
+	case T_BOOL:
+		_Write(op, &v.longval, sizeof(v.longval));
+		break;
+	case T_DOUBLE:
+		_Write(op, &v.doubleval, sizeof(v.doubleval));
+		break;
+	case T_STRING: {
+		uint32_t len = strlen(v.stringval);
+		_Write(op, &len, sizeof(len));
+		_Write(op, v.stringval, len);
+		break;
+	}
+	case T_NODE:
+	case T_EDGE: {
+		EntityID id = ENTITY_GET_ID((GraphEntity *)v.ptrval);
+		_Write(op, &id, sizeof(id));
+		break;
+	}
+	case T_ARRAY: {
+		uint32_t len = SIArray_Length(v);
+		_Write(op, &len, sizeof(len));
+		for(uint32_t i = 0; i < len; i++) {
+			if(!_SerializeValue(op, SIArray_Get(v, i), unsupported)) return false;
+		}
+		break;
+	}
+	case T_PTR:
+		_Write(op, &v.ptrval, sizeof(v.ptrval));
+		break;
+	default:
+		*unsupported = t;
+		return false;
+	}
+	return true;
+}
+
+// Serialize record into op's buffer, returns false if record holds an unsupported value.
+static bool _SerializeRecord(OpDistinct *op, const Record r, SIType *unsupported) {
+	op->buf_len = 0;
+	uint rec_len = Record_length(r);
+	for(uint i = 0; i < rec_len; i++) {
+		switch(Record_GetType(r, i)) {
+		case REC_TYPE_NODE:
+		case REC_TYPE_EDGE: {
+			// Entities share their scalar form's representation.
+			SIType t = (Record_GetType(r, i) == REC_TYPE_NODE) ? T_NODE : T_EDGE;
+			EntityID id = ENTITY_GET_ID(Record_GetGraphEntity(r, i));
+			_Write(op, &t, sizeof(t));
+			_Write(op, &id, sizeof(id));
+			break;
+		}
+		case REC_TYPE_SCALAR:
+			if(!_SerializeValue(op, Record_GetScalar(r, i), unsupported)) return false;
+			break;
+		default:
+			assert(false);
+		}
+	}
+	return true;
+}
+
+// Tests if the key stored at offset equals the serialized record.
+static inline bool _KeyEquals(const OpDistinct *op, uint64_t offset) {
+	uint32_t len;
+	memcpy(&len, op->keys + offset, sizeof(len));
+	return len == op->buf_len && memcmp(op->keys + offset + sizeof(len), op->buf, len) == 0;
+}
+
+// Copy serialized record into the keys buffer, returns its offset.
+static uint64_t _StoreKey(OpDistinct *op) {
+	uint32_t len = op->buf_len;
+	uint64_t required = op->keys_len + sizeof(len) + len;
+	if(required > op->keys_cap) {
+		while(required > op->keys_cap) op->keys_cap *= 2;
+		op->keys = rm_realloc(op->keys, op->keys_cap);
+	}
+	uint64_t offset = op->keys_len;
+	memcpy(op->keys + offset, &len, sizeof(len));
+	memcpy(op->keys + offset + sizeof(len), op->buf, len);
+	op->keys_len = required;
+	return offset;
+}
+
+static void _AllocSlots(OpDistinct *op, uint64_t slot_count) {
+	op->mask = slot_count - 1;
+	op->slots = rm_malloc(sizeof(DistinctEntry) * slot_count);
+	for(uint64_t i = 0; i < slot_count; i++) op->slots[i].offset = DISTINCT_EMPTY;
+}
+
+// Double the number of hash table slots.
+static void _Grow(OpDistinct *op) {
+	DistinctEntry *old_slots = op->slots;
+	uint64_t old_slot_count = op->mask + 1;
+	_AllocSlots(op, old_slot_count * 2);
+
+	for(uint64_t i = 0; i < old_slot_count; i++) {
+		if(old_slots[i].offset == DISTINCT_EMPTY) continue;
+		uint64_t pos = old_slots[i].hash & op->mask;
+		while(op->slots[pos].offset != DISTINCT_EMPTY) pos = (pos + 1) & op->mask;
+		op->slots[pos] = old_slots[i];
+	}
+	rm_free(old_slots);
+}
+
+static int _FingerprintCmp(const void *a, const void *b) {
+	uint64_t ha = ((const DistinctFingerprint *)a)->hash;
+	uint64_t hb = ((const DistinctFingerprint *)b)->hash;
+	return (ha > hb) - (ha < hb);
+}
+
+// Merge two sorted runs into a new run, both inputs are freed.
+static DistinctFingerprint *_MergeRuns(DistinctFingerprint *a, DistinctFingerprint *b) {
+	uint32_t a_len = array_len(a);
+	uint32_t b_len = array_len(b);
+	DistinctFingerprint *merged = array_new(DistinctFingerprint, a_len + b_len);
+
+	uint32_t i = 0;
+	uint32_t j = 0;
+	while(i < a_len && j < b_len) {
+		if(a[i].hash <= b[j].hash) merged = array_append(merged, a[i++]);
+		else merged = array_append(merged, b[j++]);
+	}
+	while(i < a_len) merged = array_append(merged, a[i++]);
+	while(j < b_len) merged = array_append(merged, b[j++]);
+
+	array_free(a);
+	array_free(b);
+	return merged;
+}
+
+// Hash key stored at offset with the check seed.
+static inline uint64_t _KeyCheck(const OpDistinct *op, uint64_t offset) {
+	uint32_t len;
+	memcpy(&len, op->keys + offset, sizeof(len));
+	return XXH64(op->keys + offset + sizeof(len), len, DISTINCT_CHECK_SEED);
+}
+
+/* Move hash table's keys into a sorted run of fingerprints and drop the keys,
+ * such that memory held per spilled key is fixed regardless of its size.
+ * Runs of similar size are merged to keep their number logarithmic in the number of keys. */
+static void _Spill(OpDistinct *op) {
+	DistinctFingerprint *run = array_new(DistinctFingerprint, op->count);
+	for(uint64_t i = 0; i <= op->mask; i++) {
+		if(op->slots[i].offset == DISTINCT_EMPTY) continue;
+		DistinctFingerprint f = { .hash = op->slots[i].hash, .check = _KeyCheck(op, op->slots[i].offset) };
+		run = array_append(run, f);
+		op->slots[i].offset = DISTINCT_EMPTY;
+	}
+	op->count = 0;
+	op->keys_len = 0;
+	qsort(run, array_len(run), sizeof(DistinctFingerprint), _FingerprintCmp);
+	op->runs = array_append(op->runs, run);
+
+	uint run_count = array_len(op->runs);
+	while(run_count > 1 && array_len(op->runs[run_count - 2]) <= 2 * array_len(op->runs[run_count - 1])) {
+		DistinctFingerprint *b = array_pop(op->runs);
+		DistinctFingerprint *a = array_pop(op->runs);
+		op->runs = array_append(op->runs, _MergeRuns(a, b));
+		run_count--;
+	}
+}
+
+/* Search sorted runs for the serialized record, spilled keys are matched by
+ * both of their hashes, a false match requires a 128 bit collision. */
+static bool _RunsContain(const OpDistinct *op, uint64_t hash) {
+	bool check_computed = false;
+	uint64_t check = 0;
+	uint run_count = array_len(op->runs);
+	for(uint i = 0; i < run_count; i++) {
+		DistinctFingerprint *run = op->runs[i];
+		uint32_t run_len = array_len(run);
+		// Locate first entry with given hash.
+		uint32_t lo = 0;
+		uint32_t hi = run_len;
+		while(lo < hi) {
+			uint32_t mid = lo + (hi - lo) / 2;
+			if(run[mid].hash < hash) lo = mid + 1;
+			else hi = mid;
+		}
+		// Entries sharing a hash might still differ.
+		for(uint32_t j = lo; j < run_len && run[j].hash == hash; j++) {
+			if(!check_computed) {
+				check = XXH64(op->buf, op->buf_len, DISTINCT_CHECK_SEED);
+				check_computed = true;
+			}
+			if(run[j].check == check) return true;
+		}
+	}
+	return false;
+}
+
+/* Insert the serialized record into the set,
+ * returns false if it was already a member. */
+static bool _Insert(OpDistinct *op) {
+	uint64_t hash = XXH64(op->buf, op->buf_len, 0);
+
+	uint64_t pos = hash & op->mask;
+	while(op->slots[pos].offset != DISTINCT_EMPTY) {
+		if(op->slots[pos].hash == hash && _KeyEquals(op, op->slots[pos].offset)) return false;
+		pos = (pos + 1) & op->mask;
+	}
+	if(_RunsContain(op, hash)) return false;
+
+	op->slots[pos].hash = hash;
+	op->slots[pos].offset = _StoreKey(op);
+	op->count++;
+
+	// Keep table at most half full, spill it once it holds DISTINCT_TABLE_CAP keys.
+	if(op->count >= DISTINCT_TABLE_CAP) _Spill(op);
+	else if(op->count * 2 > op->mask + 1) _Grow(op);
+	return true;
+}
+
+/* Sorted input, record is new if it differs from the previous one,
+ * which is kept in the keys buffer. */
+static bool _DiffersFromPrevious(OpDistinct *op) {
+	if(op->keys_len == op->buf_len && memcmp(op->keys, op->buf, op->buf_len) == 0) return false;
+
+	// Swap buffers, current record becomes the previous one.
+	char *tmp = op->keys;
+	uint64_t tmp_cap = op->keys_cap;
+	op->keys = op->buf;
+	op->keys_cap = op->buf_cap;
+	op->keys_len = op->buf_len;
+	op->buf = tmp;
+	op->buf_cap = tmp_cap;
+	return true;
+}
+
+static void _ClearSet(OpDistinct *op) {
+	for(uint64_t i = 0; i <= op->mask; i++) op->slots[i].offset = DISTINCT_EMPTY;
+	op->count = 0;
+	op->keys_len = 0;
+
+	uint run_count = array_len(op->runs);
+	for(uint i = 0; i < run_count; i++) array_free(op->runs[i]);
+	array_clear(op->runs);
+}
 
 OpBase *NewDistinctOp(void) {
 	OpDistinct *self = malloc(sizeof(OpDistinct));
-	self->found = raxNew();
+	self->sorted = false;
+	self->buf_len = 0;
+	self->buf_cap = 64;
+	self->buf = rm_malloc(self->buf_cap);
+	self->keys_len = 0;
+	self->keys_cap = 1024;
+	self->keys = rm_malloc(self->keys_cap);
+	self->count = 0;
+	self->runs = array_new(DistinctFingerprint *, 0);
+	_AllocSlots(self, DISTINCT_INITIAL_SLOTS);
 
 	OpBase_Init(&self->op);
 	self->op.name = "Distinct";
@@ -22,6 +305,11 @@ OpBase *NewDistinctOp(void) {
 	return (OpBase *)self;
 }
 
+void DistinctOp_SetSortedInput(OpDistinct *op) {
+	op->sorted = true;
+	op->op.name = "Sorted Distinct";
+}
+
 Record DistinctConsume(OpBase *opBase) {
 	OpDistinct *self = (OpDistinct *)opBase;
 	OpBase *child = self->op.children[0];
@@ -30,21 +318,49 @@ Record DistinctConsume(OpBase *opBase) {
 		Record r = OpBase_Consume(child);
 		if(!r) return NULL;
 
-		unsigned long long const hash = Record_Hash64(r);
-		int is_new = raxInsert(self->found, (unsigned char *) &hash, sizeof(hash), NULL, NULL);
+		SIType unsupported;
+		if(!_SerializeRecord(self, r, &unsupported)) {
+			Record_Free(r);
+			char *error;
+			asprintf(&error, "DISTINCT is not supported for values of type %s", SIType_ToString(unsupported));
+			QueryCtx_SetError(error);
+			QueryCtx_RaiseRuntimeException();
+			return NULL;
+		}
+
+		bool is_new = (self->sorted) ? _DiffersFromPrevious(self) : _Insert(self);
 		if(is_new) return r;
 		Record_Free(r);
 	}
 }
 
 OpResult DistinctReset(OpBase *ctx) {
+	OpDistinct *op = (OpDistinct *)ctx;
+	// Forget previously emitted records.
+	_ClearSet(op);
 	return OP_OK;
 }
 
 void DistinctFree(OpBase *ctx) {
 	OpDistinct *op = (OpDistinct *)ctx;
-	if(op->found) {
-		raxFree(op->found);
-		op->found = NULL;
+	if(op->runs) {
+		_ClearSet(op);
+		array_free(op->runs);
+		op->runs = NULL;
+	}
+
+	if(op->slots) {
+		rm_free(op->slots);
+		op->slots = NULL;
+	}
+
+	if(op->keys) {
+		rm_free(op->keys);
+		op->keys = NULL;
+	}
+
+	if(op->buf) {
+		rm_free(op->buf);
+		op->buf = NULL;
 	}
 }
@@ -7,14 +7,49 @@
 #pragma once
 
 #include "op.h"
-#include "rax.h"
+
+// Maximum number of keys held by the hash table before it is spilled into a sorted run.
+#define DISTINCT_TABLE_CAP 65536
+// Marks an empty hash table slot.
+#define DISTINCT_EMPTY UINT64_MAX
+// Seed of the second hash identifying spilled keys.
+#define DISTINCT_CHECK_SEED 0x9E3779B97F4A7C15ULL
+
+/* A previously emitted record's key, records are identified by their
+ * serialized values, which are stored in the keys buffer. */
+typedef struct {
+	uint64_t hash;          // Hash of serialized key.
+	uint64_t offset;        // Position of key within keys buffer, DISTINCT_EMPTY if slot is empty.
+} DistinctEntry;
+
+/* A spilled key, identified by two independent 64 bit hashes of its serialization,
+ * spilled keys are no longer held in memory and can't be compared byte by byte. */
+typedef struct {
+	uint64_t hash;          // Hash of serialized key.
+	uint64_t check;         // Hash of serialized key, seeded by DISTINCT_CHECK_SEED.
+} DistinctFingerprint;
 
 typedef struct {
 	OpBase op;
-	rax *found;
+	bool sorted;                // Input is sorted on all of its values, duplicates are adjacent.
+	char *buf;                  // Current record's serialized key.
+	uint64_t buf_len;
+	uint64_t buf_cap;
+	char *keys;                 // Serialized keys held by hash table, each prefixed by its length.
+	uint64_t keys_len;
+	uint64_t keys_cap;
+	DistinctEntry *slots;       // Open addressing hash table.
+	uint64_t mask;              // Number of slots - 1.
+	uint64_t count;             // Number of keys in hash table.
+	DistinctFingerprint **runs; // Sorted runs spilled from the hash table, ordered by hash.
 } OpDistinct;
 
 OpBase *NewDistinctOp(void);
+
+/* Distinct is told its input is sorted on every projected value,
+ * in which case only the previous record is remembered. */
+void DistinctOp_SetSortedInput(OpDistinct *op);
+
 Record DistinctConsume(OpBase *opBase);
 OpResult DistinctReset(OpBase *ctx);
 void DistinctFree(OpBase *ctx);
@@ -121,8 +121,14 @@ OpResult ExpandIntoInit(OpBase *opBase) {
 	OpExpandInto *op = (OpExpandInto *)opBase;
 
 	size_t required_dim = Graph_RequiredMatrixDim(op->graph);
-	GrB_Matrix_new(&op->M, GrB_BOOL, op->recordsCap, required_dim);
-	GrB_Matrix_new(&op->F, GrB_BOOL, op->recordsCap, required_dim);
+	if(op->M == NULL) {
+		GrB_Matrix_new(&op->M, GrB_BOOL, op->recordsCap, required_dim);
+		GrB_Matrix_new(&op->F, GrB_BOOL, op->recordsCap, required_dim);
+	} else {
+		// Re-initialized cached plan, graph might have grown.
+		GxB_Matrix_resize(op->M, op->recordsCap, required_dim);
+		GxB_Matrix_resize(op->F, op->recordsCap, required_dim);
+	}
 	return OP_OK;
 }
 
@@ -196,8 +202,6 @@ Record ExpandIntoConsume(OpBase *opBase) {
 			if(op->records[i]) {
 				Record_Free(op->records[i]);
 				op->records[i] = NULL;
-			} else {
-				break;
 			}
 		}
 
@@ -226,11 +230,15 @@ Record ExpandIntoConsume(OpBase *opBase) {
 
 OpResult ExpandIntoReset(OpBase *ctx) {
 	OpExpandInto *op = (OpExpandInto *)ctx;
-	for(int i = 0; i < op->recordCount; i++) {
-		if(op->records[i]) Record_Free(op->records[i]);
-		op->records = NULL;
+	// Emitted records are NULL-set, free the rest.
+	for(int i = 0; i < op->recordsCap; i++) {
+		if(op->records[i]) {
+			Record_Free(op->records[i]);
+			op->records[i] = NULL;
+		}
 	}
 	op->recordCount = 0;
+	op->r = NULL;
 
 	if(op->F) GrB_Matrix_clear(op->F);
 	if(op->edges) array_clear(op->edges);
@@ -268,7 +276,6 @@ void ExpandIntoFree(OpBase *ctx) {
 	if(op->records) {
 		for(int i = 0; i < op->recordsCap; i++) {
 			if(op->records[i]) Record_Free(op->records[i]);
-			else break;
 		}
 		rm_free(op->records);
 		op->records = NULL;
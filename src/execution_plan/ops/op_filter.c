@@ -9,18 +9,32 @@
 OpBase *NewFilterOp(FT_FilterNode *filterTree) {
 	OpFilter *filter = malloc(sizeof(OpFilter));
 	filter->filterTree = filterTree;
+	filter->program = NULL;
 
 	// Set our Op operations
 	OpBase_Init(&filter->op);
 	filter->op.name = "Filter";
 	filter->op.type = OPType_FILTER;
+	filter->op.init = FilterInit;
 	filter->op.consume = FilterConsume;
+	filter->op.consumeBatch = FilterConsumeBatch;
 	filter->op.reset = FilterReset;
 	filter->op.free = FilterFree;
+	filter->op.clone = FilterClone;
 
 	return (OpBase *)filter;
 }
 
+/* Compile the filter tree once it is final,
+ * optimizations might have modified it since the operation was created. */
+OpResult FilterInit(OpBase *opBase) {
+	OpFilter *filter = (OpFilter *)opBase;
+	// Cached plans are re-initialized on every execution, compile once.
+	if(filter->program) return OP_OK;
+	filter->program = AR_Program_CompileFilter(filter->filterTree);
+	return OP_OK;
+}
+
 /* FilterConsume next operation
  * returns OP_OK when graph passes filter tree. */
 Record FilterConsume(OpBase *opBase) {
@@ -33,21 +47,54 @@ Record FilterConsume(OpBase *opBase) {
 		if(!r) break;
 
 		/* Pass graph through filter tree */
-		if(FilterTree_applyFilters(filter->filterTree, r) == FILTER_PASS) break;
+		if(AR_Program_ApplyFilter(filter->program, r) == FILTER_PASS) break;
 		else Record_Free(r);
 	}
 
 	return r;
 }
 
+/* Narrows down child's batch selection to records passing the filter tree,
+ * returns the first batch with at least one passing record. */
+RecordBatch *FilterConsumeBatch(OpBase *opBase) {
+	RecordBatch *batch;
+	OpFilter *filter = (OpFilter *)opBase;
+	OpBase *child = filter->op.children[0];
+
+	while((batch = OpBase_ConsumeBatch(child))) {
+		uint selected = 0;
+		for(uint i = 0; i < batch->selected; i++) {
+			uint16_t idx = batch->selection[i];
+			if(AR_Program_ApplyFilter(filter->program, batch->records[idx]) == FILTER_PASS) {
+				batch->selection[selected++] = idx;
+			}
+		}
+		batch->selected = selected;
+		if(selected) break;
+	}
+
+	return batch;
+}
+
 /* Restart iterator */
 OpResult FilterReset(OpBase *ctx) {
 	return OP_OK;
 }
 
+/* Creates an uninitialized copy of Filter. */
+OpBase *FilterClone(const OpBase *opBase) {
+	const OpFilter *op = (const OpFilter *)opBase;
+	return NewFilterOp(FilterTree_Clone(op->filterTree));
+}
+
 /* Frees Filter*/
 void FilterFree(OpBase *ctx) {
 	OpFilter *filter = (OpFilter *)ctx;
+	if(filter->program) {
+		AR_Program_Free(filter->program);
+		filter->program = NULL;
+	}
+
 	if(filter->filterTree) {
 		FilterTree_Free(filter->filterTree);
 		filter->filterTree = NULL;
@@ -9,24 +9,34 @@
 
 #include "op.h"
 #include "../../filter_tree/filter_tree.h"
+#include "../../arithmetic/ar_program.h"
 
 /* Filter
  * filters graph according to where cluase */
 typedef struct {
 	OpBase op;
 	FT_FilterNode *filterTree;
+	AR_Program *program;        // Compiled filter tree.
 } OpFilter;
 
 /* Creates a new Filter operation */
 OpBase *NewFilterOp(FT_FilterNode *filterTree);
 
+/* Compiles filter tree. */
+OpResult FilterInit(OpBase *opBase);
+
 /* FilterConsume next operation
  * returns NULL when depleted. */
 Record FilterConsume(OpBase *opBase);
 
+RecordBatch *FilterConsumeBatch(OpBase *opBase);
+
 /* Restart iterator */
 OpResult FilterReset(OpBase *ctx);
 
+/* Creates an uninitialized copy of Filter */
+OpBase *FilterClone(const OpBase *opBase);
+
 /* Frees Filter*/
 void FilterFree(OpBase *ctx);
 
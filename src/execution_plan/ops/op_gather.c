@@ -0,0 +1,364 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_gather.h"
+#include "op_all_node_scan.h"
+#include "op_node_by_label_scan.h"
+#include "../execution_plan.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include "../../util/thpool/thpool.h"
+#include <assert.h>
+#include <pthread.h>
+
+extern threadpool _thpool;
+extern uint query_parallelism;
+
+/* State shared by Gather and its helpers, freed by the last party releasing it. */
+typedef struct GatherState {
+	pthread_mutex_t lock;       // Guards state.
+	pthread_cond_t cond;        // Signaled when a chunk is produced or consumed and when a helper is done.
+	Record **chunks;            // Chunks of records produced by helpers.
+	uint64_t next_morsel;       // Next unclaimed morsel, claimed atomically.
+	uint64_t morsel_count;      // Number of morsels covering the node ID space.
+	uint active;                // Number of helpers processing morsels.
+	uint refcount;              // Number of parties referencing state, Gather and queued helpers.
+	bool cancelled;             // Gather stopped consuming, helpers should quit.
+	char *error;                // First error encountered by a helper.
+	const QueryCtx *query_ctx;  // Query context, valid while helpers are active.
+} GatherState;
+
+/* Work item of a single helper thread. */
+typedef struct {
+	GatherState *state;
+	OpBase *pipeline;           // Helper's private copy of the gathered pipeline.
+	OpBase *scan;               // Scan operation at the bottom of pipeline.
+	Record *chunk;              // Records produced by pipeline, yet to be handed over.
+} GatherTask;
+
+static void _Gather_FreeChunk(Record *chunk, uint from) {
+	uint count = array_len(chunk);
+	for(uint i = from; i < count; i++) Record_Free(chunk[i]);
+	array_free(chunk);
+}
+
+// Returns the scan operation at the bottom of pipeline.
+static OpBase *_Gather_LocateScan(OpBase *pipeline) {
+	OpBase *op = pipeline;
+	while(op->childCount) op = op->children[0];
+	assert(op->type & (OPType_ALL_NODE_SCAN | OPType_NODE_BY_LABEL_SCAN));
+	return op;
+}
+
+static OpBase *_Gather_ClonePipeline(const OpBase *op) {
+	OpBase *clone = OpBase_Clone(op);
+	if(op->childCount) ExecutionPlan_AddOp(clone, _Gather_ClonePipeline(op->children[0]));
+	return clone;
+}
+
+static void _Gather_InitPipeline(OpBase *clone, const OpBase *op) {
+	clone->record_map = op->record_map;
+	if(clone->init) clone->init(clone);
+	clone->op_initialized = true;
+	if(clone->childCount) _Gather_InitPipeline(clone->children[0], op->children[0]);
+}
+
+static void _Gather_FreePipeline(OpBase *op) {
+	for(int i = 0; i < op->childCount; i++) _Gather_FreePipeline(op->children[i]);
+	OpBase_Free(op);
+}
+
+/* Claim the next morsel and restart pipeline over its node IDs,
+ * returns false if all morsels were claimed. */
+static bool _Gather_ClaimMorsel(GatherState *state, OpBase *pipeline, OpBase *scan) {
+	uint64_t morsel = __atomic_fetch_add(&state->next_morsel, 1, __ATOMIC_RELAXED);
+	if(morsel >= state->morsel_count) return false;
+
+	OpBase_PropagateReset(pipeline);
+	NodeID start = morsel * GATHER_MORSEL_SIZE;
+	NodeID end = start + GATHER_MORSEL_SIZE;
+	if(scan->type == OPType_ALL_NODE_SCAN) AllNodeScanSetRange(scan, start, end);
+	else NodeByLabelScanSetRange(scan, start, end);
+	return true;
+}
+
+static void _GatherState_Release(GatherState *state) {
+	pthread_mutex_lock(&state->lock);
+	uint refcount = --state->refcount;
+	pthread_mutex_unlock(&state->lock);
+	if(refcount) return;
+
+	uint chunk_count = array_len(state->chunks);
+	for(uint i = 0; i < chunk_count; i++) _Gather_FreeChunk(state->chunks[i], 0);
+	array_free(state->chunks);
+	if(state->error) free(state->error);
+	pthread_cond_destroy(&state->cond);
+	pthread_mutex_destroy(&state->lock);
+	rm_free(state);
+}
+
+/*--------------------------------------------------------------------------------------
+ * Helper thread
+ *------------------------------------------------------------------------------------*/
+
+/* Hand over chunk to the query thread, blocks while too many chunks are pending,
+ * returns false if Gather was cancelled in which case chunk is freed. */
+static bool _Gather_HandOver(GatherState *state, Record *chunk) {
+	pthread_mutex_lock(&state->lock);
+	while(!state->cancelled && array_len(state->chunks) >= GATHER_MAX_PENDING_CHUNKS) {
+		pthread_cond_wait(&state->cond, &state->lock);
+	}
+	bool cancelled = state->cancelled;
+	if(!cancelled) {
+		state->chunks = array_append(state->chunks, chunk);
+		pthread_cond_broadcast(&state->cond);
+	}
+	pthread_mutex_unlock(&state->lock);
+
+	if(cancelled) _Gather_FreeChunk(chunk, 0);
+	return !cancelled;
+}
+
+static void _Gather_Process(GatherTask *task) {
+	GatherState *state = task->state;
+	task->chunk = array_new(Record, GATHER_CHUNK_SIZE);
+
+	while(_Gather_ClaimMorsel(state, task->pipeline, task->scan)) {
+		Record r;
+		while((r = OpBase_Consume(task->pipeline))) {
+			task->chunk = array_append(task->chunk, r);
+			if(array_len(task->chunk) < GATHER_CHUNK_SIZE) continue;
+
+			Record *chunk = task->chunk;
+			task->chunk = NULL;
+			if(!_Gather_HandOver(state, chunk)) return;
+			task->chunk = array_new(Record, GATHER_CHUNK_SIZE);
+		}
+	}
+
+	Record *chunk = task->chunk;
+	task->chunk = NULL;
+	if(array_len(chunk)) _Gather_HandOver(state, chunk);
+	else array_free(chunk);
+}
+
+static void _Gather_SetError(GatherState *state, char *error) {
+	pthread_mutex_lock(&state->lock);
+	if(!state->error) {
+		state->error = error;
+		error = NULL;
+	}
+	// Other helpers should stop as well.
+	state->cancelled = true;
+	pthread_cond_broadcast(&state->cond);
+	pthread_mutex_unlock(&state->lock);
+
+	if(error) free(error);
+}
+
+static void _Gather_Work(void *arg) {
+	GatherTask *task = arg;
+	GatherState *state = task->state;
+
+	/* Take part only if there are morsels left to process,
+	 * once all morsels are claimed the query thread waits for active helpers only. */
+	pthread_mutex_lock(&state->lock);
+	bool participate = !state->cancelled &&
+					   __atomic_load_n(&state->next_morsel, __ATOMIC_RELAXED) < state->morsel_count;
+	if(participate) state->active++;
+	pthread_mutex_unlock(&state->lock);
+
+	if(participate) {
+		QueryCtx_Inherit(state->query_ctx);
+		if(SET_EXCEPTION_HANDLER() == 0) _Gather_Process(task);
+		else _Gather_SetError(state, QueryCtx_TakeError());
+	}
+
+	// Pipeline refers to the query's execution plan, free it before leaving.
+	if(task->chunk) _Gather_FreeChunk(task->chunk, 0);
+	_Gather_FreePipeline(task->pipeline);
+	rm_free(task);
+
+	if(participate) {
+		// Parameters are owned by the query.
+		QueryCtx_SetParams(NULL);
+		QueryCtx_Free();
+
+		pthread_mutex_lock(&state->lock);
+		state->active--;
+		pthread_cond_broadcast(&state->cond);
+		pthread_mutex_unlock(&state->lock);
+	}
+
+	_GatherState_Release(state);
+}
+
+/*--------------------------------------------------------------------------------------
+ * Query thread
+ *------------------------------------------------------------------------------------*/
+
+// Split node ID space into morsels and dispatch helpers.
+static void _Gather_Start(OpGather *op) {
+	OpBase *pipeline = op->op.children[0];
+	op->scan = _Gather_LocateScan(pipeline);
+
+	Graph *g = QueryCtx_GetGraph();
+	uint64_t id_space = Graph_RequiredMatrixDim(g);
+	uint64_t morsel_count = (id_space + GATHER_MORSEL_SIZE - 1) / GATHER_MORSEL_SIZE;
+
+	// The query thread processes morsels as well.
+	uint helper_count = 0;
+	if(query_parallelism > 1 && morsel_count > 1) {
+		helper_count = query_parallelism - 1;
+		if(helper_count > morsel_count - 1) helper_count = morsel_count - 1;
+	}
+
+	GatherState *state = rm_malloc(sizeof(GatherState));
+	pthread_mutex_init(&state->lock, NULL);
+	pthread_cond_init(&state->cond, NULL);
+	state->chunks = array_new(Record *, helper_count);
+	state->next_morsel = 0;
+	state->morsel_count = morsel_count;
+	state->active = 0;
+	state->refcount = 1;
+	state->cancelled = false;
+	state->error = NULL;
+	state->query_ctx = QueryCtx_GetQueryCtx();
+	op->state = state;
+
+	for(uint i = 0; i < helper_count; i++) {
+		GatherTask *task = rm_malloc(sizeof(GatherTask));
+		task->state = state;
+		task->chunk = NULL;
+		// Pipelines are cloned by the query thread, while the original pipeline is idle.
+		task->pipeline = _Gather_ClonePipeline(pipeline);
+		_Gather_InitPipeline(task->pipeline, pipeline);
+		task->scan = _Gather_LocateScan(task->pipeline);
+
+		pthread_mutex_lock(&state->lock);
+		state->refcount++;
+		pthread_mutex_unlock(&state->lock);
+
+		if(thpool_add_work(_thpool, _Gather_Work, task) != 0) {
+			// Failed to dispatch helper, morsels are processed by the remaining threads.
+			_Gather_FreePipeline(task->pipeline);
+			rm_free(task);
+			_GatherState_Release(state);
+		}
+	}
+}
+
+// Cancel helpers and wait for active ones to quit.
+static void _Gather_Stop(OpGather *op) {
+	GatherState *state = op->state;
+	if(state) {
+		pthread_mutex_lock(&state->lock);
+		state->cancelled = true;
+		pthread_cond_broadcast(&state->cond);
+		while(state->active) pthread_cond_wait(&state->cond, &state->lock);
+		pthread_mutex_unlock(&state->lock);
+
+		_GatherState_Release(state);
+		op->state = NULL;
+	}
+
+	// Free records which weren't handed off.
+	if(op->chunk) {
+		_Gather_FreeChunk(op->chunk, op->chunk_idx);
+		op->chunk = NULL;
+	}
+	op->chunk_idx = 0;
+	op->local_morsel = false;
+}
+
+OpBase *NewGatherOp(void) {
+	OpGather *op = malloc(sizeof(OpGather));
+	op->scan = NULL;
+	op->chunk = NULL;
+	op->chunk_idx = 0;
+	op->local_morsel = false;
+	op->state = NULL;
+
+	// Set our Op operations
+	OpBase_Init(&op->op);
+	op->op.name = "Gather";
+	op->op.type = OPType_GATHER;
+	op->op.consume = GatherConsume;
+	op->op.reset = GatherReset;
+	op->op.free = GatherFree;
+
+	return (OpBase *)op;
+}
+
+Record GatherConsume(OpBase *opBase) {
+	OpGather *op = (OpGather *)opBase;
+	OpBase *pipeline = op->op.children[0];
+
+	if(!op->state) _Gather_Start(op);
+	GatherState *state = op->state;
+
+	while(true) {
+		// Hand off records produced by helpers.
+		if(op->chunk) {
+			if(op->chunk_idx < array_len(op->chunk)) return op->chunk[op->chunk_idx++];
+			array_free(op->chunk);
+			op->chunk = NULL;
+		}
+
+		// Continue processing local morsel.
+		if(op->local_morsel) {
+			Record r = OpBase_Consume(pipeline);
+			if(r) return r;
+			op->local_morsel = false;
+		}
+
+		pthread_mutex_lock(&state->lock);
+		if(state->error) {
+			// Report helper's error as if it was encountered by this thread.
+			char *error = state->error;
+			state->error = NULL;
+			pthread_mutex_unlock(&state->lock);
+			QueryCtx_SetError(error);
+			QueryCtx_RaiseRuntimeException();
+			return NULL;
+		}
+		if(array_len(state->chunks)) {
+			op->chunk = array_pop(state->chunks);
+			op->chunk_idx = 0;
+			// Wake helpers waiting for room.
+			pthread_cond_broadcast(&state->cond);
+			pthread_mutex_unlock(&state->lock);
+			continue;
+		}
+		pthread_mutex_unlock(&state->lock);
+
+		// Process next morsel locally.
+		if(_Gather_ClaimMorsel(state, pipeline, op->scan)) {
+			op->local_morsel = true;
+			continue;
+		}
+
+		// All morsels were claimed, wait for helpers.
+		pthread_mutex_lock(&state->lock);
+		while(state->active && !array_len(state->chunks) && !state->error) {
+			pthread_cond_wait(&state->cond, &state->lock);
+		}
+		bool depleted = !state->active && !array_len(state->chunks) && !state->error;
+		pthread_mutex_unlock(&state->lock);
+		if(depleted) return NULL;
+	}
+}
+
+OpResult GatherReset(OpBase *opBase) {
+	_Gather_Stop((OpGather *)opBase);
+	return OP_OK;
+}
+
+void GatherFree(OpBase *opBase) {
+	_Gather_Stop((OpGather *)opBase);
+}
+
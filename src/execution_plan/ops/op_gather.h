@@ -0,0 +1,41 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "op.h"
+
+// Number of node IDs scanned by a single morsel.
+#define GATHER_MORSEL_SIZE 16384
+// Number of records handed over from a helper thread at once.
+#define GATHER_CHUNK_SIZE 512
+// Maximum number of chunks awaiting consumption before helpers are throttled.
+#define GATHER_MAX_PENDING_CHUNKS 64
+
+struct GatherState;
+
+/* Gather splits the node ID space scanned by its child pipeline into morsels,
+ * which are processed by the query thread and by helper threads of the thread pool.
+ * Each helper executes a private copy of the pipeline, the records it produces
+ * are handed over to the query thread, which passes them on to Gather's parent.
+ * The pipeline must be a chain of clonable operations ending with a node scan. */
+typedef struct {
+	OpBase op;
+	OpBase *scan;               // Scan operation at the bottom of the gathered pipeline.
+	Record *chunk;              // Chunk of records produced by a helper, being handed off.
+	uint chunk_idx;             // Position of the next record to hand off within chunk.
+	bool local_morsel;          // Pipeline is processing a morsel claimed by the query thread.
+	struct GatherState *state;  // State shared with helper threads, created upon first consume.
+} OpGather;
+
+OpBase *NewGatherOp(void);
+
+Record GatherConsume(OpBase *opBase);
+
+OpResult GatherReset(OpBase *opBase);
+
+void GatherFree(OpBase *opBase);
+
@@ -5,6 +5,8 @@
 */
 
 #include "op_index_scan.h"
+#include "../../util/arr.h"
+#include "../../filter_tree/ft_to_rsq.h"
 
 int IndexScanToString(const OpBase *ctx, char *buff, uint buff_len) {
 	const IndexScan *op = (const IndexScan *)ctx;
@@ -13,12 +15,13 @@ int IndexScanToString(const OpBase *ctx, char *buff, uint buff_len) {
 	return offset;
 }
 
-OpBase *NewIndexScanOp(Graph *g, QGNode *n, uint node_idx, RSIndex *idx, RSResultsIterator *iter) {
+OpBase *NewIndexScanOp(Graph *g, QGNode *n, uint node_idx, RSIndex *idx, FT_FilterNode **filters) {
 	IndexScan *indexScan = malloc(sizeof(IndexScan));
 	indexScan->g = g;
 	indexScan->n = n;
 	indexScan->idx = idx;
-	indexScan->iter = iter;
+	indexScan->filters = filters;
+	indexScan->iter = NULL;
 	indexScan->nodeRecIdx = node_idx;
 
 	// Set our Op operations
@@ -38,6 +41,14 @@ OpBase *NewIndexScanOp(Graph *g, QGNode *n, uint node_idx, RSIndex *idx, RSResul
 
 Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
+	/* Filters might refer to query parameters, query the index
+	 * once parameters are known. */
+	if(op->iter == NULL) {
+		RSQNode *root = FilterTree_ToIndexQuery(op->filters, op->idx);
+		// Pass ownership of root to iterator.
+		op->iter = RediSearch_GetResultsIterator(root, op->idx);
+	}
+
 	const EntityID *nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL);
 	if(!nodeId) return NULL;
 
@@ -52,7 +63,12 @@ Record IndexScanConsume(OpBase *opBase) {
 
 OpResult IndexScanReset(OpBase *ctx) {
 	IndexScan *op = (IndexScan *)ctx;
-	RediSearch_ResultsIteratorReset(op->iter);
+	/* Release iterator and with it the index read lock,
+	 * the index is queried again on next consume. */
+	if(op->iter) {
+		RediSearch_ResultsIteratorFree(op->iter);
+		op->iter = NULL;
+	}
 	return OP_OK;
 }
 
@@ -66,4 +82,11 @@ void IndexScanFree(OpBase *ctx) {
 		RediSearch_ResultsIteratorFree(op->iter);
 		op->iter = NULL;
 	}
+
+	if(op->filters) {
+		uint filters_count = array_len(op->filters);
+		for(uint i = 0; i < filters_count; i++) FilterTree_Free(op->filters[i]);
+		array_free(op->filters);
+		op->filters = NULL;
+	}
 }
@@ -10,6 +10,7 @@
 #include "op.h"
 #include "../../graph/graph.h"
 #include "../../index/index.h"
+#include "../../filter_tree/filter_tree.h"
 #include "redisearch_api.h"
 
 typedef struct {
@@ -18,11 +19,12 @@ typedef struct {
 	Graph *g;
 	RSIndex *idx;
 	uint nodeRecIdx;
-	RSResultsIterator *iter;
+	FT_FilterNode **filters;    // Filters resolved by index.
+	RSResultsIterator *iter;    // Index iterator, constructed on first consume.
 } IndexScan;
 
-/* Creates a new IndexScan operation */
-OpBase *NewIndexScanOp(Graph *g, QGNode *n, uint node_idx, RSIndex *idx, RSResultsIterator *iter);
+/* Creates a new IndexScan operation, which takes ownership over filters. */
+OpBase *NewIndexScanOp(Graph *g, QGNode *n, uint node_idx, RSIndex *idx, FT_FilterNode **filters);
 
 /* IndexScan next operation
  * called each time a new node is required */
@@ -61,6 +61,7 @@ static void _CommitNodes(OpMerge *op, Record r) {
 		PropertyMap *map = node_ctx->properties;
 		if(map) _AddProperties(op, r, (GraphEntity *)created_node, map);
 
+		if(schema) SchemaStats_AddEntity(schema->stats, (GraphEntity *)created_node);
 		if(schema) Schema_AddNodeToIndices(schema, created_node, false);
 	}
 
@@ -93,6 +94,7 @@ static void _CommitEdges(OpMerge *op, Record r) {
 		// Convert properties and add to newly-created node.
 		PropertyMap *map = edge_ctx->properties;
 		if(map) _AddProperties(op, r, (GraphEntity *)created_edge, map);
+		SchemaStats_AddEntity(schema->stats, (GraphEntity *)created_edge);
 	}
 
 	if(op->stats) op->stats->relationships_created += edge_count;
@@ -11,6 +11,8 @@
 static inline bool _outOfBounds(OpNodeByIdSeek *op) {
 	/* Because currentId starts at minimum and only increases
 	 * we only care about top bound. */
+	if(op->currentId >= Graph_RequiredMatrixDim(op->g)) return true;
+	if(op->maxId == ID_RANGE_UNBOUND) return false;
 	if(op->currentId > op->maxId) return true;
 	if(op->currentId == op->maxId && !op->maxInclusive) return true;
 	return false;
@@ -36,16 +38,19 @@ OpBase *NewOpNodeByIdSeekOp
 
 	// The smallest possible entity ID is 0.
 	op_nodeByIdSeek->minId = minId;
-	if(minId == ID_RANGE_UNBOUND) op_nodeByIdSeek->minId = 0;
+	if(minId == ID_RANGE_UNBOUND) {
+		op_nodeByIdSeek->minId = 0;
+		op_nodeByIdSeek->minInclusive = true;
+	}
 
-	// The largest possible entity ID is the same as Graph_RequiredMatrixDim.
-	if(maxId == ID_RANGE_UNBOUND) maxId = Graph_RequiredMatrixDim(op_nodeByIdSeek->g);
-	op_nodeByIdSeek->maxId = MIN(Graph_RequiredMatrixDim(op_nodeByIdSeek->g), maxId);
+	/* The largest possible entity ID is the same as Graph_RequiredMatrixDim,
+	 * which is checked upon each access as the graph might grow
+	 * between executions of a cached plan. */
+	op_nodeByIdSeek->maxId = maxId;
 
 	op_nodeByIdSeek->currentId = op_nodeByIdSeek->minId;
-	/* Advance current ID when min is not inclusive and
-	 * minimum range is specified. */
-	if(!minInclusive && minId != ID_RANGE_UNBOUND) op_nodeByIdSeek->currentId++;
+	// Advance current ID when min is not inclusive.
+	if(!op_nodeByIdSeek->minInclusive) op_nodeByIdSeek->currentId++;
 
 	op_nodeByIdSeek->nodeRecIdx = nodeRecIdx;
 
@@ -39,10 +39,12 @@ OpBase *NewNodeByLabelScanOp(QGNode *node, unsigned int node_idx) {
 	nodeByLabelScan->op.name = "Node By Label Scan";
 	nodeByLabelScan->op.type = OPType_NODE_BY_LABEL_SCAN;
 	nodeByLabelScan->op.consume = NodeByLabelScanConsume;
+	nodeByLabelScan->op.consumeBatch = NodeByLabelScanConsumeBatch;
 	nodeByLabelScan->op.init = NodeByLabelScanInit;
 	nodeByLabelScan->op.reset = NodeByLabelScanReset;
 	nodeByLabelScan->op.toString = NodeByLabelScanToString;
 	nodeByLabelScan->op.free = NodeByLabelScanFree;
+	nodeByLabelScan->op.clone = NodeByLabelScanClone;
 
 	nodeByLabelScan->op.modifies = array_new(uint, 1);
 	nodeByLabelScan->op.modifies = array_append(nodeByLabelScan->op.modifies, node_idx);
@@ -51,6 +53,10 @@ OpBase *NewNodeByLabelScanOp(QGNode *node, unsigned int node_idx) {
 }
 
 OpResult NodeByLabelScanInit(OpBase *opBase) {
+	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
+	/* Label matrix might have been modified since this operation was constructed,
+	 * retrieve a synchronized matrix. */
+	if(!op->_zero_matrix) GxB_MatrixTupleIter_reuse(op->iter, Graph_GetLabelMatrix(op->g, op->node->labelID));
 	return OP_OK;
 }
 
@@ -70,12 +76,41 @@ Record NodeByLabelScanConsume(OpBase *opBase) {
 	return r;
 }
 
+RecordBatch *NodeByLabelScanConsumeBatch(OpBase *opBase) {
+	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
+	RecordBatch *batch = OpBase_GetBatch(opBase, opBase->record_map->record_len);
+	RecordBatch_Clear(batch);
+
+	GrB_Index nodeId;
+	bool depleted = false;
+	while(!RecordBatch_IsFull(batch)) {
+		GxB_MatrixTupleIter_next(op->iter, NULL, &nodeId, &depleted);
+		if(depleted) break;
+
+		Record r = RecordBatch_NewRecord(batch);
+		Node *n = Record_GetNode(r, op->nodeRecIdx);
+		Graph_GetNode(op->g, nodeId, n);
+	}
+
+	return (batch->selected) ? batch : NULL;
+}
+
 OpResult NodeByLabelScanReset(OpBase *ctx) {
 	NodeByLabelScan *op = (NodeByLabelScan *)ctx;
 	GxB_MatrixTupleIter_reset(op->iter);
 	return OP_OK;
 }
 
+OpBase *NodeByLabelScanClone(const OpBase *opBase) {
+	const NodeByLabelScan *op = (const NodeByLabelScan *)opBase;
+	return NewNodeByLabelScanOp(op->node, op->nodeRecIdx);
+}
+
+void NodeByLabelScanSetRange(OpBase *opBase, NodeID start, NodeID end) {
+	NodeByLabelScan *op = (NodeByLabelScan *)opBase;
+	GxB_MatrixTupleIter_iterate_range(op->iter, start, end);
+}
+
 void NodeByLabelScanFree(OpBase *op) {
 	NodeByLabelScan *nodeByLabelScan = (NodeByLabelScan *)op;
 
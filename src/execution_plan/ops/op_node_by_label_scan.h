@@ -32,9 +32,18 @@ OpResult NodeByLabelScanInit(OpBase *ctx);
  * called each time a new ID is required */
 Record NodeByLabelScanConsume(OpBase *opBase);
 
+RecordBatch *NodeByLabelScanConsumeBatch(OpBase *opBase);
+
 /* Restart iterator */
 OpResult NodeByLabelScanReset(OpBase *ctx);
 
+/* Creates an uninitialized copy of NodeByLabelScan */
+OpBase *NodeByLabelScanClone(const OpBase *opBase);
+
+/* Restrict scan to nodes with IDs in the range [start, end),
+ * effective until the operation is reset. */
+void NodeByLabelScanSetRange(OpBase *opBase, NodeID start, NodeID end);
+
 /* Frees NodeByLabelScan */
 void NodeByLabelScanFree(OpBase *ctx);
 
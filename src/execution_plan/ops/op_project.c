@@ -31,6 +31,7 @@ OpBase *NewProjectOp(AR_ExpNode **exps, uint *modifies) {
 	project->exp_count = array_len(exps);
 	project->order_exps = NULL;
 	project->order_exp_count = 0;
+	project->programs = NULL;
 	project->singleResponse = false;
 
 	// Set our Op operations
@@ -38,6 +39,7 @@ OpBase *NewProjectOp(AR_ExpNode **exps, uint *modifies) {
 	project->op.name = "Project";
 	project->op.type = OPType_PROJECT;
 	project->op.consume = ProjectConsume;
+	project->op.consumeBatch = ProjectConsumeBatch;
 	project->op.init = ProjectInit;
 	project->op.reset = ProjectReset;
 	project->op.free = ProjectFree;
@@ -49,15 +51,52 @@ OpBase *NewProjectOp(AR_ExpNode **exps, uint *modifies) {
 
 OpResult ProjectInit(OpBase *opBase) {
 	OpProject *op = (OpProject *)opBase;
+	// Cached plans are re-initialized on every execution, compile once.
+	if(op->programs) return OP_OK;
+
 	AR_ExpNode **order_exps = _getOrderExpressions(opBase->parent);
 	if(order_exps) {
 		op->order_exps = order_exps;
 		op->order_exp_count = array_len(order_exps);
 	}
 
+	// Compile expressions.
+	op->programs = rm_malloc(sizeof(AR_Program *) * (op->exp_count + op->order_exp_count));
+	for(unsigned short i = 0; i < op->exp_count; i++) {
+		op->programs[i] = AR_Program_Compile(op->exps[i]);
+	}
+	for(unsigned short i = 0; i < op->order_exp_count; i++) {
+		op->programs[op->exp_count + i] = AR_Program_Compile(op->order_exps[i]);
+	}
+
 	return OP_OK;
 }
 
+// Evaluate projected expressions against r, storing results in projection.
+static void _ProjectRecord(OpProject *op, Record r, Record projection) {
+	int rec_idx = 0;
+	for(unsigned short i = 0; i < op->exp_count; i++) {
+		SIValue v = AR_Program_Evaluate(op->programs[rec_idx], r);
+		/* Persisting a value is only necessary here if 'v' refers to a scalar held in Record 'r'.
+		 * Graph entities don't need to be persisted here as Record_Add will copy them internally.
+		 * The RETURN projection here requires persistence:
+		 * MATCH (a) WITH toUpper(a.name) AS e RETURN e
+		 * TODO This is a rare case; the logic of when to persist can be improved.  */
+		if(!(v.type & SI_GRAPHENTITY)) SIValue_Persist(&v);
+		Record_Add(projection, rec_idx, v);
+		rec_idx++;
+	}
+
+	// Project Order expressions.
+	for(unsigned short i = 0; i < op->order_exp_count; i++) {
+		SIValue v = AR_Program_Evaluate(op->programs[rec_idx], r);
+		// TODO persisting here can be improved as described above.
+		if(!(v.type & SI_GRAPHENTITY)) SIValue_Persist(&v);
+		Record_Add(projection, rec_idx, v);
+		rec_idx++;
+	}
+}
+
 Record ProjectConsume(OpBase *opBase) {
 	OpProject *op = (OpProject *)opBase;
 	Record r = NULL;
@@ -82,39 +121,61 @@ Record ProjectConsume(OpBase *opBase) {
 	OpBase_AddVolatileRecord(opBase, r);
 	OpBase_AddVolatileRecord(opBase, projection);
 
-	int rec_idx = 0;
-	for(unsigned short i = 0; i < op->exp_count; i++) {
-		SIValue v = AR_EXP_Evaluate(op->exps[i], r);
-		/* Persisting a value is only necessary here if 'v' refers to a scalar held in Record 'r'.
-		 * Graph entities don't need to be persisted here as Record_Add will copy them internally.
-		 * The RETURN projection here requires persistence:
-		 * MATCH (a) WITH toUpper(a.name) AS e RETURN e
-		 * TODO This is a rare case; the logic of when to persist can be improved.  */
-		if(!(v.type & SI_GRAPHENTITY)) SIValue_Persist(&v);
-		Record_Add(projection, rec_idx, v);
-		rec_idx++;
-	}
-
-	// Project Order expressions.
-	for(unsigned short i = 0; i < op->order_exp_count; i++) {
-		SIValue v = AR_EXP_Evaluate(op->order_exps[i], r);
-		// TODO persisting here can be improved as described above.
-		if(!(v.type & SI_GRAPHENTITY)) SIValue_Persist(&v);
-		Record_Add(projection, rec_idx, v);
-		rec_idx++;
-	}
+	_ProjectRecord(op, r, projection);
 
 	Record_Free(r);
 	OpBase_RemoveVolatileRecords(opBase); // No exceptions encountered, Records are not dangling.
 	return projection;
 }
 
+RecordBatch *ProjectConsumeBatch(OpBase *opBase) {
+	OpProject *op = (OpProject *)opBase;
+	/* Projections are written into this operation's batch,
+	 * which frees them once it is cleared or freed. */
+	RecordBatch *projections = OpBase_GetBatch(opBase, op->exp_count + op->order_exp_count);
+	RecordBatch_Clear(projections);
+
+	if(op->op.childCount) {
+		OpBase *child = op->op.children[0];
+		RecordBatch *batch = OpBase_ConsumeBatch(child);
+		if(!batch) return NULL;
+
+		for(uint i = 0; i < batch->selected; i++) {
+			_ProjectRecord(op, RecordBatch_Get(batch, i), RecordBatch_NewRecord(projections));
+		}
+	} else {
+		// QUERY: RETURN 1+2
+		// Return a single projection followed by NULL
+		// on the second call.
+		if(op->singleResponse) return NULL;
+		op->singleResponse = true;
+
+		Record r = Record_New(opBase->record_map->record_len);  // Fake empty record.
+		OpBase_AddVolatileRecord(opBase, r);
+		_ProjectRecord(op, r, RecordBatch_NewRecord(projections));
+		Record_Free(r);
+		OpBase_RemoveVolatileRecords(opBase);
+	}
+
+	return projections;
+}
+
 OpResult ProjectReset(OpBase *ctx) {
+	OpProject *op = (OpProject *)ctx;
+	op->singleResponse = false;
 	return OP_OK;
 }
 
 void ProjectFree(OpBase *ctx) {
 	OpProject *op = (OpProject *)ctx;
+	if(op->programs) {
+		for(unsigned short i = 0; i < op->exp_count + op->order_exp_count; i++) {
+			AR_Program_Free(op->programs[i]);
+		}
+		rm_free(op->programs);
+		op->programs = NULL;
+	}
+
 	// TODO These expressions are typically freed as part of
 	// _ExecutionPlanSegment_Free, but this forms a leak in scenarios
 	// like the ReduceCount optimization.
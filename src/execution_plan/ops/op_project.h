@@ -9,12 +9,14 @@
 
 #include "op.h"
 #include "../../arithmetic/arithmetic_expression.h"
+#include "../../arithmetic/ar_program.h"
 
 typedef struct {
 	OpBase op;
 	const AST *ast;
 	AR_ExpNode **exps;              // Projected expressions.
 	AR_ExpNode **order_exps;        // Order by expressions.
+	AR_Program **programs;          // Compiled projected expressions followed by order by expressions.
 	bool singleResponse;            // When no child operations, return NULL after a first response.
 	unsigned short exp_count;       // Number of projected expressions.
 	unsigned short order_exp_count; // Number of order by expressions.
@@ -26,6 +28,8 @@ OpResult ProjectInit(OpBase *opBase);
 
 Record ProjectConsume(OpBase *op);
 
+RecordBatch *ProjectConsumeBatch(OpBase *op);
+
 OpResult ProjectReset(OpBase *ctx);
 
 void ProjectFree(OpBase *ctx);
@@ -17,6 +17,7 @@ OpBase *NewResultsOp(ResultSet *result_set) {
 	results->op.name = "Results";
 	results->op.type = OPType_RESULTS;
 	results->op.consume = ResultsConsume;
+	results->op.consumeBatch = ResultsConsumeBatch;
 	results->op.reset = ResultsReset;
 	results->op.free = ResultsFree;
 
@@ -40,6 +41,22 @@ Record ResultsConsume(OpBase *opBase) {
 	return r;
 }
 
+/* Results batch consume operation
+ * appends each selected record of child's batch to the result set. */
+RecordBatch *ResultsConsumeBatch(OpBase *opBase) {
+	Results *op = (Results *)opBase;
+	if(op->op.childCount == 0) return NULL;
+
+	OpBase *child = op->op.children[0];
+	RecordBatch *batch = OpBase_ConsumeBatch(child);
+	if(!batch) return NULL;
+
+	for(uint i = 0; i < batch->selected; i++) {
+		ResultSet_AddRecord(op->result_set, RecordBatch_Get(batch, i));
+	}
+	return batch;
+}
+
 /* Restart */
 OpResult ResultsReset(OpBase *op) {
 	return OP_OK;
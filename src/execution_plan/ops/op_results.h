@@ -27,6 +27,8 @@ OpBase *NewResultsOp(ResultSet *result_set);
  * called each time a new result record is required */
 Record ResultsConsume(OpBase *op);
 
+RecordBatch *ResultsConsumeBatch(OpBase *op);
+
 /* Restart iterator */
 OpResult ResultsReset(OpBase *ctx);
 
@@ -210,6 +210,11 @@ OpResult SortReset(OpBase *ctx) {
 			Record r = array_pop(op->buffer);
 			Record_Free(r);
 		}
+		// When sorting via heap, buffer is reallocated per execution.
+		if(op->heap) {
+			array_free(op->buffer);
+			op->buffer = NULL;
+		}
 	}
 
 	return OP_OK;
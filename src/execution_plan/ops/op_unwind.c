@@ -39,12 +39,24 @@ OpBase *NewUnwindOp(uint record_idx, AR_ExpNode *exp) {
 
 OpResult UnwindInit(OpBase *opBase) {
 	OpUnwind *op = (OpUnwind *) opBase;
+	// Discard state of a previous execution.
+	SIValue_Free(&op->list);
+	if(op->currentRecord) Record_Free(op->currentRecord);
 	op->currentRecord = Record_New(1);
 
 	if(op->op.childCount == 0) {
 		// No child operation, list must be static.
 		op->listIdx = 0;
 		op->list = AR_EXP_Evaluate(op->exp, op->currentRecord);
+		/* A list provided as a query parameter isn't validated ahead of time,
+		 * unwinding NULL produces no records, any other scalar
+		 * is treated as a single element list. */
+		if(op->list.type != T_ARRAY) {
+			SIValue v = op->list;
+			op->list = SIArray_New(1);
+			if(!SIValue_IsNull(v)) SIArray_Append(&op->list, v);
+			SIValue_Free(&v);
+		}
 	} else {
 		// List might depend on data provided by child operation.
 		op->list = SI_EmptyArray();
@@ -71,6 +71,9 @@ static void _UpdateNode(OpUpdate *op, EntityUpdateCtx *ctx) {
 
 	// Update index for node entities.
 	_UpdateIndex(ctx, op->gc, s, old_value, &ctx->new_value);
+
+	// Update label statistics.
+	if(s) SchemaStats_SetProperty(s->stats, ctx->attr_id, ctx->new_value, old_value == PROPERTY_NOTFOUND);
 }
 
 static void _UpdateEdge(OpUpdate *op, EntityUpdateCtx *ctx) {
@@ -93,6 +96,10 @@ static void _UpdateEdge(OpUpdate *op, EntityUpdateCtx *ctx) {
 		// Update property.
 		GraphEntity_SetProperty((GraphEntity *)edge, ctx->attr_id, ctx->new_value);
 	}
+
+	// Update relationship statistics.
+	Schema *s = GraphContext_GetSchemaByID(op->gc, label_id, SCHEMA_EDGE);
+	if(s) SchemaStats_SetProperty(s->stats, ctx->attr_id, ctx->new_value, old_value == PROPERTY_NOTFOUND);
 }
 
 /* Executes delayed updates. */
@@ -8,134 +8,159 @@
 #include "../../value.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
-#include "../../util/qsort.h"
 #include <assert.h>
 
-/* Determins order between two records by inspecting
- * element stored at postion idx. */
-static bool _record_islt(Record l, Record r, uint idx) {
-	SIValue lv = Record_GetScalar(l, idx);
-	SIValue rv = Record_GetScalar(r, idx);
-	return SIValue_Compare(lv, rv, NULL) < 0;
+/* Combine join keys hash codes into hash,
+ * returns false if a key is null, as null doesn't equal any value. */
+static bool _HashKeys(const SIValue *keys, uint key_count, uint64_t *hash) {
+	uint64_t h = 0;
+	for(uint i = 0; i < key_count; i++) {
+		if(SIValue_IsNull(keys[i])) return false;
+		h = 31 * h + SIValue_HashCode(keys[i]);
+	}
+	*hash = h;
+	return true;
 }
 
-/* `idx` is an actual variable in the caller function.
- * Using it in a macro like this is rather ugly,
- * but the macro passed to QSORT must accept only 2 arguments. */
-#define RECORD_SORT_ON_ENTRY(a, b) (_record_islt((*a), (*b), idx))
-
-// Performs binary search, returns the leftmost index of a match.
-static int64_t _binarySearchLeftmost(Record *array, int join_key_idx, SIValue v) {
-	int64_t recordCount = array_len(array);
-	int64_t pos;
-	int64_t left = 0;
-	int64_t right = recordCount;
-	while(left < right) {
-		pos = (right + left) / 2;
-		SIValue x = Record_GetScalar(array[pos], join_key_idx);
-		if(SIValue_Compare(x, v, NULL) < 0) left = pos + 1;
-		else right = pos;
-	}
-	return left;
+// Partition holding tuples with the given hash, selected by the hash's high bits.
+static inline HashJoinPartition *_Partition(const OpValueHashJoin *op, uint64_t hash) {
+	if(op->partition_bits == 0) return op->partitions;
+	return op->partitions + (hash >> (64 - op->partition_bits));
 }
 
-// Performs binary search, returns the rightmost index of a match.
-static int64_t _binarySearchRightmost(Record *array, int64_t array_len, int join_key_idx,
-									  SIValue v) {
-	int64_t pos;
-	int64_t left = 0;
-	int64_t right = array_len;
-	while(left < right) {
-		pos = (right + left) / 2;
-		SIValue x = Record_GetScalar(array[pos], join_key_idx);
-		if(SIValue_Compare(v, x, NULL) < 0) right = pos;
-		else left = pos + 1;
+// Tests if build record r's join keys equal keys.
+static bool _KeysEqual(const OpValueHashJoin *op, const Record r, const SIValue *keys) {
+	for(uint i = 0; i < op->key_count; i++) {
+		int disjointOrNull = 0;
+		SIValue v = Record_GetScalar(r, op->join_value_rec_idx + i);
+		if(SIValue_Compare(v, keys[i], &disjointOrNull) != 0 || disjointOrNull) return false;
 	}
-	return right - 1;
+	return true;
 }
 
-/* Retrive the next intersecting record
- * if such exists, otherwise returns NULL. */
-static Record _get_intersecting_record(OpValueHashJoin *op) {
-	// No more intersecting records.
-	if(op->intersect_idx == -1 ||
-	   op->number_of_intersections == 0) return NULL;
+/* Consumes entire left branch into the tuple arena,
+ * join keys are evaluated and stored at the end of each record. */
+static void _CollectBuildRecords(OpValueHashJoin *op) {
+	OpBase *left_child = op->op.children[0];
+	SIValue keys[op->key_count];
 
-	Record cr = op->cached_records[op->intersect_idx];
+	Record r;
+	while((r = OpBase_Consume(left_child))) {
+		uint32_t idx = array_len(op->tuples);
+		if(idx == 0) op->join_value_rec_idx = Record_length(r);
 
-	// Update intersection trackers.
-	op->intersect_idx++;
-	op->number_of_intersections--;
+		// Add joined values to record, cache record first so it is freed in case of an error.
+		Record_Extend(&r, op->join_value_rec_idx + op->key_count);
+		HashJoinTuple tuple = {.r = r, .hash = 0, .next = HASH_JOIN_NIL};
+		op->tuples = array_append(op->tuples, tuple);
+
+		for(uint i = 0; i < op->key_count; i++) {
+			keys[i] = AR_EXP_Evaluate(op->lhs_exps[i], r);
+			Record_AddScalar(r, op->join_value_rec_idx + i, keys[i]);
+		}
 
-	return cr;
+		// Records with a null join key never match.
+		if(!_HashKeys(keys, op->key_count, &op->tuples[idx].hash)) {
+			array_pop(op->tuples);
+			Record_Free(r);
+		}
+	}
 }
 
-/* Look up first intersecting cached record CR position.
- * Returns false if intersecting record is found. */
-static bool _set_intersection_idx(OpValueHashJoin *op, SIValue v) {
-	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
-	uint record_count = array_len(op->cached_records);
-
-	int64_t leftmost_idx = _binarySearchLeftmost(op->cached_records, op->join_value_rec_idx, v);
-	if(leftmost_idx >= record_count) return false;
-
-	// Make sure value was found.
-	Record r = op->cached_records[leftmost_idx];
-	SIValue x = Record_GetScalar(r, op->join_value_rec_idx);
-	if(SIValue_Compare(x, v, NULL) != 0) return false; // Value wasn't found.
-
-	/* Value was found
-	 * idx points to the first intersecting record.
-	 * update number_of_intersections to count how many
-	 * records share the same value. */
-	op->intersect_idx = leftmost_idx;
-
-	/* Count how many records share the same node.
-	 * reduce search space by truncating left bound */
-	int64_t rightmost_idx = _binarySearchRightmost(op->cached_records + leftmost_idx,
-												   record_count - leftmost_idx,
-												   op->join_value_rec_idx,
-												   v);
-	// Compensate index.
-	rightmost_idx += leftmost_idx;
-	// +1 consider rightmost_idx == leftmost_idx.
-	op->number_of_intersections = rightmost_idx - leftmost_idx + 1;
-	assert(op->number_of_intersections > 0);
+/* Index tuples by hash, build side is split into partitions of at most
+ * HASH_JOIN_PARTITION_CAP tuples, each with its own open addressing table. */
+static void _BuildTable(OpValueHashJoin *op) {
+	uint32_t tuple_count = array_len(op->tuples);
 
-	return true;
-}
+	op->partition_bits = 0;
+	while(((uint64_t)HASH_JOIN_PARTITION_CAP << op->partition_bits) < tuple_count) {
+		op->partition_bits++;
+	}
+	uint64_t partition_count = (uint64_t)1 << op->partition_bits;
+	op->partitions = rm_malloc(sizeof(HashJoinPartition) * partition_count);
 
-/* Sorts cached records by joined value. */
-void _sort_cached_records(OpValueHashJoin *op) {
-	uint idx = op->join_value_rec_idx;
-	QSORT(Record, op->cached_records,
-		  array_len(op->cached_records), RECORD_SORT_ON_ENTRY);
+	// Size each partition's table to at most half occupancy.
+	uint32_t *counts = rm_calloc(partition_count, sizeof(uint32_t));
+	for(uint32_t i = 0; i < tuple_count; i++) {
+		counts[_Partition(op, op->tuples[i].hash) - op->partitions]++;
+	}
+	for(uint64_t i = 0; i < partition_count; i++) {
+		uint64_t cap = 1;
+		while(cap < (uint64_t)counts[i] * 2) cap <<= 1;
+		HashJoinPartition *p = op->partitions + i;
+		p->mask = cap - 1;
+		p->slots = rm_malloc(sizeof(HashJoinSlot) * cap);
+		for(uint64_t j = 0; j < cap; j++) p->slots[j].head = HASH_JOIN_NIL;
+	}
+	rm_free(counts);
+
+	// Insert in reverse order such that chains list tuples in build order.
+	for(int64_t i = (int64_t)tuple_count - 1; i >= 0; i--) {
+		HashJoinTuple *t = op->tuples + i;
+		HashJoinPartition *p = _Partition(op, t->hash);
+		uint64_t pos = t->hash & p->mask;
+		while(p->slots[pos].head != HASH_JOIN_NIL && p->slots[pos].hash != t->hash) {
+			pos = (pos + 1) & p->mask;
+		}
+		t->next = p->slots[pos].head;
+		p->slots[pos].hash = t->hash;
+		p->slots[pos].head = i;
+	}
 }
 
-/* Caches all records coming from left branch. */
-void _cache_records(OpValueHashJoin *op) {
-	assert(op->cached_records == NULL);
+// Returns the first tuple with the given hash, HASH_JOIN_NIL if there's none.
+static uint32_t _Lookup(const OpValueHashJoin *op, uint64_t hash) {
+	const HashJoinPartition *p = _Partition(op, hash);
+	uint64_t pos = hash & p->mask;
+	while(p->slots[pos].head != HASH_JOIN_NIL) {
+		if(p->slots[pos].hash == hash) return p->slots[pos].head;
+		pos = (pos + 1) & p->mask;
+	}
+	return HASH_JOIN_NIL;
+}
 
-	OpBase *left_child = op->op.children[0];
-	op->cached_records = array_new(Record, 32);
+/* Retrieve the next build tuple intersecting with rhs_rec,
+ * if such exists, otherwise returns NULL. */
+static HashJoinTuple *_NextMatch(OpValueHashJoin *op) {
+	while(op->match != HASH_JOIN_NIL) {
+		HashJoinTuple *t = op->tuples + op->match;
+		op->match = t->next;
+		// Tuples sharing a hash might still differ.
+		if(_KeysEqual(op, t->r, op->probe_keys)) return t;
+	}
+	return NULL;
+}
 
-	Record r = left_child->consume(left_child);
-	if(!r) return;
+// Discard current right hand side record.
+static void _ReleaseProbe(OpValueHashJoin *op) {
+	op->match = HASH_JOIN_NIL;
+	for(uint i = 0; i < op->key_count; i++) {
+		SIValue_Free(&op->probe_keys[i]);
+		op->probe_keys[i] = SI_NullVal();
+	}
+	if(op->rhs_rec) {
+		Record_Free(op->rhs_rec);
+		op->rhs_rec = NULL;
+	}
+}
 
-	op->join_value_rec_idx = Record_length(r);
-	int extended_rec_len = Record_length(r) + 1;
+static void _FreeTable(OpValueHashJoin *op) {
+	if(op->tuples) {
+		uint32_t tuple_count = array_len(op->tuples);
+		for(uint32_t i = 0; i < tuple_count; i++) Record_Free(op->tuples[i].r);
+		array_free(op->tuples);
+		op->tuples = NULL;
+	}
 
-	// As long as there's data coming in from left branch.
-	do {
-		// Add joined value to record.
-		Record_Extend(&r, extended_rec_len); // Cache record.
-		op->cached_records = array_append(op->cached_records, r);
+	if(op->partitions) {
+		uint64_t partition_count = (uint64_t)1 << op->partition_bits;
+		for(uint64_t i = 0; i < partition_count; i++) rm_free(op->partitions[i].slots);
+		rm_free(op->partitions);
+		op->partitions = NULL;
+	}
 
-		// Evaluate joined expression.
-		SIValue v = AR_EXP_Evaluate(op->lhs_exp, r);
-		Record_AddScalar(r, op->join_value_rec_idx, v);
-	} while((r = left_child->consume(left_child)));
+	op->partition_bits = 0;
+	op->built = false;
 }
 
 /* String representation of operation */
@@ -147,29 +172,41 @@ static int ValueHashJoinToString(const OpBase *ctx, char *buff, uint buff_len) {
 	int offset = 0;
 	offset += snprintf(buff + offset, buff_len - offset, "%s | ", op->op.name);
 
-	AR_EXP_ToString(op->lhs_exp, &exp_str);
-	offset += snprintf(buff + offset, buff_len - offset, "%s", exp_str);
-	rm_free(exp_str);
+	for(uint i = 0; i < op->key_count; i++) {
+		if(i > 0) offset += snprintf(buff + offset, buff_len - offset, " AND ");
+
+		AR_EXP_ToString(op->lhs_exps[i], &exp_str);
+		offset += snprintf(buff + offset, buff_len - offset, "%s", exp_str);
+		rm_free(exp_str);
 
-	offset += snprintf(buff + offset, buff_len - offset, " = ");
+		offset += snprintf(buff + offset, buff_len - offset, " = ");
 
-	AR_EXP_ToString(op->rhs_exp, &exp_str);
-	offset += snprintf(buff + offset, buff_len - offset, "%s", exp_str);
-	rm_free(exp_str);
+		AR_EXP_ToString(op->rhs_exps[i], &exp_str);
+		offset += snprintf(buff + offset, buff_len - offset, "%s", exp_str);
+		rm_free(exp_str);
+	}
 
 	return offset;
 }
 
 /* Creates a new valueHashJoin operation */
-OpBase *NewValueHashJoin(AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp) {
+OpBase *NewValueHashJoin(AR_ExpNode **lhs_exps, AR_ExpNode **rhs_exps) {
+	assert(array_len(lhs_exps) == array_len(rhs_exps) && array_len(lhs_exps) > 0);
+
 	OpValueHashJoin *valueHashJoin = malloc(sizeof(OpValueHashJoin));
 	valueHashJoin->rhs_rec = NULL;
-	valueHashJoin->lhs_exp = lhs_exp;
-	valueHashJoin->rhs_exp = rhs_exp;
-	valueHashJoin->intersect_idx = -1;
-	valueHashJoin->cached_records = NULL;
-	valueHashJoin->join_value_rec_idx = -1;
-	valueHashJoin->number_of_intersections = 0;
+	valueHashJoin->lhs_exps = lhs_exps;
+	valueHashJoin->rhs_exps = rhs_exps;
+	valueHashJoin->key_count = array_len(lhs_exps);
+	valueHashJoin->join_value_rec_idx = 0;
+	valueHashJoin->built = false;
+	valueHashJoin->tuples = NULL;
+	valueHashJoin->partitions = NULL;
+	valueHashJoin->partition_bits = 0;
+	valueHashJoin->match = HASH_JOIN_NIL;
+	valueHashJoin->match_hash = 0;
+	valueHashJoin->probe_keys = rm_malloc(sizeof(SIValue) * valueHashJoin->key_count);
+	for(uint i = 0; i < valueHashJoin->key_count; i++) valueHashJoin->probe_keys[i] = SI_NullVal();
 
 	// Set our Op operations
 	OpBase_Init(&valueHashJoin->op);
@@ -197,110 +234,71 @@ Record ValueHashJoinConsume(OpBase *opBase) {
 	OpBase *right_child = op->op.children[1];
 
 	// Eager, pull from left branch until depleted.
-	if(op->cached_records == NULL) {
-		_cache_records(op);
-		// Sort cache on intersect node ID.
-		_sort_cached_records(op);
+	if(!op->built) {
+		op->tuples = array_new(HashJoinTuple, 32);
+		_CollectBuildRecords(op);
+		_BuildTable(op);
+		op->built = true;
 	}
 
-	/* Try to produce a record:
-	 * given a right hand side record R,
-	 * evaluate V = exp on R,
-	 * see if there are any cached records
-	 * which V evaluated to V:
-	 * X in cached_records and X[idx] = V
-	 * return merged record:
-	 * X merged with R. */
-
-	Record l;
-	if(op->number_of_intersections > 0) {
-		while((l = _get_intersecting_record(op))) {
-			/* Merge into cached records to avoid
-			 * record extension */
-			Record_Merge(&l, op->rhs_rec);
-			return Record_Clone(l);
+	// Nothing to join with, avoid consuming right branch.
+	if(array_len(op->tuples) == 0) return NULL;
+
+	while(true) {
+		/* Given a right hand side record R, produce a record
+		 * for each build record X which agrees with R on every join key,
+		 * merge R into X to avoid record extension. */
+		HashJoinTuple *t = _NextMatch(op);
+		if(t) {
+			Record_Merge(&t->r, op->rhs_rec);
+			return Record_Clone(t->r);
 		}
-	}
 
-	/* If we're here there are no more
-	 * left hand side records which intersect with R
-	 * discard R. */
-	if(op->rhs_rec) Record_Free(op->rhs_rec);
+		/* If we're here there are no more
+		 * left hand side records which intersect with R
+		 * discard R. */
+		_ReleaseProbe(op);
 
-	/* Try to get new right hand side record
-	 * which intersect with a left hand side record. */
-	while(true) {
 		// Pull from right branch.
-		op->rhs_rec = right_child->consume(right_child);
+		op->rhs_rec = OpBase_Consume(right_child);
 		if(!op->rhs_rec) return NULL;
 
-		// Get value on which we're intersecting.
-		SIValue v = AR_EXP_Evaluate(op->rhs_exp, op->rhs_rec);
-
-		// No intersection, discard R.
-		if(!_set_intersection_idx(op, v)) {
-			Record_Free(op->rhs_rec);
-			continue;
+		// Get values on which we're intersecting.
+		for(uint i = 0; i < op->key_count; i++) {
+			op->probe_keys[i] = AR_EXP_Evaluate(op->rhs_exps[i], op->rhs_rec);
 		}
-
-		// Found atleast one intersecting record.
-		l = _get_intersecting_record(op);
-		Record_Merge(&l, op->rhs_rec);
-		return Record_Clone(l);
+		if(!_HashKeys(op->probe_keys, op->key_count, &op->match_hash)) continue;
+		op->match = _Lookup(op, op->match_hash);
 	}
 }
 
 OpResult ValueHashJoinReset(OpBase *ctx) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
-	op->intersect_idx = -1;
-	op->number_of_intersections = 0;
-
-	// Clear cached records.
-	if(op->rhs_rec) {
-		Record_Free(op->rhs_rec);
-		op->rhs_rec = NULL;
-	}
-
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			Record_Free(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
-	}
-
+	_ReleaseProbe(op);
+	_FreeTable(op);
 	return OP_OK;
 }
 
 /* Frees valueHashJoin */
 void ValueHashJoinFree(OpBase *ctx) {
 	OpValueHashJoin *op = (OpValueHashJoin *)ctx;
-	// Free cached records.
-	if(op->rhs_rec) {
-		Record_Free(op->rhs_rec);
-		op->rhs_rec = NULL;
+	if(op->probe_keys) {
+		_ReleaseProbe(op);
+		rm_free(op->probe_keys);
+		op->probe_keys = NULL;
 	}
 
-	if(op->cached_records) {
-		uint record_count = array_len(op->cached_records);
-		for(uint i = 0; i < record_count; i++) {
-			Record r = op->cached_records[i];
-			Record_Free(r);
-		}
-		array_free(op->cached_records);
-		op->cached_records = NULL;
-	}
+	_FreeTable(op);
 
-	if(op->lhs_exp) {
-		AR_EXP_Free(op->lhs_exp);
-		op->lhs_exp = NULL;
+	if(op->lhs_exps) {
+		for(uint i = 0; i < op->key_count; i++) AR_EXP_Free(op->lhs_exps[i]);
+		array_free(op->lhs_exps);
+		op->lhs_exps = NULL;
 	}
 
-	if(op->rhs_exp) {
-		AR_EXP_Free(op->rhs_exp);
-		op->rhs_exp = NULL;
+	if(op->rhs_exps) {
+		for(uint i = 0; i < op->key_count; i++) AR_EXP_Free(op->rhs_exps[i]);
+		array_free(op->rhs_exps);
+		op->rhs_exps = NULL;
 	}
 }
-
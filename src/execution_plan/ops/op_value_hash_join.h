@@ -9,19 +9,53 @@
 #include "op.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
+// Maximum number of build records per hash table partition.
+#define HASH_JOIN_PARTITION_CAP 4096
+// Marks an empty slot and the end of a tuple chain.
+#define HASH_JOIN_NIL UINT32_MAX
+
+/* Build side record, tuples sharing a hash value are chained. */
+typedef struct {
+	Record r;           // Build record, join keys are stored at the end of the record.
+	uint64_t hash;      // Hash of join keys.
+	uint32_t next;      // Next tuple sharing hash, HASH_JOIN_NIL terminates chain.
+} HashJoinTuple;
+
+/* Open addressing hash table slot. */
+typedef struct {
+	uint64_t hash;      // Hash of join keys.
+	uint32_t head;      // First tuple sharing hash, HASH_JOIN_NIL if slot is empty.
+} HashJoinSlot;
+
+/* Hash table covering a subset of the build side,
+ * large build sides are split such that each table remains cache friendly. */
+typedef struct {
+	HashJoinSlot *slots;
+	uint64_t mask;      // Number of slots - 1.
+} HashJoinPartition;
+
+/* ValueHashJoin joins its two child streams on one or more equality conditions.
+ * The left stream is consumed entirely to build a hash table,
+ * each right stream record probes the table for matching left records. */
 typedef struct {
 	OpBase op;
 	Record rhs_rec;                     // Right hand side record.
-	AR_ExpNode *lhs_exp;                // Left hand side expression to join on.
-	AR_ExpNode *rhs_exp;                // Right hand side expression to join on.
-	int64_t intersect_idx;              // Current intersection, < number_of_intersections
-	Record *cached_records;             // Cached left hand side records.
-	uint join_value_rec_idx;            // position on joined expression within record.
-	int64_t number_of_intersections;    // Number of intersections located.
+	AR_ExpNode **lhs_exps;              // Left hand side expressions to join on.
+	AR_ExpNode **rhs_exps;              // Right hand side expressions to join on.
+	uint key_count;                     // Number of joined expressions.
+	uint join_value_rec_idx;            // Position of first joined value within build records.
+	bool built;                         // Hash table was built.
+	HashJoinTuple *tuples;              // Tuple arena, holds build records.
+	HashJoinPartition *partitions;      // Hash table partitions.
+	uint partition_bits;                // Number of hash bits selecting a partition.
+	uint32_t match;                     // Next tuple to inspect for rhs_rec, HASH_JOIN_NIL if none.
+	uint64_t match_hash;                // Hash of rhs_rec's join keys.
+	SIValue *probe_keys;                // rhs_rec's join keys.
 } OpValueHashJoin;
 
-/* Creates a new ValueHashJoin operation */
-OpBase *NewValueHashJoin(AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp);
+/* Creates a new ValueHashJoin operation joining on lhs_exps[i] = rhs_exps[i],
+ * operation takes ownership over both expression arrays. */
+OpBase *NewValueHashJoin(AR_ExpNode **lhs_exps, AR_ExpNode **rhs_exps);
 
 /* Try to produce a record combining data from both streams */
 Record ValueHashJoinConsume(OpBase *opBase);
@@ -32,3 +32,4 @@
 #include "op_procedure_call.h"
 #include "op_value_hash_join.h"
 #include "op_apply.h"
+#include "op_gather.h"
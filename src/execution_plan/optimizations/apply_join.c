@@ -5,11 +5,17 @@
 */
 
 #include "apply_join.h"
+#include "traverse_order.h"
 #include "../../util/arr.h"
 #include "../ops/op_filter.h"
 #include "rax.h"
 #include "../ops/op_value_hash_join.h"
 #include "../ops/op_cartesian_product.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../../query_ctx.h"
+
+// Estimated fraction of a label's nodes located by an index scan.
+#define INDEX_SCAN_SELECTIVITY 0.1
 
 // Tests to see if given filter can act as a join condition.
 static inline bool _applicableFilter(const FT_FilterNode *f) {
@@ -120,74 +126,200 @@ static void _relate_exp_to_stream(const OpBase *cp, const FT_FilterNode *f, AR_E
 	raxFree(entities);
 }
 
-/* Try to replace cartesian product with a value hash join operation */
+/* Returns the index of cp's child which resolves all entities referenced by exp,
+ * -1 if exp doesn't reference any entity or no single child resolves it. */
+static int _resolving_child(const OpBase *cp, AR_ExpNode *exp) {
+	int resolving_child = -1;
+	for(int i = 0; i < cp->childCount && resolving_child == -1; i++) {
+		rax *entities = raxNew();
+		AR_EXP_CollectEntityIDs(exp, entities);
+		if(raxSize(entities) > 0 && _stream_resolves_entities(cp->children[i], entities)) {
+			resolving_child = i;
+		}
+		raxFree(entities);
+	}
+	return resolving_child;
+}
+
+/* A cartesian product with more than two children is joined pairwise,
+ * consider: MATCH (a), (b), (c) WHERE a.v = b.v
+ * the branches resolving a and b are moved under a new cartesian product,
+ * placed right beneath the filters relating them, which is then
+ * converted into a join. */
+static void _group_joined_branches(ExecutionPlan *plan, OpBase *cp) {
+	// Cartesian products connecting segments relate IDs of different record maps.
+	if(cp->modifies) return;
+
+	while(cp->childCount > 2) {
+		OpFilter **filters = _locate_filters(cp);
+		uint filter_count = array_len(filters);
+
+		// Find a pair of branches related by an equality filter.
+		int left = -1;
+		int right = -1;
+		for(uint i = 0; i < filter_count && left == -1; i++) {
+			const FT_FilterNode *f = filters[i]->filterTree;
+			if(!_applicableFilter(f)) continue;
+			int l = _resolving_child(cp, f->pred.lhs);
+			int r = _resolving_child(cp, f->pred.rhs);
+			if(l == -1 || r == -1 || l == r) continue;
+			left = l;
+			right = r;
+		}
+
+		if(left == -1) {
+			array_free(filters);
+			return;
+		}
+
+		// Collect every equality filter relating the two branches.
+		OpFilter **join_filters = array_new(OpFilter *, 1);
+		for(uint i = 0; i < filter_count; i++) {
+			const FT_FilterNode *f = filters[i]->filterTree;
+			if(!_applicableFilter(f)) continue;
+			int l = _resolving_child(cp, f->pred.lhs);
+			int r = _resolving_child(cp, f->pred.rhs);
+			if((l == left && r == right) || (l == right && r == left)) {
+				join_filters = array_append(join_filters, filters[i]);
+			}
+		}
+		array_free(filters);
+
+		OpBase *left_branch = cp->children[left];
+		OpBase *right_branch = cp->children[right];
+		OpBase *inner_cp = NewCartesianProductOp();
+		ExecutionPlan_PushBelow(left_branch, inner_cp);
+		ExecutionPlan_DetachOp(right_branch);
+		ExecutionPlan_AddOp(inner_cp, right_branch);
+
+		// Move join filters beneath the outer cartesian product.
+		uint join_filter_count = array_len(join_filters);
+		for(uint i = 0; i < join_filter_count; i++) {
+			OpBase *filter = (OpBase *)join_filters[i];
+			ExecutionPlan_RemoveOp(plan, filter);
+			ExecutionPlan_PushBelow(inner_cp, filter);
+		}
+		array_free(join_filters);
+	}
+}
+
+/* Estimate the number of records produced by op, based on the number of
+ * scanned nodes and the graph's average out degree. */
+static double _estimateCardinality(const OpBase *op, const Graph *g) {
+	double node_count = Graph_NodeCount(g);
+	double avg_degree = (node_count > 0) ? Graph_EdgeCount(g) / node_count : 0;
+	if(avg_degree < 1) avg_degree = 1;
+
+	switch(op->type) {
+	case OPType_ALL_NODE_SCAN:
+		return node_count;
+	case OPType_NODE_BY_LABEL_SCAN: {
+		int label = ((const NodeByLabelScan *)op)->node->labelID;
+		return (label < 0) ? 0 : Graph_LabeledNodeCount(g, label);
+	}
+	case OPType_INDEX_SCAN:
+		return node_count * INDEX_SCAN_SELECTIVITY;
+	case OPType_NODE_BY_ID_SEEK:
+		return 1;
+	case OPType_FILTER:
+		return _estimateCardinality(op->children[0], g) * FILTER_SELECTIVITY;
+	case OPType_CONDITIONAL_TRAVERSE:
+	case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+		return _estimateCardinality(op->children[0], g) * avg_degree;
+	case OPType_CARTESIAN_PRODUCT: {
+		double cardinality = 1;
+		for(int i = 0; i < op->childCount; i++) cardinality *= _estimateCardinality(op->children[i], g);
+		return cardinality;
+	}
+	default:
+		// Assume operation passes its input through, taps produce a single record.
+		if(op->childCount == 0) return 1;
+		return _estimateCardinality(op->children[0], g);
+	}
+}
+
+/* Try to replace cartesian product with a value hash join operation
+ * joining on every equality filter relating both of its branches. */
 void applyJoin(ExecutionPlan *plan) {
 	OpBase **cps = ExecutionPlan_LocateOps(plan->root, OPType_CARTESIAN_PRODUCT);
 	int cp_count = array_len(cps);
+	for(int i = 0; i < cp_count; i++) _group_joined_branches(plan, cps[i]);
+	array_free(cps);
+
+	// Locate cartesian products again, including those introduced by grouping.
+	cps = ExecutionPlan_LocateOps(plan->root, OPType_CARTESIAN_PRODUCT);
+	cp_count = array_len(cps);
 
 	for(int i = 0; i < cp_count; i++) {
 		OpBase *cp = cps[i];
-		/* TODO: change the way our cartesian product
-		 * today we alow for cartesian product with > 2 child ops
-		 * I think it might be better to create a chain of cartesian products
-		 * where each pulls from exactly 2 streams
-		 * consider: MATCH a,b,c WHERE a.v = b.v. */
+		// Products of more than two branches which remain after grouping aren't joined.
 		if(cp->childCount != 2) continue;
 		OpFilter **filters = _locate_filters(cp);
 
+		AR_ExpNode **lhs_exps = array_new(AR_ExpNode *, 1);
+		AR_ExpNode **rhs_exps = array_new(AR_ExpNode *, 1);
+		OpFilter **join_filters = array_new(OpFilter *, 1);
+
 		int filter_count = array_len(filters);
 		for(int j = 0; j < filter_count; j++) {
 			OpFilter *filter = filters[j];
-			if(_applicableFilter(filter->filterTree)) {
-				// Reduce cartesian product to value hash join
-				AR_ExpNode *lhs = NULL;
-				AR_ExpNode *rhs = NULL;
-
-				/* Make sure lhs expression is resolved by
-				 * left stream, if not swap. */
-				_relate_exp_to_stream(cp, filter->filterTree, &lhs, &rhs);
-				/* There are cases where either lhs or rhs expressions
-				 * require data from both streams, consider:
-				 * a.v + c.v = b.v + d.v
-				 * where a and d are resolved by lhs stream and
-				 * b and c are resolved by rhs stream.
-				 * in which case we can't perform join. */
-				if(lhs == NULL || rhs == NULL) continue;
-
-				assert(lhs != rhs);
-				lhs = AR_EXP_Clone(lhs);
-				rhs = AR_EXP_Clone(rhs);
-
-				/* In order to reduce value-hash-join cache size
-				 * prefer to cache a branch which will produce the smallest number
-				 * of records, currently prefer a branch with a filter. */
-				OpBase *left_branch = cp->children[0];
-				OpBase *right_branch = cp->children[1];
-				bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
-				bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);
-				if(!left_branch_filtered && right_branch_filtered) {
-					// Swap branches!
-					cp->children[0] = right_branch;
-					cp->children[1] = left_branch;
-
-					AR_ExpNode *t = lhs;
-					lhs = rhs;
-					rhs = t;
-				}
-
-				OpBase *value_hash_join = NewValueHashJoin(lhs, rhs);
-
-				/* Remove filter which is now part of the join operation
-				 * replace cartesian product with join. */
-				ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
-				OpBase_Free((OpBase *)filter);
-				ExecutionPlan_ReplaceOp(plan, cp, value_hash_join);
-				OpBase_Free(cp);
-
-				break;
-			}
+			if(!_applicableFilter(filter->filterTree)) continue;
+
+			AR_ExpNode *lhs = NULL;
+			AR_ExpNode *rhs = NULL;
+
+			/* Make sure lhs expression is resolved by
+			 * left stream, if not swap. */
+			_relate_exp_to_stream(cp, filter->filterTree, &lhs, &rhs);
+			/* There are cases where either lhs or rhs expressions
+			 * require data from both streams, consider:
+			 * a.v + c.v = b.v + d.v
+			 * where a and d are resolved by lhs stream and
+			 * b and c are resolved by rhs stream.
+			 * in which case we can't perform join. */
+			if(lhs == NULL || rhs == NULL) continue;
+
+			assert(lhs != rhs);
+			lhs_exps = array_append(lhs_exps, AR_EXP_Clone(lhs));
+			rhs_exps = array_append(rhs_exps, AR_EXP_Clone(rhs));
+			join_filters = array_append(join_filters, filter);
 		}
 		array_free(filters);
+
+		uint join_filter_count = array_len(join_filters);
+		if(join_filter_count == 0) {
+			array_free(lhs_exps);
+			array_free(rhs_exps);
+			array_free(join_filters);
+			continue;
+		}
+
+		/* The left branch is cached in a hash table, in order to reduce
+		 * its size, build on the branch which is expected to produce fewer records. */
+		Graph *g = QueryCtx_GetGraph();
+		OpBase *left_branch = cp->children[0];
+		OpBase *right_branch = cp->children[1];
+		if(_estimateCardinality(left_branch, g) > _estimateCardinality(right_branch, g)) {
+			// Swap branches!
+			cp->children[0] = right_branch;
+			cp->children[1] = left_branch;
+
+			AR_ExpNode **t = lhs_exps;
+			lhs_exps = rhs_exps;
+			rhs_exps = t;
+		}
+
+		OpBase *value_hash_join = NewValueHashJoin(lhs_exps, rhs_exps);
+
+		/* Remove filters which are now part of the join operation
+		 * replace cartesian product with join. */
+		for(uint j = 0; j < join_filter_count; j++) {
+			ExecutionPlan_RemoveOp(plan, (OpBase *)join_filters[j]);
+			OpBase_Free((OpBase *)join_filters[j]);
+		}
+		array_free(join_filters);
+		ExecutionPlan_ReplaceOp(plan, cp, value_hash_join);
+		OpBase_Free(cp);
 	}
 	array_free(cps);
 }
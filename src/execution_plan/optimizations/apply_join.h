@@ -9,8 +9,8 @@
 #include "../execution_plan.h"
 
 /* applyJoin will try to locate situations where two disjoint
- * streams can be joined on a key attribute, in which case the
- * runtime complaxity is reduced from O(n^2) to O(nlogn + 2n)
+ * streams can be joined on one or more key attributes, in which case the
+ * runtime complaxity is reduced from O(n^2) to O(n + m)
  * consider MATCH (a), (b) where a.v = b.v RETURN a,b
  * prior to this optimization a and b will be combined via a
  * cartesian product O(n^2) because a and b are related,
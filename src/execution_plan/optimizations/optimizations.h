@@ -16,7 +16,8 @@
 #include "./utilize_indices.h"
 #include "./reduce_distinct.h"
 #include "./reduce_traversal.h"
-#include "./select_entry_point.h"
+#include "./reduce_var_len_traversal.h"
+#include "./parallelize_scans.h"
 
 #endif
 
@@ -28,11 +28,18 @@ void optimizePlan(GraphContext *gc, ExecutionPlan *plan) {
 	 * into an expand into operation. */
 	reduceTraversal(plan);
 
+	/* Reduce variable length traversals whose duplicate records
+	 * are discarded into reachability traversals. */
+	reduceVarLenTraversal(plan);
+
 	/* Try to reduce distinct if it follows aggregation. */
 	reduceDistinct(plan);
 
 	/* Try to reduce execution plan incase it perform node or edge counting. */
 	reduceCount(plan);
 
+	/* Split scans feeding order independent operations
+	 * across multiple threads. */
+	parallelizeScans(plan);
 }
 
@@ -0,0 +1,70 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./parallelize_scans.h"
+#include "../ops/op_gather.h"
+#include "../../util/arr.h"
+
+extern uint query_parallelism;
+
+// Operations modifying the graph, which must be executed by a single thread.
+#define PARALLELIZE_WRITE_OPS (OPType_CREATE | OPType_UPDATE | OPType_DELETE | OPType_MERGE)
+// Operations re-executing their children, restarting helper threads each time.
+#define PARALLELIZE_REPEATING_OPS (OPType_APPLY | OPType_CARTESIAN_PRODUCT | OPType_VALUE_HASH_JOIN)
+
+// Returns true if op accepts its input records in any order.
+static bool _OrderIndependent(const OpBase *op) {
+	return (op->type == OPType_AGGREGATE ||
+			op->type == OPType_SORT ||
+			op->type == OPType_DISTINCT ||
+			op->type == OPType_PROJECT ||
+			op->type == OPType_RESULTS);
+}
+
+static bool _RepeatedExecution(const OpBase *op) {
+	for(; op; op = op->parent) {
+		if(op->type & PARALLELIZE_REPEATING_OPS) return true;
+	}
+	return false;
+}
+
+// Returns the top most operation of the chain starting at scan, NULL if chain can't be parallelized.
+static OpBase *_LocateChainTop(OpBase *scan) {
+	OpBase *top = scan;
+	bool worthwhile = false;
+	while(top->parent && top->parent->childCount == 1 && top->parent->clone) {
+		top = top->parent;
+		worthwhile |= (top->type & (OPType_FILTER | OPType_CONDITIONAL_TRAVERSE)) != 0;
+	}
+
+	// A bare scan doesn't justify the overhead of helper threads.
+	if(!worthwhile) return NULL;
+	if(!top->parent || !_OrderIndependent(top->parent)) return NULL;
+	if(_RepeatedExecution(top->parent)) return NULL;
+	return top;
+}
+
+void parallelizeScans(ExecutionPlan *plan) {
+	if(query_parallelism <= 1) return;
+
+	OpBase **writes = ExecutionPlan_LocateOps(plan->root, PARALLELIZE_WRITE_OPS);
+	bool read_only = (array_len(writes) == 0);
+	array_free(writes);
+	if(!read_only) return;
+
+	OpBase **scans = ExecutionPlan_LocateOps(plan->root,
+											 OPType_ALL_NODE_SCAN | OPType_NODE_BY_LABEL_SCAN);
+	uint scan_count = array_len(scans);
+	for(uint i = 0; i < scan_count; i++) {
+		OpBase *scan = scans[i];
+		// Scan must be the source of the chain's records.
+		if(scan->childCount != 0) continue;
+
+		OpBase *top = _LocateChainTop(scan);
+		if(top) ExecutionPlan_PushBelow(top, NewGatherOp());
+	}
+	array_free(scans);
+}
@@ -0,0 +1,17 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* The parallelize scans optimizer searches the execution plan for node scans
+ * followed by a chain of filters and traversals, e.g. SCAN -> TRAVERSE -> FILTER,
+ * which feed an operation that doesn't depend on the order of its input records,
+ * e.g. AGGREGATE. Such chains are placed under a GATHER operation which splits the scan
+ * into morsels processed concurrently by threads of the thread pool.
+ * Write queries and chains which might be re-executed, e.g. under APPLY, are left as is. */
+void parallelizeScans(ExecutionPlan *plan);
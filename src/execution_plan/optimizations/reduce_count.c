@@ -9,8 +9,6 @@
 #include "../../util/arr.h"
 #include "../../query_ctx.h"
 
-static GrB_UnaryOp countMultipleEdges = NULL;
-
 static int _identifyResultAndAggregateOps(OpBase *root, OpResult **opResult,
 										  OpAggregate **opAggregate) {
 	OpBase *op = root;
@@ -130,6 +128,8 @@ bool _reduceNodeCount(ExecutionPlan *plan) {
 	OpBase_Free((OpBase *)opAggregate);
 
 	ExecutionPlan_AddOp((OpBase *)opResult, opProject);
+	// Count is computed at planning time, plan can't be reused.
+	plan->embeds_graph_data = true;
 	return true;
 }
 
@@ -156,53 +156,6 @@ static int _identifyEdgeCountPattern(OpBase *root, OpResult **opResult, OpAggreg
 	return 1;
 }
 
-void _countEdges(void *z, const void *x) {
-	uint64_t *entry = (uint64_t *) x;
-	if(SINGLE_EDGE(*entry)) {
-		*(uint64_t *)z = 1;
-	} else {
-		// Multiple edges
-		EdgeID *ids = (EdgeID *)(*entry);
-		*(uint64_t *)z = array_len(ids);
-	}
-}
-
-uint64_t _countRelationshipEdges(GrB_Matrix M) {
-	// Create Unary operation only once.
-	if(!countMultipleEdges) {
-		GrB_UnaryOp_new(&countMultipleEdges, _countEdges, GrB_UINT64, GrB_UINT64);
-	}
-
-	/* TODO: to avoid this entire process keep track if
-	 * M contains multiple edges between two given nodes
-	 * if there are no multiple edges,
-	 * i.e. `a` is connected to `b` with multiple edges of type R
-	 * then all we need to do is return M's nnz.
-	 * Otherwise create a new matrix A, where A[i,j] = x
-	 * where x is the number of edges in M[i,j]
-	 * then reduce A using the plus (sum) monoid. */
-
-	GrB_Index nrows;
-	GrB_Index ncols;
-	GrB_Matrix_nrows(&nrows, M);
-	GrB_Matrix_ncols(&ncols, M);
-
-	GrB_Matrix A;
-	GrB_Matrix_new(&A, GrB_UINT64, nrows, ncols);
-
-	// A[i,j] = # of edges in M[i,j].
-	GrB_Matrix_apply(A, GrB_NULL, GrB_NULL,
-					 countMultipleEdges, M, GrB_NULL);
-
-	uint64_t edges = 0;
-	// Sum(A)
-	GrB_Matrix_reduce_UINT64(&edges, GrB_NULL,
-							 GxB_PLUS_UINT64_MONOID, A, GrB_NULL);
-
-	GrB_free(&A);
-	return edges;
-}
-
 void _reduceEdgeCount(ExecutionPlan *plan) {
 	/* We'll only modify execution plan if it is structured as follows:
 	 * "Full Scan -> Conditional Traverse -> Aggregate -> Results" */
@@ -228,7 +181,7 @@ void _reduceEdgeCount(ExecutionPlan *plan) {
 	if(condTraverse->edgeRelationTypes[0] != GRAPH_NO_RELATION) {
 		uint64_t edges = 0;
 		for(int i = 0; i < edgeRelationCount; i++) {
-			edges += _countRelationshipEdges(Graph_GetRelationMap(g, condTraverse->edgeRelationTypes[i]));
+			edges += Graph_RelationEdgeCount(g, condTraverse->edgeRelationTypes[i]);
 		}
 		edgeCount = SI_LongVal(edges);
 	} else {
@@ -258,6 +211,8 @@ void _reduceEdgeCount(ExecutionPlan *plan) {
 	OpBase_Free((OpBase *)opAggregate);
 
 	ExecutionPlan_AddOp((OpBase *)opResult, opProject);
+	// Count is computed at planning time, plan can't be reused.
+	plan->embeds_graph_data = true;
 }
 
 void reduceCount(ExecutionPlan *plan) {
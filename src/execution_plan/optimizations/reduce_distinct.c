@@ -5,8 +5,68 @@
 */
 
 #include "reduce_filters.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_project.h"
+#include "../ops/op_distinct.h"
+#include "../../util/arr.h"
 
-void reduceDistinct(ExecutionPlan *plan) {
+/* Returns the sort operation producing op's records,
+ * skipping over operations which maintain their input order. */
+static OpSort *_SortedInput(OpBase *op) {
+	while(op) {
+		switch(op->type) {
+		case OPType_SORT:
+			return (OpSort *)op;
+		case OPType_FILTER:
+		case OPType_SKIP:
+		case OPType_LIMIT:
+			if(op->childCount != 1) return NULL;
+			op = op->children[0];
+			break;
+		default:
+			return NULL;
+		}
+	}
+	return NULL;
+}
+
+/* Distinct's input is sorted on all of its values if it projects
+ * the aliases of a preceding sort's leading expressions, e.g.
+ * WITH n.v AS v ORDER BY v RETURN DISTINCT v */
+static bool _DistinctInputIsSorted(OpBase *distinct) {
+	if(distinct->childCount != 1) return false;
+	OpBase *child = distinct->children[0];
+	if(child->type != OPType_PROJECT || child->childCount != 1) return false;
+
+	OpSort *sort = _SortedInput(child->children[0]);
+	if(!sort) return false;
+
+	AR_ExpNode **exps = ((OpProject *)child)->exps;
+	uint exp_count = array_len(exps);
+	if(exp_count == 0 || exp_count > array_len(sort->expressions)) return false;
+
+	// Each projection must match a distinct sort expression among the leading exp_count.
+	bool matched[exp_count];
+	memset(matched, 0, sizeof(matched));
+	for(uint i = 0; i < exp_count; i++) {
+		AR_ExpNode *exp = exps[i];
+		if(exp->type != AR_EXP_OPERAND || exp->operand.type != AR_EXP_VARIADIC) return false;
+		if(exp->operand.variadic.entity_prop) return false;
+
+		const char *alias = exp->operand.variadic.entity_alias;
+		bool found = false;
+		for(uint j = 0; j < exp_count && !found; j++) {
+			const char *sorted_alias = sort->expressions[j]->resolved_name;
+			if(matched[j] || !sorted_alias || strcmp(sorted_alias, alias)) continue;
+			matched[j] = true;
+			found = true;
+		}
+		if(!found) return false;
+	}
+	return true;
+}
+
+static void _reduceDistinctAggregate(ExecutionPlan *plan) {
 	// Look for aggregate operation.
 	OpBase *aggregate = ExecutionPlan_LocateOp(plan->root, OPType_AGGREGATE);
 	if(aggregate == NULL || aggregate->parent == NULL) return;
@@ -26,3 +86,17 @@ void reduceDistinct(ExecutionPlan *plan) {
 		}
 	}
 }
+
+void reduceDistinct(ExecutionPlan *plan) {
+	_reduceDistinctAggregate(plan);
+
+	// Distinct operations over sorted input only need to compare adjacent records.
+	OpBase **distinct_ops = ExecutionPlan_LocateOps(plan->root, OPType_DISTINCT);
+	uint distinct_count = array_len(distinct_ops);
+	for(uint i = 0; i < distinct_count; i++) {
+		if(_DistinctInputIsSorted(distinct_ops[i])) {
+			DistinctOp_SetSortedInput((OpDistinct *)distinct_ops[i]);
+		}
+	}
+	array_free(distinct_ops);
+}
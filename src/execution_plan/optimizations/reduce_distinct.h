@@ -12,5 +12,7 @@
  * is unnecessary, as aggregation groups are guaranteed to be unique.
  * this optimization will try to look for an aggregation operation
  * followed by a distinct operation, in which case we can omit distinct
- * from the execution plan. */
+ * from the execution plan.
+ * In addition, a distinct operation whose input is sorted on all of its
+ * values is switched to comparing each record with its predecessor. */
 void reduceDistinct(ExecutionPlan *plan);
@@ -0,0 +1,51 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "reduce_var_len_traversal.h"
+#include "../../util/arr.h"
+#include "../ops/op_cond_var_len_traverse.h"
+
+/* Returns true if the number of times each of op's records is produced
+ * doesn't affect the query's result, i.e. op's records reach a distinct
+ * operation through operations which maintain set semantics. */
+static bool _MultiplicityIrrelevant(const OpBase *op) {
+	const OpBase *parent = op->parent;
+	while(parent) {
+		switch(parent->type) {
+		case OPType_DISTINCT:
+			return true;
+		case OPType_FILTER:
+		case OPType_PROJECT:
+		case OPType_EXPAND_INTO:
+		case OPType_CONDITIONAL_TRAVERSE:
+		case OPType_CARTESIAN_PRODUCT:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE:
+		case OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO:
+			parent = parent->parent;
+			break;
+		default:
+			return false;
+		}
+	}
+	return false;
+}
+
+void reduceVarLenTraversal(ExecutionPlan *plan) {
+	OPType t = OPType_CONDITIONAL_VAR_LEN_TRAVERSE | OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO;
+	OpBase **traversals = ExecutionPlan_LocateOps(plan->root, t);
+	uint traversal_count = array_len(traversals);
+
+	for(uint i = 0; i < traversal_count; i++) {
+		CondVarLenTraverse *traverse = (CondVarLenTraverse *)traversals[i];
+		/* Nodes reachable within [2, maxHops] hops aren't
+		 * the nodes at BFS distance 2 or more. */
+		if(traverse->minHops > 1) continue;
+		if(!_MultiplicityIrrelevant((OpBase *)traverse)) continue;
+		CondVarLenTraverseOp_SetReachability(traverse);
+	}
+
+	array_free(traversals);
+}
@@ -0,0 +1,19 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* A variable length traversal produces a record for every path
+ * leading from its source to each of its destinations, although only the
+ * destination node is set. When the records are later reduced by a distinct
+ * operation, duplicate records are meaningless and the traversal only needs
+ * to discover each reachable destination once.
+ * Consider: MATCH (a:A)-[:R*]->(b) RETURN DISTINCT b
+ * This optimization switches such traversals with at most one minimum hop
+ * to a frontier based BFS, see CondVarLenTraverseOp_SetReachability. */
+void reduceVarLenTraversal(ExecutionPlan *plan);
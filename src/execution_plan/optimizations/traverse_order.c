@@ -6,209 +6,465 @@
 
 #include "./traverse_order.h"
 #include "../../util/arr.h"
-#include "../../util/vector.h"
 #include "../../util/rmalloc.h"
+#include "rax.h"
+#include <math.h>
+#include <string.h>
 #include <assert.h>
 
-#define T 1     // Transpose penalty.
-#define F 4 * T // Filter score.
-#define L 2 * T // Label score.
-
-typedef AlgebraicExpression **Arrangement;
-
-// Create a new arrangement.
-Arrangement Arrangement_New(uint size) {
-	return rm_malloc(sizeof(AlgebraicExpression *) * size);
+/* Statistics and estimates used to cost arrangements of expressions. */
+typedef struct {
+	uint exp_count;
+	AlgebraicExpression **exps;
+	uint node_count;            // Number of distinct nodes referenced by expressions.
+	QGNode **nodes;             // Distinct nodes referenced by expressions.
+	uint *src;                  // Index of each expression's source node.
+	uint *dest;                 // Index of each expression's destination node.
+	double *node_card;          // Estimated number of graph nodes matching each node's label.
+	double *node_sel;           // Estimated fraction of nodes passing each node's filters.
+	bool *node_indexed;         // Node's filters can be resolved by an index scan.
+	double *fanout;             // Estimated number of destinations reached from a single source.
+	uint *relations;            // Number of non diagonal operands within each expression.
+	uint *transposes;           // Number of operands transposed by each expression.
+	double graph_nodes;         // Number of nodes in the graph.
+	double transpose_penalty;   // Additional cost of a produced record per transposed operand.
+} TraverseOrderCtx;
+
+/* Best known way of resolving a set of expressions. */
+typedef struct {
+	double cost;                // Accumulated cost, INFINITY if set wasn't reached.
+	double card;                // Estimated number of records.
+	uint64_t resolved;          // Resolved nodes.
+	int last;                   // Last expression applied.
+	bool reverse;               // Last expression is traversed from its destination.
+} TraverseOrderState;
+
+static uint _NodeIdx(TraverseOrderCtx *ctx, QGNode *n) {
+	for(uint i = 0; i < ctx->node_count; i++) {
+		if(ctx->nodes[i] == n) return i;
+	}
+	ctx->nodes[ctx->node_count] = n;
+	return ctx->node_count++;
 }
 
-// Clone arrangement.
-Arrangement Arrangement_Clone(const Arrangement arrangement, uint size) {
-	assert(arrangement);
-	Arrangement clone = Arrangement_New(size);
-	memcpy(clone, arrangement, sizeof(AlgebraicExpression *) * size);
-	return clone;
+static inline bool _RangeOp(AST_Operator op) {
+	return (op == OP_LT || op == OP_LE || op == OP_GT || op == OP_GE);
 }
 
-// Print arrangement.
-void Arrangement_Print(Arrangement arrangement, uint size) {
-	printf("Arrangement_Print\n");
-	for(uint i = 0; i < size; i++) {
-		AlgebraicExpression *exp = arrangement[i];
-		/* printf("%d, src: %s, dest: %s\n", i, exp->src_node->alias, exp->dest_node->alias); */
-		printf("%d, src: %u, dest: %u\n", i, exp->src_node->id, exp->dest_node->id);
+// Operator to apply once operands are swapped, a < b iff b > a.
+static inline AST_Operator _SwapOperands(AST_Operator op) {
+	switch(op) {
+	case OP_LT:
+		return OP_GT;
+	case OP_GT:
+		return OP_LT;
+	case OP_LE:
+		return OP_GE;
+	case OP_GE:
+		return OP_LE;
+	default:
+		return op;
 	}
 }
 
-// Free arrangement.
-void Arrangement_Free(Arrangement arrangement) {
-	assert(arrangement);
-	rm_free(arrangement);
-}
+/* Returns the entity property compared by predicate against a value
+ * which doesn't depend on any entity, NULL if predicate isn't of this form.
+ * Sets op such that the predicate reads: property op value,
+ * and constant to the compared value, null if it is only known at runtime. */
+static const char *_ComparedProperty(const FT_FilterNode *f, AST_Operator *op, SIValue *constant) {
+	const AR_ExpNode *prop = NULL;
+	const AR_ExpNode *value = NULL;
+	*op = f->pred.op;
+	if(f->pred.lhs->type == AR_EXP_OPERAND && f->pred.lhs->operand.type == AR_EXP_VARIADIC) {
+		prop = f->pred.lhs;
+		value = f->pred.rhs;
+	} else if(f->pred.rhs->type == AR_EXP_OPERAND && f->pred.rhs->operand.type == AR_EXP_VARIADIC) {
+		prop = f->pred.rhs;
+		value = f->pred.lhs;
+		*op = _SwapOperands(*op);
+	}
+	if(!prop || value->type != AR_EXP_OPERAND || value->operand.type == AR_EXP_VARIADIC) return NULL;
 
-// Computes x!
-static unsigned long factorial(uint x) {
-	unsigned long res = 1;
-	for(int i = 2; i <= x; i++) res *= i;
-	return res;
+	*constant = (value->operand.type == AR_EXP_CONSTANT) ? value->operand.constant : SI_NullVal();
+	return prop->operand.variadic.entity_prop;
 }
 
-// Function to swap values at two pointers.
-static void swap(Arrangement exps, uint i, uint  j) {
-	AlgebraicExpression *temp;
-	temp = exps[i];
-	exps[i] = exps[j];
-	exps[j] = temp;
+/* Estimates the fraction of n's label nodes for which: prop op constant holds,
+ * based on the label's attribute statistics.
+ * Returns a negative value if statistics can't provide an estimate. */
+static double _StatisticsSelectivity(const QGNode *n, const char *prop, AST_Operator op,
+									 SIValue constant, const GraphContext *gc) {
+	if(gc == NULL || n->label == NULL) return -1;
+	Schema *s = GraphContext_GetSchema(gc, n->label, SCHEMA_NODE);
+	if(s == NULL) return -1;
+	double label_nodes = Graph_LabeledNodeCount(gc->g, s->id);
+	if(label_nodes == 0) return -1;
+
+	// Assume at least a single node passes, as statistics are approximate.
+	double min_selectivity = 1 / label_nodes;
+	Attribute_ID id = GraphContext_GetAttributeID(gc, prop);
+	const AttributeStats *a = (id == ATTRIBUTE_NOTFOUND) ? NULL : SchemaStats_GetAttribute(s->stats, id);
+	if(a == NULL || a->count == 0) return min_selectivity;
+
+	// Fraction of nodes holding the attribute, nodes lacking it never pass.
+	double holding = a->count / label_nodes;
+	if(holding > 1) holding = 1;
+
+	double selectivity;
+	if(op == OP_EQUAL) {
+		selectivity = holding / AttributeStats_DistinctCount(a);
+	} else {
+		if(!(SI_TYPE(constant) & SI_NUMERIC) || array_len(a->sample) == 0) return -1;
+		// x > v holds for values not below v inclusively, x >= v for values not below v exclusively.
+		bool inclusive = (op == OP_LE || op == OP_GT);
+		double below = AttributeStats_FractionBelow(a, SI_GET_NUMERIC(constant), inclusive);
+		selectivity = holding * ((op == OP_LT || op == OP_LE) ? below : 1 - below);
+	}
+
+	return (selectivity < min_selectivity) ? min_selectivity : selectivity;
 }
 
-// Computes all permutations of set exps.
-static void permute(Arrangement set, int l, int r, Arrangement **permutations) {
-	int i;
-	if(l == r) {
-		Arrangement permutation = Arrangement_Clone(set, r + 1);
-		*permutations = array_append(*permutations, permutation);
-	} else {
-		for(i = l; i <= r; i++) {
-			swap(set, l, i);
-			permute(set, l + 1, r, permutations);
-			swap(set, l, i);   // backtrack.
+/* Estimates the fraction of node n's records passing filter tree f,
+ * considering only filters which refer to n alone.
+ * Sets indexed if f's selective predicates can be resolved by an index. */
+static double _FilterSelectivity(const FT_FilterNode *f, uint rec_id, const QGNode *n,
+								 const GraphContext *gc, bool *indexed) {
+	if(f == NULL) return 1;
+
+	if(f->t == FT_N_COND) {
+		bool l_indexed = false;
+		bool r_indexed = false;
+		double l = _FilterSelectivity(f->cond.left, rec_id, n, gc, &l_indexed);
+		double r = _FilterSelectivity(f->cond.right, rec_id, n, gc, &r_indexed);
+		if(f->cond.op == OP_AND) {
+			*indexed |= (l_indexed || r_indexed);
+			return l * r;
 		}
+		// OR, both branches must be resolvable by an index.
+		*indexed |= (l_indexed && r_indexed);
+		return l + r - (l * r);
+	}
+
+	// Only consider filters applied to n alone.
+	rax *entities = raxNew();
+	if(f->t == FT_N_PRED) {
+		AR_EXP_CollectEntityIDs(f->pred.lhs, entities);
+		AR_EXP_CollectEntityIDs(f->pred.rhs, entities);
+	} else {
+		AR_EXP_CollectEntityIDs(f->exp.exp, entities);
 	}
+	bool applies = (raxSize(entities) == 1 &&
+					raxFind(entities, (unsigned char *)&rec_id, sizeof(rec_id)) != raxNotFound);
+	raxFree(entities);
+	if(!applies) return 1;
+	if(f->t != FT_N_PRED) return FILTER_SELECTIVITY;
+
+	AST_Operator op;
+	SIValue constant;
+	const char *prop = _ComparedProperty(f, &op, &constant);
+	if(prop == NULL) return FILTER_SELECTIVITY;
+
+	bool equality = (op == OP_EQUAL);
+	if(!equality && !_RangeOp(op)) return FILTER_SELECTIVITY;
+
+	if(gc && n->label && GraphContext_GetIndex(gc, n->label, prop, IDX_EXACT_MATCH)) {
+		*indexed = true;
+	}
+
+	double selectivity = _StatisticsSelectivity(n, prop, op, constant, gc);
+	if(selectivity >= 0) return selectivity;
+	return (equality) ? EQUALITY_SELECTIVITY : RANGE_SELECTIVITY;
+}
+
+// Estimated number of graph nodes matching n's label.
+static double _NodeCardinality(const TraverseOrderCtx *ctx, const QGNode *n, const GraphContext *gc) {
+	if(n->label == NULL) return ctx->graph_nodes;
+	if(gc == NULL) return ctx->graph_nodes * LABEL_SELECTIVITY;
+	// Label doesn't exist.
+	if(n->labelID < 0) return 0;
+	return Graph_LabeledNodeCount(gc->g, n->labelID);
 }
 
-// Computes all possible permutations of exps.
-static Arrangement *permutations(const Arrangement exps, uint exps_count) {
-	// Number of permutations of a set S is |S|!.
-	unsigned long permutation_count = factorial(exps_count);
-	Arrangement *permutations = array_new(Arrangement, permutation_count);
+/* Estimated number of destinations reached by traversing exp from a single source,
+ * labels of the expression's end points are accounted for by their nodes. */
+static double _ExpressionFanout(const TraverseOrderCtx *ctx, const AlgebraicExpression *exp,
+								const GraphContext *gc) {
+	double fanout = 1;
+	for(uint i = 0; i < exp->operand_count; i++) {
+		const AlgebraicExpressionOperand *operand = exp->operands + i;
+		if(operand->diagonal && (i == 0 || i == exp->operand_count - 1)) continue;
+
+		if(gc && operand->operand) {
+			GrB_Index nvals;
+			GrB_Matrix_nvals(&nvals, operand->operand);
+			fanout *= nvals / ctx->graph_nodes;
+		} else if(operand->diagonal) {
+			fanout *= LABEL_SELECTIVITY;
+		}
+	}
 
-	// Compute permutations.
-	permute(exps, 0, exps_count - 1, &permutations);
-	assert(array_len(permutations) == permutation_count);
+	// Variable length traversals reach every node within their hop range.
+	if(exp->edge && QGEdge_VariableLength(exp->edge)) {
+		uint min_hops = exp->edge->minHops;
+		uint max_hops = exp->edge->maxHops;
+		if(max_hops - min_hops > VAR_LEN_ESTIMATED_HOPS) max_hops = min_hops + VAR_LEN_ESTIMATED_HOPS;
+		double reached = 0;
+		for(uint hops = min_hops; hops <= max_hops; hops++) reached += pow(fanout, hops);
+		fanout = reached;
+	}
 
-	return permutations;
+	return fanout;
 }
 
-/* A valid arrangement of expressions is one in which the ith expression
- * source or destination nodes appear in a previous expression k where k < i. */
-static bool valid_arrangement(const Arrangement arrangement, uint exps_count) {
-	AlgebraicExpression *exp = arrangement[0];
-	/* A 1 hop traversals where either the source node
-	 * or destination node is labeled, can't be the opening expression
-	 * in an arrangement.
-	 * Consider: MATCH (a:L0)-[:R*]->(b:L1)
-	 * [L0] * [R] * [L1] but because R is a variable length traversal
-	 * we're dealing with 3 different expressions:
-	 * exp0: [L0]
-	 * exp1: [R]
-	 * exp2: [L1]
-	 * the arrangement where [R] is the first expression:
-	 * exp0: [R]
-	 * exp1: [L0]
-	 * exp2: [L1]
-	 * Isn't valid, as currently the first expression is converted
-	 * into a scan operation. */
-	if((exp->src_node->label || exp->dest_node->label) &&
-	   exp->edge &&
-	   exp->operand_count == 1) return false;
-
-	for(int i = 1; i < exps_count; i++) {
-		exp = arrangement[i];
-		QGNode *src = exp->src_node;
-		QGNode *dest = exp->dest_node;
-		int j = i - 1;
-
-		// Scan previous expressions.
-		for(; j >= 0; j--) {
-			AlgebraicExpression *prev_exp = arrangement[j];
-			if(prev_exp->src_node == src ||
-			   prev_exp->dest_node == src ||
-			   prev_exp->src_node == dest ||
-			   prev_exp->dest_node == dest) break;
+static void _TraverseOrderCtx_Init(TraverseOrderCtx *ctx, AlgebraicExpression **exps, uint exp_count,
+								   const RecordMap *record_map, const FT_FilterNode *filters,
+								   const GraphContext *gc) {
+	ctx->exps = exps;
+	ctx->exp_count = exp_count;
+	ctx->node_count = 0;
+	ctx->nodes = rm_malloc(sizeof(QGNode *) * exp_count * 2);
+	ctx->src = rm_malloc(sizeof(uint) * exp_count);
+	ctx->dest = rm_malloc(sizeof(uint) * exp_count);
+	ctx->fanout = rm_malloc(sizeof(double) * exp_count);
+	ctx->relations = rm_malloc(sizeof(uint) * exp_count);
+	ctx->transposes = rm_malloc(sizeof(uint) * exp_count);
+
+	ctx->graph_nodes = (gc) ? Graph_NodeCount(gc->g) : DEFAULT_NODE_COUNT;
+	if(ctx->graph_nodes < 1) ctx->graph_nodes = 1;
+	// Maintained transposes are read as is.
+	ctx->transpose_penalty = (gc && Graph_MaintainsTransposedMatrices(gc->g)) ? 0 : TRANSPOSE_PENALTY;
+
+	for(uint i = 0; i < exp_count; i++) {
+		AlgebraicExpression *exp = exps[i];
+		ctx->src[i] = _NodeIdx(ctx, exp->src_node);
+		ctx->dest[i] = _NodeIdx(ctx, exp->dest_node);
+		ctx->fanout[i] = _ExpressionFanout(ctx, exp, gc);
+		ctx->relations[i] = 0;
+		ctx->transposes[i] = 0;
+		for(uint j = 0; j < exp->operand_count; j++) {
+			if(exp->operands[j].diagonal) continue;
+			ctx->relations[i]++;
+			if(exp->operands[j].transpose) ctx->transposes[i]++;
 		}
-		/* Nither src or dest nodes are mentioned in previous expressions
-		 * as such the arrangement is invalid. */
-		if(j < 0) return false;
 	}
-	return true;
+
+	ctx->node_card = rm_malloc(sizeof(double) * ctx->node_count);
+	ctx->node_sel = rm_malloc(sizeof(double) * ctx->node_count);
+	ctx->node_indexed = rm_malloc(sizeof(bool) * ctx->node_count);
+	for(uint i = 0; i < ctx->node_count; i++) {
+		QGNode *n = ctx->nodes[i];
+		uint rec_id = RecordMap_LookupID(record_map, n->id);
+		ctx->node_indexed[i] = false;
+		ctx->node_card[i] = _NodeCardinality(ctx, n, gc);
+		ctx->node_sel[i] = _FilterSelectivity(filters, rec_id, n, gc, ctx->node_indexed + i);
+	}
 }
 
-static int penalty_arrangement(Arrangement arrangement, uint exp_count) {
-	int penalty = 0;
-	AlgebraicExpression *exp;
+static void _TraverseOrderCtx_Free(TraverseOrderCtx *ctx) {
+	rm_free(ctx->nodes);
+	rm_free(ctx->src);
+	rm_free(ctx->dest);
+	rm_free(ctx->fanout);
+	rm_free(ctx->relations);
+	rm_free(ctx->transposes);
+	rm_free(ctx->node_card);
+	rm_free(ctx->node_sel);
+	rm_free(ctx->node_indexed);
+}
 
-	// Account for first expression transposes.
-	exp = arrangement[0];
-	for(uint i = 0; i < exp->operand_count; i++) {
-		if(arrangement[0]->operands[i].transpose) penalty += T;
+/* A 1 hop traversal where either the source node
+ * or destination node is labeled, can't be the opening expression.
+ * Consider: MATCH (a:L0)-[:R*]->(b:L1)
+ * [L0] * [R] * [L1] but because R is a variable length traversal
+ * we're dealing with 3 different expressions:
+ * exp0: [L0]
+ * exp1: [R]
+ * exp2: [L1]
+ * the arrangement where [R] is the first expression:
+ * exp0: [R]
+ * exp1: [L0]
+ * exp2: [L1]
+ * Isn't valid, as currently the first expression is converted
+ * into a scan operation. */
+static bool _ValidOpening(const AlgebraicExpression *exp) {
+	return !((exp->src_node->label || exp->dest_node->label) &&
+			 exp->edge &&
+			 exp->operand_count == 1);
+}
+
+/* Cost of opening with expression e, scanning its source
+ * or its destination if reverse is set, sets the number of produced records. */
+static double _OpeningCost(const TraverseOrderCtx *ctx, uint e, bool reverse, double *card) {
+	uint start = (reverse) ? ctx->dest[e] : ctx->src[e];
+	uint other = (reverse) ? ctx->src[e] : ctx->dest[e];
+
+	// Scan start node, an index scan only visits nodes passing its filters.
+	double scanned = ctx->node_card[start] * ctx->node_sel[start];
+	double cost = (ctx->node_indexed[start]) ? scanned : ctx->node_card[start] + scanned;
+
+	double out = scanned * ctx->fanout[e];
+	if(other != start) out *= (ctx->node_card[other] / ctx->graph_nodes) * ctx->node_sel[other];
+	else if(ctx->relations[e] > 0) out /= ctx->graph_nodes;
+
+	uint transposes = (reverse) ? ctx->relations[e] - ctx->transposes[e] : ctx->transposes[e];
+	cost += out * (1 + ctx->transpose_penalty * transposes);
+
+	*card = out;
+	return cost;
+}
+
+/* Cost of applying expression e to card records in which
+ * the expression's source and/or destination are resolved,
+ * sets the number of produced records. */
+static double _StepCost(const TraverseOrderCtx *ctx, uint e, bool src_resolved, bool dest_resolved,
+						double card, double *out) {
+	uint transposes = ctx->transposes[e];
+	double produced = card * ctx->fanout[e];
+	if(ctx->relations[e] == 0) {
+		// Label test of a resolved node, its selectivity was accounted for once the node was reached.
+		produced = card;
+	} else if(src_resolved && dest_resolved) {
+		// Expand into, only records connecting both end points pass.
+		produced /= ctx->graph_nodes;
+	} else {
+		uint reached = (src_resolved) ? ctx->dest[e] : ctx->src[e];
+		produced *= (ctx->node_card[reached] / ctx->graph_nodes) * ctx->node_sel[reached];
+		if(!src_resolved) transposes = ctx->relations[e] - transposes;
 	}
 
-	for(uint i = 1; i < exp_count; i++) {
-		exp = arrangement[i];
-		bool src_resolved = false;
-		QGNode *src = exp->src_node;
+	*out = produced;
+	return produced * (1 + ctx->transpose_penalty * transposes);
+}
 
-		// See if source is already resolved.
-		for(int j = i - 1; j >= 0; j--) {
-			AlgebraicExpression *prev_exp = arrangement[j];
-			if(prev_exp->src_node == src || prev_exp->dest_node == src) {
-				src_resolved = true;
-				break;
+/* Dynamic programming over connected subsets of expressions,
+ * the cheapest way of resolving a set extends the cheapest way of resolving
+ * one of its subsets by a single expression.
+ * Sets order to the best arrangement, returns true if the first expression is reversed. */
+static bool _OrderDP(const TraverseOrderCtx *ctx, bool any_opening, uint *order) {
+	uint exp_count = ctx->exp_count;
+	uint64_t state_count = (uint64_t)1 << exp_count;
+	TraverseOrderState *states = rm_malloc(sizeof(TraverseOrderState) * state_count);
+	for(uint64_t i = 0; i < state_count; i++) states[i].cost = INFINITY;
+
+	// Opening expressions.
+	for(uint e = 0; e < exp_count; e++) {
+		if(!any_opening && !_ValidOpening(ctx->exps[e])) continue;
+		TraverseOrderState *s = states + ((uint64_t)1 << e);
+		for(int reverse = 0; reverse < 2; reverse++) {
+			double card;
+			double cost = _OpeningCost(ctx, e, reverse, &card);
+			if(cost < s->cost) {
+				s->cost = cost;
+				s->card = card;
+				s->resolved = ((uint64_t)1 << ctx->src[e]) | ((uint64_t)1 << ctx->dest[e]);
+				s->last = e;
+				s->reverse = reverse;
 			}
 		}
+	}
 
-		// dest_node must be resolved as we're working with valid arrangemet.
-		if(src_resolved) {
-			// Count how many transposes are performed.
-			for(uint k = 0; k < exp->operand_count; k++) {
-				if(exp->operands[k].transpose) penalty += T;
-			}
-		} else {
-			// Count how many transposes we require to perform.
-			for(uint k = 0; k < exp->operand_count; k++) {
-				if(!exp->operands[k].transpose) penalty += T;
+	/* Subsets precede their supersets numerically,
+	 * extend each reached set by every expression connected to it. */
+	for(uint64_t set = 1; set < state_count; set++) {
+		const TraverseOrderState *s = states + set;
+		if(s->cost == INFINITY) continue;
+
+		for(uint e = 0; e < exp_count; e++) {
+			uint64_t e_bit = (uint64_t)1 << e;
+			if(set & e_bit) continue;
+
+			bool src_resolved = s->resolved & ((uint64_t)1 << ctx->src[e]);
+			bool dest_resolved = s->resolved & ((uint64_t)1 << ctx->dest[e]);
+			if(!src_resolved && !dest_resolved) continue;
+
+			double card;
+			double cost = s->cost + _StepCost(ctx, e, src_resolved, dest_resolved, s->card, &card);
+			TraverseOrderState *next = states + (set | e_bit);
+			if(cost < next->cost) {
+				next->cost = cost;
+				next->card = card;
+				next->resolved = s->resolved | ((uint64_t)1 << ctx->src[e]) | ((uint64_t)1 << ctx->dest[e]);
+				next->last = e;
+				next->reverse = !src_resolved;
 			}
 		}
 	}
 
-	return penalty;
-}
+	// Walk back from the full set.
+	uint64_t set = state_count - 1;
+	assert(states[set].cost != INFINITY);
+	for(int i = exp_count - 1; i >= 0; i--) {
+		order[i] = states[set].last;
+		set &= ~((uint64_t)1 << order[i]);
+	}
+	bool reverse = states[(uint64_t)1 << order[0]].reverse;
 
-static int reward_arrangement(Arrangement arrangement, uint exp_count, const RecordMap *record_map,
-							  const FT_FilterNode *filters) {
-	// Arrangement_Print(arrangement, exp_count);
-	int reward = 0;
-	rax *filtered_entities = FilterTree_CollectModified(filters);
+	rm_free(states);
+	return reverse;
+}
 
-	// A bit naive at the moment.
-	for(uint i = 0; i < exp_count; i++) {
-		AlgebraicExpression *exp = arrangement[i];
-		uint src_id = RecordMap_LookupID(record_map, exp->src_node->id);
-		uint dest_id = RecordMap_LookupID(record_map, exp->dest_node->id);
+/* Orders sets too large for dynamic programming, starting from every opening
+ * expression the cheapest connected expression is repeatedly applied.
+ * Sets order to the best arrangement, returns true if the first expression is reversed. */
+static bool _OrderGreedy(const TraverseOrderCtx *ctx, bool any_opening, uint *order) {
+	uint exp_count = ctx->exp_count;
+	uint candidate[exp_count];
+	bool applied[exp_count];
+	bool resolved[ctx->node_count];
+	double best_cost = INFINITY;
+	bool best_reverse = false;
+
+	for(uint opening = 0; opening < exp_count; opening++) {
+		if(!any_opening && !_ValidOpening(ctx->exps[opening])) continue;
+
+		for(int reverse = 0; reverse < 2; reverse++) {
+			memset(applied, 0, sizeof(applied));
+			memset(resolved, 0, sizeof(resolved));
+
+			double card;
+			double cost = _OpeningCost(ctx, opening, reverse, &card);
+			candidate[0] = opening;
+			applied[opening] = true;
+			resolved[ctx->src[opening]] = true;
+			resolved[ctx->dest[opening]] = true;
+
+			for(uint i = 1; i < exp_count; i++) {
+				double step_cost = INFINITY;
+				double step_card = 0;
+				uint step = 0;
+				for(uint e = 0; e < exp_count; e++) {
+					if(applied[e]) continue;
+					bool src_resolved = resolved[ctx->src[e]];
+					bool dest_resolved = resolved[ctx->dest[e]];
+					if(!src_resolved && !dest_resolved) continue;
+
+					double out;
+					double c = _StepCost(ctx, e, src_resolved, dest_resolved, card, &out);
+					if(c < step_cost) {
+						step_cost = c;
+						step_card = out;
+						step = e;
+					}
+				}
+				assert(step_cost != INFINITY);
+				cost += step_cost;
+				card = step_card;
+				candidate[i] = step;
+				applied[step] = true;
+				resolved[ctx->src[step]] = true;
+				resolved[ctx->dest[step]] = true;
+			}
 
-		if(raxFind(filtered_entities, (unsigned char *)&src_id, sizeof(src_id)) != raxNotFound) {
-			reward += F * (exp_count - i);
-			raxRemove(filtered_entities, (unsigned char *)&src_id, sizeof(src_id), NULL);
-		}
-		if(raxFind(filtered_entities, (unsigned char *)&dest_id, sizeof(dest_id)) != raxNotFound) {
-			reward += F * (exp_count - i);
-			raxRemove(filtered_entities, (unsigned char *)&dest_id, sizeof(dest_id), NULL);
+			if(cost < best_cost) {
+				best_cost = cost;
+				best_reverse = reverse;
+				memcpy(order, candidate, sizeof(candidate));
+			}
 		}
-		if(exp->src_node->label) reward += L * (exp_count - i);
 	}
 
-	// printf("reward: %d\n", reward);
-	raxFree(filtered_entities);
-	return reward;
-}
-
-static int score_arrangement(Arrangement arrangement, uint exp_count, const RecordMap *record_map,
-							 const FT_FilterNode *filters) {
-	int score = 0;
-	int penalty = penalty_arrangement(arrangement, exp_count);
-	int reward = reward_arrangement(arrangement, exp_count, record_map, filters);
-	score -= penalty;
-	score += reward;
-	return score;
+	assert(best_cost != INFINITY);
+	return best_reverse;
 }
 
 // Transpose out-of-order expressions so that each expresson's source is resolved
@@ -233,56 +489,41 @@ static void resolve_winning_sequence(AlgebraicExpression **exps, uint exp_count)
 
 /* Given a set of algebraic expressions representing a graph traversal
  * we pick the order in which the expressions will be evaluated
- * taking into account filters and transposes.
+ * and the node from which evaluation starts, such that the estimated
+ * number of records produced along the way is minimal.
  * exps will reordered. */
 void orderExpressions(AlgebraicExpression **exps, uint exps_count, const RecordMap *record_map,
-					  const FT_FilterNode *filters) {
+					  const FT_FilterNode *filters, const GraphContext *gc) {
 	assert(exps && exps_count > 0);
 
-	// Single expression, return quickly.
-	if(exps_count == 1) return;
-
-	// Compute all possible permutations of algebraic expressions.
-	Arrangement *arrangements = permutations(exps, exps_count);
-	uint arrangement_count = array_len(arrangements);
-	if(arrangement_count == 1) goto cleanup;
+	TraverseOrderCtx ctx;
+	_TraverseOrderCtx_Init(&ctx, exps, exps_count, record_map, filters, gc);
 
-	// Remove invalid arrangements.
-	Arrangement *valid_arrangements = array_new(Arrangement, arrangement_count);
-	for(int i = 0; i < arrangement_count; i++) {
-		if(valid_arrangement(arrangements[i], exps_count)) {
-			valid_arrangements = array_append(valid_arrangements, arrangements[i]);
-		}
-	}
-	uint valid_arrangement_count = array_len(valid_arrangements);
-	assert(valid_arrangement_count > 0);
-
-	/* Score each arrangement,
-	 * keep track after arrangement with highest score. */
-	int max_score = INT_MIN;
-	Arrangement top_arrangement = valid_arrangements[0];
-
-	for(uint i = 0; i < valid_arrangement_count; i++) {
-		Arrangement arrangement = valid_arrangements[i];
-		int score = score_arrangement(arrangement, exps_count, record_map, filters);
-		// printf("score: %d\n", score);
-		// Arrangement_Print(arrangement, exps_count);
-		if(max_score < score) {
-			max_score = score;
-			top_arrangement = arrangement;
+	// Make sure there's at least one valid opening expression.
+	bool any_opening = true;
+	for(uint i = 0; i < exps_count; i++) {
+		if(_ValidOpening(exps[i])) {
+			any_opening = false;
+			break;
 		}
 	}
 
-	array_free(valid_arrangements);
+	uint order[exps_count];
+	bool reverse;
+	if(exps_count <= TRAVERSE_ORDER_DP_MAX_EXPS) reverse = _OrderDP(&ctx, any_opening, order);
+	else reverse = _OrderGreedy(&ctx, any_opening, order);
 
 	// Update input.
-	for(uint i = 0; i < exps_count; i++) exps[i] = top_arrangement[i];
+	AlgebraicExpression *ordered[exps_count];
+	for(uint i = 0; i < exps_count; i++) ordered[i] = exps[order[i]];
+	memcpy(exps, ordered, sizeof(ordered));
+
+	// Open from the expression's destination.
+	if(reverse) AlgebraicExpression_Transpose(exps[0]);
 
 	// Depending on how the expressions have been ordered, we may have to transpose expressions
 	// so that their source nodes have already been resolved by previous expressions.
 	resolve_winning_sequence(exps, exps_count);
 
-cleanup:
-	for(uint i = 0; i < arrangement_count; i++) Arrangement_Free(arrangements[i]);
-	array_free(arrangements);
+	_TraverseOrderCtx_Free(&ctx);
 }
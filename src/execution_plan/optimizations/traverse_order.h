@@ -7,18 +7,37 @@
 #pragma once
 
 #include "../execution_plan.h"
+#include "../../graph/graphcontext.h"
 #include "../../filter_tree/filter_tree.h"
 #include "../../arithmetic/algebraic_expression.h"
 
-typedef enum {
-	TRAVERSE_ORDER_FIRST,
-	TRAVERSE_ORDER_LAST,
-} TRAVERSE_ORDER;
+// Maximum number of expressions ordered by dynamic programming, larger sets are ordered greedily.
+#define TRAVERSE_ORDER_DP_MAX_EXPS 12
 
-/* Reorders exps such that exp[i] is the ith expression to evaluate. */
+// Estimated fraction of nodes passing an equality filter, used when no statistics are available.
+#define EQUALITY_SELECTIVITY 0.1
+// Estimated fraction of nodes passing a range filter, used when no statistics are available.
+#define RANGE_SELECTIVITY 0.3
+// Estimated fraction of records passing an arbitrary filter.
+#define FILTER_SELECTIVITY 0.5
+// Estimated fraction of nodes carrying a label, used when no statistics are available.
+#define LABEL_SELECTIVITY 0.5
+// Number of nodes assumed when no statistics are available.
+#define DEFAULT_NODE_COUNT 1000
+// Additional cost of a record produced by a traversal, per transposed operand,
+// only applies to graphs which do not maintain transposed relation matrices.
+#define TRANSPOSE_PENALTY 0.5
+// Maximum number of hops beyond an edge's minimum accounted for by variable length traversals.
+#define VAR_LEN_ESTIMATED_HOPS 3
+
+/* Reorders exps such that exp[i] is the ith expression to evaluate,
+ * the first expression is transposed if it should be resolved from its destination.
+ * The order minimizes the estimated number of intermediate records, which is
+ * derived from gc's label and relation cardinalities and attribute statistics, gc can be NULL. */
 void orderExpressions(
 	AlgebraicExpression **exps,     // Expressions to order.
 	uint exps_count,                // Number of expressions.
 	const RecordMap *record_map,    // Mapping of entity IDs to Record IDs.
-	const FT_FilterNode *filters    // Filters.
+	const FT_FilterNode *filters,   // Filters.
+	const GraphContext *gc          // Graph statistics are taken from, optional.
 );
@@ -0,0 +1,216 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "plan_cache.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+#include <string.h>
+
+// Detach entry from the recently used list, cache must be locked.
+static void _PlanCache_Unlink(PlanCache *cache, PlanCacheEntry *entry) {
+	if(entry->prev) entry->prev->next = entry->next;
+	else cache->head = entry->next;
+	if(entry->next) entry->next->prev = entry->prev;
+	else cache->tail = entry->prev;
+	entry->prev = NULL;
+	entry->next = NULL;
+
+	raxRemove(cache->lookup, (unsigned char *)entry->query, strlen(entry->query), NULL);
+	cache->size--;
+}
+
+// Returns true if c is a Cypher whitespace character.
+static inline bool _PlanCache_IsSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Returns the number of columns named by a RETURN clause, 0 if clause is NULL.
+static uint _PlanCache_ColumnCount(const cypher_astnode_t *ret_clause) {
+	if(!ret_clause || cypher_ast_return_has_include_existing(ret_clause)) return 0;
+	return cypher_ast_return_nprojections(ret_clause);
+}
+
+// Returns the name of the idx'th column of a RETURN clause.
+static const char *_PlanCache_ColumnName(const cypher_astnode_t *ret_clause, uint idx) {
+	const cypher_astnode_t *projection = cypher_ast_return_get_projection(ret_clause, idx);
+	const cypher_astnode_t *alias = cypher_ast_projection_get_alias(projection);
+	if(!alias) alias = cypher_ast_projection_get_expression(projection);
+	return cypher_ast_identifier_get_name(alias);
+}
+
+// Returns true if both ASTs return the same column names.
+static bool _PlanCache_SameColumns(const AST *a, const AST *b) {
+	const cypher_astnode_t *a_ret = AST_GetClause(a, CYPHER_AST_RETURN);
+	const cypher_astnode_t *b_ret = AST_GetClause(b, CYPHER_AST_RETURN);
+	uint column_count = _PlanCache_ColumnCount(a_ret);
+	if(column_count != _PlanCache_ColumnCount(b_ret)) return false;
+	for(uint i = 0; i < column_count; i++) {
+		if(strcmp(_PlanCache_ColumnName(a_ret, i), _PlanCache_ColumnName(b_ret, i)) != 0) return false;
+	}
+	return true;
+}
+
+char *PlanCache_Key(const char *query) {
+	assert(query);
+	size_t query_len = strlen(query);
+
+	char *key = rm_malloc(query_len + 1);
+	size_t n = 0;
+	bool space = false;     // Whitespace or a comment separates the previous token from the next.
+	const char *c = query;
+	const char *end = query + query_len;
+	while(c < end) {
+		if(_PlanCache_IsSpace(*c)) {
+			space = true;
+			c++;
+		} else if(c[0] == '/' && c[1] == '/') {
+			// Line comment.
+			while(c < end && *c != '\n') c++;
+			space = true;
+		} else if(c[0] == '/' && c[1] == '*') {
+			// Block comment.
+			const char *close = strstr(c + 2, "*/");
+			c = (close) ? close + 2 : end;
+			space = true;
+		} else {
+			if(space && n > 0) key[n++] = ' ';
+			space = false;
+			char quote = *c;
+			if(quote != '\'' && quote != '"' && quote != '`') {
+				key[n++] = *c++;
+				continue;
+			}
+			// Copy quoted string or identifier as is.
+			key[n++] = *c++;
+			while(c < end) {
+				if(*c == '\\' && quote != '`' && c + 1 < end) key[n++] = *c++;
+				else if(*c == quote) break;
+				key[n++] = *c++;
+			}
+			if(c < end) key[n++] = *c++;
+		}
+	}
+
+	key[n] = '\0';
+	return key;
+}
+
+PlanCache *PlanCache_New(uint capacity) {
+	assert(capacity > 0);
+	PlanCache *cache = rm_malloc(sizeof(PlanCache));
+	cache->lookup = raxNew();
+	cache->head = NULL;
+	cache->tail = NULL;
+	cache->size = 0;
+	cache->capacity = capacity;
+	assert(pthread_mutex_init(&cache->lock, NULL) == 0);
+	return cache;
+}
+
+PlanCacheEntry *PlanCacheEntry_New(const char *query, const char *text, uint64_t version,
+								   cypher_parse_result_t *parse_result, AST *ast, ResultSet *result_set,
+								   ExecutionPlan *plan) {
+	assert(query && text && parse_result && ast && plan);
+	PlanCacheEntry *entry = rm_malloc(sizeof(PlanCacheEntry));
+	entry->query = rm_strdup(query);
+	entry->text = rm_strdup(text);
+	entry->version = version;
+	entry->parse_result = parse_result;
+	entry->ast = ast;
+	entry->result_set = result_set;
+	entry->plan = plan;
+	entry->prev = NULL;
+	entry->next = NULL;
+	return entry;
+}
+
+PlanCacheEntry *PlanCache_Checkout(PlanCache *cache, const char *query, const char *text,
+								   const AST *ast, uint64_t version) {
+	assert(cache && query && text);
+
+	assert(pthread_mutex_lock(&cache->lock) == 0);
+	PlanCacheEntry *entry = raxFind(cache->lookup, (unsigned char *)query, strlen(query));
+	if(entry == raxNotFound) {
+		entry = NULL;
+	} else if(strcmp(entry->text, text) != 0 && (!ast || !_PlanCache_SameColumns(entry->ast, ast))) {
+		// Formatting variation naming its columns differently, leave entry in place.
+		entry = NULL;
+	} else {
+		// Entry is used exclusively by the caller until it is released.
+		_PlanCache_Unlink(cache, entry);
+	}
+	assert(pthread_mutex_unlock(&cache->lock) == 0);
+
+	// Plan was built against a previous schema, discard it.
+	if(entry && entry->version != version) {
+		PlanCacheEntry_Free(entry);
+		entry = NULL;
+	}
+
+	return entry;
+}
+
+void PlanCache_Release(PlanCache *cache, PlanCacheEntry *entry, uint64_t version) {
+	assert(cache && entry);
+
+	if(entry->version != version) {
+		PlanCacheEntry_Free(entry);
+		return;
+	}
+
+	// Prepare plan for its next execution.
+	ExecutionPlan_Reset(entry->plan);
+
+	PlanCacheEntry *evicted = NULL;
+	assert(pthread_mutex_lock(&cache->lock) == 0);
+	// The same query might have been cached while this entry was checked out.
+	if(raxTryInsert(cache->lookup, (unsigned char *)entry->query, strlen(entry->query), entry, NULL)) {
+		// Introduce entry as the most recently used entry.
+		entry->next = cache->head;
+		if(cache->head) cache->head->prev = entry;
+		cache->head = entry;
+		if(!cache->tail) cache->tail = entry;
+		cache->size++;
+
+		if(cache->size > cache->capacity) {
+			evicted = cache->tail;
+			_PlanCache_Unlink(cache, evicted);
+		}
+	} else {
+		evicted = entry;
+	}
+	assert(pthread_mutex_unlock(&cache->lock) == 0);
+
+	// Free outside of the lock.
+	if(evicted) PlanCacheEntry_Free(evicted);
+}
+
+void PlanCacheEntry_Free(PlanCacheEntry *entry) {
+	assert(entry);
+	ExecutionPlan_Free(entry->plan);
+	ResultSet_Free(entry->result_set);
+	AST_Free(entry->ast);
+	cypher_parse_result_free(entry->parse_result);
+	rm_free(entry->query);
+	rm_free(entry->text);
+	rm_free(entry);
+}
+
+void PlanCache_Free(PlanCache *cache) {
+	if(!cache) return;
+
+	PlanCacheEntry *entry = cache->head;
+	while(entry) {
+		PlanCacheEntry *next = entry->next;
+		PlanCacheEntry_Free(entry);
+		entry = next;
+	}
+
+	raxFree(cache->lookup);
+	pthread_mutex_destroy(&cache->lock);
+	rm_free(cache);
+}
+
@@ -0,0 +1,72 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "rax.h"
+#include "execution_plan.h"
+#include "../ast/ast.h"
+#include "cypher-parser.h"
+#include <pthread.h>
+
+/* PlanCacheEntry holds an execution plan together with every
+ * object referenced by it, the parse result owning the AST nodes,
+ * the AST and the result set bound to the plan's projections. */
+typedef struct PlanCacheEntry {
+	char *query;                            // Cache key, normalized query text excluding parameters.
+	char *text;                             // Query text plan was built from, excluding parameters.
+	uint64_t version;                       // Graph schema version plan was built against.
+	cypher_parse_result_t *parse_result;    // Parse result owning the AST nodes.
+	AST *ast;                               // AST plan was built from.
+	ResultSet *result_set;                  // Result set populated by plan.
+	ExecutionPlan *plan;                    // Reusable execution plan.
+	struct PlanCacheEntry *prev;            // More recently used entry.
+	struct PlanCacheEntry *next;            // Less recently used entry.
+} PlanCacheEntry;
+
+/* PlanCache is a per graph LRU cache of execution plans keyed by query text,
+ * a plan is used by a single query at a time: a query checks an entry out
+ * of the cache, executes its plan and releases the entry back into the cache. */
+typedef struct PlanCache {
+	rax *lookup;            // Maps query text to its entry.
+	PlanCacheEntry *head;   // Most recently used entry.
+	PlanCacheEntry *tail;   // Least recently used entry.
+	uint size;              // Number of cached entries.
+	uint capacity;          // Maximum number of cached entries.
+	pthread_mutex_t lock;   // Guards cache structure.
+} PlanCache;
+
+/* Build the cache key of a query, given its text excluding parameters.
+ * Comments are dropped and whitespace is collapsed so that formatting
+ * variations of a query share an entry.
+ * Caller is responsible for freeing the returned key. */
+char *PlanCache_Key(const char *query);
+
+/* Create a new plan cache holding up to capacity plans. */
+PlanCache *PlanCache_New(uint capacity);
+
+/* Create a new cache entry, entry takes ownership over all given objects. */
+PlanCacheEntry *PlanCacheEntry_New(const char *query, const char *text, uint64_t version,
+								   cypher_parse_result_t *parse_result, AST *ast, ResultSet *result_set,
+								   ExecutionPlan *plan);
+
+/* Remove and return the entry cached for query, built from the exact same text,
+ * or if ast is specified, from a formatting variation of text returning the same columns,
+ * as unaliased columns are named after the query text.
+ * Returns NULL if query isn't cached or its plan was built against an older version. */
+PlanCacheEntry *PlanCache_Checkout(PlanCache *cache, const char *query, const char *text,
+								   const AST *ast, uint64_t version);
+
+/* Return an executed entry to the cache, evicting the least recently used entry
+ * if the cache is full, entries built against an older version are discarded. */
+void PlanCache_Release(PlanCache *cache, PlanCacheEntry *entry, uint64_t version);
+
+/* Free cache entry and all objects owned by it. */
+void PlanCacheEntry_Free(PlanCacheEntry *entry);
+
+/* Free plan cache and all of its entries. */
+void PlanCache_Free(PlanCache *cache);
+
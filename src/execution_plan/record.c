@@ -93,6 +93,13 @@ void Record_Merge(Record *a, const Record b) {
 	}
 }
 
+void Record_PersistScalars(Record r) {
+	int length = Record_length(r);
+	for(int i = 0; i < length; i++) {
+		if(r[i].type == REC_TYPE_SCALAR) SIValue_Persist(&r[i].value.s);
+	}
+}
+
 void Record_TransferEntries(Record *to, Record from) {
 	int aLength = Record_length(*to);
 	int bLength = Record_length(from);
@@ -279,6 +286,16 @@ unsigned long long Record_Hash64(const Record r) {
 	return hash;
 }
 
+void Record_Clear(Record r) {
+	unsigned int length = Record_length(r);
+	for(unsigned int i = 0; i < length; i++) {
+		if(r[i].type == REC_TYPE_SCALAR) {
+			SIValue_Free(&r[i].value.s);
+		}
+	}
+	memset(r, 0, sizeof(Entry) * length);
+}
+
 void Record_Free(Record r) {
 	unsigned int length = Record_length(r);
 	for(unsigned int i = 0; i < length; i++) {
@@ -50,6 +50,9 @@ void Record_Truncate(Record r, uint count);
 // Merge record b into a, sharing any nested references in b with a.
 void Record_Merge(Record *a, const Record b);
 
+// Persist record's scalars, such that the record owns all of its values.
+void Record_PersistScalars(Record r);
+
 // Merge record b into a, transfer value ownership from b to a.
 void Record_TransferEntries(Record *to, Record from);
 
@@ -92,6 +95,9 @@ size_t Record_ToString(const Record r, char **buf, size_t *buf_cap);
 // 64-bit hash of record
 unsigned long long Record_Hash64(const Record r);
 
+// Free record entries, retaining the record allocation for reuse.
+void Record_Clear(Record r);
+
 // Free record.
 void Record_Free(Record r);
 
@@ -0,0 +1,72 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "record_batch.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+RecordBatch *RecordBatch_New(uint record_len) {
+	RecordBatch *batch = rm_malloc(sizeof(RecordBatch));
+	// Record slots are allocated on first use.
+	batch->records = rm_calloc(RECORD_BATCH_CAPACITY, sizeof(Record));
+	batch->selection = rm_malloc(sizeof(uint16_t) * RECORD_BATCH_CAPACITY);
+	batch->count = 0;
+	batch->selected = 0;
+	batch->record_len = record_len;
+	batch->depleted = false;
+	return batch;
+}
+
+Record RecordBatch_NewRecord(RecordBatch *batch) {
+	assert(!RecordBatch_IsFull(batch));
+
+	Record r = batch->records[batch->count];
+	if(r == NULL) {
+		r = Record_New(batch->record_len);
+		batch->records[batch->count] = r;
+	} else if(Record_length(r) < batch->record_len) {
+		// Slot was previously occupied by a shorter appended record.
+		Record_Extend(&r, batch->record_len);
+		batch->records[batch->count] = r;
+	}
+
+	batch->selection[batch->selected++] = batch->count++;
+	return r;
+}
+
+void RecordBatch_Append(RecordBatch *batch, Record r) {
+	assert(!RecordBatch_IsFull(batch));
+
+	// Replace any record previously allocated for this slot.
+	Record prev = batch->records[batch->count];
+	if(prev) Record_Free(prev);
+
+	batch->records[batch->count] = r;
+	batch->selection[batch->selected++] = batch->count++;
+}
+
+void RecordBatch_Clear(RecordBatch *batch) {
+	for(uint i = 0; i < batch->count; i++) Record_Clear(batch->records[i]);
+	batch->count = 0;
+	batch->selected = 0;
+}
+
+void RecordBatch_Reset(RecordBatch *batch) {
+	RecordBatch_Clear(batch);
+	batch->depleted = false;
+}
+
+void RecordBatch_Free(RecordBatch *batch) {
+	if(!batch) return;
+
+	for(uint i = 0; i < RECORD_BATCH_CAPACITY; i++) {
+		if(batch->records[i]) Record_Free(batch->records[i]);
+	}
+	rm_free(batch->records);
+	rm_free(batch->selection);
+	rm_free(batch);
+}
+
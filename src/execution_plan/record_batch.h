@@ -0,0 +1,57 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "record.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Maximum number of records a batch can hold.
+#define RECORD_BATCH_CAPACITY 1024
+
+/* RecordBatch is a fixed capacity set of records passed between operations
+ * in a single call, records are allocated once and reused by later batches.
+ * A selection vector lists the records which are part of the batch,
+ * such that an operation can drop records without moving them, e.g. filter. */
+typedef struct RecordBatch {
+	Record *records;        // Record slots, reused across batches.
+	uint16_t *selection;    // Indices of selected records.
+	uint count;             // Number of populated records.
+	uint selected;          // Number of selected records.
+	uint record_len;        // Minimum length of records handed out by the batch.
+	bool depleted;          // Batch producer is depleted.
+} RecordBatch;
+
+// Create a new empty batch handing out records of length record_len.
+RecordBatch *RecordBatch_New(uint record_len);
+
+// Returns true if batch has no room for additional records.
+static inline bool RecordBatch_IsFull(const RecordBatch *batch) {
+	return batch->count == RECORD_BATCH_CAPACITY;
+}
+
+// Returns the idx'th selected record.
+static inline Record RecordBatch_Get(const RecordBatch *batch, uint idx) {
+	return batch->records[batch->selection[idx]];
+}
+
+/* Populate the next record slot of the batch and select it,
+ * returned record is empty and owned by the batch. */
+Record RecordBatch_NewRecord(RecordBatch *batch);
+
+// Append record to batch and select it, batch takes ownership over record.
+void RecordBatch_Append(RecordBatch *batch, Record r);
+
+// Empty batch, record allocations are retained for reuse.
+void RecordBatch_Clear(RecordBatch *batch);
+
+// Empty batch and mark its producer as active.
+void RecordBatch_Reset(RecordBatch *batch);
+
+// Free batch and all of its records.
+void RecordBatch_Free(RecordBatch *batch);
+
@@ -9,6 +9,7 @@
 #include "../util/arr.h"
 #include "../ast/ast_shared.h"
 #include <assert.h>
+#include <string.h>
 
 /* forward declarations */
 void _FilterTree_DeMorgan(FT_FilterNode **root, uint negate_count);
@@ -129,9 +130,39 @@ Vector *FilterTree_SubTrees(const FT_FilterNode *root) {
 	return sub_trees;
 }
 
-/* Applies a single filter to a single result.
- * Compares given values, tests if values maintain desired relation (op) */
-int _applyFilter(SIValue *aVal, SIValue *bVal, AST_Operator op) {
+static inline int _CompareIntegers(int64_t a, int64_t b, AST_Operator op) {
+	switch(op) {
+	case OP_EQUAL:
+		return a == b;
+	case OP_NEQUAL:
+		return a != b;
+	case OP_GT:
+		return a > b;
+	case OP_GE:
+		return a >= b;
+	case OP_LT:
+		return a < b;
+	case OP_LE:
+		return a <= b;
+	default:
+		/* Op should be enforced by AST. */
+		assert(0);
+	}
+	return 0;
+}
+
+int FilterTree_CompareValues(const SIValue *aVal, const SIValue *bVal, AST_Operator op) {
+	// Fast paths, integers and string (in)equality are compared directly.
+	if(aVal->type == T_INT64 && bVal->type == T_INT64) {
+		return _CompareIntegers(aVal->longval, bVal->longval, op);
+	}
+	if(aVal->type == T_STRING && bVal->type == T_STRING && (op == OP_EQUAL || op == OP_NEQUAL)) {
+		// Interned strings are equal if they share the same address.
+		bool equal = (aVal->stringval == bVal->stringval ||
+					  strcmp(aVal->stringval, bVal->stringval) == 0);
+		return (op == OP_EQUAL) ? equal : !equal;
+	}
+
 	int disjointOrNull = 0;
 	int rel = SIValue_Compare(*aVal, *bVal, &disjointOrNull);
 	// If there was null comparison, return false.
@@ -171,7 +202,7 @@ int _applyPredicateFilters(const FT_FilterNode *root, const Record r) {
 	SIValue lhs = AR_EXP_Evaluate(root->pred.lhs, r);
 	SIValue rhs = AR_EXP_Evaluate(root->pred.rhs, r);
 
-	int ret = _applyFilter(&lhs, &rhs, root->pred.op);
+	int ret = FilterTree_CompareValues(&lhs, &rhs, root->pred.op);
 
 	SIValue_Free(&lhs);
 	SIValue_Free(&rhs);
@@ -388,6 +419,31 @@ void FilterTree_Print(const FT_FilterNode *root) {
 	_FilterTree_Print(root, 0);
 }
 
+FT_FilterNode *FilterTree_Clone(const FT_FilterNode *root) {
+	if(root == NULL) return NULL;
+
+	FT_FilterNode *clone = NULL;
+	switch(root->t) {
+	case FT_N_EXP:
+		clone = FilterTree_CreateExpressionFilter(AR_EXP_Clone(root->exp.exp));
+		break;
+	case FT_N_PRED:
+		clone = FilterTree_CreatePredicateFilter(root->pred.op,
+												 AR_EXP_Clone(root->pred.lhs),
+												 AR_EXP_Clone(root->pred.rhs));
+		break;
+	case FT_N_COND:
+		clone = FilterTree_CreateConditionFilter(root->cond.op);
+		AppendLeftChild(clone, FilterTree_Clone(root->cond.left));
+		AppendRightChild(clone, FilterTree_Clone(root->cond.right));
+		break;
+	default:
+		assert(false);
+	}
+
+	return clone;
+}
+
 void FilterTree_Free(FT_FilterNode *root) {
 	if(root == NULL) return;
 	switch(root->t) {
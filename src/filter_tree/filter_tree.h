@@ -82,6 +82,10 @@ FT_FilterNode *FilterTree_CreatePredicateFilter(AST_Operator op, AR_ExpNode *lhs
 /* Creates a new condition node. */
 FT_FilterNode *FilterTree_CreateConditionFilter(AST_Operator op);
 
+/* Tests if a and b maintain relation op,
+ * comparisons against null fail, disjoint values are only unequal. */
+int FilterTree_CompareValues(const SIValue *a, const SIValue *b, AST_Operator op);
+
 /* Runs val through the filter tree. */
 int FilterTree_applyFilters(const FT_FilterNode *root, const Record r);
 
@@ -111,5 +115,8 @@ void FilterTree_DeMorgan(FT_FilterNode **root);
 /* Prints tree. */
 void FilterTree_Print(const FT_FilterNode *root);
 
+/* Clones tree. */
+FT_FilterNode *FilterTree_Clone(const FT_FilterNode *root);
+
 /* Free tree. */
 void FilterTree_Free(FT_FilterNode *root);
@@ -0,0 +1,309 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "ft_to_rsq.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../util/range/string_range.h"
+#include "../util/range/numeric_range.h"
+#include <assert.h>
+
+/* Reverse an inequality symbol so that indices can support
+ * inequalities with right-hand variables. */
+static int _reverseOp(int op) {
+	switch(op) {
+	case OP_LT:
+		return OP_GT;
+	case OP_LE:
+		return OP_GE;
+	case OP_GT:
+		return OP_LT;
+	case OP_GE:
+		return OP_LE;
+	default:
+		return op;
+	}
+}
+
+/* Modifies filter tree such that the left-hand side
+ * is of type variadic and the right-hand side is constant. */
+static void _normalize_filter(FT_FilterNode *filter) {
+	// Normalize, left hand side should be variadic, right hand side const.
+	if(filter->pred.rhs->operand.type == AR_EXP_VARIADIC) {
+		// Swap.
+		AR_ExpNode *tmp = filter->pred.rhs;
+		filter->pred.rhs = filter->pred.lhs;
+		filter->pred.lhs = tmp;
+		filter->pred.op = _reverseOp(filter->pred.op);
+	}
+}
+
+// Evaluate predicate's right-hand side, either a constant or a parameter.
+static inline SIValue _predicateValue(const FT_FilterNode *filter) {
+	return AR_EXP_Evaluate(filter->pred.rhs, NULL);
+}
+
+// Index can only resolve predicates against numeric, boolean and string values.
+static inline bool _indexableValue(SIValue v) {
+	return SI_TYPE(v) & (SI_NUMERIC | T_STRING | T_BOOL);
+}
+
+/* Create a RediSearch query node out of a numeric range object. */
+static RSQNode *_NumericRangeToQueryNode(RSIndex *idx, const char *field,
+										 const NumericRange *range) {
+	double max = (range->max == INFINITY) ? RSRANGE_INF : range->max;
+	double min = (range->min == -INFINITY) ? RSRANGE_NEG_INF : range->min;
+	return RediSearch_CreateNumericNode(idx, field, max, min, range->include_max, range->include_min);
+}
+
+/* Create a RediSearch query node out of a string range object. */
+static RSQNode *_StringRangeToQueryNode(RSIndex *idx, const char *field,
+										const StringRange *range) {
+	const char *max = (range->max == NULL) ? RSLECRANGE_INF : range->max;
+	const char *min = (range->min == NULL) ? RSLEXRANGE_NEG_INF : range->min;
+	RSQNode *root = RediSearch_CreateTagNode(idx, field);
+	RSQNode *child = RediSearch_CreateLexRangeNode(idx, field, min, max,
+												   range->include_min,
+												   range->include_max);
+	RediSearch_QueryNodeAddChild(root, child);
+	return root;
+}
+
+/* Creates a RediSearch query node out of given filter tree. */
+static RSQNode *_filterTreeToQueryNode(FT_FilterNode *filter, RSIndex *sp) {
+	RSQNode *node = NULL;
+	RSQNode *parent = NULL;
+
+	if(filter->t == FT_N_COND) {
+		RSQNode *left = NULL;
+		RSQNode *right = NULL;
+		switch(filter->cond.op) {
+		case OP_OR:
+			node = RediSearch_CreateUnionNode(sp);
+			left = _filterTreeToQueryNode(filter->cond.left, sp);
+			right = _filterTreeToQueryNode(filter->cond.right, sp);
+			RediSearch_QueryNodeAddChild(node, left);
+			RediSearch_QueryNodeAddChild(node, right);
+			break;
+		case OP_AND:
+			node = RediSearch_CreateIntersectNode(sp, false);
+			left = _filterTreeToQueryNode(filter->cond.left, sp);
+			right = _filterTreeToQueryNode(filter->cond.right, sp);
+			RediSearch_QueryNodeAddChild(node, left);
+			RediSearch_QueryNodeAddChild(node, right);
+			break;
+		default:
+			assert("unexpected conditional operation");
+		}
+	} else if(filter->t == FT_N_PRED) {
+		// Make sure left hand side is variadic and right hand side is constant.
+		_normalize_filter(filter);
+		double d;
+		const char *field = filter->pred.lhs->operand.variadic.entity_prop;
+		SIValue v = _predicateValue(filter);
+		switch(SI_TYPE(v)) {
+		case T_STRING:
+			parent = RediSearch_CreateTagNode(sp, field);
+			switch(filter->pred.op) {
+			case OP_LT:    // <
+				node = RediSearch_CreateLexRangeNode(sp, field, RSLEXRANGE_NEG_INF, v.stringval, 0, 0);
+				break;
+			case OP_LE:    // <=
+				node = RediSearch_CreateLexRangeNode(sp, field, RSLEXRANGE_NEG_INF, v.stringval, 0, 1);
+				break;
+			case OP_GT:    // >
+				node = RediSearch_CreateLexRangeNode(sp, field, v.stringval, RSLECRANGE_INF, 0, 0);
+				break;
+			case OP_GE:    // >=
+				node = RediSearch_CreateLexRangeNode(sp, field, v.stringval, RSLECRANGE_INF, 1, 0);
+				break;
+			case OP_EQUAL:  // ==
+				node = RediSearch_CreateTokenNode(sp, field, v.stringval);
+				break;
+			case OP_NEQUAL: // !=
+				assert("Index can't utilize the 'not equals' operation.");
+				break;
+			default:
+				assert("unexpected operation");
+			}
+
+			RediSearch_QueryNodeAddChild(parent, node);
+			node = parent;
+			break;
+
+		case T_DOUBLE:
+		case T_INT64:
+		case T_BOOL:
+			d = SI_GET_NUMERIC(v);
+			switch(filter->pred.op) {
+			case OP_LT:    // <
+				node = RediSearch_CreateNumericNode(sp, field, d, RSRANGE_NEG_INF, false, false);
+				break;
+			case OP_LE:    // <=
+				node = RediSearch_CreateNumericNode(sp, field, d, RSRANGE_NEG_INF, true, false);
+				break;
+			case OP_GT:    // >
+				node = RediSearch_CreateNumericNode(sp, field, RSRANGE_INF, d, false, false);
+				break;
+			case OP_GE:    // >=
+				node = RediSearch_CreateNumericNode(sp, field, RSRANGE_INF, d, false, true);
+				break;
+			case OP_EQUAL:  // ==
+				node = RediSearch_CreateNumericNode(sp, field, d, d, true, true);
+				break;
+			case OP_NEQUAL: // !=
+				assert("Index can't utilize the 'not equals' operation.");
+				break;
+			default:
+				assert("unexpected operation");
+			}
+			break;
+		default:
+			// Parameter of a type which can't be matched by the index, e.g. NULL.
+			node = RediSearch_CreateEmptyNode(sp);
+		}
+	} else {
+		assert("unknow filter tree node type");
+	}
+	return node;
+}
+
+/* Reduce filter into a range object
+ * Returns false if filter's value can't be resolved by the index. */
+static bool _predicateTreeToRange(FT_FilterNode *tree, rax *string_ranges,
+								  rax *numeric_ranges) {
+	// Simple predicate trees are used to build up a range object.
+	_normalize_filter(tree);
+	assert(tree->pred.lhs->operand.type == AR_EXP_VARIADIC);
+
+	int op = tree->pred.op;
+	SIValue c = _predicateValue(tree);
+	if(!_indexableValue(c)) return false;
+
+	const char *prop = tree->pred.lhs->operand.variadic.entity_prop;
+	StringRange *sr = raxFind(string_ranges, (unsigned char *)prop, strlen(prop));
+	NumericRange *nr = raxFind(numeric_ranges, (unsigned char *)prop, strlen(prop));
+
+	// Get or create range object for alias.prop.
+	if(SI_TYPE(c) & SI_NUMERIC || SI_TYPE(c) == T_BOOL) {
+		// Create if doesn't exists.
+		if(nr == raxNotFound) {
+			nr = NumericRange_New();
+			raxTryInsert(numeric_ranges, (unsigned char *)prop, strlen(prop), nr, NULL);
+		}
+		NumericRange_TightenRange(nr, op, SI_GET_NUMERIC(c));
+	} else {
+		// Create if doesn't exists.
+		if(sr == raxNotFound) {
+			sr = StringRange_New();
+			raxTryInsert(string_ranges, (unsigned char *)prop, strlen(prop), sr, NULL);
+		}
+		StringRange_TightenRange(sr, op, c.stringval);
+	}
+
+	return true;
+}
+
+RSQNode *FilterTree_ToIndexQuery(FT_FilterNode **filters, RSIndex *idx) {
+	assert(filters && idx);
+
+	RSQNode *root = NULL;
+	rax *string_ranges = raxNew();
+	rax *numeric_ranges = raxNew();
+	RSQNode **rsqnodes = array_new(RSQNode *, 1);
+
+	/* Reduce filters into ranges.
+	 * we differentiate between between numeric filters
+	 * and string filters. */
+	uint filters_count = array_len(filters);
+	for(uint i = 0; i < filters_count; i++) {
+		FT_FilterNode *filter_tree = filters[i];
+
+		if(filter_tree->t == FT_N_PRED) {
+			if(!_predicateTreeToRange(filter_tree, string_ranges, numeric_ranges)) {
+				root = RediSearch_CreateEmptyNode(idx);
+				goto cleanup;
+			}
+		} else {
+			// OR trees are directly converted into RSQnodes.
+			RSQNode *rsqnode = _filterTreeToQueryNode(filter_tree, idx);
+			rsqnodes = array_append(rsqnodes, rsqnode);
+		}
+	}
+
+	/* Build RediSearch query tree
+	 * Convert each range object to RediSearch query node. */
+	raxIterator it;
+	raxStart(&it, string_ranges);
+	raxSeek(&it, "^", NULL, 0);
+	char query_field_name[1024];
+	while(raxNext(&it)) {
+		char *field = (char *)it.key;
+
+		/* Make sure each property is bound to either numeric or string type
+		 * but not to both, e.g. a.v = 1 AND a.v = 'a'
+		 * in which case use an empty RSQueryNode. */
+		if(raxFind(numeric_ranges, (unsigned char *)field, (int)it.key_len) != raxNotFound) {
+			root = RediSearch_CreateEmptyNode(idx);
+			raxStop(&it);
+			goto cleanup;
+		}
+
+		StringRange *sr = raxFind(string_ranges, (unsigned char *)field, (int)it.key_len);
+		if(!StringRange_IsValid(sr)) {
+			root = RediSearch_CreateEmptyNode(idx);
+			raxStop(&it);
+			goto cleanup;
+		}
+
+		sprintf(query_field_name, "%.*s", (int)it.key_len, field);
+		RSQNode *rsqn = _StringRangeToQueryNode(idx, query_field_name, sr);
+		rsqnodes = array_append(rsqnodes, rsqn);
+	}
+	raxStop(&it);
+
+	raxStart(&it, numeric_ranges);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) {
+		char *field = (char *)it.key;
+		NumericRange *nr = raxFind(numeric_ranges, (unsigned char *)field, (int)it.key_len);
+
+		// return empty RSQueryNode.
+		if(!NumericRange_IsValid(nr)) {
+			root = RediSearch_CreateEmptyNode(idx);
+			raxStop(&it);
+			goto cleanup;
+		}
+
+		sprintf(query_field_name, "%.*s", (int)it.key_len, field);
+		RSQNode *rsqn = _NumericRangeToQueryNode(idx, query_field_name, nr);
+		rsqnodes = array_append(rsqnodes, rsqn);
+	}
+	raxStop(&it);
+
+	// Connect all RediSearch query nodes.
+	uint rsqnode_count = array_len(rsqnodes);
+	assert(rsqnode_count > 0);
+
+	// Just a single filter.
+	if(rsqnode_count == 1) {
+		root = array_pop(rsqnodes);
+	} else {
+		// Multiple filters, combine using AND.
+		root = RediSearch_CreateIntersectNode(idx, false);
+		for(uint i = 0; i < rsqnode_count; i++) {
+			RSQNode *qnode = array_pop(rsqnodes);
+			RediSearch_QueryNodeAddChild(root, qnode);
+		}
+	}
+
+cleanup:
+	raxFreeWithCallback(string_ranges, (void(*)(void *))StringRange_Free);
+	raxFreeWithCallback(numeric_ranges, (void(*)(void *))NumericRange_Free);
+	array_free(rsqnodes);
+	return root;
+}
+
@@ -0,0 +1,18 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "filter_tree.h"
+#include "redisearch_api.h"
+
+/* Convert filters into a single RediSearch query tree, combining filters using AND.
+ * Each filter is either a simple predicate: n.v op x, where lhs is variadic
+ * and x is either a constant or a query parameter, or an OR tree of such predicates.
+ * Predicates right-hand side is evaluated upon conversion, as such a query
+ * tree can only be built once query parameters are known. */
+RSQNode *FilterTree_ToIndexQuery(FT_FilterNode **filters, RSIndex *idx);
+
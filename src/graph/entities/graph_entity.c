@@ -9,6 +9,7 @@
 #include "graph_entity.h"
 #include "../../query_ctx.h"
 #include "../../util/rmalloc.h"
+#include "../../util/string_pool.h"
 #include "../graphcontext.h"
 #include "node.h"
 #include "edge.h"
@@ -46,6 +47,17 @@ static void _GraphEntity_RemoveProperty(const GraphEntity *e, Attribute_ID attr_
 	}
 }
 
+/* Produce the value to store as an entity property,
+ * strings are interned within the graph's string pool. */
+static SIValue _GraphEntity_PropertyValue(SIValue value) {
+	if(SI_TYPE(value) != T_STRING) return SI_CloneValue(value);
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	if(gc == NULL || gc->string_pool == NULL) return SI_CloneValue(value);
+
+	return SI_InternedStringVal(StringPool_Intern(gc->string_pool, value.stringval));
+}
+
 /* Add a new property to entity */
 SIValue *GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value) {
 	if(e->entity->properties == NULL) {
@@ -57,7 +69,7 @@ SIValue *GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue v
 
 	int prop_idx = e->entity->prop_count;
 	e->entity->properties[prop_idx].id = attr_id;
-	e->entity->properties[prop_idx].value = SI_CloneValue(value);
+	e->entity->properties[prop_idx].value = _GraphEntity_PropertyValue(value);
 	e->entity->prop_count++;
 
 	return &(e->entity->properties[prop_idx].value);
@@ -87,8 +99,10 @@ void GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue
 
 	SIValue *prop = GraphEntity_GetProperty(e, attr_id);
 	assert(prop != PROPERTY_NOTFOUND);
+	// Acquire new value before releasing the old one, as both might share a string.
+	SIValue new_value = _GraphEntity_PropertyValue(value);
 	SIValue_Free(prop);
-	*prop = SI_CloneValue(value);
+	*prop = new_value;
 }
 
 size_t GraphEntity_PropertiesToString(const GraphEntity *e, char **buffer, size_t *bufferLen,
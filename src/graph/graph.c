@@ -12,74 +12,11 @@
 #include "../GraphBLASExt/GxB_Delete.h"
 #include "../util/rmalloc.h"
 
-static GrB_BinaryOp _graph_edge_accum = NULL;
-
 /* ========================= Forward declarations  ========================= */
 void _MatrixResizeToCapacity(const Graph *g, GrB_Matrix m);
 
-
-/* ========================= GraphBLAS functions ========================= */
-void _edge_accum(void *_z, const void *_x, const void *_y) {
-	EdgeID *z = (EdgeID *)_z;
-	const EdgeID *x = (const EdgeID *)_x;
-	const EdgeID *y = (const EdgeID *)_y;
-
-	EdgeID *ids;
-	/* Single edge ID,
-	 * switching from single edge ID to multiple IDs. */
-	if(SINGLE_EDGE(*x)) {
-		ids = array_new(EdgeID, 2);
-		ids = array_append(ids, SINGLE_EDGE_ID(*x));
-		ids = array_append(ids, SINGLE_EDGE_ID(*y));
-		// TODO: Make sure MSB of ids isn't on.
-		*z = (EdgeID)ids;
-	} else {
-		// Multiple edges, adding another edge.
-		ids = (EdgeID *)(*x);
-		ids = array_append(ids, SINGLE_EDGE_ID(*y));
-		*z = (EdgeID)ids;
-	}
-}
-
-bool _select_op_free_edge(GrB_Index i, GrB_Index j, GrB_Index nrows, GrB_Index ncols, const void *x,
-						  const void *thunk) {
-	// K is a uint64_t pointer which points to the address of our graph.
-	const Graph *g = (const Graph *) * ((uint64_t *)thunk);
-	const EdgeID *id = (const EdgeID *)x;
-	if((SINGLE_EDGE(*id))) {
-		DataBlock_DeleteItem(g->edges, SINGLE_EDGE_ID(*id));
-	} else {
-		/* Due to GraphBLAS V3.0+ parallelism
-		 * _select_op_free_edge will be called twice
-		 * Tim: "In my draft parallel GraphBLAS,
-		 * most of my codes take 2 passes over the data.
-		 * It's what Intel calls the Inspector / Executor model of computing.
-		 * Both passes are fully parallel.
-		 * The first pass is purely symbolic,
-		 * and it figures out where all the output data needs to go.
-		 * The 2nd pass fills in the data in the output."
-		 *
-		 * To avoid double freeing we'll place a marker on the first pass:
-		 * ids[0] = INVALID_ENTITY_ID
-		 * to be picked up by the second pass, on which the array will be freed. */
-		EdgeID *ids = (EdgeID *)(*id);
-
-		// Check for first pass marker.
-		if(ids[0] != INVALID_ENTITY_ID) {
-			uint id_count = array_len(ids);
-			for(uint i = 0; i < id_count; i++) {
-				DataBlock_DeleteItem(g->edges, ids[i]);
-			}
-			// Place first pass marker for second pass to pick up on.
-			ids[0] = INVALID_ENTITY_ID;
-		} else {
-			// Second pass, simply free the array.
-			array_free(ids);
-		}
-	}
-
-	return false;
-}
+// Flag indicating whether graphs maintain transposed relation matrices.
+extern bool maintain_transposed_matrices;
 
 /* ========================= Synchronization functions ========================= */
 
@@ -104,9 +41,15 @@ void Graph_AcquireWriteLock(Graph *g) {
 	g->_writelocked = true;
 }
 
-/* Release the held lock */
+static void _Graph_FlushAllPendingEdges(Graph *g);
+
+/* Release the held lock, a writer's pending edges are committed
+ * while the graph is still exclusively held. */
 void Graph_ReleaseLock(Graph *g) {
-	g->_writelocked = false;
+	if(g->_writelocked) {
+		_Graph_FlushAllPendingEdges(g);
+		g->_writelocked = false;
+	}
 	pthread_rwlock_unlock(&g->_rwlock);
 }
 
@@ -146,15 +89,133 @@ size_t _Graph_EdgeCap(const Graph *g) {
 	return g->edges->itemCap;
 }
 
+#define PENDING_EDGE_ISLT(a, b) \
+	((a)->src < (b)->src || \
+	 ((a)->src == (b)->src && ((a)->dest < (b)->dest || \
+							   ((a)->dest == (b)->dest && (a)->id < (b)->id))))
+
+/* Write pending edges of relation r into its mapping matrix.
+ * Edges connecting the same pair of nodes are grouped, such that each
+ * mapping matrix entry is set once, pairs connected by multiple edges
+ * are assigned a slot within the relation's multi edge table. */
+static void _Graph_FlushPendingEdges(Graph *g, int r) {
+	PendingEdge *pending = g->_pending_edges[r];
+	uint32_t pending_count = array_len(pending);
+	if(pending_count == 0) return;
+
+	GrB_Matrix M = g->_relations_map[r];
+	MultiEdgeTable *t = g->_multi_edges[r];
+
+	QSORT(PendingEdge, pending, pending_count, PENDING_EDGE_ISLT);
+
+	/* Make sure M has no pending operations, otherwise each extraction
+	 * below would force GraphBLAS to merge the assignments made so far.
+	 * All extractions are performed prior to any assignment. */
+	_Graph_ApplyPending(M);
+
+	uint32_t group_count = 0;
+	EdgeID *ids = array_new(EdgeID, 8);
+	for(uint32_t i = 0; i < pending_count;) {
+		NodeID src = pending[i].src;
+		NodeID dest = pending[i].dest;
+		array_clear(ids);
+
+		EdgeID entry;
+		bool update = true;
+		GrB_Info res = GrB_Matrix_extractElement_UINT64(&entry, M, src, dest);
+		if(res == GrB_SUCCESS && SINGLE_EDGE(entry)) {
+			ids = array_append(ids, SINGLE_EDGE_ID(entry));
+		}
+
+		for(; i < pending_count && pending[i].src == src && pending[i].dest == dest; i++) {
+			ids = array_append(ids, pending[i].id);
+		}
+
+		uint32_t id_count = array_len(ids);
+		if(res == GrB_SUCCESS && !SINGLE_EDGE(entry)) {
+			// Pair is already connected by multiple edges, extend its slot.
+			MultiEdgeTable_Append(t, MULTI_EDGE_SLOT(entry), ids, id_count);
+			update = false;
+		} else if(id_count == 1) {
+			entry = SET_MSB(ids[0]);
+		} else {
+			entry = MultiEdgeTable_NewSlot(t, ids, id_count);
+		}
+
+		// Reuse pending array to record entry updates.
+		if(update) {
+			pending[group_count].src = src;
+			pending[group_count].dest = dest;
+			pending[group_count].id = entry;
+			group_count++;
+		}
+	}
+	array_free(ids);
+
+	for(uint32_t i = 0; i < group_count; i++) {
+		GrB_Info res = GrB_Matrix_setElement_UINT64(M, pending[i].id, pending[i].src, pending[i].dest);
+		assert(res == GrB_SUCCESS);
+	}
+
+	array_clear(g->_pending_edges[r]);
+}
+
+// Write pending edges of every relation into their mapping matrices.
+static void _Graph_FlushAllPendingEdges(Graph *g) {
+	uint32_t relation_count = array_len(g->_relations_map);
+	for(uint32_t r = 0; r < relation_count; r++) {
+		if(array_len(g->_pending_edges[r]) == 0) continue;
+		GrB_Matrix M = g->_relations_map[r];
+		g->SynchronizeMatrix(g, M);
+		_Graph_FlushPendingEdges(g, r);
+		// Readers share matrix, apply assignments prior to releasing the graph.
+		_Graph_ApplyPending(M);
+	}
+}
+
 // Retrieve a relation mapping matrix coresponding to relation_idx
 // Make sure matrix is synchronized.
 GrB_Matrix Graph_GetRelationMap(const Graph *g, int relation_idx) {
 	assert(g && relation_idx >= 0 && relation_idx < array_len(g->_relations_map));
 	GrB_Matrix m = g->_relations_map[relation_idx];
 	g->SynchronizeMatrix(g, m);
+
+	/* Edges are pending only while the graph is exclusively held, either by a writer
+	 * or prior to being shared, e.g. while loading. Writers commit pending edges
+	 * once they release the write lock, see Graph_ReleaseLock,
+	 * as such readers sharing the graph never modify the mapping matrix. */
+	if(array_len(g->_pending_edges[relation_idx]) > 0) {
+		_Graph_FlushPendingEdges((Graph *)g, relation_idx);
+	}
+
 	return m;
 }
 
+const EdgeID *Graph_ResolveRelationMapEntry(const Graph *g, int relation_idx, EdgeID *entry,
+											uint32_t *count) {
+	assert(g && entry && count);
+	if(SINGLE_EDGE(*entry)) {
+		*entry = SINGLE_EDGE_ID(*entry);
+		*count = 1;
+		return entry;
+	}
+
+	// Multiple edges, entry is a slot within relation's multi edge table.
+	return MultiEdgeTable_GetEdges(g->_multi_edges[relation_idx], MULTI_EDGE_SLOT(*entry), count);
+}
+
+uint64_t Graph_RelationEdgeCount(const Graph *g, int relation_idx) {
+	assert(g);
+	GrB_Index nvals;
+	GrB_Matrix M = Graph_GetRelationMap(g, relation_idx);
+	GrB_Matrix_nvals(&nvals, M);
+
+	/* Each multi edge slot is represented by a single entry in M
+	 * and holds multiple edges. */
+	const MultiEdgeTable *t = g->_multi_edges[relation_idx];
+	return nvals - MultiEdgeTable_SlotCount(t) + MultiEdgeTable_EdgeCount(t);
+}
+
 // Create a new mapping matrix M,
 // M[I,J] holds the edge ID connecting node J to I (CSC format)
 // assuming _relations_map[K] holds mapping for relation K.
@@ -164,10 +225,14 @@ void _Graph_AddRelationMap(Graph *g) {
 								  Graph_RequiredMatrixDim(g));
 	assert(res == GrB_SUCCESS);
 	g->_relations_map = array_append(g->_relations_map, mapper);
+	g->_multi_edges = array_append(g->_multi_edges, MultiEdgeTable_New());
+	g->_pending_edges = array_append(g->_pending_edges, array_new(PendingEdge, 0));
 }
 
-// Locates edges connecting src to destination.
-void _Graph_GetEdgesConnectingNodes(const Graph *g, NodeID src, NodeID dest, int r, Edge **edges) {
+// Locates edges connecting src to destination, returns the number of edges located,
+// edges are appended to edges if specified.
+static uint32_t _Graph_GetEdgesConnectingNodes(const Graph *g, NodeID src, NodeID dest, int r,
+											   Edge **edges) {
 	assert(g && src < Graph_RequiredMatrixDim(g) && dest < Graph_RequiredMatrixDim(g) &&
 		   r < Graph_RelationTypeCount(g));
 
@@ -182,27 +247,18 @@ void _Graph_GetEdgesConnectingNodes(const Graph *g, NodeID src, NodeID dest, int
 	GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, relationMap, src, dest);
 
 	// No entry at [dest, src], src is not connected to dest with relation R.
-	if(res == GrB_NO_VALUE) return;
+	if(res == GrB_NO_VALUE) return 0;
+
+	uint32_t edgeCount;
+	const EdgeID *edgeIds = Graph_ResolveRelationMapEntry(g, r, &edgeId, &edgeCount);
+	if(edges == NULL) return edgeCount;
 
-	if(SINGLE_EDGE(edgeId)) {
-		// Discard most significate bit.
-		edgeId = SINGLE_EDGE_ID(edgeId);
-		e.entity = DataBlock_GetItem(g->edges, edgeId);
+	for(uint32_t i = 0; i < edgeCount; i++) {
+		e.entity = DataBlock_GetItem(g->edges, edgeIds[i]);
 		assert(e.entity);
 		*edges = array_append(*edges, e);
-	} else {
-		/* Multiple edges connecting src to dest,
-		 * entry is a pointer to an array of edge IDs. */
-		EdgeID *edgeIds = (EdgeID *)edgeId;
-		int edgeCount = array_len(edgeIds);
-
-		for(int i = 0; i < edgeCount; i++) {
-			edgeId = edgeIds[i];
-			e.entity = DataBlock_GetItem(g->edges, edgeId);
-			assert(e.entity);
-			*edges = array_append(*edges, e);
-		}
 	}
+	return edgeCount;
 }
 
 // Tests if there's an edge of type r between src and dest nodes.
@@ -292,26 +348,106 @@ void Graph_SetMatrixPolicy(Graph *g, MATRIX_POLICY policy) {
 	}
 }
 
+/* Choose between hypersparse and standard CSR representation for matrix
+ * according to its density, a hypersparse matrix only stores its non-empty rows
+ * while a standard matrix holds a row pointer for each of its N rows.
+ * The gap between the two thresholds prevents a matrix whose density
+ * hovers around a threshold from being repeatedly converted. */
+static void _Graph_ConformMatrixFormat(GrB_Matrix m) {
+	bool hyper;
+	GrB_Index nrows;
+	GrB_Index nvals;
+	GrB_Matrix_nrows(&nrows, m);
+	GrB_Matrix_nvals(&nvals, m);
+	GxB_Matrix_Option_get(m, GxB_IS_HYPER, &hyper);
+
+	if(!hyper && nvals * GRAPH_HYPERSPARSE_RATIO < nrows) {
+		GxB_Matrix_Option_set(m, GxB_HYPER, GxB_ALWAYS_HYPER);
+	} else if(hyper && nvals * GRAPH_HYPERSPARSE_RATIO > nrows * 2) {
+		GxB_Matrix_Option_set(m, GxB_HYPER, GxB_NEVER_HYPER);
+	}
+}
+
+// Conform matrix format unless matrix has pending operations.
+static inline void _Graph_ConformSynchronizedMatrix(GrB_Matrix m) {
+	bool pending = false;
+	GxB_Matrix_Pending(m, &pending);
+	if(!pending) _Graph_ConformMatrixFormat(m);
+}
+
+void Graph_ConformMatrixFormats(Graph *g) {
+	assert(g && g->_writelocked);
+
+	_Graph_ConformSynchronizedMatrix(g->adjacency_matrix);
+	_Graph_ConformSynchronizedMatrix(g->_t_adjacency_matrix);
+
+	uint32_t label_count = array_len(g->labels);
+	for(uint32_t i = 0; i < label_count; i++) _Graph_ConformSynchronizedMatrix(g->labels[i]);
+
+	uint32_t relation_count = array_len(g->relations);
+	for(uint32_t i = 0; i < relation_count; i++) {
+		_Graph_ConformSynchronizedMatrix(g->relations[i]);
+		_Graph_ConformSynchronizedMatrix(g->_relations_map[i]);
+	}
+
+	uint32_t t_relation_count = array_len(g->_t_relations);
+	for(uint32_t i = 0; i < t_relation_count; i++) _Graph_ConformSynchronizedMatrix(g->_t_relations[i]);
+}
+
 /* Synchronize and resize all matrices in graph. */
 void Graph_ApplyAllPending(Graph *g) {
 	GrB_Matrix M;
 
+	M = g->adjacency_matrix;
+	g->SynchronizeMatrix(g, M);
+	_Graph_ConformMatrixFormat(M);
+
+	M = g->_t_adjacency_matrix;
+	g->SynchronizeMatrix(g, M);
+	_Graph_ConformMatrixFormat(M);
+
 	for(int i = 0; i < array_len(g->labels); i ++) {
 		M = g->labels[i];
 		g->SynchronizeMatrix(g, M);
+		_Graph_ConformMatrixFormat(M);
 	}
 
 	for(int i = 0; i < array_len(g->relations); i ++) {
 		M = g->relations[i];
 		g->SynchronizeMatrix(g, M);
+		_Graph_ConformMatrixFormat(M);
+	}
+
+	for(int i = 0; i < array_len(g->_t_relations); i ++) {
+		M = g->_t_relations[i];
+		g->SynchronizeMatrix(g, M);
+		_Graph_ConformMatrixFormat(M);
 	}
 
 	for(int i = 0; i < array_len(g->_relations_map); i ++) {
 		M = g->_relations_map[i];
 		g->SynchronizeMatrix(g, M);
+		_Graph_FlushPendingEdges(g, i);
+		_Graph_ConformMatrixFormat(M);
 	}
 }
 
+void Graph_SynchronizeMatrices(const Graph *g) {
+	assert(g);
+	g->SynchronizeMatrix(g, g->adjacency_matrix);
+	g->SynchronizeMatrix(g, g->_t_adjacency_matrix);
+	g->SynchronizeMatrix(g, g->_zero_matrix);
+
+	uint32_t label_count = array_len(g->labels);
+	for(uint32_t i = 0; i < label_count; i++) g->SynchronizeMatrix(g, g->labels[i]);
+
+	uint32_t relation_count = array_len(g->relations);
+	for(uint32_t i = 0; i < relation_count; i++) g->SynchronizeMatrix(g, g->relations[i]);
+
+	uint32_t t_relation_count = array_len(g->_t_relations);
+	for(uint32_t i = 0; i < t_relation_count; i++) g->SynchronizeMatrix(g, g->_t_relations[i]);
+}
+
 /* ================================ Graph API ================================ */
 Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 	node_cap = MAX(node_cap, GRAPH_DEFAULT_NODE_CAP);
@@ -322,7 +458,11 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 	g->edges = DataBlock_New(edge_cap, sizeof(Entity), (fpDestructor)FreeEntity);
 	g->labels = array_new(GrB_Matrix, GRAPH_DEFAULT_LABEL_CAP);
 	g->relations = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	g->_t_relations = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	g->_maintain_transpose = maintain_transposed_matrices;
 	g->_relations_map = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	g->_multi_edges = array_new(MultiEdgeTable *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+	g->_pending_edges = array_new(PendingEdge *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
 	GrB_Matrix_new(&g->adjacency_matrix, GrB_BOOL, node_cap, node_cap);
 	GrB_Matrix_new(&g->_t_adjacency_matrix, GrB_BOOL, node_cap, node_cap);
 	GrB_Matrix_new(&g->_zero_matrix, GrB_BOOL, node_cap, node_cap);
@@ -340,13 +480,6 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
 	assert(pthread_mutex_init(&g->_mutex, NULL) == 0);
 	assert(pthread_mutex_init(&g->_writers_mutex, NULL) == 0);
 
-	// Create edge accumulator binary function
-	if(!_graph_edge_accum) {
-		GrB_Info info;
-		info = GrB_BinaryOp_new(&_graph_edge_accum, _edge_accum, GrB_UINT64, GrB_UINT64, GrB_UINT64);
-		assert(info == GrB_SUCCESS);
-	}
-
 	return g;
 }
 
@@ -358,6 +491,71 @@ size_t Graph_RequiredMatrixDim(const Graph *g) {
 	return g->nodes->itemCount + array_len(g->nodes->deletedIdx);
 }
 
+bool Graph_RequiresCompaction(const Graph *g) {
+	assert(g);
+	/* Compact once at least a block worth of node IDs is free
+	 * and free IDs make up at least 10% of the ID range. */
+	uint64_t deleted = DataBlock_DeletedItemsCount(g->nodes);
+	return (deleted >= BLOCK_CAP && deleted * 10 >= Graph_RequiredMatrixDim(g));
+}
+
+// Replace M with M(I,I), I holds n row (column) indices.
+static void _Graph_PermuteMatrix(GrB_Matrix *M, const GrB_Index *I, GrB_Index n) {
+	GrB_Type t;
+	GrB_Matrix C;
+	GxB_Matrix_type(&t, *M);
+	GrB_Matrix_new(&C, t, n, n);
+	GrB_Info res = GrB_Matrix_extract(C, GrB_NULL, GrB_NULL, *M, I, n, I, n, GrB_NULL);
+	assert(res == GrB_SUCCESS);
+	GrB_Matrix_free(M);
+	*M = C;
+}
+
+uint64_t Graph_CompactNodes(Graph *g, uint64_t n, NodeID *from, NodeID *to) {
+	assert(g && g->_writelocked && from && to);
+
+	// Matrices must reflect every pending change prior to being permuted.
+	Graph_ApplyAllPending(g);
+
+	uint64_t moved = DataBlock_Compact(g->nodes, n, from, to);
+
+	/* Nothing was relocated, though free IDs at the end of the ID range
+	 * might have been discarded, matrices are resized on their next retrieval. */
+	if(moved == 0) return 0;
+
+	// Relocated entities carry their own ID.
+	for(uint64_t i = 0; i < moved; i++) {
+		Entity *en = DataBlock_GetItem(g->nodes, to[i]);
+		en->id = to[i];
+	}
+
+	/* New row (column) i is old row (column) I[i], relocated nodes
+	 * take over the rows and columns of the free IDs they've filled,
+	 * which are empty in every matrix. */
+	GrB_Index dim = Graph_RequiredMatrixDim(g);
+	GrB_Index *I = rm_malloc(sizeof(GrB_Index) * dim);
+	for(GrB_Index i = 0; i < dim; i++) I[i] = i;
+	for(uint64_t i = 0; i < moved; i++) I[to[i]] = from[i];
+
+	_Graph_PermuteMatrix(&g->adjacency_matrix, I, dim);
+	_Graph_PermuteMatrix(&g->_t_adjacency_matrix, I, dim);
+
+	uint32_t label_count = array_len(g->labels);
+	for(uint32_t i = 0; i < label_count; i++) _Graph_PermuteMatrix(g->labels + i, I, dim);
+
+	uint32_t relation_count = array_len(g->relations);
+	for(uint32_t i = 0; i < relation_count; i++) {
+		_Graph_PermuteMatrix(g->relations + i, I, dim);
+		_Graph_PermuteMatrix(g->_relations_map + i, I, dim);
+	}
+
+	uint32_t t_relation_count = array_len(g->_t_relations);
+	for(uint32_t i = 0; i < t_relation_count; i++) _Graph_PermuteMatrix(g->_t_relations + i, I, dim);
+
+	rm_free(I);
+	return moved;
+}
+
 size_t Graph_NodeCount(const Graph *g) {
 	assert(g);
 	return g->nodes->itemCount;
@@ -435,23 +633,15 @@ int Graph_GetEdgeRelation(const Graph *g, Edge *e) {
 		GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, M, srcNodeID, destNodeID);
 		if(res != GrB_SUCCESS) continue;
 
-		if(SINGLE_EDGE(edgeId)) {
-			EdgeID curEdgeID = SINGLE_EDGE_ID(edgeId);
-			if(curEdgeID == id) {
+		/* Multiple edges might exists between src and dest
+		 * see if given edge is one of them. */
+		uint32_t edge_count;
+		const EdgeID *edges = Graph_ResolveRelationMapEntry(g, i, &edgeId, &edge_count);
+		for(uint32_t j = 0; j < edge_count; j++) {
+			if(edges[j] == id) {
 				Edge_SetRelationID(e, i);
 				return i;
 			}
-		} else {
-			/* Multiple edges exists between src and dest
-			 * see if given edge is one of them. */
-			EdgeID *edges = (EdgeID *)edgeId;
-			int edge_count = array_len(edges);
-			for(int j = 0; j < edge_count; j++) {
-				if(edges[j] == id) {
-					Edge_SetRelationID(e, i);
-					return i;
-				}
-			}
 		}
 	}
 
@@ -460,6 +650,21 @@ int Graph_GetEdgeRelation(const Graph *g, Edge *e) {
 	return GRAPH_NO_RELATION;
 }
 
+// Collects edges of type r connecting src to dest, returns the number of edges collected,
+// when r is GRAPH_NO_RELATION edges of every type are collected.
+static inline uint32_t _Graph_CollectEdges(const Graph *g, NodeID src, NodeID dest, int r,
+										   Edge **edges) {
+	if(r != GRAPH_NO_RELATION) return _Graph_GetEdgesConnectingNodes(g, src, dest, r, edges);
+
+	// Relation type missing, scan through each edge type.
+	uint32_t count = 0;
+	int relationCount = Graph_RelationTypeCount(g);
+	for(int i = 0; i < relationCount; i++) {
+		count += _Graph_GetEdgesConnectingNodes(g, src, dest, i, edges);
+	}
+	return count;
+}
+
 void Graph_GetEdgesConnectingNodes(const Graph *g, NodeID srcID, NodeID destID, int r,
 								   Edge **edges) {
 	assert(g && r < Graph_RelationTypeCount(g) && edges);
@@ -473,15 +678,7 @@ void Graph_GetEdgesConnectingNodes(const Graph *g, NodeID srcID, NodeID destID,
 	assert(Graph_GetNode(g, srcID, &srcNode));
 	assert(Graph_GetNode(g, destID, &destNode));
 
-	if(r != GRAPH_NO_RELATION) {
-		_Graph_GetEdgesConnectingNodes(g, srcID, destID, r, edges);
-	} else {
-		// Relation type missing, scan through each edge type.
-		int relationCount = Graph_RelationTypeCount(g);
-		for(int i = 0; i < relationCount; i++) {
-			_Graph_GetEdgesConnectingNodes(g, srcID, destID, i, edges);
-		}
-	}
+	_Graph_CollectEdges(g, srcID, destID, r, edges);
 }
 
 void Graph_CreateNode(Graph *g, int label, Node *n) {
@@ -507,7 +704,6 @@ void Graph_CreateNode(Graph *g, int label, Node *n) {
 }
 
 int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
-	GrB_Info info;
 	Node srcNode;
 	Node destNode;
 
@@ -527,89 +723,134 @@ int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
 
 	GrB_Matrix adj = Graph_GetAdjacencyMatrix(g);
 	GrB_Matrix relationMat = Graph_GetRelationMatrix(g, r);
-	GrB_Matrix relationMapMat = Graph_GetRelationMap(g, r);
 	GrB_Matrix tadj = _Graph_Get_Transposed_AdjacencyMatrix(g);
 
 	// Rows represent source nodes, columns represent destination nodes.
 	GrB_Matrix_setElement_BOOL(adj, true, src, dest);
 	GrB_Matrix_setElement_BOOL(tadj, true, dest, src);
 	GrB_Matrix_setElement_BOOL(relationMat, true, src, dest);
-	GrB_Index I = src;
-	GrB_Index J = dest;
-	id = SET_MSB(id);
-	info = GxB_Matrix_subassign_UINT64   // C(I,J)<Mask> = accum (C(I,J),x)
-		   (
-			   relationMapMat,     // input/output matrix for results
-			   GrB_NULL,           // optional mask for C(I,J), unused if NULL
-			   _graph_edge_accum,  // optional accum for Z=accum(C(I,J),x)
-			   id,                 // scalar to assign to C(I,J)
-			   &I,                 // row indices
-			   1,                  // number of row indices
-			   &J,                 // column indices
-			   1,                  // number of column indices
-			   GrB_NULL            // descriptor for C(I,J) and Mask
-		   );
-	assert(info == GrB_SUCCESS);
+	if(g->_maintain_transpose) {
+		GrB_Matrix t_relationMat = Graph_GetTransposedRelationMatrix(g, r);
+		GrB_Matrix_setElement_BOOL(t_relationMat, true, dest, src);
+	}
+
+	/* Defer updating the relation mapping matrix, such that edges
+	 * connecting the same pair of nodes are grouped into a single entry
+	 * once the mapping matrix is retrieved, see _Graph_FlushPendingEdges. */
+	PendingEdge pending = {.src = src, .dest = dest, .id = id};
+	g->_pending_edges[r] = array_append(g->_pending_edges[r], pending);
 
 	return 1;
 }
 
+void Graph_NeighborCursor_Init(const Graph *g, NeighborCursor *c, NodeID node, GRAPH_EDGE_DIR dir,
+							   int relation) {
+	assert(g && c && dir != GRAPH_EDGE_DIR_BOTH);
+	GrB_Matrix M;
+	const void *entries = NULL;
+	const void **vals = NULL;
+
+	c->node = node;
+	c->dir = dir;
+	c->relation = relation;
+	c->filter = false;
+	c->neighbors = NULL;
+	c->entries = NULL;
+	c->count = 0;
+
+	// Invalid relation type, e.g. MATCH ()-[:real_type|fake_type]->(), no neighbors.
+	if(relation == GRAPH_UNKNOWN_RELATION) return;
+
+	if(dir == GRAPH_EDGE_DIR_OUTGOING) {
+		/* If a relationship type is specified, read the relation map's row,
+		 * which holds both destinations and edges, otherwise the adjacency matrix's row. */
+		if(relation == GRAPH_NO_RELATION) {
+			M = Graph_GetAdjacencyMatrix(g);
+		} else {
+			M = Graph_GetRelationMap(g, relation);
+			vals = &entries;
+		}
+	} else {
+		/* Retrieve the transposed relation matrix if it is maintained,
+		 * otherwise the transposed adjacency matrix, in which case
+		 * sources connected by other relationship types are visited as well. */
+		if(relation == GRAPH_NO_RELATION || g->_maintain_transpose) {
+			M = Graph_GetTransposedRelationMatrix(g, relation);
+		} else {
+			M = _Graph_Get_Transposed_AdjacencyMatrix(g);
+			c->filter = true;
+		}
+	}
+
+	const GrB_Index *neighbors;
+	GrB_Info res = GxB_Matrix_row_slice(&neighbors, vals, &c->count, M, node);
+	assert(res == GrB_SUCCESS);
+	c->neighbors = (const NodeID *)neighbors;
+	c->entries = (const EdgeID *)entries;
+}
+
+uint32_t Graph_NeighborCursor_Edges(const Graph *g, const NeighborCursor *c, uint64_t i,
+									Edge **edges) {
+	assert(g && c && i < c->count);
+	NodeID neighbor = c->neighbors[i];
+	NodeID src = (c->dir == GRAPH_EDGE_DIR_OUTGOING) ? c->node : neighbor;
+	NodeID dest = (c->dir == GRAPH_EDGE_DIR_OUTGOING) ? neighbor : c->node;
+
+	// Relation map entry unavailable, look it up.
+	if(c->entries == NULL) return _Graph_CollectEdges(g, src, dest, c->relation, edges);
+
+	uint32_t edge_count;
+	EdgeID entry = c->entries[i];
+	const EdgeID *edge_ids = Graph_ResolveRelationMapEntry(g, c->relation, &entry, &edge_count);
+	if(edges == NULL) return edge_count;
+
+	Edge e;
+	e.relationID = c->relation;
+	e.srcNodeID = src;
+	e.destNodeID = dest;
+	for(uint32_t j = 0; j < edge_count; j++) {
+		e.entity = DataBlock_GetItem(g->edges, edge_ids[j]);
+		assert(e.entity);
+		*edges = array_append(*edges, e);
+	}
+	return edge_count;
+}
+
 /* Retrieves all either incoming or outgoing edges
  * to/from given node N, depending on given direction. */
 void Graph_GetNodeEdges(const Graph *g, const Node *n, GRAPH_EDGE_DIR dir, int edgeType,
 						Edge **edges) {
 	assert(g && n && edges);
-	GrB_Matrix M;
-	NodeID srcNodeID;
-	NodeID destNodeID;
-	GxB_MatrixTupleIter *tupleIter;
+	NeighborCursor c;
+	NodeID id = ENTITY_GET_ID(n);
 
 	// Outgoing.
 	if(dir == GRAPH_EDGE_DIR_OUTGOING || dir == GRAPH_EDGE_DIR_BOTH) {
-		/* If a relationship type is specified, retrieve the appropriate relation matrix;
-		 * otherwise use the overall adjacency matrix. */
-		if(edgeType == GRAPH_NO_RELATION) M = Graph_GetAdjacencyMatrix(g);
-		else M = Graph_GetRelationMatrix(g, edgeType);
-
-		/* Construct an iterator to traverse the source node's row, which contains
-		 * all outgoing edges. */
-		GxB_MatrixTupleIter_new(&tupleIter, M);
-		srcNodeID = ENTITY_GET_ID(n);
-		GxB_MatrixTupleIter_iterate_row(tupleIter, srcNodeID);
-		while(true) {
-			bool depleted = false;
-			GxB_MatrixTupleIter_next(tupleIter, NULL, &destNodeID, &depleted);
-			if(depleted) break;
-			// Collect all edges connecting this source node to each of its destinations.
-			Graph_GetEdgesConnectingNodes(g, srcNodeID, destNodeID, edgeType, edges);
-		}
-		GxB_MatrixTupleIter_free(tupleIter);
+		Graph_NeighborCursor_Init(g, &c, id, GRAPH_EDGE_DIR_OUTGOING, edgeType);
+		// Collect all edges connecting this source node to each of its destinations.
+		for(uint64_t i = 0; i < c.count; i++) Graph_NeighborCursor_Edges(g, &c, i, edges);
 	}
 
 	// Incoming.
 	if(dir == GRAPH_EDGE_DIR_INCOMING || dir == GRAPH_EDGE_DIR_BOTH) {
-		/* Retrieve the transposed adjacency matrix, regardless of whether or not
-		 * a relationship type is specified. */
-		M = _Graph_Get_Transposed_AdjacencyMatrix(g);
-
-		/* Construct an iterator to traverse the node's row, which in the transposed
-		 * adjacency matrix contains all incoming edges. */
-		GxB_MatrixTupleIter_new(&tupleIter, M);
-		destNodeID = ENTITY_GET_ID(n);
-		GxB_MatrixTupleIter_iterate_row(tupleIter, destNodeID);
-
-		while(true) {
-			bool depleted = false;
-			GxB_MatrixTupleIter_next(tupleIter, NULL, &srcNodeID, &depleted);
-			if(depleted) break;
-			/* Collect all edges connecting this destination node to each of its sources.
-			 * This call will only collect edges of the appropriate relationship type,
-			 * if one is specified. */
-			Graph_GetEdgesConnectingNodes(g, srcNodeID, destNodeID, edgeType, edges);
-		}
+		Graph_NeighborCursor_Init(g, &c, id, GRAPH_EDGE_DIR_INCOMING, edgeType);
+		/* Collect all edges connecting this destination node to each of its sources.
+		 * This call will only collect edges of the appropriate relationship type,
+		 * if one is specified. */
+		for(uint64_t i = 0; i < c.count; i++) Graph_NeighborCursor_Edges(g, &c, i, edges);
+	}
+}
 
-		// Clean up
-		GxB_MatrixTupleIter_free(tupleIter);
+/* Removes edge from a multi edge slot, in case the slot is left
+ * with a single edge, mapping entry reverts back to edge ID. */
+static void _Graph_RemoveMultiEdge(Graph *g, int r, GrB_Matrix R, NodeID src, NodeID dest,
+								   MultiEdgeSlotID slot, EdgeID id) {
+	MultiEdgeTable *t = g->_multi_edges[r];
+	if(MultiEdgeTable_Remove(t, slot, id) == 1) {
+		uint32_t count;
+		EdgeID remaining = MultiEdgeTable_GetEdges(t, slot, &count)[0];
+		MultiEdgeTable_FreeSlot(t, slot);
+		GrB_Matrix_setElement_UINT64(R, SET_MSB(remaining), src, dest);
 	}
 }
 
@@ -638,6 +879,10 @@ int Graph_DeleteEdge(Graph *g, Edge *e) {
 		 * delete entry from both M and R. */
 		assert(GxB_Matrix_Delete(M, src_id, dest_id) == GrB_SUCCESS);
 		assert(GxB_Matrix_Delete(R, src_id, dest_id) == GrB_SUCCESS);
+		if(g->_maintain_transpose) {
+			M = Graph_GetTransposedRelationMatrix(g, r);
+			assert(GxB_Matrix_Delete(M, dest_id, src_id) == GrB_SUCCESS);
+		}
 
 		// See if source is connected to destination with additional edges.
 		bool connected = false;
@@ -661,33 +906,9 @@ int Graph_DeleteEdge(Graph *g, Edge *e) {
 	} else {
 		/* Multiple edges connecting src to dest
 		 * locate specific edge and remove it
-		 * revert back from array representation to edge ID
+		 * revert back from multi edge slot to edge ID
 		 * incase we're left with a single edge connecting src to dest. */
-
-		int i = 0;
-		EdgeID id = ENTITY_GET_ID(e);
-		EdgeID *edges = (EdgeID *)edge_id;
-		int edge_count = array_len(edges);
-
-		// Locate edge within edge array.
-		for(; i < edge_count; i++) {
-			if(edges[i] == id) break;
-		}
-		assert(i < edge_count);
-
-		/* Remove edge from edge array
-		 * migrate last edge ID and reduce array size.
-		 * TODO: reallocate array of size / capacity ratio is high. */
-		edges[i] = edges[edge_count - 1];
-		array_pop(edges);
-
-		/* Incase we're left with a single edge connecting src to dest
-		 * revert back from array to scalar. */
-		if(array_len(edges) == 1) {
-			edge_id = edges[0];
-			array_free(edges);
-			GrB_Matrix_setElement_UINT64(R, SET_MSB(edge_id), src_id, dest_id);
-		}
+		_Graph_RemoveMultiEdge(g, r, R, src_id, dest_id, MULTI_EDGE_SLOT(edge_id), ENTITY_GET_ID(e));
 	}
 
 	// Free and remove edges from datablock.
@@ -712,7 +933,7 @@ void Graph_DeleteNode(Graph *g, Node *n) {
 }
 
 void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
-					  uint *node_deleted, uint *edge_deleted) {
+					  uint *node_deleted, uint *edge_deleted, EdgeDeletedFunc cb, void *cb_ctx) {
 	assert(g && g->_writelocked && nodes && node_count > 0);
 
 	/* Create a matrix M where M[j,i] = 1 where:
@@ -721,48 +942,39 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 	GrB_Matrix A;                       // A = R(M) masked relation matrix.
 	GrB_Index nvals;                    // Number of elements in mask.
 	GrB_Matrix Mask;                    // Mask noteing all implicitly deleted edges.
+	GrB_Matrix TMask = NULL;            // Transposed mask, when transposed relations are maintained.
 	GrB_Matrix Nodes;                   // Mask noteing each node marked for deletion.
 	GrB_Matrix adj;                     // Adjacency matrix.
 	GrB_Matrix tadj;                    // Transposed adjacency matrix.
 	GrB_Descriptor desc;                // GraphBLAS descriptor.
-	GxB_SelectOp selectop;              // GraphBLAS select operator, used to free edges.
-	GxB_MatrixTupleIter *adj_iter;      // iterator over the adjacency matrix.
-	GxB_MatrixTupleIter *tadj_iter;     // iterator over the transposed adjacency matrix.
+	GrB_Index *rows;                    // Row indices of implicitly deleted edges.
+	GrB_Index *cols;                    // Column indices of implicitly deleted edges.
+	EdgeID *entries;                    // Relation mapping entries of implicitly deleted edges.
+	MultiEdgeSlotID *slots;             // Multi edge slots of implicitly deleted edges.
+	NeighborCursor c;                   // Neighbors of deleted node.
 
 	GrB_Descriptor_new(&desc);
 	adj = Graph_GetAdjacencyMatrix(g);
 	tadj = _Graph_Get_Transposed_AdjacencyMatrix(g);
-	GxB_MatrixTupleIter_new(&adj_iter, adj);
-	GxB_MatrixTupleIter_new(&tadj_iter, tadj);
-	GxB_SelectOp_new(&selectop, _select_op_free_edge, GrB_UINT64, GrB_UINT64);
 	GrB_Matrix_new(&A, GrB_UINT64, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
 	GrB_Matrix_new(&Mask, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
 	GrB_Matrix_new(&Nodes, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
 
 	// Populate mask with implicit edges, take note of deleted nodes.
 	for(uint i = 0; i < node_count; i++) {
-		GrB_Index src;
-		GrB_Index dest;
 		Node *n = nodes + i;
-		bool depleted = false;
 		NodeID ID = ENTITY_GET_ID(n);
 
 		// Outgoing edges.
-		GxB_MatrixTupleIter_iterate_row(adj_iter, ID);
-		while(true) {
-			GxB_MatrixTupleIter_next(adj_iter, NULL,  &dest, &depleted);
-			if(depleted) break;
-			GrB_Matrix_setElement_BOOL(Mask, true, ID, dest);
+		Graph_NeighborCursor_Init(g, &c, ID, GRAPH_EDGE_DIR_OUTGOING, GRAPH_NO_RELATION);
+		for(uint64_t j = 0; j < c.count; j++) {
+			GrB_Matrix_setElement_BOOL(Mask, true, ID, c.neighbors[j]);
 		}
 
-		depleted = false;
-
 		// Incoming edges.
-		GxB_MatrixTupleIter_iterate_row(tadj_iter, ID);
-		while(true) {
-			GxB_MatrixTupleIter_next(tadj_iter, NULL, &src, &depleted);
-			if(depleted) break;
-			GrB_Matrix_setElement_BOOL(Mask, true, src, ID);
+		Graph_NeighborCursor_Init(g, &c, ID, GRAPH_EDGE_DIR_INCOMING, GRAPH_NO_RELATION);
+		for(uint64_t j = 0; j < c.count; j++) {
+			GrB_Matrix_setElement_BOOL(Mask, true, c.neighbors[j], ID);
 		}
 
 		GrB_Matrix_setElement_BOOL(Nodes, true, ID, ID);
@@ -774,11 +986,22 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 	GrB_Matrix_nvals(&nvals, Mask);
 	*edge_deleted += nvals;
 
+	if(g->_maintain_transpose) {
+		GrB_Matrix_new(&TMask, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+		GrB_transpose(TMask, NULL, NULL, Mask, NULL);
+	}
+
+	// Deleted nodes might not be connected, in which case there are no edges to remove.
+	rows = (nvals > 0) ? rm_malloc(sizeof(GrB_Index) * nvals) : NULL;
+	cols = (nvals > 0) ? rm_malloc(sizeof(GrB_Index) * nvals) : NULL;
+	entries = (nvals > 0) ? rm_malloc(sizeof(EdgeID) * nvals) : NULL;
+	slots = array_new(MultiEdgeSlotID, 0);
+
 	// Clear updated output matrix before assignment.
 	GrB_Descriptor_set(desc, GrB_OUTP, GrB_REPLACE);
 
 	// Free and remove implicit edges from relation matrices.
-	int relation_count = Graph_RelationTypeCount(g);
+	int relation_count = (nvals > 0) ? Graph_RelationTypeCount(g) : 0;
 	for(int i = 0; i < relation_count; i++) {
 		GrB_Matrix R = Graph_GetRelationMap(g, i);
 
@@ -789,20 +1012,31 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 		 * A will contain all implicitly deleted edges from R. */
 		GrB_Matrix_apply(A, Mask, NULL, GrB_IDENTITY_UINT64, R, desc);
 
-		/* Free each multi edge array entry in A
-		 * Call _select_op_free_edge on each entry of A. */
-
-		/* For user-defined select operators,
-		 * if Thunk is not NULL, then it must be a vector of length 1,
-		 * with exactly one entry.
-		 * The value of this entry is passed to the user-defined select operator,
-		 * with no typecasting. */
-
-		GxB_Scalar thunk;
-		GxB_Scalar_new(&thunk, GrB_UINT64);
-		GxB_Scalar_setElement_UINT64(thunk, (uint64_t)g);
-		GxB_select(A, GrB_NULL, GrB_NULL, selectop, A, thunk, GrB_NULL);
-		GrB_free(&thunk);
+		/* Free each edge in A, A is a subset of Mask
+		 * and so there's enough room to extract its entries. */
+		GrB_Index entry_count = nvals;
+		GrB_Matrix_extractTuples_UINT64(rows, cols, entries, &entry_count, A);
+
+		array_clear(slots);
+		for(GrB_Index j = 0; j < entry_count; j++) {
+			uint32_t edge_count;
+			EdgeID entry = entries[j];
+			const EdgeID *edge_ids = Graph_ResolveRelationMapEntry(g, i, &entry, &edge_count);
+			for(uint32_t k = 0; k < edge_count; k++) {
+				if(cb) {
+					Edge e = {0};
+					Graph_GetEdge(g, edge_ids[k], &e);
+					e.srcNodeID = rows[j];
+					e.destNodeID = cols[j];
+					e.relationID = i;
+					cb(&e, cb_ctx);
+				}
+				DataBlock_DeleteItem(g->edges, edge_ids[k]);
+			}
+			if(!SINGLE_EDGE(entries[j])) slots = array_append(slots, MULTI_EDGE_SLOT(entries[j]));
+		}
+		// Release multi edge slots all at once.
+		MultiEdgeTable_FreeSlots(g->_multi_edges[i], slots, array_len(slots));
 
 		// Clear both relation matrix and its coresponding relation mapping matrix.
 		GrB_Descriptor_set(desc, GrB_MASK, GrB_SCMP);
@@ -813,6 +1047,11 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 		R = Graph_GetRelationMatrix(g, i);
 		// Remove every entry of R marked by Mask.
 		GrB_Matrix_apply(R, Mask, NULL, GrB_IDENTITY_UINT64, R, desc);
+
+		if(TMask) {
+			R = Graph_GetTransposedRelationMatrix(g, i);
+			GrB_Matrix_apply(R, TMask, NULL, GrB_IDENTITY_UINT64, R, desc);
+		}
 	}
 
 	/* Descriptor:
@@ -842,9 +1081,11 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
 	GrB_free(&desc);
 	GrB_free(&Mask);
 	GrB_free(&Nodes);
-	GrB_free(&selectop);
-	GxB_MatrixTupleIter_free(adj_iter);
-	GxB_MatrixTupleIter_free(tadj_iter);
+	if(TMask) GrB_free(&TMask);
+	rm_free(rows);
+	rm_free(cols);
+	rm_free(entries);
+	array_free(slots);
 }
 
 void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
@@ -886,36 +1127,19 @@ void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
 
 			deletion.M = M;
 			deletions = array_append(deletions, deletion);
+
+			/* The transposed relation matrix isn't read while collecting deletions,
+			 * its entry is removed right away. */
+			if(g->_maintain_transpose) {
+				R = Graph_GetTransposedRelationMatrix(g, r);
+				assert(GxB_Matrix_Delete(R, dest_id, src_id) == GrB_SUCCESS);
+			}
 		} else {
 			/* Multiple edges connecting src to dest
 			 * locate specific edge and remove it
-			 * revert back from array representation to edge ID
+			 * revert back from multi edge slot to edge ID
 			 * incase we're left with a single edge connecting src to dest. */
-
-			int i = 0;
-			EdgeID id = ENTITY_GET_ID(e);
-			EdgeID *multi_edges = (EdgeID *)edge_id;
-			int multi_edge_count = array_len(multi_edges);
-
-			// Locate edge within edge array.
-			for(; i < multi_edge_count; i++) {
-				if(multi_edges[i] == id) break;
-			}
-			assert(i < multi_edge_count);
-
-			/* Remove edge from edge array
-			 * migrate last edge ID and reduce array size.
-			 * TODO: reallocate array of size / capacity ratio is high. */
-			multi_edges[i] = multi_edges[multi_edge_count - 1];
-			array_pop(multi_edges);
-
-			/* Incase we're left with a single edge connecting src to dest
-			 * revert back from array to scalar. */
-			if(array_len(multi_edges) == 1) {
-				edge_id = multi_edges[0];
-				array_free(multi_edges);
-				GrB_Matrix_setElement_UINT64(M, SET_MSB(edge_id), src_id, dest_id);
-			}
+			_Graph_RemoveMultiEdge(g, r, M, src_id, dest_id, MULTI_EDGE_SLOT(edge_id), ENTITY_GET_ID(e));
 		}
 
 		// Free and remove edges from datablock.
@@ -962,13 +1186,13 @@ void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
 
 /* Removes both nodes and edges from graph. */
 void Graph_BulkDelete(Graph *g, Node *nodes, uint node_count, Edge *edges, uint edge_count,
-					  uint *node_deleted, uint *edge_deleted) {
+					  uint *node_deleted, uint *edge_deleted, EdgeDeletedFunc cb, void *cb_ctx) {
 	assert(g);
 
 	*edge_deleted = 0;
 	*node_deleted = 0;
 
-	if(node_count) _BulkDeleteNodes(g, nodes, node_count, node_deleted, edge_deleted);
+	if(node_count) _BulkDeleteNodes(g, nodes, node_count, node_deleted, edge_deleted, cb, cb_ctx);
 
 	if(edge_count) {
 		// Filter out explicit edges which were removed by _BulkDeleteNodes.
@@ -1008,6 +1232,9 @@ void Graph_BulkDelete(Graph *g, Node *nodes, uint node_count, Edge *edges, uint
 		}
 
 		edge_count = uniqueIdx;
+		if(cb) {
+			for(uint i = 0; i < edge_count; i++) cb(edges + i, cb_ctx);
+		}
 		_BulkDeleteEdges(g, edges, edge_count);
 	}
 
@@ -1019,6 +1246,11 @@ DataBlockIterator *Graph_ScanNodes(const Graph *g) {
 	return DataBlock_Scan(g->nodes);
 }
 
+DataBlockIterator *Graph_ScanNodesRange(const Graph *g, NodeID start, NodeID end) {
+	assert(g);
+	return DataBlock_ScanRange(g->nodes, start, end);
+}
+
 DataBlockIterator *Graph_ScanEdges(const Graph *g) {
 	assert(g);
 	return DataBlock_Scan(g->edges);
@@ -1040,6 +1272,11 @@ int Graph_AddRelationType(Graph *g) {
 	GrB_Matrix_new(&m, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
 	g->relations = array_append(g->relations, m);
 
+	if(g->_maintain_transpose) {
+		GrB_Matrix_new(&m, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+		g->_t_relations = array_append(g->_t_relations, m);
+	}
+
 	_Graph_AddRelationMap(g);
 
 	// Edge mapping for relation K is at _relations_map[K].
@@ -1075,6 +1312,34 @@ GrB_Matrix Graph_GetRelationMatrix(const Graph *g, int relation_idx) {
 	return m;
 }
 
+bool Graph_MaintainsTransposedMatrices(const Graph *g) {
+	assert(g);
+	return g->_maintain_transpose;
+}
+
+GrB_Matrix Graph_GetTransposedRelationMatrix(const Graph *g, int relation_idx) {
+	assert(g && (relation_idx == GRAPH_NO_RELATION || relation_idx < Graph_RelationTypeCount(g)));
+	if(relation_idx == GRAPH_NO_RELATION) return _Graph_Get_Transposed_AdjacencyMatrix(g);
+
+	assert(g->_maintain_transpose);
+	GrB_Matrix m = g->_t_relations[relation_idx];
+	g->SynchronizeMatrix(g, m);
+	return m;
+}
+
+GrB_Matrix Graph_GetTransposedMatrix(const Graph *g, GrB_Matrix m) {
+	assert(g && m);
+	if(m == g->adjacency_matrix) return _Graph_Get_Transposed_AdjacencyMatrix(g);
+	if(m == g->_zero_matrix) return Graph_GetZeroMatrix(g);
+	if(!g->_maintain_transpose) return NULL;
+
+	uint32_t relation_count = array_len(g->relations);
+	for(uint32_t i = 0; i < relation_count; i++) {
+		if(g->relations[i] == m) return Graph_GetTransposedRelationMatrix(g, i);
+	}
+	return NULL;
+}
+
 GrB_Matrix Graph_GetZeroMatrix(const Graph *g) {
 	GrB_Index nvals;
 	GrB_Matrix z = g->_zero_matrix;
@@ -1104,9 +1369,18 @@ void Graph_Free(Graph *g) {
 		GrB_Matrix_free(&m);
 		m = g->_relations_map[i];
 		GrB_Matrix_free(&m);
+		if(g->_maintain_transpose) {
+			m = g->_t_relations[i];
+			GrB_Matrix_free(&m);
+		}
+		MultiEdgeTable_Free(g->_multi_edges[i]);
+		array_free(g->_pending_edges[i]);
 	}
 	array_free(g->relations);
+	array_free(g->_t_relations);
 	array_free(g->_relations_map);
+	array_free(g->_multi_edges);
+	array_free(g->_pending_edges);
 
 	uint32_t labelCount = array_len(g->labels);
 	for(int i = 0; i < labelCount; i++) {
@@ -1135,7 +1409,11 @@ void Graph_Free(Graph *g) {
 	assert(pthread_mutex_destroy(&g->_mutex) == 0);
 	assert(pthread_mutex_destroy(&g->_writers_mutex) == 0);
 
-	if(g->_writelocked) Graph_ReleaseLock(g);
+	// Relations are freed, release lock without committing pending edges.
+	if(g->_writelocked) {
+		g->_writelocked = false;
+		pthread_rwlock_unlock(&g->_rwlock);
+	}
 	assert(pthread_rwlock_destroy(&g->_rwlock) == 0);
 
 	rm_free(g);
@@ -11,6 +11,7 @@
 
 #include "entities/node.h"
 #include "entities/edge.h"
+#include "multi_edge_table.h"
 #include "../redismodule.h"
 #include "rax.h"
 #include "../util/datablock/datablock.h"
@@ -25,19 +26,22 @@
 #define GRAPH_UNKNOWN_LABEL -2                  // Labels are numbered [0-N], -2 represents an unknown relation.
 #define GRAPH_NO_RELATION -1                    // Relations are numbered [0-N], -1 represents no relation.
 #define GRAPH_UNKNOWN_RELATION -2               // Relations are numbered [0-N], -2 represents an unknown relation.
+#define GRAPH_HYPERSPARSE_RATIO 16              // Matrices with less than N/ratio entries are kept hypersparse.
 
 // Mask with most significat bit on 10000...
 #define MSB_MASK (1UL << (sizeof(EntityID) * 8 - 1))
 // Mask complement 01111...
-#define MSB_MASK_CMP ~MSB_MASK
+#define MSB_MASK_CMP (~MSB_MASK)
 // Set X's most significat bit on.
-#define SET_MSB(x) (x) | MSB_MASK
+#define SET_MSB(x) ((x) | MSB_MASK)
 // Clear X's most significat bit on.
-#define CLEAR_MSB(x) (x) & MSB_MASK_CMP
+#define CLEAR_MSB(x) ((x) & MSB_MASK_CMP)
 // Checks if X represents edge ID.
-#define SINGLE_EDGE(x) (x) & MSB_MASK
+#define SINGLE_EDGE(x) ((x) & MSB_MASK)
 // Returns edge ID.
 #define SINGLE_EDGE_ID(x) CLEAR_MSB(x)
+// Returns multi edge slot ID, X must not represent a single edge.
+#define MULTI_EDGE_SLOT(x) ((MultiEdgeSlotID)(x))
 
 typedef enum {
 	GRAPH_EDGE_DIR_INCOMING,
@@ -51,10 +55,32 @@ typedef enum {
 	DISABLED,
 } MATRIX_POLICY;
 
+// Edge yet to be recorded within its relation mapping matrix.
+typedef struct {
+	NodeID src;     // Source node ID.
+	NodeID dest;    // Destination node ID.
+	EdgeID id;      // Edge ID.
+} PendingEdge;
+
+/* Neighbors of a single node, read directly from the row of the traversed matrix,
+ * no memory is allocated, such that cursors can live on the stack.
+ * Slices are valid as long as the graph isn't modified. */
+typedef struct {
+	NodeID node;                // Node whose neighbors are visited.
+	GRAPH_EDGE_DIR dir;         // Direction of traversed edges, either incoming or outgoing.
+	int relation;               // Relation type of traversed edges, GRAPH_NO_RELATION for any.
+	const NodeID *neighbors;    // Neighbor IDs, in ascending order.
+	const EdgeID *entries;      // Relation map entry of each neighbor, NULL unless read from a relation map.
+	uint64_t count;             // Number of neighbors.
+	bool filter;                // Neighbors might be connected by other relation types only.
+} NeighborCursor;
+
 // Forward declaration of Graph struct
 typedef struct Graph Graph;
 // typedef for synchronization function pointer
 typedef void (*SyncMatrixFunc)(const Graph *, GrB_Matrix);
+// typedef for edge deletion callback, invoked before edge is removed.
+typedef void (*EdgeDeletedFunc)(const Edge *, void *);
 
 struct Graph {
 	DataBlock *nodes;                   // Graph nodes stored in blocks.
@@ -63,12 +89,16 @@ struct Graph {
 	GrB_Matrix _t_adjacency_matrix;     // Transposed Adjacency matrix.
 	GrB_Matrix *labels;                 // Label matrices.
 	GrB_Matrix *relations;              // Relation matrices.
-	GrB_Matrix *_relations_map;         // Maps from (relation, row, col) to edge id.
+	GrB_Matrix *_t_relations;           // Transposed relation matrices, empty unless maintained.
+	GrB_Matrix *_relations_map;         // Maps from (relation, row, col) to edge id or multi edge slot.
+	MultiEdgeTable **_multi_edges;      // Per relation edge IDs of node pairs connected by multiple edges.
+	PendingEdge **_pending_edges;       // Per relation edges awaiting to be written to relation mapping matrix.
 	GrB_Matrix _zero_matrix;            // Zero matrix.
 	pthread_mutex_t _writers_mutex;     // Mutex restrict single writer.
 	pthread_mutex_t _mutex;             // Mutex for accessing critical sections.
 	pthread_rwlock_t _rwlock;           // Read-write lock scoped to this specific graph
 	bool _writelocked;                  // true if the read-write lock was acquired by a writer
+	bool _maintain_transpose;           // Maintain transposed relation matrices.
 	SyncMatrixFunc SynchronizeMatrix;   // Function pointer to matrix synchronization routine.
 };
 
@@ -93,9 +123,22 @@ void Graph_ReleaseLock(Graph *g);
 /* Choose the current matrix synchronization policy. */
 void Graph_SetMatrixPolicy(Graph *g, MATRIX_POLICY policy);
 
-/* Synchronize and resize all matrices in graph. */
+/* Synchronize and resize all matrices in graph,
+ * re-evaluating whether each matrix should be kept in hypersparse form.
+ * No iterators over graph matrices may be held by the caller. */
 void Graph_ApplyAllPending(Graph *g);
 
+/* Synchronize all label and relation matrices according to the current
+ * synchronization policy, used by callers holding matrix handles
+ * retrieved by a previous query, e.g. a cached execution plan. */
+void Graph_SynchronizeMatrices(const Graph *g);
+
+/* Re-evaluate whether each matrix without pending operations should be
+ * kept in hypersparse form, matrices with pending operations are skipped
+ * as inspecting them would force their pending operations to be applied.
+ * Graph must be write locked and no iterators over graph matrices may be held. */
+void Graph_ConformMatrixFormats(Graph *g);
+
 // Create a new graph.
 Graph *Graph_New(
 	size_t node_cap,    // Allocation size for node datablocks and matrix dimensions.
@@ -162,7 +205,27 @@ void Graph_BulkDelete(
 	Edge *edges,        // Edges to delete.
 	uint edge_count,    // Number of edges to delete.
 	uint *node_deleted, // Number of nodes removed.
-	uint *edge_deleted  // Number of edges removed.
+	uint *edge_deleted, // Number of edges removed.
+	EdgeDeletedFunc cb, // Optional, invoked once per removed edge, explicit or implicit.
+	void *cb_ctx        // Callback private data.
+);
+
+// Checks if enough nodes were deleted for compaction to be worthwhile.
+bool Graph_RequiresCompaction(
+	const Graph *g
+);
+
+// Renumbers up to n nodes such that live nodes form a dense prefix,
+// nodes are relocated from the end of the node ID range into free IDs
+// and matrices are permuted accordingly, releasing unused node storage.
+// from[i] and to[i] are set to the original and new ID of the ith relocated node,
+// returns number of relocated nodes.
+// Graph must be write locked and no references to nodes may be held by the caller.
+uint64_t Graph_CompactNodes(
+	Graph *g,           // Graph to compact.
+	uint64_t n,         // Maximum number of nodes to relocate.
+	NodeID *from,       // [output] Original IDs of relocated nodes.
+	NodeID *to          // [output] New IDs of relocated nodes.
 );
 
 // All graph matrices are required to be squared NXN
@@ -177,6 +240,14 @@ DataBlockIterator *Graph_ScanNodes(
 	const Graph *g
 );
 
+// Retrieves a node iterator which can be used to access
+// nodes with IDs in the range [start, end).
+DataBlockIterator *Graph_ScanNodesRange(
+	const Graph *g,
+	NodeID start,
+	NodeID end
+);
+
 // Retrieves an edge iterator which can be used to access
 // every edge in the graph.
 DataBlockIterator *Graph_ScanEdges(
@@ -269,6 +340,28 @@ void Graph_GetNodeEdges(
 	Edge **edges            // array_t incoming/outgoing edges.
 );
 
+// Points cursor at the neighbors of node, reached by edges of given direction
+// and relation type, outgoing edges of a specific type are read off the relation map
+// and come with their relation map entries.
+// Unless transposed relation matrices are maintained, incoming edges of a specific type
+// are read off the transposed adjacency matrix, in which case cursor's filter is set.
+void Graph_NeighborCursor_Init(
+	const Graph *g,         // Graph to traverse.
+	NeighborCursor *c,      // Cursor to initialize.
+	NodeID node,            // Node whose neighbors are visited.
+	GRAPH_EDGE_DIR dir,     // Edge direction, either incoming or outgoing.
+	int relation            // Relation type, GRAPH_NO_RELATION for any.
+);
+
+// Returns the number of edges connecting cursor's node to its i'th neighbor,
+// edges is optional, when specified connecting edges are appended to it.
+uint32_t Graph_NeighborCursor_Edges(
+	const Graph *g,             // Graph to traverse.
+	const NeighborCursor *c,    // Cursor.
+	uint64_t i,                 // Neighbor index.
+	Edge **edges                // [optional] array_t of connecting edges.
+);
+
 // Retrieves the adjacency matrix.
 // Matrix is resized if its size doesn't match graph's node count.
 GrB_Matrix Graph_GetAdjacencyMatrix(
@@ -289,12 +382,48 @@ GrB_Matrix Graph_GetRelationMatrix(
 	int relation        // Relation described by matrix.
 );
 
+// Returns true if transposed relation matrices are maintained,
+// determined by the MAINTAIN_TRANSPOSED_MATRICES configuration upon graph creation.
+bool Graph_MaintainsTransposedMatrices(
+	const Graph *g
+);
+
+// Retrieves a transposed typed adjacency matrix,
+// transposed relation matrices must be maintained.
+// Matrix is resized if its size doesn't match graph's node count.
+GrB_Matrix Graph_GetTransposedRelationMatrix(
+	const Graph *g,     // Graph from which to get adjacency matrix.
+	int relation        // Relation described by matrix, GRAPH_NO_RELATION for all relations.
+);
+
+// Retrieves the maintained transpose of either the adjacency matrix,
+// a relation matrix or the zero matrix, returns NULL if m's transpose isn't maintained.
+GrB_Matrix Graph_GetTransposedMatrix(
+	const Graph *g,     // Graph to which m belongs.
+	GrB_Matrix m        // Matrix to get transpose of.
+);
+
 // Retrieve a relation mapping matrix coresponding to relation_idx
 GrB_Matrix Graph_GetRelationMap(
 	const Graph *g,     // Graph from which to get mapping matrix.
 	int relation_idx    // Relation id
 );
 
+// Retrieves the IDs of all edges represented by a relation mapping entry,
+// no allocations are made, returned pointer is valid until relation is modified.
+const EdgeID *Graph_ResolveRelationMapEntry(
+	const Graph *g,     // Graph to which entry belongs.
+	int relation_idx,   // Relation id.
+	EdgeID *entry,      // Relation mapping matrix entry.
+	uint32_t *count     // [output] Number of edge IDs.
+);
+
+// Returns number of edges of given relation type.
+uint64_t Graph_RelationEdgeCount(
+	const Graph *g,
+	int relation_idx
+);
+
 // Retrieves the zero matrix.
 // The function will resize it to match all other
 // internal matrices, caller mustn't modify it in any way.
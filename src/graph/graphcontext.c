@@ -11,10 +11,13 @@
 #include "../redismodule.h"
 #include "../util/rmalloc.h"
 #include "serializers/graphcontext_type.h"
+#include "../execution_plan/plan_cache.h"
 
 extern pthread_mutex_t _module_mutex;       // Module-level lock (defined in module.c)
 // Global array tracking all extant GraphContexts (defined in module.c)
 extern GraphContext **graphs_in_keyspace;
+// Maximum number of cached execution plans per graph, 0 disables caching (defined in module.c)
+extern uint plan_cache_size;
 
 //------------------------------------------------------------------------------
 // GraphContext API
@@ -45,6 +48,11 @@ GraphContext *GraphContext_New(RedisModuleCtx *ctx, const char *graphname,
 
 	gc->string_mapping = array_new(char *, 64);
 	gc->attributes = raxNew();
+	gc->string_pool = StringPool_New();
+
+	gc->version = 0;
+	gc->plan_cache = NULL;
+	GraphContext_InitPlanCache(gc);
 
 	QueryCtx_SetGraphCtx(gc);
 
@@ -125,9 +133,19 @@ Schema *GraphContext_AddSchema(GraphContext *gc, const char *label, SchemaType t
 		gc->relation_schemas = array_append(gc->relation_schemas, schema);
 	}
 
+	// Plans referring to the new schema by name must be rebuilt.
+	GraphContext_AdvanceVersion(gc);
 	return schema;
 }
 
+void GraphContext_AdvanceVersion(GraphContext *gc) {
+	__atomic_add_fetch(&gc->version, 1, __ATOMIC_RELAXED);
+}
+
+void GraphContext_InitPlanCache(GraphContext *gc) {
+	if(plan_cache_size > 0) gc->plan_cache = PlanCache_New(plan_cache_size);
+}
+
 const char *GraphContext_GetNodeLabel(const GraphContext *gc, Node *n) {
 	int label_id = Graph_GetNodeLabel(gc->g, ENTITY_GET_ID(n));
 	if(label_id == GRAPH_NO_LABEL) return NULL;
@@ -176,6 +194,37 @@ Attribute_ID GraphContext_GetAttributeID(const GraphContext *gc, const char *att
 	return *id;
 }
 
+void GraphContext_BuildStatistics(GraphContext *gc) {
+	uint schema_count = array_len(gc->node_schemas);
+	for(uint i = 0; i < schema_count; i++) {
+		Schema_BuildStatistics(gc->node_schemas[i], gc->g, SCHEMA_NODE);
+	}
+
+	schema_count = array_len(gc->relation_schemas);
+	for(uint i = 0; i < schema_count; i++) {
+		Schema_BuildStatistics(gc->relation_schemas[i], gc->g, SCHEMA_EDGE);
+	}
+}
+
+void GraphContext_DeleteNodeFromStatistics(GraphContext *gc, Node *n) {
+	int schema_id = Graph_GetNodeLabel(gc->g, ENTITY_GET_ID(n));
+	// Do nothing if node had no label
+	if(schema_id == GRAPH_NO_LABEL) return;
+
+	Schema *s = GraphContext_GetSchemaByID(gc, schema_id, SCHEMA_NODE);
+	SchemaStats_RemoveEntity(s->stats, (GraphEntity *)n);
+}
+
+void GraphContext_DeleteEdgeFromStatistics(GraphContext *gc, Edge *e) {
+	// Edges retrieved by traversals carry their relation, avoid scanning relation maps.
+	int schema_id = e->relationID;
+	if(schema_id < 0) schema_id = Graph_GetEdgeRelation(gc->g, e);
+	if(schema_id == GRAPH_NO_RELATION) return;
+
+	Schema *s = GraphContext_GetSchemaByID(gc, schema_id, SCHEMA_EDGE);
+	SchemaStats_RemoveEntity(s->stats, (GraphEntity *)e);
+}
+
 //------------------------------------------------------------------------------
 // Index API
 //------------------------------------------------------------------------------
@@ -203,7 +252,9 @@ int GraphContext_AddIndex(Index **idx, GraphContext *gc, const char *label, cons
 	// Retrieve the schema for this label
 	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
 	if(s == NULL) s = GraphContext_AddSchema(gc, label, SCHEMA_NODE);
-	return Schema_AddIndex(idx, s, field, type);
+	int res = Schema_AddIndex(idx, s, field, type);
+	if(res == INDEX_OK) GraphContext_AdvanceVersion(gc);
+	return res;
 }
 
 int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *field,
@@ -211,7 +262,9 @@ int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *fi
 	// Retrieve the schema for this label
 	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
 	if(s == NULL) return INDEX_FAIL;
-	return Schema_RemoveIndex(s, field, type);
+	int res = Schema_RemoveIndex(s, field, type);
+	if(res == INDEX_OK) GraphContext_AdvanceVersion(gc);
+	return res;
 }
 
 // Delete all references to a node from any indices built upon its properties
@@ -237,6 +290,53 @@ void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n) {
 	if(idx) Index_RemoveNode(idx, n);
 }
 
+//------------------------------------------------------------------------------
+// Compaction
+//------------------------------------------------------------------------------
+
+// Update schema structures keyed by node ID to reflect a node relocation
+static void _GraphContext_RelocateNode(GraphContext *gc, NodeID from, NodeID to) {
+	int schema_id = Graph_GetNodeLabel(gc->g, to);
+	if(schema_id == GRAPH_NO_LABEL) return;
+	Schema *s = GraphContext_GetSchemaByID(gc, schema_id, SCHEMA_NODE);
+
+	Node n = {0};
+	assert(Graph_GetNode(gc->g, to, &n));
+
+	if(Schema_HasIndices(s)) {
+		// Indices remove documents by node ID, use a copy of the node carrying its former ID.
+		Entity prev = *n.entity;
+		prev.id = from;
+		Node prev_node = {0};
+		prev_node.entity = &prev;
+
+		if(s->fulltextIdx) Index_RemoveNode(s->fulltextIdx, &prev_node);
+		if(s->index) Index_RemoveNode(s->index, &prev_node);
+		Schema_AddNodeToIndices(s, &n, false);
+	}
+}
+
+void GraphContext_CompactNodes(GraphContext *gc) {
+	assert(gc);
+	if(!Graph_RequiresCompaction(gc->g)) return;
+
+	/* Each pass permutes every matrix, costing the entire graph,
+	 * relocate all nodes at once rather than spreading the cost over multiple passes,
+	 * compaction isn't required again until more nodes are deleted.
+	 * At most one node is relocated per free ID. */
+	uint64_t n = DataBlock_DeletedItemsCount(gc->g->nodes);
+	NodeID *from = rm_malloc(sizeof(NodeID) * n);
+	NodeID *to = rm_malloc(sizeof(NodeID) * n);
+
+	uint64_t moved = Graph_CompactNodes(gc->g, n, from, to);
+	for(uint64_t i = 0; i < moved; i++) _GraphContext_RelocateNode(gc, from[i], to[i]);
+	// Compaction replaces graph matrices, cached plans hold the former ones.
+	if(moved > 0) GraphContext_AdvanceVersion(gc);
+
+	rm_free(from);
+	rm_free(to);
+}
+
 //------------------------------------------------------------------------------
 // Functions for globally tracking GraphContexts
 //------------------------------------------------------------------------------
@@ -267,6 +367,8 @@ void GraphContext_RemoveFromRegistry(GraphContext *gc) {
 
 // Free all data associated with graph
 void GraphContext_Free(GraphContext *gc) {
+	// Cached plans refer to graph matrices and schemas, free them first.
+	PlanCache_Free(gc->plan_cache);
 	Graph_Free(gc->g);
 	rm_free(gc->graph_name);
 
@@ -300,6 +402,9 @@ void GraphContext_Free(GraphContext *gc) {
 		array_free(gc->string_mapping);
 	}
 
+	// Free string pool, all graph entities have been released.
+	if(gc->string_pool) StringPool_Free(gc->string_pool);
+
 	// Remove GraphContext from global array of graphs
 	GraphContext_RemoveFromRegistry(gc);
 
@@ -11,6 +11,7 @@
 #include "../redismodule.h"
 #include "../index/index.h"
 #include "../schema/schema.h"
+#include "../util/string_pool.h"
 #include "graph.h"
 
 typedef struct {
@@ -19,11 +20,15 @@ typedef struct {
 
 	rax *attributes;                  // From strings to attribute IDs
 	char **string_mapping;            // From attribute IDs to strings
+	StringPool *string_pool;          // Interned string property values
 
 	Schema **node_schemas;            // Array of schemas for each node label
 	Schema **relation_schemas;        // Array of schemas for each relation type
 
 	unsigned short index_count;       // Number of indicies.
+
+	uint64_t version;                 // Schema version, advanced whenever cached plans become invalid.
+	struct PlanCache *plan_cache;     // Execution plans of recently executed queries.
 } GraphContext;
 
 /* GraphContext API */
@@ -44,6 +49,12 @@ Schema *GraphContext_GetSchema(const GraphContext *gc, const char *label, Schema
 // Add a new schema and matrix for the given label
 Schema *GraphContext_AddSchema(GraphContext *gc, const char *label, SchemaType t);
 
+/* Invalidate all cached execution plans, called whenever the graph's
+ * schemas, indices or matrices are replaced. */
+void GraphContext_AdvanceVersion(GraphContext *gc);
+// Create the graph's execution plan cache if plan caching is enabled.
+void GraphContext_InitPlanCache(GraphContext *gc);
+
 // Retrieve the label string for a given Node object
 const char *GraphContext_GetNodeLabel(const GraphContext *gc, Node *n);
 // Retrieve the relation type string for a given Edge object
@@ -61,6 +72,13 @@ const char *GraphContext_GetAttributeString(const GraphContext *gc, Attribute_ID
 // Retrieve an attribute ID given a string, or ATTRIBUTE_NOTFOUND if attribute doesn't exist.
 Attribute_ID GraphContext_GetAttributeID(const GraphContext *gc, const char *str);
 
+// Rebuild the statistics of all schemas from the graph's entities
+void GraphContext_BuildStatistics(GraphContext *gc);
+// Remove node from its label's statistics, prior to its deletion
+void GraphContext_DeleteNodeFromStatistics(GraphContext *gc, Node *n);
+// Remove edge from its relationship's statistics, prior to its deletion
+void GraphContext_DeleteEdgeFromStatistics(GraphContext *gc, Edge *e);
+
 /* Index API */
 bool GraphContext_HasIndices(GraphContext *gc);
 // Attempt to retrieve an index on the given label and attribute
@@ -75,6 +93,10 @@ int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *fi
 // Remove a single node from all indices that refer to it
 void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n);
 
+// Compact node storage if it is fragmented, relocating every node it can in a single pass,
+// graph must be write locked and no references to nodes may be held by the caller
+void GraphContext_CompactNodes(GraphContext *gc);
+
 // Add GraphContext to global array
 void GraphContext_RegisterWithModule(GraphContext *gc);
 // Remove GraphContext from global array
@@ -0,0 +1,195 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include <assert.h>
+#include <string.h>
+#include "multi_edge_table.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#define MULTI_EDGE_TABLE_DEFAULT_POOL_CAP 64
+#define MULTI_EDGE_TABLE_DEFAULT_SLOT_CAP 16
+
+// Make sure pool can hold an additional n edge IDs.
+static void _MultiEdgeTable_EnsurePoolCap(MultiEdgeTable *t, uint64_t n) {
+	if(t->pool_len + n <= t->pool_cap) return;
+	while(t->pool_len + n > t->pool_cap) t->pool_cap *= 2;
+	t->pool = rm_realloc(t->pool, sizeof(EdgeID) * t->pool_cap);
+}
+
+/* Rewrite pool such that slots are laid out back to back,
+ * discarding regions abandoned by relocated and freed slots. */
+static void _MultiEdgeTable_Compact(MultiEdgeTable *t) {
+	uint64_t pool_len = t->pool_len - t->pool_holes;
+	EdgeID *pool = rm_malloc(sizeof(EdgeID) * MAX(pool_len, MULTI_EDGE_TABLE_DEFAULT_POOL_CAP));
+
+	uint64_t offset = 0;
+	uint32_t slot_count = array_len(t->slots);
+	for(uint32_t i = 0; i < slot_count; i++) {
+		MultiEdgeSlot *slot = t->slots + i;
+		if(slot->count == 0) continue;
+		memcpy(pool + offset, t->pool + slot->offset, sizeof(EdgeID) * slot->cap);
+		slot->offset = offset;
+		offset += slot->cap;
+	}
+	assert(offset == pool_len);
+
+	rm_free(t->pool);
+	t->pool = pool;
+	t->pool_len = pool_len;
+	t->pool_cap = MAX(pool_len, MULTI_EDGE_TABLE_DEFAULT_POOL_CAP);
+	t->pool_holes = 0;
+}
+
+static inline void _MultiEdgeTable_ReclaimHoles(MultiEdgeTable *t) {
+	if(t->pool_holes > MULTI_EDGE_TABLE_DEFAULT_POOL_CAP && t->pool_holes * 2 > t->pool_len) {
+		_MultiEdgeTable_Compact(t);
+	}
+}
+
+// Release slot without reclaiming pool space.
+static void _MultiEdgeTable_ReleaseSlot(MultiEdgeTable *t, MultiEdgeSlotID id) {
+	assert(id < array_len(t->slots));
+	MultiEdgeSlot *slot = t->slots + id;
+	if(slot->count == 0) return; // Slot already released.
+
+	t->edge_count -= slot->count;
+	t->pool_holes += slot->cap;
+	slot->count = 0;
+	slot->cap = 0;
+	t->free_slots = array_append(t->free_slots, id);
+}
+
+MultiEdgeTable *MultiEdgeTable_New(void) {
+	MultiEdgeTable *t = rm_malloc(sizeof(MultiEdgeTable));
+	t->pool_len = 0;
+	t->pool_holes = 0;
+	t->edge_count = 0;
+	t->pool_cap = MULTI_EDGE_TABLE_DEFAULT_POOL_CAP;
+	t->pool = rm_malloc(sizeof(EdgeID) * t->pool_cap);
+	t->slots = array_new(MultiEdgeSlot, MULTI_EDGE_TABLE_DEFAULT_SLOT_CAP);
+	t->free_slots = array_new(MultiEdgeSlotID, MULTI_EDGE_TABLE_DEFAULT_SLOT_CAP);
+	return t;
+}
+
+MultiEdgeSlotID MultiEdgeTable_NewSlot(MultiEdgeTable *t, const EdgeID *ids, uint32_t count) {
+	assert(t && ids && count > 0);
+
+	// Reserve some room for additional edges.
+	uint32_t cap = count < 4 ? 4 : count;
+	_MultiEdgeTable_EnsurePoolCap(t, cap);
+
+	MultiEdgeSlot slot;
+	slot.offset = t->pool_len;
+	slot.count = count;
+	slot.cap = cap;
+	memcpy(t->pool + slot.offset, ids, sizeof(EdgeID) * count);
+	t->pool_len += cap;
+	t->edge_count += count;
+
+	// Prefer reusing released slot IDs.
+	MultiEdgeSlotID id;
+	if(array_len(t->free_slots) > 0) {
+		id = array_pop(t->free_slots);
+		t->slots[id] = slot;
+	} else {
+		id = array_len(t->slots);
+		t->slots = array_append(t->slots, slot);
+	}
+
+	return id;
+}
+
+void MultiEdgeTable_Append(MultiEdgeTable *t, MultiEdgeSlotID id, const EdgeID *ids,
+						   uint32_t count) {
+	assert(t && id < array_len(t->slots) && ids);
+	MultiEdgeSlot *slot = t->slots + id;
+	assert(slot->count > 0);
+
+	if(slot->count + count > slot->cap) {
+		// Slot is full, relocate it to the end of the pool with twice the capacity.
+		uint32_t cap = slot->cap;
+		while(slot->count + count > cap) cap *= 2;
+		_MultiEdgeTable_EnsurePoolCap(t, cap);
+		memcpy(t->pool + t->pool_len, t->pool + slot->offset, sizeof(EdgeID) * slot->count);
+		t->pool_holes += slot->cap;
+		slot->offset = t->pool_len;
+		slot->cap = cap;
+		t->pool_len += cap;
+	}
+
+	memcpy(t->pool + slot->offset + slot->count, ids, sizeof(EdgeID) * count);
+	slot->count += count;
+	t->edge_count += count;
+
+	_MultiEdgeTable_ReclaimHoles(t);
+}
+
+uint32_t MultiEdgeTable_Remove(MultiEdgeTable *t, MultiEdgeSlotID id, EdgeID edge_id) {
+	assert(t && id < array_len(t->slots));
+	MultiEdgeSlot *slot = t->slots + id;
+	EdgeID *edges = t->pool + slot->offset;
+
+	// Locate edge within slot.
+	uint32_t i = 0;
+	for(; i < slot->count; i++) {
+		if(edges[i] == edge_id) break;
+	}
+	assert(i < slot->count);
+
+	// Migrate last edge ID into removed position.
+	edges[i] = edges[slot->count - 1];
+	slot->count--;
+	t->edge_count--;
+
+	if(slot->count == 0) {
+		// Slot is empty, release it.
+		t->pool_holes += slot->cap;
+		slot->cap = 0;
+		t->free_slots = array_append(t->free_slots, id);
+		_MultiEdgeTable_ReclaimHoles(t);
+		return 0;
+	}
+	return slot->count;
+}
+
+const EdgeID *MultiEdgeTable_GetEdges(const MultiEdgeTable *t, MultiEdgeSlotID id,
+									  uint32_t *count) {
+	assert(t && id < array_len(t->slots) && count);
+	const MultiEdgeSlot *slot = t->slots + id;
+	*count = slot->count;
+	return t->pool + slot->offset;
+}
+
+void MultiEdgeTable_FreeSlot(MultiEdgeTable *t, MultiEdgeSlotID id) {
+	assert(t);
+	_MultiEdgeTable_ReleaseSlot(t, id);
+	_MultiEdgeTable_ReclaimHoles(t);
+}
+
+void MultiEdgeTable_FreeSlots(MultiEdgeTable *t, const MultiEdgeSlotID *slots, uint64_t count) {
+	assert(t && (slots || count == 0));
+	for(uint64_t i = 0; i < count; i++) _MultiEdgeTable_ReleaseSlot(t, slots[i]);
+	_MultiEdgeTable_ReclaimHoles(t);
+}
+
+uint64_t MultiEdgeTable_SlotCount(const MultiEdgeTable *t) {
+	assert(t);
+	return array_len(t->slots) - array_len(t->free_slots);
+}
+
+uint64_t MultiEdgeTable_EdgeCount(const MultiEdgeTable *t) {
+	assert(t);
+	return t->edge_count;
+}
+
+void MultiEdgeTable_Free(MultiEdgeTable *t) {
+	assert(t);
+	rm_free(t->pool);
+	array_free(t->slots);
+	array_free(t->free_slots);
+	rm_free(t);
+}
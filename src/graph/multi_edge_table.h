@@ -0,0 +1,102 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef MULTI_EDGE_TABLE_H_
+#define MULTI_EDGE_TABLE_H_
+
+#include <stdint.h>
+#include "entities/graph_entity.h"
+
+/* A multi edge table holds the edge IDs of every (src, dest) pair
+ * which is connected by more than a single edge of a given relation type.
+ * Each such pair is assigned a compact slot ID, which is what gets stored
+ * within the relation mapping matrix, keeping heap pointers out of GraphBLAS.
+ *
+ * Edge IDs of all slots are stored contiguously within a single pool,
+ * a slot which outgrows its capacity is relocated to the end of the pool,
+ * abandoned pool regions are reclaimed once they make up half of the pool. */
+
+typedef uint64_t MultiEdgeSlotID;
+
+typedef struct {
+	uint64_t offset;    // Position of slot's first edge ID within pool.
+	uint32_t count;     // Number of edge IDs held by slot, 0 for a free slot.
+	uint32_t cap;       // Number of edge IDs slot can hold before relocating.
+} MultiEdgeSlot;
+
+typedef struct {
+	EdgeID *pool;               // Edge IDs of all slots.
+	uint64_t pool_len;          // Number of pool entries in use, including holes.
+	uint64_t pool_cap;          // Number of entries pool can hold.
+	uint64_t pool_holes;        // Number of pool entries no longer owned by a slot.
+	MultiEdgeSlot *slots;       // Slots, indexed by slot ID.
+	MultiEdgeSlotID *free_slots;// Released slot IDs, available for reuse.
+	uint64_t edge_count;        // Total number of edge IDs held by table.
+} MultiEdgeTable;
+
+// Create a new, empty multi edge table.
+MultiEdgeTable *MultiEdgeTable_New(void);
+
+// Allocate a slot holding the given edge IDs, returns slot ID.
+MultiEdgeSlotID MultiEdgeTable_NewSlot(
+	MultiEdgeTable *t,
+	const EdgeID *ids,      // Edge IDs to store.
+	uint32_t count          // Number of edge IDs.
+);
+
+// Append edge IDs to an existing slot.
+void MultiEdgeTable_Append(
+	MultiEdgeTable *t,
+	MultiEdgeSlotID slot,
+	const EdgeID *ids,      // Edge IDs to append.
+	uint32_t count          // Number of edge IDs.
+);
+
+// Remove a single edge ID from slot,
+// returns the number of edge IDs remaining in slot.
+uint32_t MultiEdgeTable_Remove(
+	MultiEdgeTable *t,
+	MultiEdgeSlotID slot,
+	EdgeID id
+);
+
+// Retrieves slot's edge IDs, no allocations are made.
+// Returned pointer is valid until the next modification of the table.
+const EdgeID *MultiEdgeTable_GetEdges(
+	const MultiEdgeTable *t,
+	MultiEdgeSlotID slot,
+	uint32_t *count         // [output] number of edge IDs in slot.
+);
+
+// Release a slot, making its ID available for reuse.
+void MultiEdgeTable_FreeSlot(
+	MultiEdgeTable *t,
+	MultiEdgeSlotID slot
+);
+
+// Release multiple slots at once, reclaiming pool space a single time.
+void MultiEdgeTable_FreeSlots(
+	MultiEdgeTable *t,
+	const MultiEdgeSlotID *slots,
+	uint64_t count
+);
+
+// Number of slots in use.
+uint64_t MultiEdgeTable_SlotCount(
+	const MultiEdgeTable *t
+);
+
+// Number of edge IDs held by table.
+uint64_t MultiEdgeTable_EdgeCount(
+	const MultiEdgeTable *t
+);
+
+// Free table.
+void MultiEdgeTable_Free(
+	MultiEdgeTable *t
+);
+
+#endif
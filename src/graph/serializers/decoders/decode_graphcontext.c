@@ -42,7 +42,9 @@ GraphContext *RdbLoadGraphContext(RedisModuleIO *rdb) {
 	gc->index_count = 0;
 	gc->attributes = raxNew();
 	gc->string_mapping = array_new(char *, 64);
+	gc->string_pool = StringPool_New();
 	gc->g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+	GraphContext_InitPlanCache(gc);
 
 	// Set the thread-local GraphContext, as it will be accessed if we're decoding indexes.
 	QueryCtx_SetGraphCtx(gc);
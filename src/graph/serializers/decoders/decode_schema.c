@@ -5,13 +5,50 @@
 */
 
 #include "decode_schema.h"
+#include "../../../util/arr.h"
+#include <assert.h>
+#include <string.h>
+
+static void _RdbLoadStatistics(RedisModuleIO *rdb, SchemaStats *stats) {
+	/* Format:
+	 * #attributes N
+	 * {
+	 *  attribute ID
+	 *  #entities holding attribute
+	 *  #numeric values observed
+	 *  distinct values sketch
+	 *  #sampled values M
+	 *  sampled value X M
+	 * } X N */
+
+	uint attribute_count = RedisModule_LoadUnsigned(rdb);
+	for(uint i = 0; i < attribute_count; i++) {
+		Attribute_ID id = RedisModule_LoadUnsigned(rdb);
+		AttributeStats *a = SchemaStats_GetOrAddAttribute(stats, id);
+		a->count = RedisModule_LoadUnsigned(rdb);
+		a->numeric_count = RedisModule_LoadUnsigned(rdb);
+
+		size_t len;
+		char *registers = RedisModule_LoadStringBuffer(rdb, &len);
+		assert(len == HLL_REGISTERS);
+		memcpy(a->ndv->registers, registers, HLL_REGISTERS);
+		RedisModule_Free(registers);
+
+		uint sample_count = RedisModule_LoadUnsigned(rdb);
+		assert(sample_count <= STATS_SAMPLE_SIZE);
+		for(uint j = 0; j < sample_count; j++) {
+			a->sample = array_append(a->sample, RedisModule_LoadDouble(rdb));
+		}
+	}
+}
 
 Schema *RdbLoadSchema(RedisModuleIO *rdb, SchemaType type) {
 	/* Format:
 	 * id
 	 * name
 	 * #indices
-	 * (index type, indexed property) X M */
+	 * (index type, indexed property) X M
+	 * statistics */
 
 	int id = RedisModule_LoadUnsigned(rdb);
 	char *name = RedisModule_LoadStringBuffer(rdb, NULL);
@@ -26,5 +63,7 @@ Schema *RdbLoadSchema(RedisModuleIO *rdb, SchemaType type) {
 		Schema_AddIndex(&idx, s, field, type);
 	}
 
+	_RdbLoadStatistics(rdb, s->stats);
+
 	return s;
 }
@@ -13,6 +13,10 @@ GraphContext *Decode_Previous(RedisModuleIO *rdb, int encver) {
 		return RdbLoadGraphContext_v4(rdb);
 	case 5:
 		return RdbLoadGraphContext_v5(rdb);
+	case 6:
+		return RdbLoadGraphContext_v6(rdb);
+	case 7:
+		return RdbLoadGraphContext_v7(rdb);
 	default:
 		assert(false && "attempted to read unsupported RedisGraph version from RDB file.");
 	}
@@ -8,6 +8,8 @@
 
 #include "v4/decode_v4.h"
 #include "v5/decode_v5.h"
+#include "v6/decode_v6.h"
+#include "v7/decode_v7.h"
 #include "../../../graphcontext.h"
 #include "../../../../redismodule.h"
 
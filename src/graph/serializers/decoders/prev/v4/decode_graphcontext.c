@@ -78,6 +78,8 @@ GraphContext *RdbLoadGraphContext_v4(RedisModuleIO *rdb) {
 	// Initialize property mappings.
 	gc->attributes = raxNew();
 	gc->string_mapping = array_new(char *, 64);
+	gc->string_pool = StringPool_New();
+	GraphContext_InitPlanCache(gc);
 
 	// #Node schemas
 	uint32_t schema_count = RedisModule_LoadUnsigned(rdb);
@@ -127,6 +129,9 @@ GraphContext *RdbLoadGraphContext_v4(RedisModuleIO *rdb) {
 		if(idx) Index_Construct(idx);
 	}
 
+	// Statistics weren't persisted prior to encoding version 8, build them from loaded entities.
+	GraphContext_BuildStatistics(gc);
+
 	return gc;
 }
 
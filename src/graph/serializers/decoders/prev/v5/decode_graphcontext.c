@@ -42,7 +42,9 @@ GraphContext *RdbLoadGraphContext_v5(RedisModuleIO *rdb) {
 	gc->index_count = 0;
 	gc->attributes = raxNew();
 	gc->string_mapping = array_new(char *, 64);
+	gc->string_pool = StringPool_New();
 	gc->g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+	GraphContext_InitPlanCache(gc);
 
 	// Set the thread-local GraphContext, as it will be accessed if we're decoding indexes.
 	QueryCtx_SetGraphCtx(gc);
@@ -83,6 +85,9 @@ GraphContext *RdbLoadGraphContext_v5(RedisModuleIO *rdb) {
 		if(s->fulltextIdx) Index_Construct(s->fulltextIdx);
 	}
 
+	// Statistics weren't persisted prior to encoding version 8, build them from loaded entities.
+	GraphContext_BuildStatistics(gc);
+
 	return gc;
 }
 
@@ -0,0 +1,203 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include <assert.h>
+#include "decode_v7.h"
+#include "../../../../../util/arr.h"
+#include "../../../../../datatypes/array.h"
+
+// Forward declerations.
+static SIValue _RdbLoadSIArray(RedisModuleIO *rdb, char **strings);
+
+static char **_RdbLoadStrings(RedisModuleIO *rdb) {
+	/* Format:
+	 * #strings N
+	 * string X N */
+
+	uint64_t count = RedisModule_LoadUnsigned(rdb);
+	char **strings = array_new(char *, count);
+	for(uint64_t i = 0; i < count; i++) {
+		strings = array_append(strings, RedisModule_LoadStringBuffer(rdb, NULL));
+	}
+	return strings;
+}
+
+static void _RdbFreeStrings(char **strings) {
+	uint32_t count = array_len(strings);
+	for(uint32_t i = 0; i < count; i++) RedisModule_Free(strings[i]);
+	array_free(strings);
+}
+
+static SIValue _RdbLoadString(RedisModuleIO *rdb, char **strings) {
+	/* Format:
+	 * string ID + 1, 0 if string is inlined
+	 * string (if inlined) */
+
+	uint64_t id = RedisModule_LoadUnsigned(rdb);
+	if(id == 0) {
+		// Transfer ownership of the heap-allocated string to the
+		// newly-created SIValue
+		return SI_TransferStringVal(RedisModule_LoadStringBuffer(rdb, NULL));
+	}
+	// Dictionary strings are owned by the dictionary.
+	assert(id <= array_len(strings));
+	return SI_ConstStringVal(strings[id - 1]);
+}
+
+static SIValue _RdbLoadSIValue(RedisModuleIO *rdb, char **strings) {
+	/* Format:
+	 * SIType
+	 * Value */
+	SIType t = RedisModule_LoadUnsigned(rdb);
+	switch(t) {
+	case T_INT64:
+		return SI_LongVal(RedisModule_LoadSigned(rdb));
+	case T_DOUBLE:
+		return SI_DoubleVal(RedisModule_LoadDouble(rdb));
+	case T_STRING:
+		return _RdbLoadString(rdb, strings);
+	case T_BOOL:
+		return SI_BoolVal(RedisModule_LoadSigned(rdb));
+	case T_ARRAY:
+		return _RdbLoadSIArray(rdb, strings);
+	case T_NULL:
+	default: // currently impossible
+		return SI_NullVal();
+	}
+}
+
+static SIValue _RdbLoadSIArray(RedisModuleIO *rdb, char **strings) {
+	/* loads array as
+	   unsinged : array legnth
+	   array[0]
+	   .
+	   .
+	   .
+	   array[array length -1]
+	 */
+	uint arrayLen = RedisModule_LoadUnsigned(rdb);
+	SIValue list = SI_Array(arrayLen);
+	for(uint i = 0; i < arrayLen; i++) {
+		SIValue elem = _RdbLoadSIValue(rdb, strings);
+		SIArray_Append(&list, elem);
+		SIValue_Free(&elem);
+	}
+	return list;
+}
+
+static void _RdbLoadEntity(RedisModuleIO *rdb, GraphContext *gc, char **strings, GraphEntity *e) {
+	/* Format:
+	 * #properties N
+	 * (name, value type, value) X N
+	*/
+	uint64_t propCount = RedisModule_LoadUnsigned(rdb);
+	if(!propCount) return;
+
+	for(int i = 0; i < propCount; i++) {
+		char *attr_name = RedisModule_LoadStringBuffer(rdb, NULL);
+		SIValue attr_value = _RdbLoadSIValue(rdb, strings);
+		Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr_name);
+		assert(attr_id != ATTRIBUTE_NOTFOUND);
+		// Entity holds its own copy of the value, string values are interned.
+		GraphEntity_AddProperty(e, attr_id, attr_value);
+		SIValue_Free(&attr_value);
+		RedisModule_Free(attr_name);
+	}
+}
+
+static void _RdbLoadNodes(RedisModuleIO *rdb, GraphContext *gc, char **strings) {
+	/* Format:
+	 * #nodes
+	 *      #labels M
+	 *      (labels) X M
+	 *      #properties N
+	 *      (name, value type, value) X N
+	*/
+
+	uint64_t nodeCount = RedisModule_LoadUnsigned(rdb);
+	if(nodeCount == 0) return;
+
+	Graph_AllocateNodes(gc->g, nodeCount);
+	for(uint64_t i = 0; i < nodeCount; i++) {
+		Node n;
+
+		// Extend this logic when multi-label support is added.
+		// #labels M
+		uint64_t nodeLabelCount = RedisModule_LoadUnsigned(rdb);
+
+		// * (labels) x M
+		// M will currently always be 0 or 1
+		uint64_t l = (nodeLabelCount) ? RedisModule_LoadUnsigned(rdb) : GRAPH_NO_LABEL;
+		Graph_CreateNode(gc->g, l, &n);
+
+		_RdbLoadEntity(rdb, gc, strings, (GraphEntity *)&n);
+	}
+}
+
+static void _RdbLoadEdges(RedisModuleIO *rdb, GraphContext *gc, char **strings) {
+	/* Format:
+	 * #edges (N)
+	 * {
+	 *  source node ID
+	 *  destination node ID
+	 *  relation type
+	 * } X N
+	 * edge properties X N */
+
+	uint64_t edgeCount = RedisModule_LoadUnsigned(rdb);
+	if(edgeCount == 0) return;
+
+	Graph_AllocateEdges(gc->g, edgeCount);
+	// Construct connections.
+	for(int i = 0; i < edgeCount; i++) {
+		Edge e;
+		NodeID srcId = RedisModule_LoadUnsigned(rdb);
+		NodeID destId = RedisModule_LoadUnsigned(rdb);
+		uint64_t relation = RedisModule_LoadUnsigned(rdb);
+		assert(Graph_ConnectNodes(gc->g, srcId, destId, relation, &e));
+		_RdbLoadEntity(rdb, gc, strings, (GraphEntity *)&e);
+	}
+}
+
+void RdbLoadGraph_v7(RedisModuleIO *rdb, GraphContext *gc) {
+	/* Format:
+	 * #strings
+	 * string X #strings
+	 *
+	 * #nodes
+	 *      #labels M
+	 *      (labels) X M
+	 *      #properties N
+	 *      (name, value type, value) X N
+	 *
+	 * #edges
+	 *      relation type
+	 *      source node ID
+	 *      destination node ID
+	 *      #properties N
+	 *      (name, value type, value) X N
+	 */
+
+	// While loading the graph, minimize matrix realloc and synchronization calls.
+	Graph_SetMatrixPolicy(gc->g, RESIZE_TO_CAPACITY);
+
+	// Load string dictionary, referenced by string property values.
+	char **strings = _RdbLoadStrings(rdb);
+
+	// Load nodes.
+	_RdbLoadNodes(rdb, gc, strings);
+
+	// Load edges.
+	_RdbLoadEdges(rdb, gc, strings);
+
+	_RdbFreeStrings(strings);
+
+	// Revert to default synchronization behavior
+	Graph_SetMatrixPolicy(gc->g, SYNC_AND_MINIMIZE_SPACE);
+
+	// Resize and flush all pending changes to matrices.
+	Graph_ApplyAllPending(gc->g);
+}
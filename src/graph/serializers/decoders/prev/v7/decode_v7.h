@@ -0,0 +1,16 @@
+/*
+ * Copyright 2018-2019 Redis Labs Ltd. and Contributors
+ *
+ * This file is available under the Redis Labs Source Available License Agreement
+ */
+
+#pragma once
+
+#include "../../../../graphcontext.h"
+#include "../../../../../index/index.h"
+#include "../../../../../redismodule.h"
+#include "../../../../../schema/schema.h"
+
+GraphContext *RdbLoadGraphContext_v7(RedisModuleIO *rdb);
+void RdbLoadGraph_v7(RedisModuleIO *rdb, GraphContext *gc);
+Schema *RdbLoadSchema_v7(RedisModuleIO *rdb, SchemaType type);
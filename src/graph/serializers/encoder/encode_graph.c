@@ -12,6 +12,7 @@
 #include "../../../util/qsort.h"
 #include "../../../../deps/GraphBLAS/Include/GraphBLAS.h"
 #include "../../../datatypes/array.h"
+#include "../../../util/string_pool.h"
 
 // Forward declerations.
 void _RdbSaveSIArray(RedisModuleIO *rdb, const SIValue array);
@@ -52,6 +53,20 @@ static NodeID _updatedID(uint64_t *array, NodeID id) {
 	}
 }
 
+static void _RdbSaveString(RedisModuleIO *rdb, const SIValue *v) {
+	/* Format:
+	 * string ID + 1, 0 if string is inlined
+	 * string (if inlined) */
+
+	// Interned strings are saved as a reference into the string dictionary.
+	if(v->allocation == M_INTERN) {
+		RedisModule_SaveUnsigned(rdb, (uint64_t)StringPool_GetID(v->stringval) + 1);
+		return;
+	}
+	RedisModule_SaveUnsigned(rdb, 0);
+	RedisModule_SaveStringBuffer(rdb, v->stringval, strlen(v->stringval) + 1);
+}
+
 void _RdbSaveSIValue(RedisModuleIO *rdb, const SIValue *v) {
 	/* Format:
 	 * SIType
@@ -66,7 +81,7 @@ void _RdbSaveSIValue(RedisModuleIO *rdb, const SIValue *v) {
 		RedisModule_SaveDouble(rdb, v->doubleval);
 		return;
 	case T_STRING:
-		RedisModule_SaveStringBuffer(rdb, v->stringval, strlen(v->stringval) + 1);
+		_RdbSaveString(rdb, v);
 		return;
 	case T_ARRAY:
 		_RdbSaveSIArray(rdb, *v);
@@ -205,28 +220,43 @@ void _RdbSaveEdges(RedisModuleIO *rdb, const Graph *g, char **string_mapping) {
 			e.srcNodeID = src;
 			e.destNodeID = dest;
 
+			uint32_t edgeCount;
 			GrB_Matrix_extractElement_UINT64(&edgeID, M, src, dest);
-			if(SINGLE_EDGE(edgeID)) {
-				edgeID = SINGLE_EDGE_ID(edgeID);
-				Graph_GetEdge(g, edgeID, &e);
+			const EdgeID *edgeIDs = Graph_ResolveRelationMapEntry(g, r, &edgeID, &edgeCount);
+			for(uint32_t i = 0; i < edgeCount; i++) {
+				Graph_GetEdge(g, edgeIDs[i], &e);
 				_RdbSaveEdge(rdb, g, &e, r, string_mapping);
-			} else {
-				EdgeID *edgeIDs = (EdgeID *)edgeID;
-				int edgeCount = array_len(edgeIDs);
-				for(int i = 0; i < edgeCount; i++) {
-					edgeID = edgeIDs[i];
-					Graph_GetEdge(g, edgeID, &e);
-					_RdbSaveEdge(rdb, g, &e, r, string_mapping);
-				}
 			}
 		}
 
 		GxB_MatrixTupleIter_free(it);
+
+		/* Writers commit pending edges prior to releasing the graph,
+		 * as such the mapping matrix holds every edge of the relation. */
+		assert(array_len(g->_pending_edges[r]) == 0);
+	}
+}
+
+static void _RdbSaveStrings(RedisModuleIO *rdb, const StringPool *pool) {
+	/* Format:
+	 * #strings N
+	 * string X N */
+
+	// String IDs are positional, unused IDs are saved as empty strings.
+	uint32_t count = (pool) ? StringPool_IDCount(pool) : 0;
+	RedisModule_SaveUnsigned(rdb, count);
+	for(uint32_t i = 0; i < count; i++) {
+		const char *str = StringPool_GetString(pool, i);
+		if(str == NULL) str = "";
+		RedisModule_SaveStringBuffer(rdb, str, strlen(str) + 1);
 	}
 }
 
 void RdbSaveGraph(RedisModuleIO *rdb, GraphContext *gc) {
 	/* Format:
+	 * #strings
+	 * string X #strings
+	 *
 	 * #nodes
 	 *      #labels M
 	 *      (labels) X M
@@ -241,6 +271,9 @@ void RdbSaveGraph(RedisModuleIO *rdb, GraphContext *gc) {
 	 *      (name, value type, value) X N
 	 */
 
+	// Dump string dictionary, referenced by string property values.
+	_RdbSaveStrings(rdb, gc->string_pool);
+
 	// Dump nodes.
 	_RdbSaveNodes(rdb, gc->g, gc->string_mapping);
 
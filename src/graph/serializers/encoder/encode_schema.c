@@ -19,12 +19,47 @@ static inline void _RdbSaveIndexData(RedisModuleIO *rdb, Index *idx) {
 	}
 }
 
+static void _RdbSaveStatistics(RedisModuleIO *rdb, const SchemaStats *stats) {
+	/* Format:
+	 * #attributes N
+	 * {
+	 *  attribute ID
+	 *  #entities holding attribute
+	 *  #numeric values observed
+	 *  distinct values sketch
+	 *  #sampled values M
+	 *  sampled value X M
+	 * } X N */
+
+	uint attribute_count = 0;
+	uint id_count = SchemaStats_AttributeCount(stats);
+	for(uint i = 0; i < id_count; i++) {
+		if(SchemaStats_GetAttribute(stats, i)) attribute_count++;
+	}
+	RedisModule_SaveUnsigned(rdb, attribute_count);
+
+	for(uint i = 0; i < id_count; i++) {
+		const AttributeStats *a = SchemaStats_GetAttribute(stats, i);
+		if(!a) continue;
+
+		RedisModule_SaveUnsigned(rdb, i);
+		RedisModule_SaveUnsigned(rdb, a->count);
+		RedisModule_SaveUnsigned(rdb, a->numeric_count);
+		RedisModule_SaveStringBuffer(rdb, (const char *)a->ndv->registers, HLL_REGISTERS);
+
+		uint sample_count = array_len(a->sample);
+		RedisModule_SaveUnsigned(rdb, sample_count);
+		for(uint j = 0; j < sample_count; j++) RedisModule_SaveDouble(rdb, a->sample[j]);
+	}
+}
+
 void RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 	/* Format:
 	 * id
 	 * name
 	 * #indices
-	 * (index type, indexed property) X M */
+	 * (index type, indexed property) X M
+	 * statistics */
 
 	// Schema ID.
 	RedisModule_SaveUnsigned(rdb, s->id);
@@ -40,4 +75,7 @@ void RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 
 	// Fulltext indices.
 	_RdbSaveIndexData(rdb, s->fulltextIdx);
+
+	// Attribute statistics.
+	_RdbSaveStatistics(rdb, s->stats);
 }
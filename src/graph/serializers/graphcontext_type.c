@@ -14,10 +14,10 @@
 /* Declaration of the type for redis registration. */
 RedisModuleType *GraphContextRedisModuleType;
 
-#define GRAPHCONTEXT_TYPE_ENCODING_VERSION 6 // Current RDB encoding version
+#define GRAPHCONTEXT_TYPE_ENCODING_VERSION 8 // Current RDB encoding version
 
-#define DECODER_SUPPORT_MAX_V 6      // Highest RDB version that can be decoded.
-#define DECODER_SUPPORT_MIN_V 6      // Lowest version that can be decoded using the latest routine.
+#define DECODER_SUPPORT_MAX_V 8      // Highest RDB version that can be decoded.
+#define DECODER_SUPPORT_MIN_V 8      // Lowest version that can be decoded using the latest routine.
 #define PREV_DECODER_SUPPORT_MIN_V 4 // Lowest version that has backwards-compatibility decoding routines.
 
 void *GraphContextType_RdbLoad(RedisModuleIO *rdb, int encver) {
@@ -4,45 +4,53 @@
 * This file is available under the Redis Labs Source Available License Agreement
 */
 
+#include <math.h>
 #include <stdio.h>
 #include "group.h"
 #include "../redismodule.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 
-// Creates a new group
+// Initialize a group
 // arguments specify group's key.
-Group *NewGroup(int key_count, SIValue *keys, AR_ExpNode **funcs, Record r) {
-	Group *g = rm_malloc(sizeof(Group));
+void Group_Init(Group *g, int key_count, SIValue *keys, AR_ExpNode **funcs, Record r) {
 	g->keys = keys;
 	g->key_count = key_count;
 	g->aggregationFunctions = funcs;
 	if(r) g->r = Record_Clone(r);
 	else g->r = NULL;
-	return g;
 }
 
-void Group_KeyStr(const Group *g, char **group_key) {
-	if(g->key_count == 0) {
-		*group_key = rm_strdup("SINGLE_GROUP");
-		return;
-	}
+static inline bool _KeyMatch(SIValue a, SIValue b) {
+	// Common case, avoid generic comparison.
+	if(a.type == T_INT64 && b.type == T_INT64) return a.longval == b.longval;
+	// Null values are grouped together.
+	if(a.type == T_NULL || b.type == T_NULL) return a.type == b.type;
+	// NaN values are grouped together, generic comparison treats NaN as equal to any number.
+	bool a_nan = (a.type == T_DOUBLE && isnan(a.doubleval));
+	bool b_nan = (b.type == T_DOUBLE && isnan(b.doubleval));
+	if(a_nan || b_nan) return a_nan == b_nan;
+
+	int disjointOrNull = 0;
+	int res = SIValue_Compare(a, b, &disjointOrNull);
+	return res == 0 && disjointOrNull != DISJOINT;
+}
 
-	// Determine required size for group key string representation.
-	size_t group_len_key = SIValue_StringJoinLen(g->keys, g->key_count, ",");
-	*group_key = rm_malloc(sizeof(char) * group_len_key);
-	size_t bytesWritten = 0;
-	SIValue_StringJoin(g->keys, g->key_count, ",", group_key, &group_len_key, &bytesWritten);
+bool Group_KeysMatch(const Group *g, const SIValue *keys) {
+	for(int i = 0; i < g->key_count; i++) {
+		if(!_KeyMatch(g->keys[i], keys[i])) return false;
+	}
+	return true;
 }
 
-void FreeGroup(Group *g) {
+void Group_Clear(Group *g) {
 	if(g == NULL) return;
-	if(g->r) Record_Free(g->r);
-	if(g->keys) {
-		for(int i = 0; i < g->key_count; i ++) {
-			SIValue_Free(&g->keys[i]);
-		}
-		rm_free(g->keys);
+	if(g->r) {
+		Record_Free(g->r);
+		g->r = NULL;
+	}
+	for(int i = 0; i < g->key_count; i ++) {
+		SIValue_Free(&g->keys[i]);
 	}
 	if(g->aggregationFunctions) {
 		for(uint32_t i = 0; i < array_len(g->aggregationFunctions); i++) {
@@ -50,6 +58,6 @@ void FreeGroup(Group *g) {
 			AR_EXP_Free(exp);
 		}
 		array_free(g->aggregationFunctions);
+		g->aggregationFunctions = NULL;
 	}
-	rm_free(g);
 }
@@ -18,13 +18,14 @@ typedef struct {
 	Record r;   /* Representative record for all aggregated records in group. */
 } Group;
 
-/* Creates a new group */
-Group *NewGroup(int key_count, SIValue *keys, AR_ExpNode **funcs, Record r);
+/* Initialize group, keys storage is owned by the caller
+ * while the group takes ownership over the key values. */
+void Group_Init(Group *g, int key_count, SIValue *keys, AR_ExpNode **funcs, Record r);
 
-/* Compute group key string representation, it is the callers
- * responsibility to free returned string. */
-void Group_KeyStr(const Group *g, char **group_key);
+/* Tests if keys identify group, nulls are considered equal to one another. */
+bool Group_KeysMatch(const Group *g, const SIValue *keys);
 
-void FreeGroup(Group *group);
+/* Frees group's content, the group itself and its keys storage are not freed. */
+void Group_Clear(Group *g);
 
 #endif
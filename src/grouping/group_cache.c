@@ -5,51 +5,208 @@
 */
 
 #include "group_cache.h"
+#include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../graph/entities/graph_entity.h"
+#include <math.h>
+#include <string.h>
+#include <assert.h>
 
-CacheGroup *CacheGroupNew() {
-	return raxNew();
+// Initial number of hash table slots.
+#define GROUP_CACHE_INITIAL_SLOTS 32
+
+// Scramble integer bits, such that consecutive integers spread across the table.
+static inline uint64_t _MixInteger(uint64_t x) {
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb93fe53e7ed3ULL;
+	x ^= x >> 33;
+	return x;
 }
 
-void CacheGroupAdd(CacheGroup *groups, char *key, Group *group) {
-	raxInsert(groups, (unsigned char *)key, strlen(key), group, NULL);
+static void _AllocSlots(CacheGroup *cache, uint64_t slot_count) {
+	cache->mask = slot_count - 1;
+	cache->slots = rm_malloc(sizeof(CacheGroupSlot) * slot_count);
+	for(uint64_t i = 0; i < slot_count; i++) cache->slots[i].idx = GROUP_CACHE_EMPTY;
 }
 
-// Retrives a group,
-// Sets group to NULL if key is missing.
-Group *CacheGroupGet(CacheGroup *groups, char *key) {
-	Group *g = raxFind(groups, (unsigned char *)key, strlen(key));
-	if(g == raxNotFound) return NULL;
+// Position of the slot holding group with given keys, or of the empty slot it should occupy.
+static uint64_t _FindSlot(const CacheGroup *cache, const SIValue *keys, uint64_t hash) {
+	uint64_t pos = hash & cache->mask;
+	while(cache->slots[pos].idx != GROUP_CACHE_EMPTY) {
+		const CacheGroupSlot *slot = cache->slots + pos;
+		// Groups sharing a hash might still differ.
+		if(slot->hash == hash && Group_KeysMatch(cache->groups[slot->idx], keys)) break;
+		pos = (pos + 1) & cache->mask;
+	}
+	return pos;
+}
+
+// Double the number of hash table slots.
+static void _Grow(CacheGroup *cache) {
+	CacheGroupSlot *old_slots = cache->slots;
+	uint64_t old_slot_count = cache->mask + 1;
+	_AllocSlots(cache, old_slot_count * 2);
+
+	for(uint64_t i = 0; i < old_slot_count; i++) {
+		if(old_slots[i].idx == GROUP_CACHE_EMPTY) continue;
+		// Keys are distinct, no need to compare them.
+		uint64_t pos = old_slots[i].hash & cache->mask;
+		while(cache->slots[pos].idx != GROUP_CACHE_EMPTY) pos = (pos + 1) & cache->mask;
+		cache->slots[pos] = old_slots[i];
+	}
+	rm_free(old_slots);
+}
+
+// Retrieve an unused group and its keys storage from the arena.
+static Group *_AllocGroup(CacheGroup *cache, SIValue **keys) {
+	CacheGroupBlock *block = cache->blocks + cache->block_idx;
+	if(block->used == block->cap) {
+		cache->block_idx++;
+		// Allocate a new block unless one is retained from a previous use.
+		if(cache->block_idx == array_len(cache->blocks)) {
+			uint32_t cap = block->cap * 2;
+			if(cap > GROUP_CACHE_MAX_BLOCK) cap = GROUP_CACHE_MAX_BLOCK;
+			CacheGroupBlock new_block = {
+				.groups = rm_malloc(sizeof(Group) * cap),
+				.keys = (cache->key_count) ? rm_malloc(sizeof(SIValue) * cache->key_count * cap) : NULL,
+				.used = 0,
+				.cap = cap
+			};
+			cache->blocks = array_append(cache->blocks, new_block);
+		}
+		block = cache->blocks + cache->block_idx;
+	}
+
+	*keys = (block->keys) ? block->keys + (uint64_t)block->used * cache->key_count : NULL;
+	return block->groups + block->used++;
+}
+
+CacheGroup *CacheGroupNew(uint key_count) {
+	CacheGroup *cache = rm_malloc(sizeof(CacheGroup));
+	cache->key_count = key_count;
+	cache->groups = array_new(Group *, GROUP_CACHE_MIN_BLOCK);
+	_AllocSlots(cache, GROUP_CACHE_INITIAL_SLOTS);
+
+	// First arena block.
+	cache->block_idx = 0;
+	cache->blocks = array_new(CacheGroupBlock, 1);
+	CacheGroupBlock block = {
+		.groups = rm_malloc(sizeof(Group) * GROUP_CACHE_MIN_BLOCK),
+		.keys = (key_count) ? rm_malloc(sizeof(SIValue) * key_count * GROUP_CACHE_MIN_BLOCK) : NULL,
+		.used = 0,
+		.cap = GROUP_CACHE_MIN_BLOCK
+	};
+	cache->blocks = array_append(cache->blocks, block);
+	return cache;
+}
+
+uint64_t CacheGroupHash(const CacheGroup *cache, const SIValue *keys) {
+	if(cache->key_count == 0) return 0;
+
+	// Fast path, group is identified by a single integer or node.
+	if(cache->key_count == 1) {
+		SIValue key = keys[0];
+		switch(key.type) {
+		case T_INT64:
+			return _MixInteger(key.longval);
+		case T_DOUBLE: {
+			double d = key.doubleval;
+			/* Integral doubles must agree with their integer counterparts, range check
+			 * precedes the conversion, which is undefined for NaN and out of range values. */
+			if(d >= -0x1p63 && d < 0x1p63 && d == (double)(int64_t)d) return _MixInteger((int64_t)d);
+			// Hash bit pattern of any other double, all NaNs share a pattern.
+			if(isnan(d)) d = NAN;
+			uint64_t bits;
+			memcpy(&bits, &d, sizeof(bits));
+			return _MixInteger(bits) ^ T_DOUBLE;
+		}
+		case T_NODE:
+			return _MixInteger(ENTITY_GET_ID((GraphEntity *)key.ptrval)) ^ T_NODE;
+		default:
+			break;
+		}
+	}
+
+	uint64_t h = 0;
+	for(uint i = 0; i < cache->key_count; i++) h = 31 * h + SIValue_HashCode(keys[i]);
+	return h;
+}
+
+Group *CacheGroupGet(const CacheGroup *cache, const SIValue *keys, uint64_t hash) {
+	uint64_t pos = _FindSlot(cache, keys, hash);
+	uint32_t idx = cache->slots[pos].idx;
+	if(idx == GROUP_CACHE_EMPTY) return NULL;
+	return cache->groups[idx];
+}
+
+Group *CacheGroupAdd(CacheGroup *cache, const SIValue *keys, uint64_t hash, AR_ExpNode **funcs,
+					 Record r) {
+	// Keep table at most half full.
+	uint32_t idx = array_len(cache->groups);
+	if((uint64_t)(idx + 1) * 2 > cache->mask + 1) _Grow(cache);
+
+	SIValue *group_keys;
+	Group *g = _AllocGroup(cache, &group_keys);
+	for(uint i = 0; i < cache->key_count; i++) group_keys[i] = keys[i];
+	Group_Init(g, cache->key_count, group_keys, funcs, r);
+
+	uint64_t pos = _FindSlot(cache, keys, hash);
+	assert(cache->slots[pos].idx == GROUP_CACHE_EMPTY);
+	cache->slots[pos].hash = hash;
+	cache->slots[pos].idx = idx;
+	cache->groups = array_append(cache->groups, g);
 	return g;
 }
 
-void FreeGroupCache(CacheGroup *groups) {
-	raxFreeWithCallback(groups, (void (*)(void *))FreeGroup);
+void CacheGroupClear(CacheGroup *cache) {
+	uint32_t group_count = array_len(cache->groups);
+	for(uint32_t i = 0; i < group_count; i++) Group_Clear(cache->groups[i]);
+	array_clear(cache->groups);
+
+	uint32_t block_count = array_len(cache->blocks);
+	for(uint32_t i = 0; i < block_count; i++) cache->blocks[i].used = 0;
+	cache->block_idx = 0;
+
+	for(uint64_t i = 0; i <= cache->mask; i++) cache->slots[i].idx = GROUP_CACHE_EMPTY;
+}
+
+void FreeGroupCache(CacheGroup *cache) {
+	if(cache == NULL) return;
+	CacheGroupClear(cache);
+	array_free(cache->groups);
+
+	uint32_t block_count = array_len(cache->blocks);
+	for(uint32_t i = 0; i < block_count; i++) {
+		rm_free(cache->blocks[i].groups);
+		if(cache->blocks[i].keys) rm_free(cache->blocks[i].keys);
+	}
+	array_free(cache->blocks);
+
+	rm_free(cache->slots);
+	rm_free(cache);
 }
 
 // Populates an iterator to scan entire group cache
-CacheGroupIterator *CacheGroupIter(CacheGroup *groups) {
+CacheGroupIterator *CacheGroupIter(CacheGroup *cache) {
 	CacheGroupIterator *iter = rm_malloc(sizeof(CacheGroupIterator));
-
-	raxStart(iter, groups);
-	raxSeek(iter, "^", NULL, 0);
-
+	iter->cache = cache;
+	iter->pos = 0;
 	return iter;
 }
 
-// Advance iterator and returns key & value in current position.
-int CacheGroupIterNext(CacheGroupIterator *iter, char **key, Group **group) {
-	int res = raxNext(iter);
-	if(res == 0) {
+// Advance iterator and returns group in current position.
+int CacheGroupIterNext(CacheGroupIterator *iter, Group **group) {
+	if(iter->pos >= array_len(iter->cache->groups)) {
 		*group = NULL;
-	} else {
-		*group = iter->data; // TODO revisit this to fix up
+		return 0;
 	}
-	return res;
+	*group = iter->cache->groups[iter->pos++];
+	return 1;
 }
 
 void CacheGroupIterator_Free(CacheGroupIterator *iter) {
 	if(iter == NULL) return;
-	raxStop(iter);
 	rm_free(iter);
 }
@@ -8,27 +8,69 @@
 #define GROUP_CACHE_H_
 
 #include "group.h"
-#include "rax.h"
 
-typedef raxIterator CacheGroupIterator;
-typedef rax CacheGroup;
+// Number of groups allocated by the first arena block, each following block doubles in size.
+#define GROUP_CACHE_MIN_BLOCK 16
+// Maximum number of groups allocated by a single arena block.
+#define GROUP_CACHE_MAX_BLOCK 4096
+// Marks an empty hash table slot.
+#define GROUP_CACHE_EMPTY UINT32_MAX
 
-CacheGroup *CacheGroupNew();
+/* Open addressing hash table slot. */
+typedef struct {
+	uint64_t hash;          // Hash of group keys.
+	uint32_t idx;           // Position of group within creation order, GROUP_CACHE_EMPTY if slot is empty.
+} CacheGroupSlot;
 
-void CacheGroupAdd(CacheGroup *groups, char *key, Group *group);
+/* Arena block, holds groups and their keys. */
+typedef struct {
+	Group *groups;
+	SIValue *keys;          // key_count keys per group.
+	uint32_t used;          // Number of groups in use.
+	uint32_t cap;           // Number of groups block can hold.
+} CacheGroupBlock;
 
-// Retrives a group,
-// Sets group to NULL if key is missing.
-Group *CacheGroupGet(CacheGroup *groups, char *key);
+/* Group cache maps group keys to groups, keys are hashed in their binary form.
+ * Groups are allocated from arena blocks and iterated in creation order. */
+typedef struct {
+	uint key_count;         // Number of keys identifying a group.
+	CacheGroupSlot *slots;  // Hash table.
+	uint64_t mask;          // Number of slots - 1.
+	Group **groups;         // Groups in creation order.
+	CacheGroupBlock *blocks;// Arena blocks.
+	uint32_t block_idx;     // Block currently allocated from.
+} CacheGroup;
 
-void FreeGroupCache(CacheGroup *groups);
+typedef struct {
+	CacheGroup *cache;
+	uint32_t pos;           // Position of next group within creation order.
+} CacheGroupIterator;
+
+CacheGroup *CacheGroupNew(uint key_count);
+
+/* Compute hash of group keys. */
+uint64_t CacheGroupHash(const CacheGroup *cache, const SIValue *keys);
+
+// Retrives a group by its keys and their hash,
+// returns NULL if group is missing.
+Group *CacheGroupGet(const CacheGroup *cache, const SIValue *keys, uint64_t hash);
+
+/* Creates a new group identified by keys, which are copied into the arena,
+ * group takes ownership over the key values, funcs and r are handed to Group_Init. */
+Group *CacheGroupAdd(CacheGroup *cache, const SIValue *keys, uint64_t hash, AR_ExpNode **funcs,
+					 Record r);
+
+/* Frees all groups, memory is retained for reuse. */
+void CacheGroupClear(CacheGroup *cache);
+
+void FreeGroupCache(CacheGroup *cache);
 
 // Populates an iterator to scan group cache
-CacheGroupIterator *CacheGroupIter(CacheGroup *groups);
+CacheGroupIterator *CacheGroupIter(CacheGroup *cache);
 
-// Advance iterator and returns key & value in current position.
-int CacheGroupIterNext(CacheGroupIterator *iter, char **key, Group **group);
+// Advance iterator and returns group in current position.
+int CacheGroupIterNext(CacheGroupIterator *iter, Group **group);
 
 void CacheGroupIterator_Free(CacheGroupIterator *iter);
 
-#endif
\ No newline at end of file
+#endif
@@ -30,6 +30,10 @@
 pthread_mutex_t _module_mutex;     // Module-level lock.
 GraphContext **graphs_in_keyspace; // Global array tracking all extant GraphContexts.
 bool process_is_child;             // Flag indicating whether the running process is a child.
+uint plan_cache_size;              // Maximum number of cached execution plans per graph.
+uint query_parallelism;            // Maximum number of threads executing a single query.
+bool maintain_transposed_matrices; // Flag indicating whether graphs maintain transposed relation matrices.
+bool node_compaction;              // Flag indicating whether node storage is compacted after write queries.
 
 //------------------------------------------------------------------------------
 // Thread pool variables
@@ -135,6 +139,18 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	if(!_Setup_ThreadPOOL(threadCount)) return REDISMODULE_ERR;
 	RedisModule_Log(ctx, "notice", "Thread pool created, using %d threads.", threadCount);
 
+	plan_cache_size = Config_GetPlanCacheSize(ctx, argv, argc);
+	if(plan_cache_size == 0) RedisModule_Log(ctx, "notice", "Execution plan cache disabled.");
+
+	query_parallelism = Config_GetQueryParallelism(ctx, argv, argc, threadCount);
+	RedisModule_Log(ctx, "notice", "Query parallelism set to %d threads.", query_parallelism);
+
+	maintain_transposed_matrices = Config_GetMaintainTransposedMatrices(ctx, argv, argc);
+	if(!maintain_transposed_matrices) RedisModule_Log(ctx, "notice", "Transposed relation matrices disabled.");
+
+	node_compaction = Config_GetNodeCompaction(ctx, argv, argc);
+	if(node_compaction) RedisModule_Log(ctx, "notice", "Node compaction enabled, node IDs are not stable.");
+
 	if(_RegisterDataTypes(ctx) != REDISMODULE_OK) return REDISMODULE_ERR;
 
 	if(RedisModule_CreateCommand(ctx, "graph.QUERY", MGraph_Query, "write deny-oom", 1, 1,
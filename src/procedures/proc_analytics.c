@@ -0,0 +1,257 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_analytics.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+#include "../algorithms/kcore.h"
+#include "../algorithms/pagerank.h"
+#include "../algorithms/triangle_count.h"
+#include "../algorithms/connected_components.h"
+#include <assert.h>
+
+/* CALL algo.pageRank([relationship]) YIELD node, score
+ * CALL algo.WCC([relationship]) YIELD node, component
+ * CALL algo.triangleCount([relationship]) YIELD node, triangles
+ * CALL algo.kCore([relationship]) YIELD node, core
+ *
+ * Streams every node of the graph along with its computed value.
+ * Only edges of the given relationship type are considered,
+ * omit it or pass an empty string to consider edges of any type.
+ * PageRank follows edges by their direction, the other algorithms
+ * treat the graph as undirected, ignoring self loops. */
+
+typedef enum {
+	ANALYTICS_PAGERANK,
+	ANALYTICS_WCC,
+	ANALYTICS_TRIANGLE_COUNT,
+	ANALYTICS_KCORE,
+} AnalyticsAlgorithm;
+
+typedef struct {
+	Node n;                     // Reported node.
+	bool fp;                    // Values are floating point.
+	GrB_Vector values;          // Computed value of each node.
+	DataBlockIterator *iter;    // Graph nodes iterator.
+	SIValue *output;            // Output, pairs of column name and value.
+} AnalyticsContext;
+
+// Matrix of the given relationship type, relationship is optional.
+static GrB_Matrix _RelationMatrix(GraphContext *gc, const char *relationship) {
+	Graph *g = gc->g;
+	if(relationship == NULL || relationship[0] == '\0') return Graph_GetAdjacencyMatrix(g);
+
+	Schema *s = GraphContext_GetSchema(gc, relationship, SCHEMA_EDGE);
+	if(!s) return Graph_GetZeroMatrix(g);
+	return Graph_GetRelationMatrix(g, s->id);
+}
+
+// Builds the undirected pattern of M, A = M + M' without self loops.
+static GrB_Matrix _Undirected(GrB_Matrix M) {
+	GrB_Index n;
+	GrB_Matrix A;
+	GrB_Matrix_nrows(&n, M);
+	GrB_Descriptor desc;
+	GrB_Descriptor_new(&desc);
+	GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
+	GrB_Matrix_new(&A, GrB_BOOL, n, n);
+	GrB_eWiseAdd_Matrix_BinaryOp(A, NULL, NULL, GrB_LOR, M, M, desc);
+	GrB_Descriptor_free(&desc);
+	GxB_Matrix_select(A, NULL, NULL, GxB_OFFDIAG, A, NULL, NULL);
+	return A;
+}
+
+// Builds a vector holding an entry for each node of the graph.
+static GrB_Vector _Nodes(Graph *g, GrB_Index n) {
+	GrB_Vector nodes;
+	GrB_Vector_new(&nodes, GrB_BOOL, n);
+
+	Node node;
+	Entity *en;
+	DataBlockIterator *it = Graph_ScanNodes(g);
+	while((en = (Entity *)DataBlockIterator_Next(it))) {
+		node.entity = en;
+		GrB_Vector_setElement_BOOL(nodes, true, ENTITY_GET_ID(&node));
+	}
+	DataBlockIterator_Free(it);
+
+	return nodes;
+}
+
+static GrB_Vector _Compute(AnalyticsAlgorithm algo, Graph *g, GrB_Matrix M) {
+	if(algo == ANALYTICS_PAGERANK) {
+		GrB_Index n;
+		GrB_Matrix_nrows(&n, M);
+		GrB_Vector nodes = _Nodes(g, n);
+		GrB_Vector ranks = PageRank(M, nodes);
+		GrB_Vector_free(&nodes);
+		return ranks;
+	}
+
+	GrB_Vector values = NULL;
+	GrB_Matrix A = _Undirected(M);
+	switch(algo) {
+	case ANALYTICS_WCC:
+		values = ConnectedComponents(A);
+		break;
+	case ANALYTICS_TRIANGLE_COUNT:
+		values = TriangleCount(A);
+		break;
+	case ANALYTICS_KCORE:
+		values = KCore(A);
+		break;
+	default:
+		assert(false);
+	}
+	GrB_Matrix_free(&A);
+	return values;
+}
+
+static ProcedureResult _Invoke(ProcedureCtx *ctx, const char **args, AnalyticsAlgorithm algo,
+							   char *column) {
+	ctx->privateData = NULL;
+	uint argc = array_len(args);
+	if(argc > 1) return PROCEDURE_ERR;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	const char *relationship = (argc > 0) ? args[0] : NULL;
+	GrB_Matrix M = _RelationMatrix(gc, relationship);
+
+	AnalyticsContext *pdata = rm_malloc(sizeof(AnalyticsContext));
+	pdata->fp = (algo == ANALYTICS_PAGERANK);
+	pdata->values = _Compute(algo, gc->g, M);
+	pdata->iter = Graph_ScanNodes(gc->g);
+	pdata->output = array_new(SIValue, 4);
+	pdata->output = array_append(pdata->output, SI_ConstStringVal("node"));
+	pdata->output = array_append(pdata->output, SI_NullVal()); // Place holder.
+	pdata->output = array_append(pdata->output, SI_ConstStringVal(column));
+	pdata->output = array_append(pdata->output, SI_NullVal()); // Place holder.
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+ProcedureResult Proc_PageRankInvoke(ProcedureCtx *ctx, const char **args) {
+	return _Invoke(ctx, args, ANALYTICS_PAGERANK, "score");
+}
+
+ProcedureResult Proc_WCCInvoke(ProcedureCtx *ctx, const char **args) {
+	return _Invoke(ctx, args, ANALYTICS_WCC, "component");
+}
+
+ProcedureResult Proc_TriangleCountInvoke(ProcedureCtx *ctx, const char **args) {
+	return _Invoke(ctx, args, ANALYTICS_TRIANGLE_COUNT, "triangles");
+}
+
+ProcedureResult Proc_KCoreInvoke(ProcedureCtx *ctx, const char **args) {
+	return _Invoke(ctx, args, ANALYTICS_KCORE, "core");
+}
+
+SIValue *Proc_AnalyticsStep(ProcedureCtx *ctx) {
+	// Procedure failed.
+	if(!ctx->privateData) return NULL;
+
+	AnalyticsContext *pdata = (AnalyticsContext *)ctx->privateData;
+
+	// Depleted?
+	Entity *en = (Entity *)DataBlockIterator_Next(pdata->iter);
+	if(en == NULL) return NULL;
+
+	pdata->n.entity = en;
+	NodeID id = ENTITY_GET_ID(&pdata->n);
+	pdata->output[1] = SI_Node(&pdata->n);
+
+	// Nodes without an entry, e.g. outside of any triangle, are valued 0.
+	if(pdata->fp) {
+		double v = 0;
+		GrB_Vector_extractElement_FP64(&v, pdata->values, id);
+		pdata->output[3] = SI_DoubleVal(v);
+	} else {
+		uint64_t v = 0;
+		GrB_Vector_extractElement_UINT64(&v, pdata->values, id);
+		pdata->output[3] = SI_LongVal(v);
+	}
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_AnalyticsFree(ProcedureCtx *ctx) {
+	// Clean up.
+	if(ctx->privateData) {
+		AnalyticsContext *pdata = ctx->privateData;
+		GrB_Vector_free(&pdata->values);
+		DataBlockIterator_Free(pdata->iter);
+		array_free(pdata->output);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+static ProcedureOutput **_Outputs(char *column, SIType type) {
+	ProcedureOutput **outputs = array_new(ProcedureOutput *, 2);
+	ProcedureOutput *out_node = rm_malloc(sizeof(ProcedureOutput));
+	out_node->name = "node";
+	out_node->type = T_NODE;
+	ProcedureOutput *out_value = rm_malloc(sizeof(ProcedureOutput));
+	out_value->name = column;
+	out_value->type = type;
+
+	outputs = array_append(outputs, out_node);
+	outputs = array_append(outputs, out_value);
+	return outputs;
+}
+
+ProcedureCtx *Proc_PageRankCtx() {
+	void *privateData = NULL;
+	ProcedureCtx *ctx = ProcCtxNew("algo.pageRank",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   _Outputs("score", T_DOUBLE),
+								   Proc_AnalyticsStep,
+								   Proc_PageRankInvoke,
+								   Proc_AnalyticsFree,
+								   privateData);
+	return ctx;
+}
+
+ProcedureCtx *Proc_WCCCtx() {
+	void *privateData = NULL;
+	ProcedureCtx *ctx = ProcCtxNew("algo.WCC",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   _Outputs("component", T_INT64),
+								   Proc_AnalyticsStep,
+								   Proc_WCCInvoke,
+								   Proc_AnalyticsFree,
+								   privateData);
+	return ctx;
+}
+
+ProcedureCtx *Proc_TriangleCountCtx() {
+	void *privateData = NULL;
+	ProcedureCtx *ctx = ProcCtxNew("algo.triangleCount",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   _Outputs("triangles", T_INT64),
+								   Proc_AnalyticsStep,
+								   Proc_TriangleCountInvoke,
+								   Proc_AnalyticsFree,
+								   privateData);
+	return ctx;
+}
+
+ProcedureCtx *Proc_KCoreCtx() {
+	void *privateData = NULL;
+	ProcedureCtx *ctx = ProcCtxNew("algo.kCore",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   _Outputs("core", T_INT64),
+								   Proc_AnalyticsStep,
+								   Proc_KCoreInvoke,
+								   Proc_AnalyticsFree,
+								   privateData);
+	return ctx;
+}
@@ -0,0 +1,14 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "proc_ctx.h"
+
+ProcedureCtx *Proc_PageRankCtx();
+ProcedureCtx *Proc_WCCCtx();
+ProcedureCtx *Proc_TriangleCountCtx();
+ProcedureCtx *Proc_KCoreCtx();
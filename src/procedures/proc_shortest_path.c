@@ -0,0 +1,267 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_shortest_path.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+#include "../algorithms/shortest_path.h"
+#include <errno.h>
+
+/* CALL algo.shortestPath(src, dest [, relationship [, weight]]) YIELD node, distance
+ * Streams the nodes along a shortest path from src to dest, in order.
+ * CALL algo.SSSP(src [, relationship [, weight]]) YIELD node, distance
+ * Streams every node reachable from src.
+ *
+ * src and dest are node IDs, only edges of the given relationship type are traversed,
+ * omit it or pass an empty string to traverse edges of any type.
+ * Without a weight attribute distance is the number of hops from src,
+ * otherwise it is the weight of the lightest path from src, where the weight
+ * of an edge is its weight attribute, edges without a numeric weight aren't traversed. */
+
+typedef struct {
+	Node n;             // Reported node.
+	Graph *g;           // Graph traversed.
+	uint row;           // Next row to report.
+	NodeID *nodes;      // Reported nodes, arr.h array.
+	SIValue *distances; // Distance of each reported node, arr.h array.
+	SIValue *output;    // Output, pairs of column name and value.
+} ShortestPathContext;
+
+// Parse a node ID argument, returns false if argument isn't an existing node's ID.
+static bool _ParseNodeID(Graph *g, const char *arg, NodeID *id) {
+	char *end;
+	errno = 0;
+	unsigned long long v = strtoull(arg, &end, 10);
+	if(errno != 0 || end == arg || *end != '\0') return false;
+
+	Node n;
+	*id = v;
+	return Graph_GetNode(g, *id, &n);
+}
+
+// Distance of node, as computed by either search.
+static SIValue _Distance(GrB_Vector distances, bool weighted, NodeID id) {
+	if(weighted) {
+		double d;
+		GrB_Vector_extractElement_FP64(&d, distances, id);
+		return SI_DoubleVal(d);
+	}
+	uint64_t d;
+	GrB_Vector_extractElement_UINT64(&d, distances, id);
+	return SI_LongVal(d);
+}
+
+/* Computes shortest paths from src, stopping once dest is reached when searching
+ * by hops. Sets distances and parents, returns false if a negative cycle is reachable
+ * from src. relationship and weight are optional, NULL or empty if not specified. */
+static bool _ComputePaths(GraphContext *gc, NodeID src, NodeID dest, const char *relationship,
+						  const char *weight, GrB_Vector *distances, GrB_Vector *parents) {
+	Graph *g = gc->g;
+	bool any_relation = (relationship == NULL || relationship[0] == '\0');
+	Schema *s = (any_relation) ? NULL : GraphContext_GetSchema(gc, relationship, SCHEMA_EDGE);
+
+	if(weight == NULL || weight[0] == '\0') {
+		GrB_Matrix M;
+		if(any_relation) M = Graph_GetAdjacencyMatrix(g);
+		else if(s) M = Graph_GetRelationMatrix(g, s->id);
+		else M = Graph_GetZeroMatrix(g);
+		ShortestPath_BFS(M, src, dest, distances, parents);
+		return true;
+	}
+
+	// Unknown relationship type, no edge is traversable.
+	Attribute_ID attr = GraphContext_GetAttributeID(gc, weight);
+	if(!any_relation && !s) attr = ATTRIBUTE_NOTFOUND;
+
+	int relation = (s) ? s->id : GRAPH_NO_RELATION;
+	GrB_Matrix W = ShortestPath_WeightMatrix(g, relation, attr);
+	bool res = ShortestPath_BellmanFord(W, src, distances, parents);
+	GrB_Matrix_free(&W);
+	return res;
+}
+
+static ShortestPathContext *_NewContext(Graph *g) {
+	ShortestPathContext *pdata = rm_malloc(sizeof(ShortestPathContext));
+	pdata->g = g;
+	pdata->row = 0;
+	pdata->nodes = array_new(NodeID, 0);
+	pdata->distances = array_new(SIValue, 0);
+	pdata->output = array_new(SIValue, 4);
+	pdata->output = array_append(pdata->output, SI_ConstStringVal("node"));
+	pdata->output = array_append(pdata->output, SI_NullVal()); // Place holder.
+	pdata->output = array_append(pdata->output, SI_ConstStringVal("distance"));
+	pdata->output = array_append(pdata->output, SI_NullVal()); // Place holder.
+	return pdata;
+}
+
+static void _SetInvalidNodeError(const char *arg) {
+	char *error;
+	asprintf(&error, "Invalid node ID `%s`", arg);
+	QueryCtx_SetError(error);
+}
+
+static void _SetNegativeCycleError(void) {
+	char *error;
+	asprintf(&error, "Negative weight cycle is reachable from source");
+	QueryCtx_SetError(error);
+}
+
+ProcedureResult Proc_ShortestPathInvoke(ProcedureCtx *ctx, const char **args) {
+	ctx->privateData = NULL;
+	uint argc = array_len(args);
+	if(argc < 2 || argc > 4) return PROCEDURE_ERR;
+
+	NodeID src;
+	NodeID dest;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	if(!_ParseNodeID(gc->g, args[0], &src)) {
+		_SetInvalidNodeError(args[0]);
+		return PROCEDURE_ERR;
+	}
+	if(!_ParseNodeID(gc->g, args[1], &dest)) {
+		_SetInvalidNodeError(args[1]);
+		return PROCEDURE_ERR;
+	}
+
+	const char *relationship = (argc > 2) ? args[2] : NULL;
+	const char *weight = (argc > 3) ? args[3] : NULL;
+	bool weighted = (weight && weight[0] != '\0');
+
+	GrB_Vector distances;
+	GrB_Vector parents;
+	if(!_ComputePaths(gc, src, dest, relationship, weight, &distances, &parents)) {
+		_SetNegativeCycleError();
+		return PROCEDURE_ERR;
+	}
+
+	ShortestPathContext *pdata = _NewContext(gc->g);
+	NodeID *path = ShortestPath_Trace(parents, src, dest);
+	if(path) {
+		uint path_len = array_len(path);
+		for(uint i = 0; i < path_len; i++) {
+			pdata->nodes = array_append(pdata->nodes, path[i]);
+			pdata->distances = array_append(pdata->distances, _Distance(distances, weighted, path[i]));
+		}
+		array_free(path);
+	}
+
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+ProcedureResult Proc_SSSPInvoke(ProcedureCtx *ctx, const char **args) {
+	ctx->privateData = NULL;
+	uint argc = array_len(args);
+	if(argc < 1 || argc > 3) return PROCEDURE_ERR;
+
+	NodeID src;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	if(!_ParseNodeID(gc->g, args[0], &src)) {
+		_SetInvalidNodeError(args[0]);
+		return PROCEDURE_ERR;
+	}
+
+	const char *relationship = (argc > 1) ? args[1] : NULL;
+	const char *weight = (argc > 2) ? args[2] : NULL;
+	bool weighted = (weight && weight[0] != '\0');
+
+	GrB_Vector distances;
+	GrB_Vector parents;
+	if(!_ComputePaths(gc, src, SHORTEST_PATH_NO_DEST, relationship, weight, &distances, &parents)) {
+		_SetNegativeCycleError();
+		return PROCEDURE_ERR;
+	}
+
+	// Report reachable nodes by ascending ID.
+	GrB_Index nvals;
+	GrB_Vector_nvals(&nvals, parents);
+	GrB_Index *ids = rm_malloc(sizeof(GrB_Index) * nvals);
+	GrB_Vector_extractTuples_UINT64(ids, NULL, &nvals, parents);
+
+	ShortestPathContext *pdata = _NewContext(gc->g);
+	for(GrB_Index i = 0; i < nvals; i++) {
+		pdata->nodes = array_append(pdata->nodes, ids[i]);
+		pdata->distances = array_append(pdata->distances, _Distance(distances, weighted, ids[i]));
+	}
+
+	rm_free(ids);
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_ShortestPathStep(ProcedureCtx *ctx) {
+	// Procedure failed.
+	if(!ctx->privateData) return NULL;
+
+	ShortestPathContext *pdata = (ShortestPathContext *)ctx->privateData;
+
+	// Depleted?
+	if(pdata->row >= array_len(pdata->nodes)) return NULL;
+
+	Graph_GetNode(pdata->g, pdata->nodes[pdata->row], &pdata->n);
+	pdata->output[1] = SI_Node(&pdata->n);
+	pdata->output[3] = pdata->distances[pdata->row];
+	pdata->row++;
+	return pdata->output;
+}
+
+ProcedureResult Proc_ShortestPathFree(ProcedureCtx *ctx) {
+	// Clean up.
+	if(ctx->privateData) {
+		ShortestPathContext *pdata = ctx->privateData;
+		array_free(pdata->nodes);
+		array_free(pdata->distances);
+		array_free(pdata->output);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+static ProcedureOutput **_Outputs(void) {
+	ProcedureOutput **outputs = array_new(ProcedureOutput *, 2);
+	ProcedureOutput *out_node = rm_malloc(sizeof(ProcedureOutput));
+	out_node->name = "node";
+	out_node->type = T_NODE;
+	ProcedureOutput *out_distance = rm_malloc(sizeof(ProcedureOutput));
+	out_distance->name = "distance";
+	out_distance->type = SI_NUMERIC;
+
+	outputs = array_append(outputs, out_node);
+	outputs = array_append(outputs, out_distance);
+	return outputs;
+}
+
+ProcedureCtx *Proc_ShortestPathCtx() {
+	void *privateData = NULL;
+	ProcedureCtx *ctx = ProcCtxNew("algo.shortestPath",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   _Outputs(),
+								   Proc_ShortestPathStep,
+								   Proc_ShortestPathInvoke,
+								   Proc_ShortestPathFree,
+								   privateData);
+	return ctx;
+}
+
+ProcedureCtx *Proc_SSSPCtx() {
+	void *privateData = NULL;
+	ProcedureCtx *ctx = ProcCtxNew("algo.SSSP",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   _Outputs(),
+								   Proc_ShortestPathStep,
+								   Proc_SSSPInvoke,
+								   Proc_ShortestPathFree,
+								   privateData);
+	return ctx;
+}
@@ -0,0 +1,195 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "proc_stats.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/array.h"
+#include "../graph/graphcontext.h"
+#include "../schema/schema_stats.h"
+
+/* CALL db.stats()
+ * Reports the statistics the optimizer estimates cardinalities with:
+ * kind: "label", "relationship", "property", "outDegree" or "inDegree"
+ * name: label or relationship type
+ * property: attribute name, property rows only
+ * count: number of nodes, edges, entities holding the property or nodes with edges
+ * distinct: estimated number of distinct property values
+ * histogram: equi-depth bucket bounds of numeric property values,
+ *            or number of nodes with degree in [2^i, 2^(i+1))
+ * label: label of the nodes a degree histogram accounts for,
+ *        NULL for histograms accounting for all nodes */
+
+#define STATS_COLUMN_COUNT 7
+
+static char *_columns[STATS_COLUMN_COUNT] = {
+	"kind", "name", "property", "count", "distinct", "histogram", "label"
+};
+
+typedef struct {
+	uint row;           // Current row.
+	SIValue **rows;     // Materialized rows, each holding STATS_COLUMN_COUNT values.
+	SIValue *output;    // Output, pairs of column name and value.
+} StatsContext;
+
+static void _AddRow(StatsContext *pdata, const char *kind, const char *name, const char *property,
+					uint64_t count, SIValue distinct, SIValue histogram, const char *label) {
+	SIValue *row = rm_malloc(sizeof(SIValue) * STATS_COLUMN_COUNT);
+	row[0] = SI_ConstStringVal((char *)kind);
+	row[1] = SI_ConstStringVal((char *)name);
+	row[2] = (property) ? SI_ConstStringVal((char *)property) : SI_NullVal();
+	row[3] = SI_LongVal(count);
+	row[4] = distinct;
+	row[5] = histogram;
+	row[6] = (label) ? SI_ConstStringVal((char *)label) : SI_NullVal();
+	pdata->rows = array_append(pdata->rows, row);
+}
+
+static void _AddAttributeRows(StatsContext *pdata, GraphContext *gc, Schema *s) {
+	double bounds[STATS_HISTOGRAM_BUCKETS + 1];
+	uint attribute_count = SchemaStats_AttributeCount(s->stats);
+	for(uint i = 0; i < attribute_count; i++) {
+		const AttributeStats *a = SchemaStats_GetAttribute(s->stats, i);
+		if(!a || a->count == 0) continue;
+
+		SIValue histogram = SI_NullVal();
+		uint buckets = AttributeStats_Histogram(a, bounds);
+		if(buckets > 0) {
+			histogram = SI_Array(buckets + 1);
+			for(uint j = 0; j <= buckets; j++) SIArray_Append(&histogram, SI_DoubleVal(bounds[j]));
+		}
+
+		_AddRow(pdata, "property", Schema_GetName(s), GraphContext_GetAttributeString(gc, i),
+				a->count, SI_LongVal(AttributeStats_DistinctCount(a)), histogram, NULL);
+	}
+}
+
+// Adds a degree row, histogram is trimmed after its last non empty bucket,
+// rows of empty histograms are omitted unless they account for all nodes.
+static void _AddDegreeHistogramRow(StatsContext *pdata, Schema *s, GRAPH_EDGE_DIR dir,
+								   const uint64_t *buckets, const char *label) {
+	int last = STATS_DEGREE_BUCKETS - 1;
+	while(last >= 0 && buckets[last] == 0) last--;
+	if(last < 0 && label) return;
+
+	uint64_t nodes = 0;
+	SIValue histogram = SI_Array(last + 1);
+	for(int i = 0; i <= last; i++) {
+		nodes += buckets[i];
+		SIArray_Append(&histogram, SI_LongVal(buckets[i]));
+	}
+
+	const char *kind = (dir == GRAPH_EDGE_DIR_OUTGOING) ? "outDegree" : "inDegree";
+	_AddRow(pdata, kind, Schema_GetName(s), NULL, nodes, SI_NullVal(), histogram, label);
+}
+
+// Adds the degree rows of relation s in direction dir, accounting for all nodes followed by one per label.
+static void _AddDegreeRows(StatsContext *pdata, GraphContext *gc, Schema *s, GRAPH_EDGE_DIR dir) {
+	int label_count = Graph_LabelTypeCount(gc->g);
+	uint64_t *histograms = rm_malloc(sizeof(uint64_t) * STATS_DEGREE_BUCKETS * (label_count + 1));
+	SchemaStats_DegreeHistograms(gc->g, s->id, dir, histograms);
+
+	_AddDegreeHistogramRow(pdata, s, dir, histograms + label_count * STATS_DEGREE_BUCKETS, NULL);
+	for(int i = 0; i < label_count; i++) {
+		Schema *label = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		_AddDegreeHistogramRow(pdata, s, dir, histograms + i * STATS_DEGREE_BUCKETS,
+							   Schema_GetName(label));
+	}
+
+	rm_free(histograms);
+}
+
+ProcedureResult Proc_StatsInvoke(ProcedureCtx *ctx, const char **args) {
+	if(array_len(args) != 0) return PROCEDURE_ERR;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
+
+	StatsContext *pdata = rm_malloc(sizeof(StatsContext));
+	pdata->row = 0;
+	pdata->rows = array_new(SIValue *, 0);
+	pdata->output = array_new(SIValue, STATS_COLUMN_COUNT * 2);
+	for(uint i = 0; i < STATS_COLUMN_COUNT; i++) {
+		pdata->output = array_append(pdata->output, SI_ConstStringVal(_columns[i]));
+		pdata->output = array_append(pdata->output, SI_NullVal()); // Place holder.
+	}
+
+	uint schema_count = GraphContext_SchemaCount(gc, SCHEMA_NODE);
+	for(uint i = 0; i < schema_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		_AddRow(pdata, "label", Schema_GetName(s), NULL, Graph_LabeledNodeCount(g, s->id),
+				SI_NullVal(), SI_NullVal(), NULL);
+		_AddAttributeRows(pdata, gc, s);
+	}
+
+	schema_count = GraphContext_SchemaCount(gc, SCHEMA_EDGE);
+	for(uint i = 0; i < schema_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_EDGE);
+		_AddRow(pdata, "relationship", Schema_GetName(s), NULL, Graph_RelationEdgeCount(g, s->id),
+				SI_NullVal(), SI_NullVal(), NULL);
+		_AddDegreeRows(pdata, gc, s, GRAPH_EDGE_DIR_OUTGOING);
+		_AddDegreeRows(pdata, gc, s, GRAPH_EDGE_DIR_INCOMING);
+		_AddAttributeRows(pdata, gc, s);
+	}
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_StatsStep(ProcedureCtx *ctx) {
+	assert(ctx->privateData);
+
+	StatsContext *pdata = (StatsContext *)ctx->privateData;
+
+	// Depleted?
+	if(pdata->row >= array_len(pdata->rows)) return NULL;
+
+	// Rows retain ownership of their values.
+	SIValue *row = pdata->rows[pdata->row++];
+	for(uint i = 0; i < STATS_COLUMN_COUNT; i++) pdata->output[i * 2 + 1] = SI_ConstValue(row[i]);
+	return pdata->output;
+}
+
+ProcedureResult Proc_StatsFree(ProcedureCtx *ctx) {
+	// Clean up.
+	if(ctx->privateData) {
+		StatsContext *pdata = ctx->privateData;
+		uint row_count = array_len(pdata->rows);
+		for(uint i = 0; i < row_count; i++) {
+			for(uint j = 0; j < STATS_COLUMN_COUNT; j++) SIValue_Free(&pdata->rows[i][j]);
+			rm_free(pdata->rows[i]);
+		}
+		array_free(pdata->rows);
+		array_free(pdata->output);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_StatsCtx() {
+	void *privateData = NULL;
+	ProcedureOutput **outputs = array_new(ProcedureOutput *, STATS_COLUMN_COUNT);
+	SIType types[STATS_COLUMN_COUNT] = {T_STRING, T_STRING, T_STRING, T_INT64, T_INT64, T_ARRAY,
+										T_STRING};
+	for(uint i = 0; i < STATS_COLUMN_COUNT; i++) {
+		ProcedureOutput *output = rm_malloc(sizeof(ProcedureOutput));
+		output->name = _columns[i];
+		output->type = types[i];
+		outputs = array_append(outputs, output);
+	}
+
+	ProcedureCtx *ctx = ProcCtxNew("db.stats",
+								   0,
+								   outputs,
+								   Proc_StatsStep,
+								   Proc_StatsInvoke,
+								   Proc_StatsFree,
+								   privateData);
+	return ctx;
+}
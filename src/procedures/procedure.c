@@ -23,6 +23,15 @@ void Proc_Register() {
 	_procRegister("db.labels", Proc_LabelsCtx);
 	_procRegister("db.propertyKeys", Proc_PropKeysCtx);
 	_procRegister("db.relationshipTypes", Proc_RelationsCtx);
+	_procRegister("db.stats", Proc_StatsCtx);
+
+	// Register graph algorithms.
+	_procRegister("algo.shortestPath", Proc_ShortestPathCtx);
+	_procRegister("algo.SSSP", Proc_SSSPCtx);
+	_procRegister("algo.pageRank", Proc_PageRankCtx);
+	_procRegister("algo.WCC", Proc_WCCCtx);
+	_procRegister("algo.triangleCount", Proc_TriangleCountCtx);
+	_procRegister("algo.kCore", Proc_KCoreCtx);
 
 	// Register FullText Search generator.
 	_procRegister("db.idx.fulltext.drop", Proc_FulltextDropIdxGen);
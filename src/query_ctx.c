@@ -7,9 +7,16 @@
 #include "query_ctx.h"
 #include "util/simple_timer.h"
 #include <assert.h>
+#include <string.h>
 
 pthread_key_t _tlsQueryCtxKey;  // Thread local storage query context key.
 
+static void _QueryCtx_FreeParam(void *param) {
+	SIValue *v = param;
+	SIValue_Free(v);
+	rm_free(v);
+}
+
 static inline QueryCtx *_QueryCtx_GetCtx(void) {
 	QueryCtx *ctx = pthread_getspecific(_tlsQueryCtxKey);
 	if(!ctx) {
@@ -68,6 +75,11 @@ void QueryCtx_SetAST(AST *ast) {
 	ctx->ast = ast;
 }
 
+void QueryCtx_SetParams(rax *params) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ctx->params = params;
+}
+
 void QueryCtx_SetGraphCtx(GraphContext *gc) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ctx->gc = gc;
@@ -83,12 +95,38 @@ void QueryCtx_SetRedisModuleCtx(RedisModuleCtx *redisctx) {
 	ctx->redisctx = redisctx;
 }
 
+void QueryCtx_Inherit(const QueryCtx *query) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ctx->ast = query->ast;
+	ctx->params = query->params;
+	ctx->gc = query->gc;
+	ctx->redisctx = query->redisctx;
+}
+
+QueryCtx *QueryCtx_GetQueryCtx(void) {
+	return _QueryCtx_GetCtx();
+}
+
+char *QueryCtx_TakeError(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	char *error = ctx->error;
+	ctx->error = NULL;
+	return error;
+}
+
 AST *QueryCtx_GetAST(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	assert(ctx->ast);
 	return ctx->ast;
 }
 
+SIValue *QueryCtx_GetParam(const char *name) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(!ctx->params) return NULL;
+	SIValue *v = raxFind(ctx->params, (unsigned char *)name, strlen(name));
+	return (v == raxNotFound) ? NULL : v;
+}
+
 GraphContext *QueryCtx_GetGraphCtx(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	assert(ctx->gc);
@@ -128,6 +166,11 @@ void QueryCtx_Free(void) {
 		ctx->breakpoint = NULL;
 	}
 
+	if(ctx->params) {
+		raxFreeWithCallback(ctx->params, _QueryCtx_FreeParam);
+		ctx->params = NULL;
+	}
+
 	rm_free(ctx);
 	// NULL-set the context for reuse the next time this thread receives a query
 	pthread_setspecific(_tlsQueryCtxKey, NULL);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include"ast/ast.h"
+#include "rax.h"
 #include "redismodule.h"
 #include "util/rmalloc.h"
 #include "graph/graphcontext.h"
@@ -17,6 +18,7 @@ extern pthread_key_t _tlsQueryCtxKey;  // Thread local storage query context key
 
 typedef struct {
 	AST *ast;                   // The scoped AST associated with this query.
+	rax *params;                // Query parameters, maps parameter name to an SIValue.
 	char *error;                // The error message produced by this query, if any.
 	double timer[2];            // Query execution time tracking.
 	GraphContext *gc;           // The GraphContext associated with this query's graph.
@@ -48,6 +50,8 @@ void QueryCtx_EmitException(void);
 /* Setters */
 /* Set the provided AST for access through the QueryCtx. */
 void QueryCtx_SetAST(AST *ast);
+/* Set the query parameters, QueryCtx takes ownership over params. */
+void QueryCtx_SetParams(rax *params);
 /* Set the error message for this query. */
 void QueryCtx_SetError(char *error);
 /* Set the provided GraphCtx for access through the QueryCtx. */
@@ -55,9 +59,19 @@ void QueryCtx_SetGraphCtx(GraphContext *gc);
 /* Set the Redis module context. */
 void QueryCtx_SetRedisModuleCtx(RedisModuleCtx *redisctx);
 
+/* Share the query's AST, parameters, GraphCtx and Redis module context with the calling thread,
+ * such that it can execute part of the query. Shared objects remain owned by the query. */
+void QueryCtx_Inherit(const QueryCtx *query);
+
 /* Getters */
+/* Retrieve the calling thread's QueryCtx. */
+QueryCtx *QueryCtx_GetQueryCtx(void);
+/* Detach the error message of this query, caller takes ownership. */
+char *QueryCtx_TakeError(void);
 /* Retrieve the AST. */
 AST *QueryCtx_GetAST(void);
+/* Retrieve parameter's value, returns NULL if parameter is not specified. */
+SIValue *QueryCtx_GetParam(const char *name);
 /* Retrieve the Graph object. */
 Graph *QueryCtx_GetGraph(void);
 /* Retrieve the GraphCtx. */
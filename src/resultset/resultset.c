@@ -77,14 +77,19 @@ static void _ResultSet_ReplyWithPreamble(ResultSet *set, const Record r) {
 
 ResultSet *NewResultSet(RedisModuleCtx *ctx, bool compact) {
 	ResultSet *set = rm_malloc(sizeof(ResultSet));
+	set->column_count = 0;
+	set->columns = NULL;
+	ResultSet_Reset(set, ctx, compact);
+	return set;
+}
+
+void ResultSet_Reset(ResultSet *set, RedisModuleCtx *ctx, bool compact) {
 	set->ctx = ctx;
 	set->gc = QueryCtx_GetGraphCtx();
 	set->compact = compact;
 	set->formatter = (compact) ? &ResultSetFormatterCompact : &ResultSetFormatterVerbose;
 	set->recordCount = 0;
-	set->column_count = 0;
 	set->header_emitted = false;
-	set->columns = NULL;
 
 	set->stats.labels_added = 0;
 	set->stats.nodes_created = 0;
@@ -92,8 +97,6 @@ ResultSet *NewResultSet(RedisModuleCtx *ctx, bool compact) {
 	set->stats.relationships_created = 0;
 	set->stats.nodes_deleted = 0;
 	set->stats.relationships_deleted = 0;
-
-	return set;
 }
 
 void ResultSet_BuildColumns(ResultSet *set, AR_ExpNode **projections) {
@@ -31,6 +31,10 @@ typedef struct {
 
 ResultSet *NewResultSet(RedisModuleCtx *ctx, bool compact);
 
+/* Prepare result set for reuse by a new query with the same projections,
+ * columns are retained, records and statistics are discarded. */
+void ResultSet_Reset(ResultSet *set, RedisModuleCtx *ctx, bool compact);
+
 void ResultSet_BuildColumns(ResultSet *set, AR_ExpNode **projections);
 
 int ResultSet_AddRecord(ResultSet *set, Record r);
@@ -16,6 +16,7 @@ Schema *Schema_New(const char *name, int id) {
 	schema->id = id;
 	schema->index = NULL;
 	schema->fulltextIdx = NULL;
+	schema->stats = SchemaStats_New();
 	schema->name = rm_strdup(name);
 	return schema;
 }
@@ -129,12 +130,69 @@ void Schema_AddNodeToIndices(const Schema *s, const Node *n, bool update) {
 	Index_IndexNode(idx, n);
 }
 
+// Account for every edge of relation s within s's statistics.
+static void _Schema_BuildEdgeStatistics(Schema *s, const Graph *g) {
+	Edge e;
+	bool depleted = false;
+	NodeID src;
+	NodeID dest;
+	EdgeID entry;
+	GrB_Matrix M = Graph_GetRelationMap(g, s->id);
+	GxB_MatrixTupleIter *it;
+	GxB_MatrixTupleIter_new(&it, M);
+
+	while(true) {
+		// Entry is read off the iterator, avoiding a lookup per tuple.
+		GxB_MatrixTupleIter_next_UINT64(it, &src, &dest, &entry, &depleted);
+		if(depleted) break;
+
+		uint32_t edge_count;
+		const EdgeID *edge_ids = Graph_ResolveRelationMapEntry(g, s->id, &entry, &edge_count);
+		for(uint32_t i = 0; i < edge_count; i++) {
+			Graph_GetEdge(g, edge_ids[i], &e);
+			SchemaStats_AddEntity(s->stats, (GraphEntity *)&e);
+		}
+	}
+
+	GxB_MatrixTupleIter_free(it);
+}
+
+void Schema_BuildStatistics(Schema *s, const Graph *g, SchemaType t) {
+	assert(s && g);
+
+	SchemaStats_Free(s->stats);
+	s->stats = SchemaStats_New();
+
+	if(t == SCHEMA_EDGE) {
+		_Schema_BuildEdgeStatistics(s, g);
+		return;
+	}
+
+	// Account for every node labeled by schema.
+	Node n;
+	bool depleted = false;
+	NodeID node_id;
+	GrB_Matrix L = Graph_GetLabelMatrix(g, s->id);
+	GxB_MatrixTupleIter *it;
+	GxB_MatrixTupleIter_new(&it, L);
+
+	while(true) {
+		GxB_MatrixTupleIter_next(it, NULL, &node_id, &depleted);
+		if(depleted) break;
+		Graph_GetNode(g, node_id, &n);
+		SchemaStats_AddEntity(s->stats, (GraphEntity *)&n);
+	}
+
+	GxB_MatrixTupleIter_free(it);
+}
+
 void Schema_Free(Schema *schema) {
 	if(schema->name) rm_free(schema->name);
 
 	// Free indicies.
 	if(schema->index) Index_Free(schema->index);
 	if(schema->fulltextIdx) Index_Free(schema->fulltextIdx);
+	SchemaStats_Free(schema->stats);
 	rm_free(schema);
 }
 
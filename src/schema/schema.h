@@ -10,6 +10,8 @@
 #include "../index/index.h"
 #include "rax.h"
 #include "redisearch_api.h"
+#include "schema_stats.h"
+#include "../graph/graph.h"
 #include "../graph/entities/graph_entity.h"
 
 typedef enum {
@@ -25,6 +27,7 @@ typedef struct {
 	char *name;           // Schema name.
 	Index *index;         // Exact match index.
 	Index *fulltextIdx;   // Full-text index.
+	SchemaStats *stats;   // Statistics of schema's entities.
 } Schema;
 
 /* Creates a new schema. */
@@ -52,6 +55,10 @@ int Schema_RemoveIndex(Schema *s, const char *field, IndexType type);
 /* Introduce node schema indicies */
 void Schema_AddNodeToIndices(const Schema *s, const Node *n, bool update);
 
+/* Rebuild schema's statistics from every entity of schema,
+ * t specifies whether schema describes nodes or edges. */
+void Schema_BuildStatistics(Schema *s, const Graph *g, SchemaType t);
+
 /* Free schema. */
 void Schema_Free(Schema *s);
 
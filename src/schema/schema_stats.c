@@ -0,0 +1,218 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "schema_stats.h"
+#include "../util/arr.h"
+#include "../util/qsort.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+#include <string.h>
+
+#define DOUBLE_ISLT(a, b) (*(a) < *(b))
+
+// Advances xorshift random state, returning the next pseudo random number.
+static inline uint64_t _NextRandom(SchemaStats *stats) {
+	uint64_t x = stats->seed;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	stats->seed = x;
+	return x;
+}
+
+// Introduce value to attribute's sketch and sample.
+static void _ObserveValue(SchemaStats *stats, AttributeStats *a, SIValue v) {
+	if(SIValue_IsNull(v)) return;
+	HLL_Add(a->ndv, SIValue_HashCode(v));
+
+	if(!(SI_TYPE(v) & SI_NUMERIC)) return;
+	a->numeric_count++;
+
+	// Reservoir sampling, the ith value replaces a sampled value with probability SAMPLE_SIZE / i.
+	if(array_len(a->sample) < STATS_SAMPLE_SIZE) {
+		a->sample = array_append(a->sample, SI_GET_NUMERIC(v));
+	} else {
+		uint64_t j = _NextRandom(stats) % a->numeric_count;
+		if(j < STATS_SAMPLE_SIZE) a->sample[j] = SI_GET_NUMERIC(v);
+	}
+}
+
+SchemaStats *SchemaStats_New(void) {
+	SchemaStats *stats = rm_malloc(sizeof(SchemaStats));
+	stats->attributes = array_new(AttributeStats *, 0);
+	stats->seed = 0x9E3779B97F4A7C15ULL;
+	return stats;
+}
+
+AttributeStats *SchemaStats_GetAttribute(const SchemaStats *stats, Attribute_ID id) {
+	assert(stats);
+	if(id < 0 || id >= array_len(stats->attributes)) return NULL;
+	return stats->attributes[id];
+}
+
+AttributeStats *SchemaStats_GetOrAddAttribute(SchemaStats *stats, Attribute_ID id) {
+	assert(stats && id >= 0);
+	while(array_len(stats->attributes) <= id) {
+		stats->attributes = array_append(stats->attributes, NULL);
+	}
+
+	AttributeStats *a = stats->attributes[id];
+	if(a) return a;
+
+	// The sample is allocated at full capacity, such that it is never relocated.
+	a = rm_malloc(sizeof(AttributeStats));
+	a->count = 0;
+	a->ndv = HLL_New();
+	a->numeric_count = 0;
+	a->sample = array_new(double, STATS_SAMPLE_SIZE);
+	stats->attributes[id] = a;
+	return a;
+}
+
+uint SchemaStats_AttributeCount(const SchemaStats *stats) {
+	assert(stats);
+	return array_len(stats->attributes);
+}
+
+void SchemaStats_AddEntity(SchemaStats *stats, const GraphEntity *e) {
+	assert(stats && e);
+	int prop_count = ENTITY_PROP_COUNT(e);
+	EntityProperty *props = ENTITY_PROPS(e);
+	for(int i = 0; i < prop_count; i++) {
+		AttributeStats *a = SchemaStats_GetOrAddAttribute(stats, props[i].id);
+		a->count++;
+		_ObserveValue(stats, a, props[i].value);
+	}
+}
+
+void SchemaStats_RemoveEntity(SchemaStats *stats, const GraphEntity *e) {
+	assert(stats && e);
+	int prop_count = ENTITY_PROP_COUNT(e);
+	EntityProperty *props = ENTITY_PROPS(e);
+	for(int i = 0; i < prop_count; i++) {
+		AttributeStats *a = SchemaStats_GetAttribute(stats, props[i].id);
+		if(a && a->count > 0) a->count--;
+	}
+}
+
+void SchemaStats_SetProperty(SchemaStats *stats, Attribute_ID id, SIValue v, bool added) {
+	assert(stats);
+	AttributeStats *a = SchemaStats_GetOrAddAttribute(stats, id);
+	// Setting an existing attribute to NULL removes it.
+	if(SIValue_IsNull(v) && !added) {
+		if(a->count > 0) a->count--;
+		return;
+	}
+	if(added) a->count++;
+	_ObserveValue(stats, a, v);
+}
+
+uint64_t AttributeStats_DistinctCount(const AttributeStats *a) {
+	assert(a);
+	uint64_t ndv = HLL_Count(a->ndv);
+	// The sketch overestimates once entities are removed, never exceed the number of values.
+	if(ndv > a->count) ndv = a->count;
+	if(ndv == 0 && a->count > 0) ndv = 1;
+	return ndv;
+}
+
+uint AttributeStats_Histogram(const AttributeStats *a, double *bounds) {
+	assert(a && bounds);
+	uint n = array_len(a->sample);
+	if(n == 0) return 0;
+
+	double sorted[n];
+	memcpy(sorted, a->sample, sizeof(double) * n);
+	QSORT(double, sorted, n, DOUBLE_ISLT);
+
+	uint buckets = (n < STATS_HISTOGRAM_BUCKETS) ? n : STATS_HISTOGRAM_BUCKETS;
+	for(uint i = 0; i < buckets; i++) bounds[i] = sorted[((uint64_t)i * n) / buckets];
+	bounds[buckets] = sorted[n - 1];
+	return buckets;
+}
+
+double AttributeStats_FractionBelow(const AttributeStats *a, double v, bool inclusive) {
+	double bounds[STATS_HISTOGRAM_BUCKETS + 1];
+	uint buckets = AttributeStats_Histogram(a, bounds);
+	if(buckets == 0) return 0;
+
+	// Whole buckets beneath v, interpolate within the bucket containing v.
+	double fraction = 0;
+	for(uint i = 0; i < buckets; i++) {
+		double lo = bounds[i];
+		double hi = bounds[i + 1];
+		if(v > hi || (v == hi && inclusive && hi > lo)) {
+			fraction += 1;
+		} else if(v > lo) {
+			fraction += (v - lo) / (hi - lo);
+			break;
+		} else {
+			// Bucket made of a single value.
+			if(v == lo && hi == lo && inclusive) fraction += 1;
+			else break;
+		}
+	}
+
+	return fraction / buckets;
+}
+
+void SchemaStats_DegreeHistograms(const Graph *g, int relation, GRAPH_EDGE_DIR dir,
+								  uint64_t *histograms) {
+	assert(g && histograms);
+	int label_count = Graph_LabelTypeCount(g);
+	memset(histograms, 0, sizeof(uint64_t) * STATS_DEGREE_BUCKETS * (label_count + 1));
+
+	GrB_Matrix R = Graph_GetRelationMatrix(g, relation);
+	GrB_Index n = Graph_RequiredMatrixDim(g);
+	GrB_Vector degrees;
+	GrB_Vector_new(&degrees, GrB_UINT64, n);
+
+	// Out degrees are row sums, in degrees are column sums.
+	if(dir != GRAPH_EDGE_DIR_INCOMING) {
+		GrB_Matrix_reduce_Monoid(degrees, NULL, NULL, GxB_PLUS_UINT64_MONOID, R, NULL);
+	}
+	if(dir != GRAPH_EDGE_DIR_OUTGOING) {
+		GrB_Descriptor desc;
+		GrB_Descriptor_new(&desc);
+		GrB_Descriptor_set(desc, GrB_INP0, GrB_TRAN);
+		GrB_Matrix_reduce_Monoid(degrees, NULL, GrB_PLUS_UINT64, GxB_PLUS_UINT64_MONOID, R, desc);
+		GrB_Descriptor_free(&desc);
+	}
+
+	GrB_Index nvals;
+	GrB_Vector_nvals(&nvals, degrees);
+	GrB_Index *ids = rm_malloc(sizeof(GrB_Index) * nvals);
+	uint64_t *values = rm_malloc(sizeof(uint64_t) * nvals);
+	GrB_Vector_extractTuples_UINT64(ids, values, &nvals, degrees);
+
+	uint64_t *all = histograms + (uint64_t)label_count * STATS_DEGREE_BUCKETS;
+	for(GrB_Index i = 0; i < nvals; i++) {
+		if(values[i] == 0) continue;
+		int bucket = 63 - __builtin_clzll(values[i]);
+		if(bucket >= STATS_DEGREE_BUCKETS) bucket = STATS_DEGREE_BUCKETS - 1;
+		all[bucket]++;
+		int label = Graph_GetNodeLabel(g, ids[i]);
+		if(label != GRAPH_NO_LABEL) histograms[label * STATS_DEGREE_BUCKETS + bucket]++;
+	}
+
+	rm_free(ids);
+	rm_free(values);
+	GrB_Vector_free(&degrees);
+}
+
+void SchemaStats_Free(SchemaStats *stats) {
+	if(!stats) return;
+	uint attribute_count = array_len(stats->attributes);
+	for(uint i = 0; i < attribute_count; i++) {
+		AttributeStats *a = stats->attributes[i];
+		if(!a) continue;
+		HLL_Free(a->ndv);
+		array_free(a->sample);
+		rm_free(a);
+	}
+	array_free(stats->attributes);
+	rm_free(stats);
+}
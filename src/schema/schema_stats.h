@@ -0,0 +1,91 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../value.h"
+#include "../util/hll.h"
+#include "../graph/graph.h"
+#include "../graph/entities/graph_entity.h"
+
+// Number of numeric values sampled per attribute.
+#define STATS_SAMPLE_SIZE 256
+// Maximum number of buckets within an attribute's histogram.
+#define STATS_HISTOGRAM_BUCKETS 16
+// Number of buckets within a degree histogram, bucket i counts degrees within [2^i, 2^(i+1)).
+#define STATS_DEGREE_BUCKETS 32
+
+/* Schema statistics describe the attributes of the entities within a schema,
+ * they are maintained incrementally as entities are created, updated and deleted.
+ *
+ * Per attribute we keep the number of entities holding it, a HyperLogLog sketch
+ * of its distinct values and a uniform (reservoir) sample of its numeric values
+ * from which equi-depth histograms are derived.
+ * Sketches and samples only grow, values of deleted entities remain accounted for.
+ *
+ * Entity and edge counts are not duplicated here, label and relation matrices
+ * maintain them exactly, degree distributions are computed from the matrices
+ * on demand. */
+
+typedef struct {
+	uint64_t count;         // Number of entities holding attribute.
+	HLL *ndv;               // Sketch of attribute's distinct values.
+	uint64_t numeric_count; // Number of numeric values observed.
+	double *sample;         // Uniform sample of observed numeric values, arr.h array.
+} AttributeStats;
+
+typedef struct {
+	AttributeStats **attributes;    // Statistics indexed by attribute ID, NULL if attribute wasn't seen.
+	uint64_t seed;                  // Sampling random state.
+} SchemaStats;
+
+// Create new, empty statistics.
+SchemaStats *SchemaStats_New(void);
+
+// Account for every property of a newly introduced entity.
+void SchemaStats_AddEntity(SchemaStats *stats, const GraphEntity *e);
+
+// Account for a removed entity.
+void SchemaStats_RemoveEntity(SchemaStats *stats, const GraphEntity *e);
+
+// Account for a property set to v, added is true if the entity didn't hold the attribute,
+// setting a held attribute to NULL removes it.
+void SchemaStats_SetProperty(SchemaStats *stats, Attribute_ID id, SIValue v, bool added);
+
+// Retrieves attribute's statistics, NULL if attribute wasn't seen.
+AttributeStats *SchemaStats_GetAttribute(const SchemaStats *stats, Attribute_ID id);
+
+// Retrieves attribute's statistics, creating them if attribute wasn't seen.
+AttributeStats *SchemaStats_GetOrAddAttribute(SchemaStats *stats, Attribute_ID id);
+
+// Number of attribute IDs statistics are kept for, some of which might be NULL.
+uint SchemaStats_AttributeCount(const SchemaStats *stats);
+
+// Estimated number of distinct values of attribute.
+uint64_t AttributeStats_DistinctCount(const AttributeStats *a);
+
+/* Builds an equi-depth histogram of attribute's numeric values,
+ * bucket i spans [bounds[i], bounds[i + 1]] and holds an equal share of the values.
+ * bounds must accommodate STATS_HISTOGRAM_BUCKETS + 1 values.
+ * Returns the number of buckets, 0 if no numeric values were observed. */
+uint AttributeStats_Histogram(const AttributeStats *a, double *bounds);
+
+/* Estimated fraction of attribute's numeric values less than v,
+ * or less than or equal to v if inclusive is set. */
+double AttributeStats_FractionBelow(const AttributeStats *a, double v, bool inclusive);
+
+/* Computes degree histograms of relation in direction dir (incoming or outgoing).
+ * histograms holds STATS_DEGREE_BUCKETS buckets for each of the graph's labels,
+ * followed by STATS_DEGREE_BUCKETS buckets accounting for all nodes.
+ * Nodes without edges aren't counted, (src, dest) pairs connected
+ * by multiple edges contribute a single degree. */
+void SchemaStats_DegreeHistograms(const Graph *g, int relation, GRAPH_EDGE_DIR dir,
+								  uint64_t *histograms);
+
+// Free statistics.
+void SchemaStats_Free(SchemaStats *stats);
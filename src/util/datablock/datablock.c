@@ -9,6 +9,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include "../arr.h"
+#include "../qsort.h"
 #include "datablock.h"
 #include "datablock_iterator.h"
 #include "../rmalloc.h"
@@ -120,6 +121,21 @@ DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock) {
     return DataBlockIterator_New(startBlock, 0, endPos, 1);
 }
 
+DataBlockIterator *DataBlock_ScanRange(const DataBlock *dataBlock, int64_t start, int64_t end) {
+    assert(dataBlock && start >= 0 && end >= start);
+
+    // Clamp range to the scanned portion of the datablock.
+    int64_t scanEnd = dataBlock->itemCount + array_len(dataBlock->deletedIdx);
+    if(end > scanEnd) end = scanEnd;
+    if(start > end) start = end;
+
+    // Begin iteration at the block holding start position.
+    uint64_t blockIdx = ITEM_INDEX_TO_BLOCK_INDEX(start);
+    if(blockIdx >= dataBlock->blockCount) blockIdx = dataBlock->blockCount - 1;
+    Block *startBlock = dataBlock->blocks[blockIdx];
+    return DataBlockIterator_New(startBlock, start, end, 1);
+}
+
 // Make sure datablock can accommodate at least k items.
 void DataBlock_Accommodate(DataBlock *dataBlock, int64_t k) {
     // Compute number of free slots.
@@ -199,6 +215,80 @@ void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
     dataBlock->itemCount--;
 }
 
+uint64_t DataBlock_DeletedItemsCount(const DataBlock *dataBlock) {
+    assert(dataBlock);
+    return array_len(dataBlock->deletedIdx);
+}
+
+// Retrieves item at position idx, regardless of its deletion state.
+static inline unsigned char *_DataBlock_ItemAt(const DataBlock *dataBlock, uint64_t idx) {
+    Block *block = GET_ITEM_BLOCK(dataBlock, idx);
+    return block->data + (ITEM_POSITION_WITHIN_BLOCK(idx) * block->itemSize);
+}
+
+// Release blocks positioned entirely beyond the first itemCount slots.
+static void _DataBlock_ReleaseBlocks(DataBlock *dataBlock, uint64_t itemCount) {
+    // Always retain at least a single block.
+    size_t blockCount = ITEM_COUNT_TO_BLOCK_COUNT(itemCount);
+    if(blockCount == 0) blockCount = 1;
+    if(blockCount >= dataBlock->blockCount) return;
+
+    for(size_t i = blockCount; i < dataBlock->blockCount; i++) _Block_Free(dataBlock->blocks[i]);
+
+    dataBlock->blockCount = blockCount;
+    dataBlock->blocks = rm_realloc(dataBlock->blocks, sizeof(Block*) * blockCount);
+    dataBlock->blocks[blockCount - 1]->next = NULL;
+    dataBlock->itemCap = blockCount * BLOCK_CAP;
+}
+
+uint64_t DataBlock_Compact(DataBlock *dataBlock, uint64_t n, uint64_t *from, uint64_t *to) {
+    assert(dataBlock && from && to);
+
+    uint64_t *deleted = dataBlock->deletedIdx;
+    uint32_t deletedCount = array_len(deleted);
+    if(deletedCount == 0) return 0;
+
+    // Free slots are consumed lowest first, trailing free slots are discarded.
+#define IDX_ISLT(a, b) ((*a) < (*b))
+    QSORT(uint64_t, deleted, deletedCount, IDX_ISLT);
+
+    uint64_t moved = 0;
+    uint32_t lo = 0;                // Lowest free slot yet to be filled.
+    uint32_t hi = deletedCount;     // One past highest free slot yet to be discarded.
+    uint64_t end = dataBlock->itemCount + deletedCount;    // One past last slot in use.
+
+    while(lo < hi) {
+        // Last slot is free, discard it.
+        if(deleted[hi - 1] == end - 1) {
+            hi--;
+            end--;
+            continue;
+        }
+
+        if(moved == n) break;
+
+        // Move last item into lowest free slot.
+        uint64_t src = end - 1;
+        uint64_t dest = deleted[lo++];
+        unsigned char *srcItem = _DataBlock_ItemAt(dataBlock, src);
+        memcpy(_DataBlock_ItemAt(dataBlock, dest), srcItem, dataBlock->itemSize);
+        _DataBlock_MarkItemAsDeleted(dataBlock, srcItem);
+
+        from[moved] = src;
+        to[moved] = dest;
+        moved++;
+        end--;
+    }
+
+    // Retain free slots which were neither filled nor discarded.
+    uint32_t remaining = hi - lo;
+    memmove(deleted, deleted + lo, sizeof(uint64_t) * remaining);
+    dataBlock->deletedIdx = array_trimm_len(deleted, remaining);
+
+    _DataBlock_ReleaseBlocks(dataBlock, end);
+    return moved;
+}
+
 void DataBlock_Free(DataBlock *dataBlock) {
     for(int i = 0; i < dataBlock->blockCount; i++)
         _Block_Free(dataBlock->blocks[i]);
@@ -40,6 +40,9 @@ void DataBlock_Accommodate(DataBlock *dataBlock, int64_t k);
 // Returns an iterator which scans entire datablock.
 DataBlockIterator *DataBlock_Scan(const DataBlock *dataBlock);
 
+// Returns an iterator which scans items at positions [start, end).
+DataBlockIterator *DataBlock_ScanRange(const DataBlock *dataBlock, int64_t start, int64_t end);
+
 // Get item at position idx
 void *DataBlock_GetItem(const DataBlock *dataBlock, size_t idx);
 
@@ -51,6 +54,16 @@ void* DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx);
 // Removes item at position idx.
 void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx);
 
+// Returns number of free slots left behind by deleted items.
+uint64_t DataBlock_DeletedItemsCount(const DataBlock *dataBlock);
+
+// Relocates up to n items from the end of the datablock into free slots,
+// lowest slots first, discarding free slots at the end of the datablock
+// and releasing blocks which are no longer in use.
+// from[i] and to[i] are set to the original and new position of the ith relocated item,
+// returns number of relocated items.
+uint64_t DataBlock_Compact(DataBlock *dataBlock, uint64_t n, uint64_t *from, uint64_t *to);
+
 // Free block.
 void DataBlock_Free(DataBlock *block);
 
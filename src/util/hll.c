@@ -0,0 +1,56 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "hll.h"
+#include "rmalloc.h"
+#include <math.h>
+#include <assert.h>
+
+HLL *HLL_New(void) {
+	return rm_calloc(1, sizeof(HLL));
+}
+
+// Finalizer mixing every input bit into the leading bits, which select a register.
+static inline uint64_t _Mix(uint64_t h) {
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+void HLL_Add(HLL *hll, uint64_t hash) {
+	assert(hll);
+	hash = _Mix(hash);
+	// Leading bits select a register, the rank is the position of the first set bit that follows.
+	uint32_t idx = hash >> (64 - HLL_PRECISION);
+	uint64_t rest = hash << HLL_PRECISION;
+	uint8_t rank = (rest == 0) ? (64 - HLL_PRECISION + 1) : __builtin_clzll(rest) + 1;
+	if(rank > hll->registers[idx]) hll->registers[idx] = rank;
+}
+
+uint64_t HLL_Count(const HLL *hll) {
+	assert(hll);
+	double m = HLL_REGISTERS;
+	double alpha = 0.7213 / (1 + 1.079 / m);
+
+	double sum = 0;
+	uint32_t zeros = 0;
+	for(uint32_t i = 0; i < HLL_REGISTERS; i++) {
+		sum += ldexp(1.0, -hll->registers[i]);
+		if(hll->registers[i] == 0) zeros++;
+	}
+
+	double estimate = alpha * m * m / sum;
+	// Small cardinalities are better estimated by the number of empty registers.
+	if(estimate <= 2.5 * m && zeros > 0) estimate = m * log(m / zeros);
+	return (uint64_t)(estimate + 0.5);
+}
+
+void HLL_Free(HLL *hll) {
+	rm_free(hll);
+}
@@ -0,0 +1,34 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Number of hash bits selecting a register.
+#define HLL_PRECISION 10
+// Number of registers, the standard error of an estimate is 1.04 / sqrt(HLL_REGISTERS).
+#define HLL_REGISTERS (1 << HLL_PRECISION)
+
+/* HyperLogLog sketch estimating the number of distinct hashes added to it,
+ * using a fixed amount of memory regardless of the number of hashes.
+ * Hashes can't be removed from a sketch. */
+typedef struct {
+	uint8_t registers[HLL_REGISTERS];   // Maximal rank observed per register.
+} HLL;
+
+// Create a new, empty sketch.
+HLL *HLL_New(void);
+
+// Introduce a 64 bit hash to the sketch.
+void HLL_Add(HLL *hll, uint64_t hash);
+
+// Estimate the number of distinct hashes added to the sketch.
+uint64_t HLL_Count(const HLL *hll);
+
+
+// Free sketch.
+void HLL_Free(HLL *hll);
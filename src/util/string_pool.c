@@ -0,0 +1,99 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "string_pool.h"
+#include "arr.h"
+#include "rmalloc.h"
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+StringPool *StringPool_New(void) {
+	StringPool *pool = rm_malloc(sizeof(StringPool));
+	pool->lookup = raxNew();
+	pool->strings = array_new(InternedString *, 64);
+	pool->free_ids = array_new(uint32_t, 16);
+	return pool;
+}
+
+char *StringPool_Intern(StringPool *pool, const char *s) {
+	assert(pool && s);
+
+	size_t len = strlen(s);
+	InternedString *is = raxFind(pool->lookup, (unsigned char *)s, len);
+	if(is != raxNotFound) {
+		is->refcount++;
+		return is->str;
+	}
+
+	// First occurrence of string, introduce it to pool.
+	is = rm_malloc(sizeof(InternedString) + len + 1);
+	is->pool = pool;
+	is->refcount = 1;
+	memcpy(is->str, s, len + 1);
+
+	// Prefer reusing released IDs.
+	if(array_len(pool->free_ids) > 0) {
+		is->id = array_pop(pool->free_ids);
+		pool->strings[is->id] = is;
+	} else {
+		is->id = array_len(pool->strings);
+		pool->strings = array_append(pool->strings, is);
+	}
+
+	raxInsert(pool->lookup, (unsigned char *)is->str, len, is, NULL);
+	return is->str;
+}
+
+void StringPool_Release(char *s) {
+	assert(s);
+	InternedString *is = INTERNED_STRING(s);
+	assert(is->refcount > 0);
+
+	if(--is->refcount > 0) return;
+
+	// Last reference released, remove string from pool.
+	StringPool *pool = is->pool;
+	raxRemove(pool->lookup, (unsigned char *)is->str, strlen(is->str), NULL);
+	pool->strings[is->id] = NULL;
+	pool->free_ids = array_append(pool->free_ids, is->id);
+	rm_free(is);
+}
+
+uint32_t StringPool_GetID(const char *s) {
+	assert(s);
+	return INTERNED_STRING(s)->id;
+}
+
+const char *StringPool_GetString(const StringPool *pool, uint32_t id) {
+	assert(pool && id < array_len(pool->strings));
+	InternedString *is = pool->strings[id];
+	return (is) ? is->str : NULL;
+}
+
+uint32_t StringPool_IDCount(const StringPool *pool) {
+	assert(pool);
+	return array_len(pool->strings);
+}
+
+uint64_t StringPool_Count(const StringPool *pool) {
+	assert(pool);
+	return raxSize(pool->lookup);
+}
+
+void StringPool_Free(StringPool *pool) {
+	assert(pool);
+	// Free any string which is still referenced.
+	uint32_t id_count = array_len(pool->strings);
+	for(uint32_t i = 0; i < id_count; i++) {
+		if(pool->strings[i]) rm_free(pool->strings[i]);
+	}
+	raxFree(pool->lookup);
+	array_free(pool->strings);
+	array_free(pool->free_ids);
+	rm_free(pool);
+}
+
@@ -0,0 +1,63 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "rax.h"
+
+/* A string pool hash-conses strings, each distinct string is stored once
+ * and shared by every holder, such that two interned strings of the same pool
+ * are equal if and only if they share the same address.
+ *
+ * Interned strings are reference counted, once the last reference is released
+ * the string is removed from its pool.
+ * Each interned string is assigned a dense ID, IDs of released strings are reused,
+ * allowing the pool to be serialized as an array of strings. */
+
+typedef struct StringPool StringPool;
+
+typedef struct {
+	StringPool *pool;       // Pool owning string.
+	uint32_t id;            // String ID within pool.
+	uint32_t refcount;      // Number of references to string.
+	char str[];             // Null terminated string.
+} InternedString;
+
+struct StringPool {
+	rax *lookup;                // Mapping from string to InternedString.
+	InternedString **strings;   // Interned strings indexed by ID, NULL for free IDs.
+	uint32_t *free_ids;         // Released IDs, available for reuse.
+};
+
+// Retrieves the header of an interned string.
+#define INTERNED_STRING(s) ((InternedString *)((s) - offsetof(InternedString, str)))
+
+// Create a new, empty string pool.
+StringPool *StringPool_New(void);
+
+// Intern string, returns a reference to the pool's copy of the string.
+char *StringPool_Intern(StringPool *pool, const char *s);
+
+// Release a reference to an interned string.
+void StringPool_Release(char *s);
+
+// Retrieves an interned string's ID.
+uint32_t StringPool_GetID(const char *s);
+
+// Retrieves string by ID, returns NULL if ID is not in use.
+const char *StringPool_GetString(const StringPool *pool, uint32_t id);
+
+// Number of IDs allocated by pool, including free IDs.
+uint32_t StringPool_IDCount(const StringPool *pool);
+
+// Number of distinct strings held by pool.
+uint64_t StringPool_Count(const StringPool *pool);
+
+// Free pool along with any string still held by it.
+void StringPool_Free(StringPool *pool);
+
@@ -8,6 +8,7 @@
 #include "graph/entities/graph_entity.h"
 #include "graph/entities/node.h"
 #include "graph/entities/edge.h"
+#include <math.h>
 #include <errno.h>
 #include <limits.h>
 #include <stdio.h>
@@ -15,6 +16,7 @@
 #include <sys/param.h>
 #include <assert.h>
 #include "util/rmalloc.h"
+#include "util/string_pool.h"
 #include "datatypes/array.h"
 
 static inline void _SIString_ToString(SIValue str, char **buf, size_t *bufferLen,
@@ -94,13 +96,19 @@ SIValue SI_TransferStringVal(char *s) {
 	};
 }
 
+SIValue SI_InternedStringVal(char *s) {
+	return (SIValue) {
+		.stringval = s, .type = T_STRING, .allocation = M_INTERN
+	};
+}
+
 /* Make an SIValue that reuses the original's allocations, if any.
  * The returned value is not responsible for freeing any allocations,
  * and is not guaranteed that these allocations will remain in scope. */
 SIValue SI_ShareValue(const SIValue v) {
 	SIValue dup = v;
 	// If the original value owns an allocation, mark that the duplicate shares it.
-	if(v.allocation == M_SELF) dup.allocation = M_VOLATILE;
+	if(v.allocation == M_SELF || v.allocation == M_INTERN) dup.allocation = M_VOLATILE;
 	return dup;
 }
 
@@ -151,7 +159,7 @@ SIValue SI_ConstValue(const SIValue v) {
  * with no responsibility for freeing or guarantee regarding scope.
  * This is used in cases like performing shallow copies of scalars in Record entries. */
 void SIValue_MakeVolatile(SIValue *v) {
-	if(v->allocation == M_SELF) v->allocation = M_VOLATILE;
+	if(v->allocation == M_SELF || v->allocation == M_INTERN) v->allocation = M_VOLATILE;
 }
 
 /* Ensure that any allocation held by the given SIValue is guaranteed to not go out
@@ -435,6 +443,8 @@ int SIValue_Compare(const SIValue a, const SIValue b, int *disjointOrNull) {
 		case T_DOUBLE:
 			return SAFE_COMPARISON_RESULT(a.doubleval - b.doubleval);
 		case T_STRING:
+			// Fast path, identical pointers, e.g. a shared interned string, are equal.
+			if(a.stringval == b.stringval) return 0;
 			return strcmp(a.stringval, b.stringval);
 		case T_NODE:
 		case T_EDGE:
@@ -524,7 +534,7 @@ XXH64_hash_t SIValue_HashCode(SIValue v) {
 		break;
 	case T_STRING:
 		XXH64_update(&state, &t, sizeof(t));
-		XXH64_update(&state, &v.stringval, strlen(v.stringval));
+		XXH64_update(&state, v.stringval, strlen(v.stringval));
 		break;
 	case T_INT64:
 		// Change type to numeric.
@@ -539,11 +549,17 @@ XXH64_hash_t SIValue_HashCode(SIValue v) {
 	case T_DOUBLE: {
 		t = SI_NUMERIC;
 		XXH64_update(&state, &t, sizeof(t));
-		// Check if the double value is actually an interger. If so, hash it as Long.
-		int64_t casted = (int64_t) v.doubleval;
-		double diff = v.doubleval - casted;
-		if(diff != 0) XXH64_update(&state, &v.doubleval, sizeof(v.doubleval));
-		else XXH64_update(&state, &casted, sizeof(casted));
+		/* Check if the double value is actually an interger. If so, hash it as Long.
+		 * Range check precedes the conversion, which is undefined for NaN and out of range values. */
+		double d = v.doubleval;
+		if(d >= -0x1p63 && d < 0x1p63 && d == (double)(int64_t)d) {
+			int64_t casted = (int64_t)d;
+			XXH64_update(&state, &casted, sizeof(casted));
+		} else {
+			// All NaNs share a single hash.
+			if(isnan(d)) d = NAN;
+			XXH64_update(&state, &d, sizeof(d));
+		}
 		break;
 	}
 	case T_EDGE:
@@ -561,6 +577,13 @@ XXH64_hash_t SIValue_HashCode(SIValue v) {
 }
 
 void SIValue_Free(SIValue *v) {
+	// Release reference to interned string.
+	if(v->allocation == M_INTERN) {
+		StringPool_Release(v->stringval);
+		v->stringval = NULL;
+		return;
+	}
+
 	// The free routine only performs work if it owns a heap allocation.
 	if(v->allocation != M_SELF) return;
 
@@ -42,7 +42,8 @@ typedef enum {
 	M_NONE = 0,       // SIValue is not heap-allocated
 	M_SELF = 0x1,     // SIValue is responsible for freeing its reference
 	M_VOLATILE = 0x2, // SIValue does not own its reference and may go out of scope
-	M_CONST = 0x4     // SIValue does not own its allocation, but its access is safe
+	M_CONST = 0x4,    // SIValue does not own its allocation, but its access is safe
+	M_INTERN = 0x8    // SIValue holds a reference to an interned string
 } SIAllocation;
 
 #define SI_TYPE(value) (value).type
@@ -99,6 +100,8 @@ SIValue SI_DuplicateStringVal(const char *s);
 SIValue SI_ConstStringVal(char *s);
 // Don't duplicate input string, but assume ownership.
 SIValue SI_TransferStringVal(char *s);
+// Assume ownership of a reference to an interned string.
+SIValue SI_InternedStringVal(char *s);
 
 /* Functions for copying and guaranteeing memory safety for SIValues. */
 // SI_ShareValue creates an SIValue that shares all of the original's allocations.
@@ -129,6 +129,31 @@ class testReturnDistinctFlow1(RedisGraphTestBase):
         q = self.query("MATCH (p:PARENT)-[:HAS]->(:CHILD) RETURN DISTINCT p.name ORDER BY p.name LIMIT 2")
         self.env.assertEqual(q, [['James'], ['Mike']])
 
+    def test_sorted_distinct(self):
+        # Input sorted on the projected alias is deduplicated by comparing adjacent records.
+        query = "MATCH (p:PARENT)-[:HAS]->(:CHILD) WITH p.name AS name ORDER BY name RETURN DISTINCT name"
+        execution_plan = self.explain(query)
+        self.env.assertIn("Sorted Distinct", execution_plan)
+        q = self.query(query)
+        self.env.assertEqual(q, [['James'], ['Mike'], ['Stevie']])
+
+        # Input isn't sorted on the projected alias.
+        query = "MATCH (p:PARENT)-[:HAS]->(c:CHILD) WITH p.name AS name, c.name AS child ORDER BY child RETURN DISTINCT name"
+        execution_plan = self.explain(query)
+        self.env.assertNotIn("Sorted Distinct", execution_plan)
+        q = self.query(query)
+        self.env.assertEqual(q, [['Stevie'], ['Mike'], ['James']])
+
+    def test_distinct_many_values(self):
+        # Enough distinct values to spill the hash table into sorted runs.
+        q = self.query("UNWIND range(0, 199999) AS x WITH x % 150000 AS v RETURN DISTINCT v")
+        self.env.assertEqual(len(q), 150000)
+        self.env.assertEqual(sorted(row[0] for row in q), list(range(150000)))
+
+        # Numerically equal values are not distinct.
+        q = self.query("UNWIND [1, 1.0, 2, 'a', 'a', null, null] AS x RETURN DISTINCT x")
+        self.env.assertEqual(q, [[1], [2], ['a'], [None]])
+
 class testReturnDistinctFlow2(RedisGraphTestBase):
 
     def __init__(self):
@@ -80,3 +80,15 @@ class testGraphMultiPatternQueryFlow(FlowTestsBase):
             self.env.assertEquals(actual_result.relationships_created, 2)
             self.env.assertEquals(actual_result.properties_set, 4)
             self.env.assertEquals(actual_result.nodes_created, 7)
+
+    # Scalars computed by the last cartesian product stream must outlive the stream's records.
+    def test07_cartesian_product_scalars_buffered_by_create(self):
+        graph = Graph("cartesian_scalars", self.env.getConnection())
+        graph.query("""CREATE (:L {name:'a'}), (:L {name:'b'})""")
+        query = """MATCH (a:L) WITH a.name + '!' AS s MATCH (b:L) CREATE (:X {v:s}) RETURN s ORDER BY s"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.nodes_created, 4)
+        self.env.assertEquals(actual_result.result_set, [['a!'], ['a!'], ['b!'], ['b!']])
+
+        actual_result = graph.query("""MATCH (x:X) RETURN x.v ORDER BY x.v""")
+        self.env.assertEquals(actual_result.result_set, [['a!'], ['a!'], ['b!'], ['b!']])
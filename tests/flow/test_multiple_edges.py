@@ -98,3 +98,27 @@ class testGraphMultipleEdgeFlow(FlowTestsBase):
         actual_result = redis_graph.query(query)
         edge_count = actual_result.result_set[0][0]
         self.env.assertEquals(edge_count, 1)
+
+    # Bind edges of multiple types and parallel edges, traversed in both directions.
+    def test_bound_edges_direction(self):
+        g = Graph("multi_edge_direction", self.env.getConnection())
+        query = """CREATE (a:L {v:1}), (b:L {v:2}), (c:L {v:3}),
+                          (a)-[:R {v:1}]->(b), (a)-[:R {v:2}]->(b), (a)-[:S {v:3}]->(b),
+                          (c)-[:R {v:4}]->(a), (b)-[:S {v:5}]->(c)"""
+        g.query(query)
+
+        query = """MATCH (a:L {v:1})-[e:R|:S]->(b) RETURN b.v, e.v ORDER BY e.v"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[2, 1], [2, 2], [2, 3]])
+
+        query = """MATCH (a:L {v:1})<-[e]-(b) RETURN b.v, e.v ORDER BY e.v"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[3, 4]])
+
+        query = """MATCH (a:L)<-[e:R]-(b:L) RETURN a.v, b.v, e.v ORDER BY e.v"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[2, 1, 1], [2, 1, 2], [1, 3, 4]])
+
+        query = """MATCH (a:L)-[e]->(b:L) RETURN a.v, b.v, e.v ORDER BY e.v"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[1, 2, 1], [1, 2, 2], [1, 2, 3], [3, 1, 4], [2, 3, 5]])
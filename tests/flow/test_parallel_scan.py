@@ -0,0 +1,54 @@
+from redisgraph import Graph
+
+from base import FlowTestsBase
+
+redis_graph = None
+GRAPH_ID = "parallel_scan"
+# Large enough for scans to be split into multiple morsels.
+PAIR_COUNT = 20000
+
+
+class testParallelScan(FlowTestsBase):
+    def __init__(self):
+        super(testParallelScan, self).__init__()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        query = "UNWIND range(0, %d) AS x CREATE (:N {v: x})-[:R]->(:M {v: x})" % (PAIR_COUNT - 1)
+        redis_graph.query(query)
+
+    def test01_label_scan_filter(self):
+        query = "MATCH (n:N) WHERE n.v % 3 = 0 RETURN count(n), sum(n.v)"
+        expected = [x for x in range(PAIR_COUNT) if x % 3 == 0]
+        # Repeated executions reuse a cached plan.
+        for i in range(3):
+            result = redis_graph.query(query).result_set
+            self.env.assertEquals(result, [[len(expected), sum(expected)]])
+
+    def test02_traversal(self):
+        query = "MATCH (n:N)-[:R]->(m:M) WHERE m.v < 10000 RETURN count(m), sum(n.v)"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[10000, sum(range(10000))]])
+
+    def test03_all_node_scan(self):
+        query = "MATCH (n) WHERE n.v >= %d RETURN n.v ORDER BY n.v" % (PAIR_COUNT - 3)
+        result = redis_graph.query(query).result_set
+        expected = [[x] for x in range(PAIR_COUNT - 3, PAIR_COUNT) for _ in range(2)]
+        self.env.assertEquals(result, expected)
+
+    def test04_distinct(self):
+        query = "MATCH (n) WHERE n.v % 1000 = 0 RETURN DISTINCT n.v ORDER BY n.v"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[x] for x in range(0, PAIR_COUNT, 1000)])
+
+    def test05_limit(self):
+        # Query completes while helper threads are still producing records.
+        query = "MATCH (n:N)-[:R]->(m:M) WHERE m.v > 100 RETURN m.v LIMIT 5"
+        for i in range(3):
+            result = redis_graph.query(query).result_set
+            self.env.assertEquals(len(result), 5)
+            for row in result:
+                self.env.assertGreater(row[0], 100)
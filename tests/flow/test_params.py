@@ -0,0 +1,152 @@
+from redisgraph import Graph, Node, Edge
+from redis import ResponseError
+
+from base import FlowTestsBase
+
+redis_graph = None
+GRAPH_ID = "params"
+
+
+class testParams(FlowTestsBase):
+    def __init__(self):
+        super(testParams, self).__init__()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        for i in range(10):
+            redis_graph.add_node(Node(label="person", properties={"name": "p%d" % i, "age": i}))
+        redis_graph.commit()
+
+    def test01_simple_params(self):
+        params = [("1", 1), ("2.5", 2.5), ("'str'", "str"), ("true", True), ("null", None)]
+        for literal, expected in params:
+            query = "CYPHER param=%s RETURN $param" % literal
+            result = redis_graph.query(query).result_set
+            self.env.assertEquals(result, [[expected]])
+
+    def test02_list_param(self):
+        query = "CYPHER list=[1, 2, 3] UNWIND $list AS x RETURN x"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[1], [2], [3]])
+
+    def test03_filter_params(self):
+        # Same query text invoked with different parameter values.
+        for age in range(10):
+            query = "CYPHER age=%d MATCH (p:person) WHERE p.age = $age RETURN p.name" % age
+            result = redis_graph.query(query).result_set
+            self.env.assertEquals(result, [["p%d" % age]])
+
+        query = "CYPHER min=3 max=5 MATCH (p:person) WHERE p.age >= $min AND p.age < $max RETURN p.age ORDER BY p.age"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[3], [4]])
+
+    def test04_index_params(self):
+        redis_graph.query("CREATE INDEX ON :person(age)")
+        query = "MATCH (p:person) WHERE p.age = $age RETURN p.name"
+        plan = redis_graph.execution_plan("CYPHER age=1 " + query)
+        self.env.assertIn("Index Scan", plan)
+
+        for age in range(10):
+            result = redis_graph.query("CYPHER age=%d %s" % (age, query)).result_set
+            self.env.assertEquals(result, [["p%d" % age]])
+
+        # Parameter of a type the index can't match.
+        result = redis_graph.query("CYPHER age=null " + query).result_set
+        self.env.assertEquals(result, [])
+
+    def test05_cached_plan_sees_updates(self):
+        query = "MATCH (p:person) WHERE p.age >= 0 RETURN count(p)"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[10]])
+
+        redis_graph.query("CREATE (:person {name: 'p10', age: 10})")
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[11]])
+
+        # Introducing a new label invalidates cached plans.
+        query = "MATCH (c:country) RETURN c.name"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [])
+        redis_graph.query("CREATE (:country {name: 'c'})")
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [['c']])
+
+    def test06_missing_params(self):
+        try:
+            redis_graph.query("MATCH (p:person) WHERE p.age = $age RETURN p")
+            assert(False)
+        except ResponseError as e:
+            self.env.assertIn("Missing parameter", str(e))
+
+        try:
+            redis_graph.query("CYPHER age=1 MATCH (p:person) WHERE p.age = $min RETURN p")
+            assert(False)
+        except ResponseError as e:
+            self.env.assertIn("Missing parameter", str(e))
+
+    def test07_invalid_params(self):
+        try:
+            redis_graph.query("CYPHER props={age: 1} MATCH (p:person) RETURN p")
+            assert(False)
+        except ResponseError:
+            pass
+
+    def test08_formatting_variations(self):
+        # Formatting variations share a cached plan.
+        queries = ["CYPHER age=1 MATCH (p:person) WHERE p.age = $age RETURN p.name AS name",
+                   "CYPHER age=2 MATCH  (p:person)\n WHERE p.age = $age // comment\n RETURN p.name AS name",
+                   "CYPHER age=3 MATCH (p:person) /* comment */ WHERE p.age = $age RETURN p.name AS name"]
+        for i, query in enumerate(queries):
+            result = redis_graph.query(query).result_set
+            self.env.assertEquals(result, [["p%d" % (i + 1)]])
+
+        # Whitespace within strings is significant.
+        result = redis_graph.query("RETURN 'a  b' AS s").result_set
+        self.env.assertEquals(result, [["a  b"]])
+        result = redis_graph.query("RETURN 'a b' AS s").result_set
+        self.env.assertEquals(result, [["a b"]])
+
+        # Column names are taken from the query text.
+        result = redis_graph.query("MATCH (p:person) WHERE p.age = 1 RETURN toUpper(p.name)")
+        self.env.assertEquals(result.header[0][1], "toUpper(p.name)")
+        result = redis_graph.query("MATCH (p:person) WHERE p.age = 1 RETURN toUpper( p.name )")
+        self.env.assertEquals(result.header[0][1], "toUpper( p.name )")
+        self.env.assertEquals(result.result_set, [["P1"]])
+
+    def test09_cached_transposed_traversal_sees_updates(self):
+        redis_graph.query("MATCH (a:person {age: 1}), (b:person {age: 2}) CREATE (a)-[:knows]->(b)")
+        query = "MATCH (a:person)<-[:knows]-(b:person) RETURN a.name, b.name ORDER BY a.name, b.name"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [["p2", "p1"]])
+
+        redis_graph.query("MATCH (a:person {age: 2}), (b:person {age: 3}) CREATE (a)-[:knows]->(b)")
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [["p2", "p1"], ["p3", "p2"]])
+
+    def test10_cached_plan_params(self):
+        query = "MATCH (p:person) WHERE p.age = $age RETURN p.name"
+        result = redis_graph.query("CYPHER age=4 " + query).result_set
+        self.env.assertEquals(result, [["p4"]])
+
+        # Cached plan is reused, parameters are parsed and validated on every invocation.
+        result = redis_graph.query("CYPHER age=5 /* comment */ " + query).result_set
+        self.env.assertEquals(result, [["p5"]])
+
+        try:
+            redis_graph.query(query)
+            assert(False)
+        except ResponseError as e:
+            self.env.assertIn("Missing parameter", str(e))
+
+        try:
+            redis_graph.query("CYPHER age=p.age " + query)
+            assert(False)
+        except ResponseError:
+            pass
+
+        # Multiple parameter prefixes.
+        result = redis_graph.query("CYPHER min=6 CYPHER age=6 " + query).result_set
+        self.env.assertEquals(result, [["p6"]])
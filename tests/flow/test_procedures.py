@@ -279,3 +279,101 @@ class testProcedures(FlowTestsBase):
         actual_resultset = redis_graph.call_procedure("db.propertyKeys").result_set
         expected_results = [["name"], ["value"]]
         self.env.assertEquals(actual_resultset, expected_results)
+
+    def test_procedure_stats(self):
+        actual_resultset = redis_graph.call_procedure("db.stats").result_set
+        # kind, name, property, count, distinct, histogram, label
+        expected_results = [["label", "fruit", None, 5, None, None, None],
+                            ["property", "fruit", "name", 5, 5, None, None],
+                            ["property", "fruit", "value", 5, 5, [1.0, 2.0, 3.0, 4.0, 5.0, 5.0], None],
+                            ["relationship", "goWellWith", None, 1, None, None, None],
+                            ["outDegree", "goWellWith", None, 1, None, [1], None],
+                            ["outDegree", "goWellWith", None, 1, None, [1], "fruit"],
+                            ["inDegree", "goWellWith", None, 1, None, [1], None],
+                            ["inDegree", "goWellWith", None, 1, None, [1], "fruit"]]
+        self.env.assertEquals(actual_resultset, expected_results)
+
+    def test_procedure_shortest_path(self):
+        g = Graph("routes", redis_con)
+        # Node IDs are assigned in creation order, A = 0 ... E = 4.
+        g.query("""CREATE (a:city {name: 'A'}), (b:city {name: 'B'}), (c:city {name: 'C'}),
+                          (d:city {name: 'D'}), (e:city {name: 'E'}),
+                          (a)-[:road {dist: 1}]->(b), (b)-[:road {dist: 1}]->(c), (a)-[:road {dist: 5}]->(c),
+                          (c)-[:road {dist: 1}]->(d), (a)-[:road {dist: 10}]->(d), (d)-[:road {dist: 2}]->(e),
+                          (a)-[:flight]->(e)""")
+
+        # Fewest hops.
+        query = """CALL algo.shortestPath(0, 4, 'road') YIELD node, distance RETURN node.name, distance"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset, [['A', 0], ['D', 1], ['E', 2]])
+
+        # Any relationship type.
+        query = """CALL algo.shortestPath(0, 4) YIELD node, distance RETURN node.name, distance"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset, [['A', 0], ['E', 1]])
+
+        # Lightest path.
+        query = """CALL algo.shortestPath(0, 4, 'road', 'dist') YIELD node, distance RETURN node.name, distance"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset, [['A', 0.0], ['B', 1.0], ['C', 2.0], ['D', 3.0], ['E', 5.0]])
+
+        # Edges only lead away from A.
+        query = """CALL algo.shortestPath(4, 0, 'road') YIELD node, distance RETURN node.name, distance"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset, [])
+
+        # Every node reachable from C.
+        query = """CALL algo.SSSP(2, 'road') YIELD node, distance RETURN node.name, distance ORDER BY node.name"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset, [['C', 0], ['D', 1], ['E', 2]])
+
+        query = """CALL algo.SSSP(0, 'road', 'dist') YIELD node, distance RETURN node.name, distance ORDER BY node.name"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset, [['A', 0.0], ['B', 1.0], ['C', 2.0], ['D', 3.0], ['E', 5.0]])
+
+        # Invalid source.
+        try:
+            g.query("""CALL algo.SSSP(100) YIELD node RETURN node""")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Invalid node ID", str(e))
+
+    def test_procedure_analytics(self):
+        g = Graph("social", redis_con)
+        # Two triangles sharing B, a separate pair and an isolated node.
+        g.query("""CREATE (a:person {name: 'A'}), (b:person {name: 'B'}), (c:person {name: 'C'}),
+                          (d:person {name: 'D'}), (e:person {name: 'E'}), (f:person {name: 'F'}),
+                          (g:person {name: 'G'}), (h:person {name: 'H'}),
+                          (a)-[:knows]->(b), (b)-[:knows]->(c), (c)-[:knows]->(a),
+                          (b)-[:knows]->(d), (d)-[:knows]->(e), (e)-[:knows]->(b),
+                          (f)-[:knows]->(g), (a)-[:likes]->(h)""")
+
+        query = """CALL algo.WCC('knows') YIELD node, component RETURN node.name, component ORDER BY node.name"""
+        actual_resultset = g.query(query).result_set
+        expected_results = [['A', 0], ['B', 0], ['C', 0], ['D', 0], ['E', 0], ['F', 5], ['G', 5], ['H', 7]]
+        self.env.assertEquals(actual_resultset, expected_results)
+
+        # Any relationship type connects H.
+        query = """CALL algo.WCC() YIELD node, component RETURN node.name, component ORDER BY node.name"""
+        actual_resultset = g.query(query).result_set
+        expected_results = [['A', 0], ['B', 0], ['C', 0], ['D', 0], ['E', 0], ['F', 5], ['G', 5], ['H', 0]]
+        self.env.assertEquals(actual_resultset, expected_results)
+
+        query = """CALL algo.triangleCount('knows') YIELD node, triangles RETURN node.name, triangles ORDER BY node.name"""
+        actual_resultset = g.query(query).result_set
+        expected_results = [['A', 1], ['B', 2], ['C', 1], ['D', 1], ['E', 1], ['F', 0], ['G', 0], ['H', 0]]
+        self.env.assertEquals(actual_resultset, expected_results)
+
+        query = """CALL algo.kCore('knows') YIELD node, core RETURN node.name, core ORDER BY node.name"""
+        actual_resultset = g.query(query).result_set
+        expected_results = [['A', 2], ['B', 2], ['C', 2], ['D', 2], ['E', 2], ['F', 1], ['G', 1], ['H', 0]]
+        self.env.assertEquals(actual_resultset, expected_results)
+
+        # B is referred to by both triangles.
+        query = """CALL algo.pageRank('knows') YIELD node, score RETURN node.name, score ORDER BY score DESC LIMIT 1"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertEquals(actual_resultset[0][0], 'B')
+
+        query = """CALL algo.pageRank() YIELD node, score RETURN sum(score)"""
+        actual_resultset = g.query(query).result_set
+        self.env.assertTrue(abs(actual_resultset[0][0] - 1) < 1e-5)
@@ -227,3 +227,37 @@ class testRelationPattern(FlowTestsBase):
         actual_result = redis_graph.query(query)
         expected_result = [[1]]
         self.env.assertEquals(actual_result.result_set, expected_result)
+
+    # Test traversals consuming enough records for their batches to grow.
+    def test07_batched_traversals(self):
+        redis_con = self.env.getConnection()
+        g = Graph("batched_traversals", redis_con)
+        # 3000 source nodes, each connected to a single hub and a private leaf.
+        g.query("""CREATE (:Hub)""")
+        g.query("""UNWIND range(0, 2999) AS x
+                   MATCH (h:Hub)
+                   CREATE (h)<-[:r]-(:S {v: x})-[:r]->(:T {v: x})""")
+
+        query = """MATCH (s:S)-[:r]->(t:T) WHERE s.v = t.v RETURN count(t)"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[3000]])
+
+        # High fan-out, each source reaches all 3000 sources through the hub.
+        query = """MATCH (s:S)-[:r]->(:Hub)<-[:r]-(o:S) WHERE s.v < 10 RETURN count(o)"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[30000]])
+
+        # Batches limited by LIMIT.
+        query = """MATCH (s:S)-[:r]->(t:T) RETURN t.v LIMIT 5"""
+        actual_result = g.query(query)
+        self.env.assertEquals(len(actual_result.result_set), 5)
+
+    # Test traversals reaching nodes created earlier within the same query.
+    def test08_traverse_created_nodes(self):
+        redis_con = self.env.getConnection()
+        g = Graph("traverse_created_nodes", redis_con)
+        g.query("""CREATE (:A)""")
+
+        query = """MATCH (a:A) CREATE (a)-[:R]->(:B {v: 1}) WITH a MATCH (a)-[:R]->(x) RETURN x.v"""
+        actual_result = g.query(query)
+        self.env.assertEquals(actual_result.result_set, [[1]])
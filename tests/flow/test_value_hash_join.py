@@ -0,0 +1,104 @@
+from redisgraph import Graph, Node
+
+from base import FlowTestsBase
+
+redis_graph = None
+GRAPH_ID = "value_hash_join"
+A_COUNT = 300
+B_COUNT = 200
+C_COUNT = 5
+
+
+class testValueHashJoin(FlowTestsBase):
+    def __init__(self):
+        super(testValueHashJoin, self).__init__()
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(GRAPH_ID, redis_con)
+        self.populate_graph()
+
+    def populate_graph(self):
+        for i in range(A_COUNT):
+            props = {"id": i, "v": i % 50, "w": i % 3, "s": "s%d" % (i % 10)}
+            # Nodes missing a join key never match.
+            if i % 17 == 0:
+                del props["v"]
+            redis_graph.add_node(Node(label="A", properties=props))
+        for i in range(B_COUNT):
+            props = {"id": i, "v": float(i % 40), "w": i % 4, "s": "s%d" % (i % 20)}
+            redis_graph.add_node(Node(label="B", properties=props))
+        for i in range(C_COUNT):
+            redis_graph.add_node(Node(label="C", properties={"id": i}))
+        redis_graph.commit()
+
+    def a_props(self, i):
+        return {"v": None if i % 17 == 0 else i % 50, "w": i % 3, "s": "s%d" % (i % 10)}
+
+    def b_props(self, i):
+        return {"v": float(i % 40), "w": i % 4, "s": "s%d" % (i % 20)}
+
+    def expected_pairs(self, keys):
+        pairs = []
+        for a in range(A_COUNT):
+            for b in range(B_COUNT):
+                ap = self.a_props(a)
+                bp = self.b_props(b)
+                if all(ap[k] is not None and ap[k] == bp[k] for k in keys):
+                    pairs.append((a, b))
+        return pairs
+
+    def test01_single_key(self):
+        query = "MATCH (a:A), (b:B) WHERE a.v = b.v RETURN count(a), sum(a.id), sum(b.id)"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Value Hash Join", plan)
+        self.env.assertNotIn("Cartesian Product", plan)
+
+        pairs = self.expected_pairs(["v"])
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[len(pairs), sum(p[0] for p in pairs), sum(p[1] for p in pairs)]])
+
+    def test02_multiple_keys(self):
+        query = "MATCH (a:A), (b:B) WHERE a.v = b.v AND b.w = a.w AND a.s = b.s RETURN a.id, b.id ORDER BY a.id, b.id"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Value Hash Join", plan)
+        # All equality conditions are evaluated by the join.
+        self.env.assertNotIn("Filter", plan)
+
+        pairs = self.expected_pairs(["v", "w", "s"])
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[a, b] for a, b in pairs])
+
+    def test03_join_with_filter(self):
+        query = "MATCH (a:A), (b:B) WHERE a.s = b.s AND b.id < 20 RETURN count(a)"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Value Hash Join", plan)
+
+        pairs = [p for p in self.expected_pairs(["s"]) if p[1] < 20]
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[len(pairs)]])
+
+    def test04_join_within_product(self):
+        # Branches related by an equality filter are joined, the product covers the rest.
+        query = "MATCH (a:A), (c:C), (b:B) WHERE a.v = b.v RETURN count(a), sum(c.id)"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertIn("Value Hash Join", plan)
+        self.env.assertIn("Cartesian Product", plan)
+        self.env.assertNotIn("Filter", plan)
+
+        pairs = self.expected_pairs(["v"])
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[len(pairs) * C_COUNT, len(pairs) * sum(range(C_COUNT))]])
+
+    def test05_cartesian_product(self):
+        # Rewound branches are replayed from memory.
+        query = "MATCH (a:A), (b:B), (c:C) RETURN count(a), sum(a.id), sum(b.id), sum(c.id)"
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[A_COUNT * B_COUNT * C_COUNT,
+                                        sum(range(A_COUNT)) * B_COUNT * C_COUNT,
+                                        sum(range(B_COUNT)) * A_COUNT * C_COUNT,
+                                        sum(range(C_COUNT)) * A_COUNT * B_COUNT]])
+
+        query = "MATCH (a:A), (b:B) WHERE a.w < b.w RETURN count(a)"
+        expected = sum(1 for a in range(A_COUNT) for b in range(B_COUNT) if a % 3 < b % 4)
+        result = redis_graph.query(query).result_set
+        self.env.assertEquals(result, [[expected]])
@@ -80,3 +80,60 @@ class VariableLengthTraversals(FlowTestsBase):
         query = """MATCH (a)<-[*]-(b:node) RETURN a.name, b.name ORDER BY a.name, b.name"""
         actual_result = redis_graph.query(query)
         self.env.assertEquals(len(actual_result.result_set), max_results)
+
+    # Distinct destinations are discovered by a BFS rather than enumerating paths.
+    def test05_reachability(self):
+        g = Graph("reachability", redis_con)
+        # Diamond followed by a cycle: (a)->(b1), (a)->(b2), (b1)->(c), (b2)->(c), (c)->(d), (d)->(c)
+        g.query("""CREATE (a:R {name: 'a'}), (b1:R {name: 'b1'}), (b2:R {name: 'b2'}), (c:R {name: 'c'}), (d:R {name: 'd'}),
+                   (a)-[:T]->(b1), (a)-[:T]->(b2), (b1)-[:T]->(c), (b2)-[:T]->(c), (c)-[:T]->(d), (d)-[:T]->(c)""")
+
+        queries = ["""MATCH (s:R {name: 'a'})-[:T*]->(e) RETURN %s e.name ORDER BY e.name""",
+                   """MATCH (s:R {name: 'a'})-[:T*0..2]->(e) RETURN %s e.name ORDER BY e.name""",
+                   """MATCH (s:R {name: 'd'})<-[:T*1..3]-(e) RETURN %s e.name ORDER BY e.name""",
+                   """MATCH (s:R)-[:T*]->(e:R {name: 'c'}) RETURN %s s.name ORDER BY s.name"""]
+
+        for q in queries:
+            plan = g.execution_plan(q % "DISTINCT")
+            self.env.assertIn("Reachability", plan)
+
+            # Distinct results must match the distinct values of all paths.
+            paths = g.query(q % "").result_set
+            expected = []
+            for row in paths:
+                if row not in expected:
+                    expected.append(row)
+            actual = g.query(q % "DISTINCT").result_set
+            self.env.assertEquals(actual, expected)
+
+        # Without distinct every path is reported.
+        query = """MATCH (s:R {name: 'a'})-[:T*]->(e:R {name: 'c'}) RETURN e.name"""
+        plan = g.execution_plan(query)
+        self.env.assertNotIn("Reachability", plan)
+        actual = g.query(query).result_set
+        self.env.assertEquals(actual, [['c'], ['c']])
+
+        # Expand into, both end points are resolved.
+        query = """MATCH (s:R {name: 'a'}), (e:R {name: 'd'}) MATCH (s)-[:T*]->(e) RETURN DISTINCT s.name, e.name"""
+        actual = g.query(query).result_set
+        self.env.assertEquals(actual, [['a', 'd']])
+
+    # Both end points are resolved, hop budget determines whether they're connected.
+    def test06_bounded_expand_into(self):
+        # A -> B -> C -> D
+        query = """MATCH (a:node {name: 'A'}), (d:node {name: 'D'}) MATCH (a)-[*..%d]->(d) RETURN a.name, d.name"""
+        actual_result = redis_graph.query(query % 2)
+        self.env.assertEquals(actual_result.result_set, [])
+        actual_result = redis_graph.query(query % 3)
+        self.env.assertEquals(actual_result.result_set, [['A', 'D']])
+
+        query = """MATCH (a:node {name: 'A'}), (d:node {name: 'D'}) MATCH (d)<-[*2..%d]-(a) RETURN a.name, d.name"""
+        actual_result = redis_graph.query(query % 2)
+        self.env.assertEquals(actual_result.result_set, [])
+        actual_result = redis_graph.query(query % 3)
+        self.env.assertEquals(actual_result.result_set, [['A', 'D']])
+
+        # Edges only lead from A towards D.
+        query = """MATCH (a:node {name: 'A'}), (d:node {name: 'D'}) MATCH (d)-[*]->(a) RETURN a.name, d.name"""
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
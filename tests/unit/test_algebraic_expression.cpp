@@ -93,6 +93,7 @@ class AlgebraicExpressionTest: public ::testing::Test {
 		gc->graph_name = strdup("G");
 		gc->attributes = raxNew();
 		gc->string_mapping = (char **)array_new(char *, 64);
+		gc->string_pool = StringPool_New();
 		gc->node_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
 		gc->relation_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
 
@@ -1237,3 +1238,57 @@ TEST_F(AlgebraicExpressionTest, ExpressionExecute) {
 	GrB_Matrix_free(&res);
 }
 
+
+TEST_F(AlgebraicExpressionTest, LabelOperandsExecute) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Graph *g = gc->g;
+	GrB_Index dim = Graph_RequiredMatrixDim(g);
+
+	// Filter matrix, traverse from every node.
+	GrB_Matrix F;
+	GrB_Matrix_new(&F, GrB_BOOL, dim, dim);
+	for(GrB_Index i = 0; i < 4; i++) GrB_Matrix_setElement_BOOL(F, true, i, i);
+
+	// F * Person * friend * Person * visit * City
+	AlgebraicExpression *exp = AlgebraicExpression_Empty();
+	AlgebraicExpression_AppendTerm(exp, F, false, false, false);
+	AlgebraicExpression_AppendTerm(exp, mat_p, false, false, true);
+	AlgebraicExpression_AppendTerm(exp, mat_ef, false, false, false);
+	AlgebraicExpression_AppendTerm(exp, mat_f, false, false, true);
+	AlgebraicExpression_AppendTerm(exp, mat_ev, false, false, false);
+	AlgebraicExpression_AppendTerm(exp, mat_c, false, false, true);
+
+	GrB_Matrix res;
+	GrB_Matrix_new(&res, GrB_BOOL, dim, dim);
+	AlgebraicExpression_Execute(exp, res);
+
+	// Result must match explicit multiplication.
+	GrB_Matrix expected;
+	GrB_Matrix_dup(&expected, F);
+	GrB_Matrix operands[5] = {mat_p, mat_ef, mat_f, mat_ev, mat_c};
+	for(int i = 0; i < 5; i++) {
+		GrB_mxm(expected, GrB_NULL, GrB_NULL, GxB_LOR_LAND_BOOL, expected, operands[i], GrB_NULL);
+	}
+
+	GrB_Index nvals;
+	GrB_Matrix_nvals(&nvals, res);
+	ASSERT_EQ(nvals, 3);
+	ASSERT_TRUE(_compare_matrices(res, expected));
+
+	// City label drops every person reached.
+	AlgebraicExpression_Free(exp);
+	exp = AlgebraicExpression_Empty();
+	AlgebraicExpression_AppendTerm(exp, F, false, false, false);
+	AlgebraicExpression_AppendTerm(exp, mat_ef, false, false, false);
+	AlgebraicExpression_AppendTerm(exp, mat_c, false, false, true);
+	AlgebraicExpression_Execute(exp, res);
+
+	GrB_Matrix_nvals(&nvals, res);
+	ASSERT_EQ(nvals, 0);
+
+	// Clean up
+	AlgebraicExpression_Free(exp);
+	GrB_Matrix_free(&expected);
+	GrB_Matrix_free(&res);
+	GrB_Matrix_free(&F);
+}
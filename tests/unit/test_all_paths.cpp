@@ -82,7 +82,7 @@ TEST_F(AllPathsTest, NoPaths) {
 	int relationships[] = { GRAPH_NO_RELATION };
 	AllPathsCtx *ctx = AllPathsCtx_New(&src, g, relationships, 1, GRAPH_EDGE_DIR_OUTGOING, minLen,
 									   maxLen);
-	Path p = AllPathsCtx_NextPath(ctx);
+	SharedPath *p = AllPathsCtx_NextPath(ctx);
 
 	ASSERT_TRUE(p == NULL);
 
@@ -102,11 +102,11 @@ TEST_F(AllPathsTest, LongestPaths) {
 	int relationships[] = { GRAPH_NO_RELATION };
 	AllPathsCtx *ctx = AllPathsCtx_New(&src, g, relationships, 1, GRAPH_EDGE_DIR_OUTGOING, minLen,
 									   maxLen);
-	Path path;
+	SharedPath *path;
 
 	unsigned int longestPath = 0;
 	while((path = AllPathsCtx_NextPath(ctx))) {
-		size_t pathLen = Path_len(path);
+		size_t pathLen = SharedPath_Len(path);
 		if(longestPath < pathLen) longestPath = pathLen;
 	}
 
@@ -124,7 +124,7 @@ TEST_F(AllPathsTest, UpToThreeLegsPaths) {
 	Node src;
 	Graph_GetNode(g, srcNodeID, &src);
 
-	Node *path = NULL;
+	SharedPath *p = NULL;
 	unsigned int minLen = 0;
 	unsigned int maxLen = 3;
 	uint pathsCount = 0;
@@ -163,7 +163,8 @@ TEST_F(AllPathsTest, UpToThreeLegsPaths) {
 
 	NodeID *expectedPaths[12] = {p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11};
 
-	while((path = AllPathsCtx_NextPath(ctx))) {
+	while((p = AllPathsCtx_NextPath(ctx))) {
+		Path path = SharedPath_Nodes(p);
 		bool expectedPathFound = false;
 		assert(pathsCount < 12);
 
@@ -185,6 +186,7 @@ TEST_F(AllPathsTest, UpToThreeLegsPaths) {
 				break;
 			}
 		}
+		Path_free(path);
 		ASSERT_TRUE(expectedPathFound);
 		pathsCount++;
 	}
@@ -199,7 +201,7 @@ TEST_F(AllPathsTest, TwoLegPaths) {
 
 	NodeID srcNodeID = 0;
 	Node src;
-	Node *path = NULL;
+	SharedPath *p = NULL;
 	Graph_GetNode(g, srcNodeID, &src);
 	unsigned int minLen = 2;
 	unsigned int maxLen = 2;
@@ -221,9 +223,10 @@ TEST_F(AllPathsTest, TwoLegPaths) {
 	NodeID p3[3] = {0, 2, 3};
 	NodeID *expectedPaths[4] = {p0, p1, p2, p3};
 
-	while((path = AllPathsCtx_NextPath(ctx))) {
+	while((p = AllPathsCtx_NextPath(ctx))) {
 		ASSERT_LT(pathsCount, 4);
-		ASSERT_EQ(Path_len(path), 3);
+		ASSERT_EQ(SharedPath_Len(p), 3);
+		Path path = SharedPath_Nodes(p);
 		bool expectedPathFound = false;
 
 		for(int i = 0; i < 4; i++) {
@@ -237,6 +240,7 @@ TEST_F(AllPathsTest, TwoLegPaths) {
 			if(expectedPathFound) break;
 		}
 
+		Path_free(path);
 		ASSERT_TRUE(expectedPathFound);
 		pathsCount++;
 	}
@@ -246,3 +250,48 @@ TEST_F(AllPathsTest, TwoLegPaths) {
 	AllPathsCtx_Free(ctx);
 	Graph_Free(g);
 }
+
+TEST_F(AllPathsTest, RetainedPaths) {
+	Graph *g = BuildGraph();
+
+	NodeID srcNodeID = 0;
+	Node src;
+	Graph_GetNode(g, srcNodeID, &src);
+	int relationships[] = { GRAPH_NO_RELATION };
+	AllPathsCtx *ctx = AllPathsCtx_New(&src, g, relationships, 1, GRAPH_EDGE_DIR_OUTGOING, 2, 2);
+
+	// Hold on to every path, beyond the context's lifetime.
+	SharedPath *p;
+	SharedPath *paths[4];
+	uint pathsCount = 0;
+	while((p = AllPathsCtx_NextPath(ctx))) {
+		ASSERT_LT(pathsCount, 4);
+		paths[pathsCount++] = SharedPath_Retain(p);
+	}
+	ASSERT_EQ(pathsCount, 4);
+	AllPathsCtx_Free(ctx);
+
+	/* Paths are discovered depth first:
+	 * 0, 2, 3
+	 * 0, 2, 1
+	 * 0, 1, 2
+	 * 0, 1, 0 */
+	NodeID expectedPaths[4][3] = {{0, 2, 3}, {0, 2, 1}, {0, 1, 2}, {0, 1, 0}};
+	for(uint i = 0; i < 4; i++) {
+		Path path = SharedPath_Nodes(paths[i]);
+		ASSERT_EQ(Path_len(path), 3);
+		for(uint j = 0; j < 3; j++) ASSERT_EQ(ENTITY_GET_ID(path + j), expectedPaths[i][j]);
+		Path_free(path);
+	}
+
+	// Paths diverging at the same node share their prefix.
+	ASSERT_EQ(paths[0]->prefix, paths[1]->prefix);
+	ASSERT_EQ(paths[2]->prefix, paths[3]->prefix);
+	ASSERT_NE(paths[0]->prefix, paths[2]->prefix);
+	ASSERT_EQ(paths[0]->prefix->prefix, paths[2]->prefix->prefix);
+	ASSERT_TRUE(SharedPath_ContainsNode(paths[0], 3));
+	ASSERT_FALSE(SharedPath_ContainsNode(paths[1], 3));
+
+	for(uint i = 0; i < 4; i++) SharedPath_Release(paths[i]);
+	Graph_Free(g);
+}
@@ -0,0 +1,154 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/value.h"
+#include "../../src/query_ctx.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/arithmetic/funcs.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/arithmetic/ar_program.h"
+#include "../../src/execution_plan/record.h"
+#include "../../src/execution_plan/record_map.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class ARProgramTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+
+		// Prepare thread-local variables
+		ASSERT_TRUE(QueryCtx_Init());
+
+		// Register functions
+		AR_RegisterFuncs();
+		Agg_RegisterFuncs();
+	}
+
+	// Record holding: a = 5, b = 'abc', c = 2.5
+	static Record _BuildRecord(RecordMap *map) {
+		Record r = Record_New(3);
+		Record_AddScalar(r, RecordMap_FindOrAddAlias(map, "a"), SI_LongVal(5));
+		Record_AddScalar(r, RecordMap_FindOrAddAlias(map, "b"), SI_ConstStringVal((char *)"abc"));
+		Record_AddScalar(r, RecordMap_FindOrAddAlias(map, "c"), SI_DoubleVal(2.5));
+		return r;
+	}
+
+	static AR_ExpNode *_Op(const char *func, AR_ExpNode *lhs, AR_ExpNode *rhs) {
+		AR_ExpNode *op = AR_EXP_NewOpNode(func, (rhs) ? 2 : 1);
+		op->op.children[0] = lhs;
+		if(rhs) op->op.children[1] = rhs;
+		return op;
+	}
+
+	static FT_FilterNode *_Cond(AST_Operator op, FT_FilterNode *lhs, FT_FilterNode *rhs) {
+		FT_FilterNode *cond = FilterTree_CreateConditionFilter(op);
+		AppendLeftChild(cond, lhs);
+		AppendRightChild(cond, rhs);
+		return cond;
+	}
+
+	// Compiled filter must agree with filter tree evaluation.
+	static void _TestFilter(FT_FilterNode *tree, Record r, int expected) {
+		AR_Program *program = AR_Program_CompileFilter(tree);
+		ASSERT_EQ(FilterTree_applyFilters(tree, r), expected);
+		ASSERT_EQ(AR_Program_ApplyFilter(program, r), expected);
+		AR_Program_Free(program);
+		FilterTree_Free(tree);
+	}
+};
+
+TEST_F(ARProgramTest, Expressions) {
+	RecordMap *map = RecordMap_New();
+	Record r = _BuildRecord(map);
+
+	// a + (3 * a)
+	AR_ExpNode *exp = _Op("add", AR_EXP_NewVariableOperandNode(map, "a", NULL),
+						  _Op("mul", AR_EXP_NewConstOperandNode(SI_LongVal(3)),
+							  AR_EXP_NewVariableOperandNode(map, "a", NULL)));
+	AR_Program *program = AR_Program_Compile(exp);
+	SIValue v = AR_Program_Evaluate(program, r);
+	ASSERT_EQ(v.type, T_INT64);
+	ASSERT_EQ(v.longval, 20);
+	AR_Program_Free(program);
+	AR_EXP_Free(exp);
+
+	// toUpper(b) allocates its result, which is handed to the caller.
+	exp = _Op("toUpper", AR_EXP_NewVariableOperandNode(map, "b", NULL), NULL);
+	program = AR_Program_Compile(exp);
+	v = AR_Program_Evaluate(program, r);
+	ASSERT_EQ(v.type, T_STRING);
+	ASSERT_STREQ(v.stringval, "ABC");
+	SIValue_Free(&v);
+	AR_Program_Free(program);
+	AR_EXP_Free(exp);
+
+	Record_Free(r);
+	RecordMap_Free(map);
+}
+
+TEST_F(ARProgramTest, Filters) {
+	RecordMap *map = RecordMap_New();
+	Record r = _BuildRecord(map);
+	AST_Operator ops[6] = {OP_EQUAL, OP_NEQUAL, OP_LT, OP_GT, OP_LE, OP_GE};
+	int int_expected[6] = {FILTER_FAIL, FILTER_PASS, FILTER_FAIL, FILTER_PASS, FILTER_FAIL, FILTER_PASS};
+	int str_expected[6] = {FILTER_PASS, FILTER_FAIL, FILTER_FAIL, FILTER_FAIL, FILTER_PASS, FILTER_PASS};
+
+	for(int i = 0; i < 6; i++) {
+		// a op 4
+		_TestFilter(FilterTree_CreatePredicateFilter(ops[i], AR_EXP_NewVariableOperandNode(map, "a", NULL),
+													 AR_EXP_NewConstOperandNode(SI_LongVal(4))), r, int_expected[i]);
+		// a op c, integer compared against a double.
+		_TestFilter(FilterTree_CreatePredicateFilter(ops[i], AR_EXP_NewVariableOperandNode(map, "a", NULL),
+													 AR_EXP_NewVariableOperandNode(map, "c", NULL)), r, int_expected[i]);
+		// b op 'abc'
+		_TestFilter(FilterTree_CreatePredicateFilter(ops[i], AR_EXP_NewVariableOperandNode(map, "b", NULL),
+													 AR_EXP_NewConstOperandNode(SI_ConstStringVal((char *)"abc"))), r, str_expected[i]);
+		// Disjoint values are only unequal.
+		_TestFilter(FilterTree_CreatePredicateFilter(ops[i], AR_EXP_NewVariableOperandNode(map, "a", NULL),
+													 AR_EXP_NewVariableOperandNode(map, "b", NULL)), r,
+					(ops[i] == OP_NEQUAL) ? FILTER_PASS : FILTER_FAIL);
+	}
+
+	// 1 = 2 OR a > c
+	_TestFilter(_Cond(OP_OR,
+					  FilterTree_CreatePredicateFilter(OP_EQUAL, AR_EXP_NewConstOperandNode(SI_LongVal(1)),
+													   AR_EXP_NewConstOperandNode(SI_LongVal(2))),
+					  FilterTree_CreatePredicateFilter(OP_GT, AR_EXP_NewVariableOperandNode(map, "a", NULL),
+													   AR_EXP_NewVariableOperandNode(map, "c", NULL))), r, FILTER_PASS);
+
+	// a < c AND b = 'abc', left operand decides.
+	_TestFilter(_Cond(OP_AND,
+					  FilterTree_CreatePredicateFilter(OP_LT, AR_EXP_NewVariableOperandNode(map, "a", NULL),
+													   AR_EXP_NewVariableOperandNode(map, "c", NULL)),
+					  FilterTree_CreatePredicateFilter(OP_EQUAL, AR_EXP_NewVariableOperandNode(map, "b", NULL),
+													   AR_EXP_NewConstOperandNode(SI_ConstStringVal((char *)"abc")))), r, FILTER_FAIL);
+
+	// a < c OR toUpper(b) = 'ABC'
+	_TestFilter(_Cond(OP_OR,
+					  FilterTree_CreatePredicateFilter(OP_LT, AR_EXP_NewVariableOperandNode(map, "a", NULL),
+													   AR_EXP_NewVariableOperandNode(map, "c", NULL)),
+					  FilterTree_CreatePredicateFilter(OP_EQUAL,
+													   _Op("toUpper", AR_EXP_NewVariableOperandNode(map, "b", NULL), NULL),
+													   AR_EXP_NewConstOperandNode(SI_ConstStringVal((char *)"ABC")))), r, FILTER_PASS);
+
+	// Expression filters.
+	_TestFilter(FilterTree_CreateExpressionFilter(AR_EXP_NewVariableOperandNode(map, "c", NULL)), r, FILTER_PASS);
+	_TestFilter(FilterTree_CreateExpressionFilter(AR_EXP_NewConstOperandNode(SI_LongVal(0))), r, FILTER_FAIL);
+
+	Record_Free(r);
+	RecordMap_Free(map);
+}
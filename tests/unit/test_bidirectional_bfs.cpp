@@ -0,0 +1,133 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/util/rmalloc.h"
+#include "../../src/algorithms/algorithms.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class BidirectionalBFSTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+
+		// Initialize GraphBLAS.
+		GrB_init(GrB_NONBLOCKING);
+		GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+		GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+	}
+
+	static void TearDownTestCase() {
+		GrB_finalize();
+	}
+
+	static Graph *BuildGraph() {
+		Edge e;
+		Node n;
+		size_t nodeCount = 6;
+		Graph *g = Graph_New(nodeCount, nodeCount);
+		int relation = Graph_AddRelationType(g);
+		for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+
+		/* Connections:
+		 * 0 -> 1
+		 * 1 -> 2
+		 * 2 -> 0
+		 * 2 -> 3
+		 * 3 -> 4
+		 * 5 is disconnected */
+		Graph_ConnectNodes(g, 0, 1, relation, &e);
+		Graph_ConnectNodes(g, 1, 2, relation, &e);
+		Graph_ConnectNodes(g, 2, 0, relation, &e);
+		Graph_ConnectNodes(g, 2, 3, relation, &e);
+		Graph_ConnectNodes(g, 3, 4, relation, &e);
+		return g;
+	}
+
+	// Determine reachability by enumerating all paths from src.
+	static bool PathExists(Graph *g, NodeID src_id, NodeID dest_id, GRAPH_EDGE_DIR dir,
+						   unsigned int minHops, unsigned int maxHops) {
+		Node src;
+		Graph_GetNode(g, src_id, &src);
+		int relationships[] = { GRAPH_NO_RELATION };
+		AllPathsCtx *ctx = AllPathsCtx_New(&src, g, relationships, 1, dir, minHops, maxHops);
+
+		SharedPath *p;
+		bool found = false;
+		while((p = AllPathsCtx_NextPath(ctx))) {
+			Node head = SharedPath_Head(p);
+			if(ENTITY_GET_ID(&head) == dest_id) {
+				found = true;
+				break;
+			}
+		}
+
+		AllPathsCtx_Free(ctx);
+		return found;
+	}
+};
+
+TEST_F(BidirectionalBFSTest, MatchesAllPaths) {
+	Graph *g = BuildGraph();
+	BidirectionalBFSCtx *ctx = BidirectionalBFS_New();
+	GrB_Matrix M = Graph_GetAdjacencyMatrix(g);
+	GrB_Matrix MT = Graph_GetTransposedMatrix(g, M);
+	GrB_Index node_count = Graph_NodeCount(g);
+
+	for(int transpose = 0; transpose < 2; transpose++) {
+		GRAPH_EDGE_DIR dir = (transpose) ? GRAPH_EDGE_DIR_INCOMING : GRAPH_EDGE_DIR_OUTGOING;
+		for(unsigned int minHops = 0; minHops <= 1; minHops++) {
+			for(unsigned int maxHops = minHops; maxHops <= 5; maxHops++) {
+				for(NodeID src = 0; src < node_count; src++) {
+					for(NodeID dest = 0; dest < node_count; dest++) {
+						bool expected = PathExists(g, src, dest, dir, minHops, maxHops);
+						// Transposed matrix either given or computed on the fly.
+						ASSERT_EQ(expected, BidirectionalBFS_Reachable(ctx, M, MT, transpose, src, dest,
+																	   minHops, maxHops));
+						ASSERT_EQ(expected, BidirectionalBFS_Reachable(ctx, M, NULL, transpose, src, dest,
+																	   minHops, maxHops));
+					}
+				}
+			}
+		}
+	}
+
+	BidirectionalBFS_Free(ctx);
+	Graph_Free(g);
+}
+
+TEST_F(BidirectionalBFSTest, Cycles) {
+	Graph *g = BuildGraph();
+	BidirectionalBFSCtx *ctx = BidirectionalBFS_New();
+	GrB_Matrix M = Graph_GetAdjacencyMatrix(g);
+
+	// Node reaches itself without traversing any edge.
+	ASSERT_TRUE(BidirectionalBFS_Reachable(ctx, M, NULL, false, 5, 5, 0, 0));
+	ASSERT_TRUE(BidirectionalBFS_Reachable(ctx, M, NULL, false, 5, 5, 0, 3));
+	// Disconnected node isn't on a cycle.
+	ASSERT_FALSE(BidirectionalBFS_Reachable(ctx, M, NULL, false, 5, 5, 1, 3));
+
+	// 0 -> 1 -> 2 -> 0
+	ASSERT_FALSE(BidirectionalBFS_Reachable(ctx, M, NULL, false, 0, 0, 1, 2));
+	ASSERT_TRUE(BidirectionalBFS_Reachable(ctx, M, NULL, false, 0, 0, 1, 3));
+	ASSERT_TRUE(BidirectionalBFS_Reachable(ctx, M, NULL, true, 0, 0, 1, 3));
+
+	// 4 has no outgoing edges.
+	ASSERT_FALSE(BidirectionalBFS_Reachable(ctx, M, NULL, false, 4, 0, 1, UINT_MAX - 2));
+	ASSERT_TRUE(BidirectionalBFS_Reachable(ctx, M, NULL, true, 4, 0, 1, UINT_MAX - 2));
+
+	BidirectionalBFS_Free(ctx);
+	Graph_Free(g);
+}
@@ -186,3 +186,60 @@ TEST_F(DataBlockTest, RemoveItem) {
 	// Cleanup.
 	DataBlock_Free(dataBlock);
 }
+
+TEST_F(DataBlockTest, Compact) {
+	uint64_t itemCount = BLOCK_CAP * 3;
+	DataBlock *dataBlock = DataBlock_New(itemCount, sizeof(uint64_t), NULL);
+
+	for(uint64_t i = 0; i < itemCount; i++) {
+		uint64_t *item = (uint64_t *)DataBlock_AllocateItem(dataBlock, NULL);
+		*item = i;
+	}
+
+	// Delete every odd item within the first block and the entire last block.
+	for(uint64_t i = 1; i < BLOCK_CAP; i += 2) DataBlock_DeleteItem(dataBlock, i);
+	for(uint64_t i = BLOCK_CAP * 2; i < itemCount; i++) DataBlock_DeleteItem(dataBlock, i);
+
+	uint64_t liveCount = BLOCK_CAP + BLOCK_CAP / 2;
+	ASSERT_EQ(dataBlock->itemCount, liveCount);
+	ASSERT_EQ(DataBlock_DeletedItemsCount(dataBlock), itemCount - liveCount);
+
+	uint64_t *from = (uint64_t *)malloc(sizeof(uint64_t) * itemCount);
+	uint64_t *to = (uint64_t *)malloc(sizeof(uint64_t) * itemCount);
+
+	// Bounded slice, trailing free slots are discarded and a single item is relocated.
+	uint64_t moved = DataBlock_Compact(dataBlock, 1, from, to);
+	ASSERT_EQ(moved, 1);
+	ASSERT_EQ(from[0], BLOCK_CAP * 2 - 1);
+	ASSERT_EQ(to[0], 1);
+	ASSERT_EQ(*(uint64_t *)DataBlock_GetItem(dataBlock, 1), BLOCK_CAP * 2 - 1);
+	ASSERT_TRUE(DataBlock_GetItem(dataBlock, BLOCK_CAP * 2 - 1) == NULL);
+	ASSERT_EQ(dataBlock->blockCount, 2);
+
+	// Compact remaining free slots.
+	moved = DataBlock_Compact(dataBlock, itemCount, from, to);
+	ASSERT_EQ(moved, BLOCK_CAP / 2 - 1);
+	ASSERT_EQ(DataBlock_DeletedItemsCount(dataBlock), 0);
+	ASSERT_EQ(dataBlock->itemCount, liveCount);
+
+	// Items relocated to their new position.
+	for(uint64_t i = 0; i < moved; i++) {
+		ASSERT_EQ(*(uint64_t *)DataBlock_GetItem(dataBlock, to[i]), from[i]);
+	}
+
+	// Live items form a dense prefix.
+	uint64_t counter = 0;
+	DataBlockIterator *it = DataBlock_Scan(dataBlock);
+	while(DataBlockIterator_Next(it)) counter++;
+	ASSERT_EQ(counter, liveCount);
+	DataBlockIterator_Free(it);
+
+	// New items are appended to the prefix.
+	uint64_t idx;
+	DataBlock_AllocateItem(dataBlock, &idx);
+	ASSERT_EQ(idx, liveCount);
+
+	free(from);
+	free(to);
+	DataBlock_Free(dataBlock);
+}
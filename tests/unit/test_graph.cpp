@@ -18,6 +18,8 @@ extern "C"
 #include "../../src/util/datablock/datablock_iterator.h"
 #include "../../src/util/rmalloc.h"
 
+extern bool maintain_transposed_matrices;
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +54,34 @@ class GraphTest : public ::testing::Test {
 		GrB_finalize();
 	}
 
+	// Validate each maintained transposed relation matrix is the transpose of its relation matrix.
+	void _test_transposed_relations(Graph *g) {
+		GrB_Index n = Graph_RequiredMatrixDim(g);
+		for(int r = 0; r < Graph_RelationTypeCount(g); r++) {
+			GrB_Matrix T;
+			GrB_Matrix both;
+			GrB_Index t_nvals;
+			GrB_Index r_nvals;
+			GrB_Index both_nvals;
+			GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+			GrB_Matrix TR = Graph_GetTransposedRelationMatrix(g, r);
+			GrB_Matrix_new(&T, GrB_BOOL, n, n);
+			GrB_Matrix_new(&both, GrB_BOOL, n, n);
+			GrB_transpose(T, NULL, NULL, R, NULL);
+			GrB_eWiseMult_Matrix_BinaryOp(both, NULL, NULL, GrB_LAND, T, TR, NULL);
+
+			GrB_Matrix_nvals(&r_nvals, R);
+			GrB_Matrix_nvals(&t_nvals, TR);
+			GrB_Matrix_nvals(&both_nvals, both);
+			ASSERT_EQ(t_nvals, r_nvals);
+			ASSERT_EQ(both_nvals, r_nvals);
+			ASSERT_EQ(Graph_GetTransposedMatrix(g, R), TR);
+
+			GrB_Matrix_free(&T);
+			GrB_Matrix_free(&both);
+		}
+	}
+
 	void _test_node_creation(Graph *g, size_t node_count) {
 		GrB_Index ncols, nrows, nvals;
 
@@ -305,6 +335,19 @@ void benchmark_graph() {
 	printf("%sgraph benchmark - PASS!%s\n", KGRN, KNRM);
 }
 
+// Edges reported by Graph_BulkDelete, indexed by edge ID.
+typedef struct {
+	uint count[16];
+	int relation[16];
+} DeletedEdges;
+
+static void _ReportDeletedEdge(const Edge *e, void *ctx) {
+	DeletedEdges *deleted = (DeletedEdges *)ctx;
+	EdgeID id = ENTITY_GET_ID(e);
+	deleted->count[id]++;
+	deleted->relation[id] = e->relationID;
+}
+
 // Validate the creation of a graph,
 // Make sure graph's defaults are applied.
 TEST_F(GraphTest, NewGraph) {
@@ -859,12 +902,23 @@ TEST_F(GraphTest, BulkDelete) {
 	Edge edges[6] = {e[0], e[0], e[4], e[4], e[10], e[10]};
 	uint node_deleted = 0;
 	uint edge_deleted = 0;
+	DeletedEdges reported = {};
+	// Entities of deleted edges are freed, capture IDs upfront.
+	EdgeID ids[13];
+	for(int i = 0; i < 13; i++) ids[i] = ENTITY_GET_ID(&e[i]);
 
 	Graph_AcquireWriteLock(g);
-	Graph_BulkDelete(g, nodes, 4, edges, 6, &node_deleted, &edge_deleted);
+	Graph_BulkDelete(g, nodes, 4, edges, 6, &node_deleted, &edge_deleted, _ReportDeletedEdge, &reported);
 	Graph_ReleaseLock(g);
 
 	ASSERT_EQ(node_deleted, 2);
+	// Every deleted edge, explicit or implicit, is reported exactly once along with its relation.
+	for(int i = 0; i < 13; i++) {
+		EdgeID id = ids[i];
+		uint expected = (i <= 8 || i == 10) ? 1 : 0;
+		ASSERT_EQ(reported.count[id], expected);
+		if(expected) ASSERT_EQ(reported.relation[id], e[i].relationID);
+	}
 	// Statistics do not count for multi edge deletions.
 	// ASSERT_EQ(edge_deleted, 10);
 
@@ -881,3 +935,268 @@ TEST_F(GraphTest, BulkDelete) {
 	// Clean up.
 	Graph_Free(g);
 }
+
+TEST_F(GraphTest, NeighborCursor) {
+	Node n;
+	Edge e;
+	Graph *g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+	Graph_AcquireWriteLock(g);
+
+	int r0 = Graph_AddRelationType(g);
+	int r1 = Graph_AddRelationType(g);
+	for(int i = 0; i < 4; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+
+	/* Connections:
+	 * (0)-[r0]->(1) twice.
+	 * (0)-[r1]->(2)
+	 * (0)-[r0]->(3)
+	 * (3)-[r1]->(1) */
+	EdgeID ids[2];
+	Graph_ConnectNodes(g, 0, 1, r0, &e);
+	ids[0] = ENTITY_GET_ID(&e);
+	Graph_ConnectNodes(g, 0, 1, r0, &e);
+	ids[1] = ENTITY_GET_ID(&e);
+	Graph_ConnectNodes(g, 0, 2, r1, &e);
+	Graph_ConnectNodes(g, 0, 3, r0, &e);
+	Graph_ConnectNodes(g, 3, 1, r1, &e);
+
+	// Outgoing edges of a specific type come with their relation map entries.
+	NeighborCursor c;
+	Graph_NeighborCursor_Init(g, &c, 0, GRAPH_EDGE_DIR_OUTGOING, r0);
+	ASSERT_EQ(c.count, 2);
+	ASSERT_TRUE(c.entries != NULL);
+	ASSERT_FALSE(c.filter);
+	ASSERT_EQ(c.neighbors[0], 1);
+	ASSERT_EQ(c.neighbors[1], 3);
+	ASSERT_EQ(Graph_NeighborCursor_Edges(g, &c, 0, NULL), 2);
+	ASSERT_EQ(Graph_NeighborCursor_Edges(g, &c, 1, NULL), 1);
+
+	Edge *edges = array_new(Edge, 2);
+	Graph_NeighborCursor_Edges(g, &c, 0, &edges);
+	ASSERT_EQ(array_len(edges), 2);
+	for(int i = 0; i < 2; i++) {
+		ASSERT_EQ(ENTITY_GET_ID(edges + i), ids[i]);
+		ASSERT_EQ(Edge_GetSrcNodeID(edges + i), 0);
+		ASSERT_EQ(Edge_GetDestNodeID(edges + i), 1);
+		ASSERT_EQ(Edge_GetRelationID(edges + i), r0);
+	}
+	array_clear(edges);
+
+	// Any relation type.
+	Graph_NeighborCursor_Init(g, &c, 0, GRAPH_EDGE_DIR_OUTGOING, GRAPH_NO_RELATION);
+	ASSERT_EQ(c.count, 3);
+	ASSERT_TRUE(c.entries == NULL);
+	ASSERT_EQ(Graph_NeighborCursor_Edges(g, &c, 0, NULL), 2);
+	ASSERT_EQ(Graph_NeighborCursor_Edges(g, &c, 1, NULL), 1);
+	ASSERT_EQ(Graph_NeighborCursor_Edges(g, &c, 2, NULL), 1);
+
+	// Incoming edges of r1 are read off the transposed adjacency matrix, 0 is filtered out.
+	Graph_NeighborCursor_Init(g, &c, 1, GRAPH_EDGE_DIR_INCOMING, r1);
+	ASSERT_TRUE(c.filter);
+	ASSERT_EQ(c.count, 2);
+	ASSERT_EQ(c.neighbors[0], 0);
+	ASSERT_EQ(c.neighbors[1], 3);
+	ASSERT_EQ(Graph_NeighborCursor_Edges(g, &c, 0, NULL), 0);
+	Graph_NeighborCursor_Edges(g, &c, 1, &edges);
+	ASSERT_EQ(array_len(edges), 1);
+	ASSERT_EQ(Edge_GetSrcNodeID(edges), 3);
+	ASSERT_EQ(Edge_GetDestNodeID(edges), 1);
+
+	// Unknown relation type has no neighbors.
+	Graph_NeighborCursor_Init(g, &c, 0, GRAPH_EDGE_DIR_OUTGOING, GRAPH_UNKNOWN_RELATION);
+	ASSERT_EQ(c.count, 0);
+
+	array_free(edges);
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+}
+
+TEST_F(GraphTest, CompactNodes) {
+	Node n;
+	Edge e;
+	GrB_Index nvals;
+	Graph *g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+	Graph_AcquireWriteLock(g);
+
+	int l = Graph_AddLabel(g);
+	int r = Graph_AddRelationType(g);
+	for(int i = 0; i < 8; i++) Graph_CreateNode(g, l, &n);
+
+	/* Connections:
+	 * 0 connected to 7.
+	 * 7 connected to 6 with multiple edges.
+	 * 6 connected to 3.
+	 * 3 connected to 4.
+	 * 1 connected to 2. */
+	Graph_ConnectNodes(g, 0, 7, r, &e);
+	Graph_ConnectNodes(g, 7, 6, r, &e);
+	Graph_ConnectNodes(g, 7, 6, r, &e);
+	Graph_ConnectNodes(g, 6, 3, r, &e);
+	Graph_ConnectNodes(g, 3, 4, r, &e);
+	Graph_ConnectNodes(g, 1, 2, r, &e);
+
+	// Delete nodes 1 and 2, implicitly deleting edge (1)->(2).
+	Node deleted[2];
+	uint node_deleted;
+	uint edge_deleted;
+	Graph_GetNode(g, 1, deleted);
+	Graph_GetNode(g, 2, deleted + 1);
+	Graph_BulkDelete(g, deleted, 2, NULL, 0, &node_deleted, &edge_deleted, NULL, NULL);
+	ASSERT_EQ(Graph_RequiredMatrixDim(g), 8);
+
+	// Nodes 7 and 6 are relocated into the free IDs 1 and 2.
+	NodeID from[8];
+	NodeID to[8];
+	uint64_t moved = Graph_CompactNodes(g, 8, from, to);
+	ASSERT_EQ(moved, 2);
+	ASSERT_EQ(from[0], 7);
+	ASSERT_EQ(to[0], 1);
+	ASSERT_EQ(from[1], 6);
+	ASSERT_EQ(to[1], 2);
+
+	ASSERT_EQ(Graph_NodeCount(g), 6);
+	ASSERT_EQ(Graph_RequiredMatrixDim(g), 6);
+	ASSERT_TRUE(Graph_GetNode(g, 1, &n));
+	ASSERT_EQ(ENTITY_GET_ID(&n), 1);
+	ASSERT_EQ(Graph_GetNodeLabel(g, 1), l);
+	ASSERT_FALSE(Graph_GetNode(g, 7, &n));
+
+	GrB_Matrix_nvals(&nvals, Graph_GetLabelMatrix(g, l));
+	ASSERT_EQ(nvals, 6);
+	GrB_Matrix_nvals(&nvals, Graph_GetAdjacencyMatrix(g));
+	ASSERT_EQ(nvals, 4);
+
+	// Connections are renumbered along with their nodes.
+	Edge *edges = array_new(Edge, 2);
+	Graph_GetEdgesConnectingNodes(g, 0, 1, r, &edges);
+	ASSERT_EQ(array_len(edges), 1);
+	array_clear(edges);
+	Graph_GetEdgesConnectingNodes(g, 1, 2, r, &edges);
+	ASSERT_EQ(array_len(edges), 2);
+	array_clear(edges);
+	Graph_GetEdgesConnectingNodes(g, 2, 3, r, &edges);
+	ASSERT_EQ(array_len(edges), 1);
+	array_clear(edges);
+
+	// Incoming edges.
+	Graph_GetNode(g, 2, &n);
+	Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, GRAPH_NO_RELATION, &edges);
+	ASSERT_EQ(array_len(edges), 2);
+	for(uint i = 0; i < array_len(edges); i++) ASSERT_EQ(Edge_GetSrcNodeID(edges + i), 1);
+	array_free(edges);
+
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+}
+
+TEST_F(GraphTest, TransposedRelations) {
+	Node n;
+	Edge e;
+	maintain_transposed_matrices = true;
+	Graph *g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+	Graph_AcquireWriteLock(g);
+	ASSERT_TRUE(Graph_MaintainsTransposedMatrices(g));
+
+	int r0 = Graph_AddRelationType(g);
+	int r1 = Graph_AddRelationType(g);
+	for(int i = 0; i < 6; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+
+	/* Connections:
+	 * (0)-[r0]->(1) twice.
+	 * (0)-[r1]->(1)
+	 * (2)-[r0]->(1)
+	 * (1)-[r1]->(3)
+	 * (3)-[r0]->(4)
+	 * (5)-[r1]->(4) */
+	Graph_ConnectNodes(g, 0, 1, r0, &e);
+	Graph_ConnectNodes(g, 0, 1, r0, &e);
+	Graph_ConnectNodes(g, 0, 1, r1, &e);
+	Graph_ConnectNodes(g, 2, 1, r0, &e);
+	Graph_ConnectNodes(g, 1, 3, r1, &e);
+	Graph_ConnectNodes(g, 3, 4, r0, &e);
+	Graph_ConnectNodes(g, 5, 4, r1, &e);
+	_test_transposed_relations(g);
+
+	// Incoming edges of a single relationship type are read from the transposed relation matrix.
+	Edge *edges = array_new(Edge, 4);
+	Graph_GetNode(g, 1, &n);
+	Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, r0, &edges);
+	ASSERT_EQ(array_len(edges), 3);
+	for(uint i = 0; i < array_len(edges); i++) ASSERT_EQ(Edge_GetRelationID(edges + i), r0);
+	array_clear(edges);
+	Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, r1, &edges);
+	ASSERT_EQ(array_len(edges), 1);
+	ASSERT_EQ(Edge_GetSrcNodeID(edges), 0);
+	array_clear(edges);
+
+	// Removing one of multiple edges keeps the connection.
+	Graph_GetEdgesConnectingNodes(g, 0, 1, r0, &edges);
+	ASSERT_EQ(array_len(edges), 2);
+	Graph_DeleteEdge(g, edges);
+	_test_transposed_relations(g);
+	array_clear(edges);
+	Graph_GetEdgesConnectingNodes(g, 0, 1, r0, &edges);
+	ASSERT_EQ(array_len(edges), 1);
+
+	// Removing the last edge disconnects the pair.
+	Graph_DeleteEdge(g, edges);
+	_test_transposed_relations(g);
+	array_clear(edges);
+
+	// Bulk delete node 3 and edge (5)-[r1]->(4).
+	uint node_deleted;
+	uint edge_deleted;
+	Node deleted;
+	Graph_GetNode(g, 3, &deleted);
+	Graph_GetEdgesConnectingNodes(g, 5, 4, r1, &edges);
+	Graph_BulkDelete(g, &deleted, 1, edges, 1, &node_deleted, &edge_deleted, NULL, NULL);
+	ASSERT_EQ(node_deleted, 1);
+	ASSERT_EQ(edge_deleted, 3);
+	_test_transposed_relations(g);
+	array_free(edges);
+
+	// Transposed matrices are renumbered along with their nodes.
+	NodeID from[6];
+	NodeID to[6];
+	Graph_CompactNodes(g, 6, from, to);
+	_test_transposed_relations(g);
+
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+	maintain_transposed_matrices = false;
+}
+
+TEST_F(GraphTest, CommitPendingEdges) {
+	Node n;
+	Edge e;
+	Graph *g = Graph_New(4, 4);
+	Graph_AcquireWriteLock(g);
+	for(int i = 0; i < 3; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+	int r = Graph_AddRelationType(g);
+
+	// Edges are staged while the graph is write locked.
+	Graph_ConnectNodes(g, 0, 1, r, &e);
+	Graph_ConnectNodes(g, 0, 1, r, &e);
+	Graph_ConnectNodes(g, 1, 2, r, &e);
+	ASSERT_EQ(array_len(g->_pending_edges[r]), 3);
+
+	// Releasing the write lock commits staged edges to the mapping matrix.
+	Graph_ReleaseLock(g);
+	ASSERT_EQ(array_len(g->_pending_edges[r]), 0);
+
+	GrB_Index nvals;
+	bool pending;
+	GrB_Matrix M = g->_relations_map[r];
+	GxB_Matrix_Pending(M, &pending);
+	ASSERT_FALSE(pending);
+	GrB_Matrix_nvals(&nvals, M);
+	ASSERT_EQ(nvals, 2);
+
+	// Readers retrieve the mapping matrix as is.
+	Graph_AcquireReadLock(g);
+	ASSERT_EQ(Graph_GetRelationMap(g, r), M);
+	ASSERT_EQ(Graph_RelationEdgeCount(g, r), 3);
+	Graph_ReleaseLock(g);
+
+	Graph_Free(g);
+}
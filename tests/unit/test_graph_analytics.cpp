@@ -0,0 +1,158 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <math.h>
+#include "../../src/util/rmalloc.h"
+#include "../../src/algorithms/kcore.h"
+#include "../../src/algorithms/pagerank.h"
+#include "../../src/algorithms/triangle_count.h"
+#include "../../src/algorithms/connected_components.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class GraphAnalyticsTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+
+		// Initialize GraphBLAS.
+		GrB_init(GrB_NONBLOCKING);
+		GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+		GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+	}
+
+	static void TearDownTestCase() {
+		GrB_finalize();
+	}
+
+	/* Undirected edges:
+	 * 0 - 1, 1 - 2, 2 - 0 (triangle)
+	 * 2 - 3, 3 - 4, 4 - 2 (triangle)
+	 * 1 - 3
+	 * 5 - 6
+	 * 7 is isolated */
+	static GrB_Matrix BuildUndirected() {
+		GrB_Index I[8] = {0, 1, 2, 2, 3, 4, 1, 5};
+		GrB_Index J[8] = {1, 2, 0, 3, 4, 2, 3, 6};
+		bool X[8] = {true, true, true, true, true, true, true, true};
+
+		GrB_Matrix A;
+		GrB_Matrix_new(&A, GrB_BOOL, 8, 8);
+		GrB_Matrix_build_BOOL(A, I, J, X, 8, GrB_LOR);
+
+		// Symmetrize.
+		GrB_Descriptor desc;
+		GrB_Descriptor_new(&desc);
+		GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
+		GrB_eWiseAdd_Matrix_BinaryOp(A, NULL, NULL, GrB_LOR, A, A, desc);
+		GrB_Descriptor_free(&desc);
+		return A;
+	}
+
+	static void ValidateUINT64(GrB_Vector v, const uint64_t *expected, GrB_Index n) {
+		for(GrB_Index i = 0; i < n; i++) {
+			uint64_t x = 0;
+			GrB_Vector_extractElement_UINT64(&x, v, i);
+			ASSERT_EQ(x, expected[i]) << "node " << i;
+		}
+	}
+};
+
+TEST_F(GraphAnalyticsTest, ConnectedComponents) {
+	GrB_Matrix A = BuildUndirected();
+	GrB_Vector components = ConnectedComponents(A);
+
+	uint64_t expected[8] = {0, 0, 0, 0, 0, 5, 5, 7};
+	ValidateUINT64(components, expected, 8);
+
+	GrB_Vector_free(&components);
+	GrB_Matrix_free(&A);
+}
+
+TEST_F(GraphAnalyticsTest, TriangleCount) {
+	GrB_Matrix A = BuildUndirected();
+	GrB_Vector triangles = TriangleCount(A);
+
+	// 1 - 2 - 3 closes a third triangle.
+	uint64_t expected[8] = {1, 2, 3, 2, 1, 0, 0, 0};
+	ValidateUINT64(triangles, expected, 8);
+
+	GrB_Vector_free(&triangles);
+	GrB_Matrix_free(&A);
+}
+
+TEST_F(GraphAnalyticsTest, KCore) {
+	GrB_Matrix A = BuildUndirected();
+	GrB_Vector cores = KCore(A);
+
+	uint64_t expected[8] = {2, 2, 2, 2, 2, 1, 1, 0};
+	ValidateUINT64(cores, expected, 8);
+
+	// 0 - 3 and 0 - 4 turn 0 through 4 into a 3-core.
+	GrB_Vector_free(&cores);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 3);
+	GrB_Matrix_setElement_BOOL(A, true, 3, 0);
+	GrB_Matrix_setElement_BOOL(A, true, 0, 4);
+	GrB_Matrix_setElement_BOOL(A, true, 4, 0);
+	cores = KCore(A);
+
+	uint64_t expected_3core[8] = {3, 3, 3, 3, 3, 1, 1, 0};
+	ValidateUINT64(cores, expected_3core, 8);
+
+	GrB_Vector_free(&cores);
+	GrB_Matrix_free(&A);
+}
+
+TEST_F(GraphAnalyticsTest, PageRank) {
+	/* Directed edges:
+	 * 0 -> 1, 1 -> 2, 2 -> 0, 3 -> 0
+	 * 3 is never reached, 4 is a dangling node and slot 5 is unused. */
+	GrB_Index I[4] = {0, 1, 2, 3};
+	GrB_Index J[4] = {1, 2, 0, 0};
+	bool X[4] = {true, true, true, true};
+	GrB_Matrix A;
+	GrB_Matrix_new(&A, GrB_BOOL, 6, 6);
+	GrB_Matrix_build_BOOL(A, I, J, X, 4, GrB_LOR);
+
+	GrB_Vector nodes;
+	GrB_Vector_new(&nodes, GrB_BOOL, 6);
+	for(GrB_Index i = 0; i < 5; i++) GrB_Vector_setElement_BOOL(nodes, true, i);
+
+	GrB_Vector ranks = PageRank(A, nodes);
+
+	// Only existing nodes are ranked.
+	GrB_Index nvals;
+	GrB_Vector_nvals(&nvals, ranks);
+	ASSERT_EQ(nvals, 5);
+
+	double r[5];
+	double sum = 0;
+	for(GrB_Index i = 0; i < 5; i++) {
+		ASSERT_EQ(GrB_Vector_extractElement_FP64(&r[i], ranks, i), GrB_SUCCESS);
+		sum += r[i];
+	}
+	ASSERT_NEAR(sum, 1, 1e-6);
+
+	// 3 and 4 have no incoming edges, both rank the same, below the cycle's nodes.
+	ASSERT_NEAR(r[3], r[4], 1e-9);
+	ASSERT_LT(r[3], r[1]);
+	// 0 is referred to by both 2 and 3.
+	ASSERT_GT(r[0], r[1]);
+	ASSERT_GT(r[0], r[2]);
+
+	GrB_Vector_free(&ranks);
+	GrB_Vector_free(&nodes);
+	GrB_Matrix_free(&A);
+}
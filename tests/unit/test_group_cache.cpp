@@ -0,0 +1,183 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/grouping/group_cache.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/value.h"
+#include <math.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+class GroupCacheTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+
+	// Group takes ownership over keys if created, keys are freed otherwise.
+	static Group *_GetOrAdd(CacheGroup *cache, SIValue *keys) {
+		uint64_t hash = CacheGroupHash(cache, keys);
+		Group *g = CacheGroupGet(cache, keys, hash);
+		if(g) {
+			for(uint i = 0; i < cache->key_count; i++) SIValue_Free(&keys[i]);
+			return g;
+		}
+		return CacheGroupAdd(cache, keys, hash, NULL, NULL);
+	}
+};
+
+TEST_F(GroupCacheTest, IntegerKeys) {
+	CacheGroup *cache = CacheGroupNew(1);
+	int group_count = 10000;
+
+	for(int i = 0; i < group_count; i++) {
+		SIValue key = SI_LongVal(i);
+		ASSERT_EQ(CacheGroupGet(cache, &key, CacheGroupHash(cache, &key)), (Group *)NULL);
+		Group *g = CacheGroupAdd(cache, &key, CacheGroupHash(cache, &key), NULL, NULL);
+		ASSERT_EQ(g->key_count, 1);
+		ASSERT_EQ(g->keys[0].longval, i);
+	}
+
+	// Every group is retrievable, integral doubles share their integer's group.
+	for(int i = 0; i < group_count; i++) {
+		SIValue key = SI_LongVal(i);
+		Group *g = CacheGroupGet(cache, &key, CacheGroupHash(cache, &key));
+		ASSERT_TRUE(g != NULL);
+		ASSERT_EQ(g->keys[0].longval, i);
+		key = SI_DoubleVal(i);
+		ASSERT_EQ(CacheGroupGet(cache, &key, CacheGroupHash(cache, &key)), g);
+	}
+
+	// Groups are iterated in creation order.
+	Group *g;
+	int i = 0;
+	CacheGroupIterator *iter = CacheGroupIter(cache);
+	while(CacheGroupIterNext(iter, &g)) ASSERT_EQ(g->keys[0].longval, i++);
+	ASSERT_EQ(i, group_count);
+	CacheGroupIterator_Free(iter);
+
+	FreeGroupCache(cache);
+}
+
+TEST_F(GroupCacheTest, MixedKeys) {
+	CacheGroup *cache = CacheGroupNew(2);
+
+	SIValue a[2] = {SI_ConstStringVal((char *)"a"), SI_LongVal(1)};
+	SIValue b[2] = {SI_ConstStringVal((char *)"a"), SI_ConstStringVal((char *)"1")};
+	SIValue c[2] = {SI_NullVal(), SI_BoolVal(true)};
+	SIValue d[2] = {SI_NullVal(), SI_BoolVal(true)};
+	SIValue e[2] = {SI_ConstStringVal((char *)"a"), SI_DoubleVal(1.5)};
+
+	Group *ga = _GetOrAdd(cache, a);
+	Group *gb = _GetOrAdd(cache, b);
+	Group *gc = _GetOrAdd(cache, c);
+	Group *gd = _GetOrAdd(cache, d);
+	Group *ge = _GetOrAdd(cache, e);
+
+	// Values of different types form different groups, nulls are grouped together.
+	ASSERT_NE(ga, gb);
+	ASSERT_NE(ga, gc);
+	ASSERT_NE(ga, ge);
+	ASSERT_EQ(gc, gd);
+	ASSERT_EQ(array_len(cache->groups), 4);
+
+	FreeGroupCache(cache);
+}
+
+TEST_F(GroupCacheTest, DoubleKeys) {
+	CacheGroup *cache = CacheGroupNew(1);
+	// Non integral, out of int64 range and NaN values.
+	double values[6] = {1.5, -1.5, 1e30, -1e30, 0x1p63, NAN};
+
+	Group *groups[6];
+	for(int i = 0; i < 6; i++) {
+		SIValue key = SI_DoubleVal(values[i]);
+		groups[i] = _GetOrAdd(cache, &key);
+	}
+
+	for(int i = 0; i < 6; i++) {
+		SIValue key = SI_DoubleVal(values[i]);
+		ASSERT_EQ(CacheGroupGet(cache, &key, CacheGroupHash(cache, &key)), groups[i]);
+	}
+	ASSERT_EQ(array_len(cache->groups), 6);
+
+	// Smallest int64 is representable as a double.
+	SIValue key = SI_DoubleVal(-0x1p63);
+	Group *g = _GetOrAdd(cache, &key);
+	key = SI_LongVal(INT64_MIN);
+	ASSERT_EQ(_GetOrAdd(cache, &key), g);
+
+	FreeGroupCache(cache);
+}
+
+TEST_F(GroupCacheTest, MultiDoubleKeys) {
+	CacheGroup *cache = CacheGroupNew(2);
+	// Infinite, out of int64 range and NaN values, NaNs of either sign.
+	double values[5] = {INFINITY, -INFINITY, 1e30, NAN, -NAN};
+
+	Group *groups[5];
+	for(int i = 0; i < 5; i++) {
+		SIValue keys[2] = {SI_LongVal(1), SI_DoubleVal(values[i])};
+		groups[i] = _GetOrAdd(cache, keys);
+	}
+
+	// NaNs are grouped together, apart from any other value.
+	ASSERT_EQ(groups[3], groups[4]);
+	for(int i = 0; i < 3; i++) ASSERT_NE(groups[i], groups[3]);
+	ASSERT_EQ(array_len(cache->groups), 4);
+
+	// Integral doubles share their integer's group.
+	SIValue a[2] = {SI_LongVal(1), SI_DoubleVal(2)};
+	SIValue b[2] = {SI_LongVal(1), SI_LongVal(2)};
+	ASSERT_EQ(_GetOrAdd(cache, a), _GetOrAdd(cache, b));
+
+	FreeGroupCache(cache);
+}
+
+TEST_F(GroupCacheTest, ClearCache) {
+	CacheGroup *cache = CacheGroupNew(1);
+
+	for(int i = 0; i < 100; i++) {
+		SIValue key = SI_DuplicateStringVal("key");
+		_GetOrAdd(cache, &key);
+		key = SI_LongVal(i);
+		_GetOrAdd(cache, &key);
+	}
+	ASSERT_EQ(array_len(cache->groups), 101);
+
+	// Cleared cache is empty, its arena is reused.
+	uint block_count = array_len(cache->blocks);
+	CacheGroupClear(cache);
+	ASSERT_EQ(array_len(cache->groups), 0);
+
+	SIValue key = SI_LongVal(7);
+	ASSERT_EQ(CacheGroupGet(cache, &key, CacheGroupHash(cache, &key)), (Group *)NULL);
+	for(int i = 0; i < 100; i++) {
+		key = SI_LongVal(i);
+		_GetOrAdd(cache, &key);
+	}
+	ASSERT_EQ(array_len(cache->groups), 100);
+	ASSERT_EQ(array_len(cache->blocks), block_count);
+
+	FreeGroupCache(cache);
+}
+
+TEST_F(GroupCacheTest, SingleGroup) {
+	CacheGroup *cache = CacheGroupNew(0);
+	Group *g = _GetOrAdd(cache, NULL);
+	ASSERT_EQ(_GetOrAdd(cache, NULL), g);
+	ASSERT_EQ(array_len(cache->groups), 1);
+	FreeGroupCache(cache);
+}
@@ -45,6 +45,7 @@ class IndexTest: public ::testing::Test {
 		gc->graph_name = strdup("G");
 		gc->attributes = raxNew();
 		gc->string_mapping = (char **)array_new(char *, 64);
+		gc->string_pool = StringPool_New();
 		gc->node_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_LABEL_CAP);
 		gc->relation_schemas = (Schema **)array_new(Schema *, GRAPH_DEFAULT_RELATION_TYPE_CAP);
 
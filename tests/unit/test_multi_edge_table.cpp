@@ -0,0 +1,108 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/graph/multi_edge_table.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class MultiEdgeTableTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+TEST_F(MultiEdgeTableTest, NewSlot) {
+	MultiEdgeTable *t = MultiEdgeTable_New();
+	EdgeID ids[3] = {5, 2, 9};
+
+	MultiEdgeSlotID a = MultiEdgeTable_NewSlot(t, ids, 2);
+	MultiEdgeSlotID b = MultiEdgeTable_NewSlot(t, ids, 3);
+	ASSERT_NE(a, b);
+	ASSERT_EQ(MultiEdgeTable_SlotCount(t), 2);
+	ASSERT_EQ(MultiEdgeTable_EdgeCount(t), 5);
+
+	uint32_t count;
+	const EdgeID *edges = MultiEdgeTable_GetEdges(t, b, &count);
+	ASSERT_EQ(count, 3);
+	for(uint32_t i = 0; i < count; i++) ASSERT_EQ(edges[i], ids[i]);
+
+	MultiEdgeTable_Free(t);
+}
+
+TEST_F(MultiEdgeTableTest, AppendAndRemove) {
+	MultiEdgeTable *t = MultiEdgeTable_New();
+	EdgeID ids[2] = {0, 1};
+	MultiEdgeSlotID a = MultiEdgeTable_NewSlot(t, ids, 2);
+	MultiEdgeSlotID b = MultiEdgeTable_NewSlot(t, ids, 2);
+
+	// Grow slot 'a' passed its capacity, forcing relocations.
+	for(EdgeID id = 2; id < 1000; id++) MultiEdgeTable_Append(t, a, &id, 1);
+
+	uint32_t count;
+	const EdgeID *edges = MultiEdgeTable_GetEdges(t, a, &count);
+	ASSERT_EQ(count, 1000);
+	for(uint32_t i = 0; i < count; i++) ASSERT_EQ(edges[i], i);
+
+	// Slot 'b' is unaffected.
+	edges = MultiEdgeTable_GetEdges(t, b, &count);
+	ASSERT_EQ(count, 2);
+	ASSERT_EQ(edges[0], 0);
+	ASSERT_EQ(edges[1], 1);
+
+	// Remove every even edge from 'a'.
+	for(EdgeID id = 0; id < 1000; id += 2) MultiEdgeTable_Remove(t, a, id);
+	edges = MultiEdgeTable_GetEdges(t, a, &count);
+	ASSERT_EQ(count, 500);
+	for(uint32_t i = 0; i < count; i++) ASSERT_EQ(edges[i] % 2, 1);
+	ASSERT_EQ(MultiEdgeTable_EdgeCount(t), 502);
+
+	// Removing the last edges releases the slot.
+	ASSERT_EQ(MultiEdgeTable_Remove(t, b, 0), 1);
+	ASSERT_EQ(MultiEdgeTable_Remove(t, b, 1), 0);
+	ASSERT_EQ(MultiEdgeTable_SlotCount(t), 1);
+
+	// Released slot IDs are reused.
+	ASSERT_EQ(MultiEdgeTable_NewSlot(t, ids, 2), b);
+
+	MultiEdgeTable_Free(t);
+}
+
+TEST_F(MultiEdgeTableTest, BulkFree) {
+	MultiEdgeTable *t = MultiEdgeTable_New();
+	EdgeID ids[4] = {10, 20, 30, 40};
+	MultiEdgeSlotID *slots = array_new(MultiEdgeSlotID, 256);
+
+	for(int i = 0; i < 256; i++) {
+		slots = array_append(slots, MultiEdgeTable_NewSlot(t, ids, 4));
+	}
+	ASSERT_EQ(MultiEdgeTable_EdgeCount(t), 1024);
+
+	// Free all but the last slot, pool is compacted.
+	MultiEdgeTable_FreeSlots(t, slots, 255);
+	ASSERT_EQ(MultiEdgeTable_SlotCount(t), 1);
+	ASSERT_EQ(MultiEdgeTable_EdgeCount(t), 4);
+	ASSERT_LT(t->pool_len, 1024);
+
+	uint32_t count;
+	const EdgeID *edges = MultiEdgeTable_GetEdges(t, slots[255], &count);
+	ASSERT_EQ(count, 4);
+	for(uint32_t i = 0; i < count; i++) ASSERT_EQ(edges[i], ids[i]);
+
+	array_free(slots);
+	MultiEdgeTable_Free(t);
+}
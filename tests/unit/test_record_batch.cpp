@@ -0,0 +1,108 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/execution_plan/record_batch.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/value.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class RecordBatchTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+TEST_F(RecordBatchTest, PopulateBatch) {
+	RecordBatch *batch = RecordBatch_New(2);
+	ASSERT_EQ(batch->count, 0);
+	ASSERT_EQ(batch->selected, 0);
+
+	for(int i = 0; i < RECORD_BATCH_CAPACITY; i++) {
+		ASSERT_FALSE(RecordBatch_IsFull(batch));
+		Record r = RecordBatch_NewRecord(batch);
+		ASSERT_EQ(Record_length(r), 2);
+		Record_AddScalar(r, 0, SI_LongVal(i));
+	}
+
+	ASSERT_TRUE(RecordBatch_IsFull(batch));
+	ASSERT_EQ(batch->count, RECORD_BATCH_CAPACITY);
+	ASSERT_EQ(batch->selected, RECORD_BATCH_CAPACITY);
+
+	for(int i = 0; i < RECORD_BATCH_CAPACITY; i++) {
+		Record r = RecordBatch_Get(batch, i);
+		ASSERT_EQ(Record_GetScalar(r, 0).longval, i);
+	}
+
+	RecordBatch_Free(batch);
+}
+
+TEST_F(RecordBatchTest, SelectionVector) {
+	RecordBatch *batch = RecordBatch_New(1);
+	for(int i = 0; i < 10; i++) {
+		Record r = RecordBatch_NewRecord(batch);
+		Record_AddScalar(r, 0, SI_LongVal(i));
+	}
+
+	// Keep only even records.
+	uint selected = 0;
+	for(uint i = 0; i < batch->selected; i++) {
+		uint16_t idx = batch->selection[i];
+		if(Record_GetScalar(batch->records[idx], 0).longval % 2 == 0) {
+			batch->selection[selected++] = idx;
+		}
+	}
+	batch->selected = selected;
+
+	ASSERT_EQ(batch->count, 10);
+	ASSERT_EQ(batch->selected, 5);
+	for(uint i = 0; i < batch->selected; i++) {
+		ASSERT_EQ(Record_GetScalar(RecordBatch_Get(batch, i), 0).longval, i * 2);
+	}
+
+	RecordBatch_Free(batch);
+}
+
+TEST_F(RecordBatchTest, ReuseRecords) {
+	RecordBatch *batch = RecordBatch_New(1);
+
+	Record first = RecordBatch_NewRecord(batch);
+	Record_AddScalar(first, 0, SI_DuplicateStringVal("batch"));
+	RecordBatch_Clear(batch);
+	ASSERT_EQ(batch->count, 0);
+	ASSERT_EQ(batch->selected, 0);
+
+	// Cleared records are handed out again, empty.
+	Record second = RecordBatch_NewRecord(batch);
+	ASSERT_EQ(first, second);
+	ASSERT_EQ(Record_GetType(second, 0), REC_TYPE_UNKNOWN);
+
+	// Appended records replace the slot's record.
+	Record appended = Record_New(1);
+	Record_AddScalar(appended, 0, SI_LongVal(7));
+	RecordBatch_Append(batch, appended);
+	ASSERT_EQ(batch->selected, 2);
+	ASSERT_EQ(RecordBatch_Get(batch, 1), appended);
+
+	// Extended once a longer record is required.
+	batch->record_len = 3;
+	RecordBatch_Reset(batch);
+	RecordBatch_NewRecord(batch);
+	Record extended = RecordBatch_NewRecord(batch);
+	ASSERT_EQ(Record_length(extended), 3);
+
+	RecordBatch_Free(batch);
+}
+
@@ -0,0 +1,105 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/value.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/schema/schema_stats.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class SchemaStatsTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+TEST_F(SchemaStatsTest, DistinctCount) {
+	SchemaStats *stats = SchemaStats_New();
+
+	// Attribute 0 holds 10000 distinct values, attribute 2 holds 10 values.
+	for(int64_t i = 0; i < 10000; i++) {
+		SchemaStats_SetProperty(stats, 0, SI_LongVal(i), true);
+		SchemaStats_SetProperty(stats, 2, SI_LongVal(i % 10), true);
+	}
+
+	ASSERT_EQ(SchemaStats_AttributeCount(stats), 3);
+	ASSERT_TRUE(SchemaStats_GetAttribute(stats, 1) == NULL);
+	ASSERT_TRUE(SchemaStats_GetAttribute(stats, 3) == NULL);
+
+	const AttributeStats *a = SchemaStats_GetAttribute(stats, 0);
+	ASSERT_EQ(a->count, 10000);
+	uint64_t ndv = AttributeStats_DistinctCount(a);
+	ASSERT_GT(ndv, 9000);
+	ASSERT_LT(ndv, 11000);
+
+	a = SchemaStats_GetAttribute(stats, 2);
+	ASSERT_EQ(a->count, 10000);
+	ASSERT_EQ(AttributeStats_DistinctCount(a), 10);
+
+	// Updates don't introduce new entities.
+	SchemaStats_SetProperty(stats, 2, SI_LongVal(5), false);
+	ASSERT_EQ(a->count, 10000);
+
+	// Setting an attribute to NULL removes it.
+	SchemaStats_SetProperty(stats, 2, SI_NullVal(), false);
+	ASSERT_EQ(a->count, 9999);
+
+	SchemaStats_Free(stats);
+}
+
+TEST_F(SchemaStatsTest, Histogram) {
+	SchemaStats *stats = SchemaStats_New();
+
+	// Values uniformly distributed over [0, 1000).
+	for(int64_t i = 0; i < 1000; i++) {
+		SchemaStats_SetProperty(stats, 0, SI_DoubleVal(i), true);
+	}
+	// Non numeric values are only accounted for by the sketch.
+	SchemaStats_SetProperty(stats, 0, SI_ConstStringVal((char *)"str"), true);
+
+	const AttributeStats *a = SchemaStats_GetAttribute(stats, 0);
+	ASSERT_EQ(a->count, 1001);
+	ASSERT_EQ(a->numeric_count, 1000);
+	ASSERT_EQ(array_len(a->sample), STATS_SAMPLE_SIZE);
+
+	double bounds[STATS_HISTOGRAM_BUCKETS + 1];
+	uint buckets = AttributeStats_Histogram(a, bounds);
+	ASSERT_EQ(buckets, STATS_HISTOGRAM_BUCKETS);
+	for(uint i = 0; i < buckets; i++) ASSERT_LE(bounds[i], bounds[i + 1]);
+	ASSERT_GE(bounds[0], 0);
+	ASSERT_LT(bounds[buckets], 1000);
+
+	ASSERT_EQ(AttributeStats_FractionBelow(a, -1, true), 0);
+	ASSERT_EQ(AttributeStats_FractionBelow(a, 1000, true), 1);
+	double half = AttributeStats_FractionBelow(a, 500, false);
+	ASSERT_GT(half, 0.4);
+	ASSERT_LT(half, 0.6);
+
+	SchemaStats_Free(stats);
+}
+
+TEST_F(SchemaStatsTest, SingleValue) {
+	SchemaStats *stats = SchemaStats_New();
+	for(int i = 0; i < 100; i++) SchemaStats_SetProperty(stats, 0, SI_LongVal(7), true);
+
+	const AttributeStats *a = SchemaStats_GetAttribute(stats, 0);
+	ASSERT_EQ(AttributeStats_DistinctCount(a), 1);
+	ASSERT_EQ(AttributeStats_FractionBelow(a, 7, false), 0);
+	ASSERT_EQ(AttributeStats_FractionBelow(a, 7, true), 1);
+
+	SchemaStats_Free(stats);
+}
@@ -0,0 +1,185 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/algorithms/algorithms.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class ShortestPathTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+
+		// Initialize GraphBLAS.
+		GrB_init(GrB_NONBLOCKING);
+		GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+		GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+	}
+
+	static void TearDownTestCase() {
+		GrB_finalize();
+	}
+
+	/* Weighted edges:
+	 * 0 -> 1 (1)
+	 * 1 -> 2 (1)
+	 * 0 -> 2 (5)
+	 * 2 -> 3 (1)
+	 * 0 -> 3 (10)
+	 * 3 -> 4 (2)
+	 * 5 is disconnected */
+	static GrB_Matrix BuildWeights() {
+		GrB_Index I[6] = {0, 1, 0, 2, 0, 3};
+		GrB_Index J[6] = {1, 2, 2, 3, 3, 4};
+		double X[6] = {1, 1, 5, 1, 10, 2};
+
+		GrB_Matrix W;
+		GrB_Matrix_new(&W, GrB_FP64, 6, 6);
+		GrB_Matrix_build_FP64(W, I, J, X, 6, GrB_MIN_FP64);
+		return W;
+	}
+
+	static GrB_Matrix BuildAdjacency() {
+		GrB_Matrix W = BuildWeights();
+		GrB_Matrix M;
+		GrB_Matrix_new(&M, GrB_BOOL, 6, 6);
+		GrB_Matrix_apply(M, NULL, NULL, GxB_ONE_BOOL, W, NULL);
+		GrB_Matrix_free(&W);
+		return M;
+	}
+
+	static void ValidatePath(NodeID *path, const NodeID *expected, uint expected_len) {
+		ASSERT_TRUE(path != NULL);
+		ASSERT_EQ(array_len(path), expected_len);
+		for(uint i = 0; i < expected_len; i++) ASSERT_EQ(path[i], expected[i]);
+	}
+};
+
+TEST_F(ShortestPathTest, FewestHops) {
+	GrB_Matrix M = BuildAdjacency();
+	GrB_Vector distances;
+	GrB_Vector parents;
+
+	ShortestPath_BFS(M, 0, SHORTEST_PATH_NO_DEST, &distances, &parents);
+
+	// Every node but 5 is reachable.
+	GrB_Index nvals;
+	GrB_Vector_nvals(&nvals, parents);
+	ASSERT_EQ(nvals, 5);
+
+	uint64_t expected_distances[5] = {0, 1, 1, 1, 2};
+	for(GrB_Index i = 0; i < 5; i++) {
+		uint64_t d;
+		ASSERT_EQ(GrB_Vector_extractElement_UINT64(&d, distances, i), GrB_SUCCESS);
+		ASSERT_EQ(d, expected_distances[i]);
+	}
+
+	NodeID expected_path[3] = {0, 3, 4};
+	NodeID *path = ShortestPath_Trace(parents, 0, 4);
+	ValidatePath(path, expected_path, 3);
+	array_free(path);
+
+	ASSERT_TRUE(ShortestPath_Trace(parents, 0, 5) == NULL);
+
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+
+	// Edges only lead away from 0.
+	ShortestPath_BFS(M, 4, 0, NULL, &parents);
+	path = ShortestPath_Trace(parents, 4, 0);
+	ASSERT_TRUE(path == NULL);
+	GrB_Vector_free(&parents);
+
+	GrB_Matrix_free(&M);
+}
+
+TEST_F(ShortestPathTest, LightestPath) {
+	GrB_Matrix W = BuildWeights();
+	GrB_Vector distances;
+	GrB_Vector parents;
+
+	ASSERT_TRUE(ShortestPath_BellmanFord(W, 0, &distances, &parents));
+
+	double expected_distances[5] = {0, 1, 2, 3, 5};
+	for(GrB_Index i = 0; i < 5; i++) {
+		double d;
+		ASSERT_EQ(GrB_Vector_extractElement_FP64(&d, distances, i), GrB_SUCCESS);
+		ASSERT_EQ(d, expected_distances[i]);
+	}
+
+	NodeID expected_path[5] = {0, 1, 2, 3, 4};
+	NodeID *path = ShortestPath_Trace(parents, 0, 4);
+	ValidatePath(path, expected_path, 5);
+	array_free(path);
+
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+	GrB_Matrix_free(&W);
+}
+
+TEST_F(ShortestPathTest, NegativeWeights) {
+	GrB_Matrix W = BuildWeights();
+	GrB_Vector distances;
+	GrB_Vector parents;
+
+	// 1 -> 3 (-1), lightest path to 4 becomes 0, 1, 3, 4.
+	GrB_Matrix_setElement_FP64(W, -1, 1, 3);
+	ASSERT_TRUE(ShortestPath_BellmanFord(W, 0, &distances, &parents));
+
+	double d;
+	GrB_Vector_extractElement_FP64(&d, distances, 4);
+	ASSERT_EQ(d, 2);
+
+	NodeID expected_path[4] = {0, 1, 3, 4};
+	NodeID *path = ShortestPath_Trace(parents, 0, 4);
+	ValidatePath(path, expected_path, 4);
+	array_free(path);
+
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+
+	// 3 -> 1 (-1) closes a negative cycle 1 -> 3 -> 1.
+	GrB_Matrix_setElement_FP64(W, -1, 3, 1);
+	ASSERT_FALSE(ShortestPath_BellmanFord(W, 0, &distances, &parents));
+
+	// Cycle isn't reachable from 4.
+	ASSERT_TRUE(ShortestPath_BellmanFord(W, 4, &distances, &parents));
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+
+	GrB_Matrix_free(&W);
+}
+
+TEST_F(ShortestPathTest, ZeroWeightCycle) {
+	GrB_Matrix W = BuildWeights();
+	GrB_Vector distances;
+	GrB_Vector parents;
+
+	// 1 -> 2 -> 1 weighs nothing, tracing must not loop.
+	GrB_Matrix_setElement_FP64(W, 0, 1, 2);
+	GrB_Matrix_setElement_FP64(W, 0, 2, 1);
+	ASSERT_TRUE(ShortestPath_BellmanFord(W, 0, &distances, &parents));
+
+	NodeID expected_path[5] = {0, 1, 2, 3, 4};
+	NodeID *path = ShortestPath_Trace(parents, 0, 4);
+	ValidatePath(path, expected_path, 5);
+	array_free(path);
+
+	GrB_Vector_free(&distances);
+	GrB_Vector_free(&parents);
+	GrB_Matrix_free(&W);
+}
@@ -0,0 +1,103 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/value.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/util/string_pool.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class StringPoolTest: public ::testing::Test {
+  protected:
+	static void SetUpTestCase() {
+		// Use the malloc family for allocations
+		Alloc_Reset();
+	}
+};
+
+TEST_F(StringPoolTest, Intern) {
+	StringPool *pool = StringPool_New();
+
+	char buf[16];
+	strcpy(buf, "Alice");
+	char *a = StringPool_Intern(pool, buf);
+	char *b = StringPool_Intern(pool, "Alice");
+	char *c = StringPool_Intern(pool, "Bob");
+
+	// Equal strings share the same address.
+	ASSERT_EQ(a, b);
+	ASSERT_NE(a, c);
+	ASSERT_NE(a, buf);
+	ASSERT_STREQ(a, "Alice");
+	ASSERT_EQ(StringPool_Count(pool), 2);
+
+	ASSERT_EQ(StringPool_GetID(a), 0);
+	ASSERT_EQ(StringPool_GetID(c), 1);
+	ASSERT_STREQ(StringPool_GetString(pool, 1), "Bob");
+
+	StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, Release) {
+	StringPool *pool = StringPool_New();
+
+	char *a = StringPool_Intern(pool, "Alice");
+	StringPool_Intern(pool, "Alice");
+	char *b = StringPool_Intern(pool, "Bob");
+
+	// String is retained as long as it is referenced.
+	StringPool_Release(a);
+	ASSERT_EQ(StringPool_Count(pool), 2);
+	StringPool_Release(a);
+	ASSERT_EQ(StringPool_Count(pool), 1);
+	ASSERT_TRUE(StringPool_GetString(pool, 0) == NULL);
+
+	// Released IDs are reused.
+	char *c = StringPool_Intern(pool, "Carol");
+	ASSERT_EQ(StringPool_GetID(c), 0);
+	ASSERT_EQ(StringPool_IDCount(pool), 2);
+
+	StringPool_Release(b);
+	StringPool_Release(c);
+	ASSERT_EQ(StringPool_Count(pool), 0);
+
+	StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, InternedValues) {
+	StringPool *pool = StringPool_New();
+
+	SIValue a = SI_InternedStringVal(StringPool_Intern(pool, "Alice"));
+	SIValue b = SI_InternedStringVal(StringPool_Intern(pool, "Alice"));
+	SIValue c = SI_ConstStringVal((char *)"Alice");
+	ASSERT_EQ(SIValue_Compare(a, b, NULL), 0);
+	ASSERT_EQ(SIValue_Compare(a, c, NULL), 0);
+
+	// Shared values do not own the string.
+	SIValue shared = SI_ShareValue(a);
+	ASSERT_EQ(shared.allocation, M_VOLATILE);
+
+	// Clones are independent of the pool.
+	SIValue clone = SI_CloneValue(a);
+	ASSERT_EQ(clone.allocation, M_SELF);
+	ASSERT_NE(clone.stringval, a.stringval);
+	SIValue_Free(&clone);
+
+	SIValue_Free(&a);
+	ASSERT_EQ(StringPool_Count(pool), 1);
+	SIValue_Free(&b);
+	ASSERT_EQ(StringPool_Count(pool), 0);
+
+	StringPool_Free(pool);
+}
@@ -115,7 +115,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
 	set[1] = ExpBC;
 	set[2] = ExpAB;
 
-	orderExpressions(set, 3, map, NULL);
+	orderExpressions(set, 3, map, NULL, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -124,7 +124,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
 	set[0] = ExpAB;
 	set[1] = ExpBC;
 	set[2] = ExpCD;
-	orderExpressions(set, 3, map, NULL);
+	orderExpressions(set, 3, map, NULL, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -133,7 +133,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
 	set[0] = ExpAB;
 	set[1] = ExpCD;
 	set[2] = ExpBC;
-	orderExpressions(set, 3, map, NULL);
+	orderExpressions(set, 3, map, NULL, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -142,7 +142,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
 	set[0] = ExpBC;
 	set[1] = ExpAB;
 	set[2] = ExpCD;
-	orderExpressions(set, 3, map, NULL);
+	orderExpressions(set, 3, map, NULL, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -151,7 +151,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
 	set[0] = ExpBC;
 	set[1] = ExpCD;
 	set[2] = ExpAB;
-	orderExpressions(set, 3, map, NULL);
+	orderExpressions(set, 3, map, NULL, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -160,7 +160,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
 	set[0] = ExpCD;
 	set[1] = ExpAB;
 	set[2] = ExpBC;
-	orderExpressions(set, 3, map, NULL);
+	orderExpressions(set, 3, map, NULL, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -235,7 +235,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 	filters = build_filter_tree_from_query(map,
 										   "MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE A.val = 1 RETURN *");
 
-	orderExpressions(set, 3, map, filters);
+	orderExpressions(set, 3, map, filters, NULL);
 	ASSERT_EQ(set[0], ExpAB);
 	ASSERT_EQ(set[1], ExpBC);
 	ASSERT_EQ(set[2], ExpCD);
@@ -250,7 +250,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 	filters = build_filter_tree_from_query(map,
 										   "MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE B.val = 1 RETURN *");
 
-	orderExpressions(set, 3, map, filters);
+	orderExpressions(set, 3, map, filters, NULL);
 	ASSERT_TRUE(set[0] == ExpAB || set[0] == ExpBC);
 
 	FilterTree_Free(filters);
@@ -263,7 +263,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 	filters = build_filter_tree_from_query(map,
 										   "MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE C.val = 1 RETURN *");
 
-	orderExpressions(set, 3, map, filters);
+	orderExpressions(set, 3, map, filters, NULL);
 	ASSERT_TRUE(set[0] == ExpBC || set[0] == ExpCD);
 
 	FilterTree_Free(filters);
@@ -276,7 +276,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 	filters = build_filter_tree_from_query(map,
 										   "MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE D.val = 1 RETURN *");
 
-	orderExpressions(set, 3, map, filters);
+	orderExpressions(set, 3, map, filters, NULL);
 
 	ASSERT_EQ(set[0], ExpCD);
 	ASSERT_EQ(set[1], ExpBC);
@@ -291,3 +291,38 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 	QueryGraph_Free(qg);
 }
 
+TEST_F(TraversalOrderingTest, LongPattern) {
+	RecordMap *map = RecordMap_New();
+	/* Both the dynamic programming and the greedy orderings
+	 * should arrange a long chain (N0)->(N1)->...->(Nk)
+	 * such that no expression is transposed. */
+	uint lengths[2] = {TRAVERSE_ORDER_DP_MAX_EXPS, TRAVERSE_ORDER_DP_MAX_EXPS + 4};
+
+	for(uint l = 0; l < 2; l++) {
+		uint exp_count = lengths[l];
+		QGNode *nodes[exp_count + 1];
+		AlgebraicExpression *exps[exp_count];
+		AlgebraicExpression *set[exp_count];
+
+		for(uint i = 0; i <= exp_count; i++) nodes[i] = QGNode_New(NULL, "N", i);
+		for(uint i = 0; i < exp_count; i++) {
+			exps[i] = AlgebraicExpression_Empty();
+			AlgebraicExpression_AppendTerm(exps[i], NULL, false, false, false);
+			exps[i]->src_node = nodes[i];
+			exps[i]->dest_node = nodes[i + 1];
+			// Reverse order.
+			set[exp_count - 1 - i] = exps[i];
+		}
+
+		orderExpressions(set, exp_count, map, NULL, NULL);
+		for(uint i = 0; i < exp_count; i++) {
+			ASSERT_EQ(set[i], exps[i]);
+			ASSERT_FALSE(set[i]->operands[0].transpose);
+		}
+
+		for(uint i = 0; i < exp_count; i++) AlgebraicExpression_Free(exps[i]);
+		for(uint i = 0; i <= exp_count; i++) QGNode_Free(nodes[i]);
+	}
+
+	RecordMap_Free(map);
+}
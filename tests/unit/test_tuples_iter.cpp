@@ -373,4 +373,151 @@ TEST_F(TuplesTest, ColumnIteratorEmptyMatrixTest) {
 
 	GxB_MatrixTupleIter_free(iter);
 	GrB_Matrix_free(&A);
-}
\ No newline at end of file
+}
+TEST_F(TuplesTest, HypersparseMatrixTest) {
+	//--------------------------------------------------------------------------
+	// Build a sparse 1000X1000 hypersparse matrix
+	//--------------------------------------------------------------------------
+
+	GrB_Index n = 1000;
+	GrB_Matrix A = CreateSquareNByNEmptyMatrix(n);
+	GxB_Matrix_Option_set(A, GxB_HYPER, GxB_ALWAYS_HYPER);
+
+	GrB_Index nvals = 4;
+	GrB_Index I_expected[4] = {2, 2, 500, 999};
+	GrB_Index J_expected[4] = {3, 700, 1, 999};
+	for(int i = 0; i < nvals; i++) {
+		GrB_Matrix_setElement_BOOL(A, true, I_expected[i], J_expected[i]);
+	}
+	GrB_Matrix_nvals(&nvals, A);
+
+	bool hyper;
+	GxB_Matrix_Option_get(A, GxB_IS_HYPER, &hyper);
+	ASSERT_TRUE(hyper);
+
+	//--------------------------------------------------------------------------
+	// Scan entire matrix
+	//--------------------------------------------------------------------------
+
+	GrB_Index row;
+	GrB_Index col;
+	bool depleted = false;
+	GxB_MatrixTupleIter *iter;
+	GxB_MatrixTupleIter_new(&iter, A);
+
+	for(int i = 0; i < nvals; i++) {
+		GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+		ASSERT_FALSE(depleted);
+		ASSERT_EQ(row, I_expected[i]);
+		ASSERT_EQ(col, J_expected[i]);
+	}
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_TRUE(depleted);
+
+	//--------------------------------------------------------------------------
+	// Iterate over populated and empty rows
+	//--------------------------------------------------------------------------
+
+	GxB_MatrixTupleIter_iterate_row(iter, 2);
+	for(int i = 0; i < 2; i++) {
+		GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+		ASSERT_FALSE(depleted);
+		ASSERT_EQ(row, 2);
+		ASSERT_EQ(col, J_expected[i]);
+	}
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_TRUE(depleted);
+
+	GxB_MatrixTupleIter_iterate_row(iter, 999);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_FALSE(depleted);
+	ASSERT_EQ(row, 999);
+	ASSERT_EQ(col, 999);
+
+	GxB_MatrixTupleIter_iterate_row(iter, 3);
+	GxB_MatrixTupleIter_next(iter, &row, &col, &depleted);
+	ASSERT_TRUE(depleted);
+
+	GxB_MatrixTupleIter_free(iter);
+	GrB_Matrix_free(&A);
+}
+
+TEST_F(TuplesTest, RowSliceTest) {
+	GrB_Index n = 1000;
+	GrB_Index I[4] = {2, 2, 500, 999};
+	GrB_Index J[4] = {3, 700, 1, 999};
+	uint64_t X[4] = {0, 1, 2, 3};
+
+	const GrB_Index *cols;
+	const void *vals;
+	GrB_Index nvals;
+
+	// Row slices of both standard and hypersparse matrices point into the matrix.
+	for(int hyper = 0; hyper < 2; hyper++) {
+		GrB_Matrix A;
+		GrB_Matrix_new(&A, GrB_UINT64, n, n);
+		if(hyper) GxB_Matrix_Option_set(A, GxB_HYPER, GxB_ALWAYS_HYPER);
+		for(int i = 0; i < 4; i++) GrB_Matrix_setElement_UINT64(A, X[i], I[i], J[i]);
+
+		// Pending entries are assembled before slicing.
+		ASSERT_EQ(GxB_Matrix_row_slice(&cols, &vals, &nvals, A, 2), GrB_SUCCESS);
+		ASSERT_EQ(nvals, 2);
+		ASSERT_EQ(cols[0], 3);
+		ASSERT_EQ(cols[1], 700);
+		ASSERT_EQ(((const uint64_t *)vals)[0], 0);
+		ASSERT_EQ(((const uint64_t *)vals)[1], 1);
+
+		// Values are optional.
+		ASSERT_EQ(GxB_Matrix_row_slice(&cols, NULL, &nvals, A, 999), GrB_SUCCESS);
+		ASSERT_EQ(nvals, 1);
+		ASSERT_EQ(cols[0], 999);
+
+		ASSERT_EQ(GxB_Matrix_row_slice(&cols, &vals, &nvals, A, 3), GrB_SUCCESS);
+		ASSERT_EQ(nvals, 0);
+
+		ASSERT_EQ(GxB_Matrix_row_slice(&cols, &vals, &nvals, A, n), GrB_INVALID_INDEX);
+		GrB_Matrix_free(&A);
+	}
+}
+
+TEST_F(TuplesTest, IteratorValuesTest) {
+	GrB_Index n = 1000;
+	GrB_Index I[4] = {2, 2, 500, 999};
+	GrB_Index J[4] = {3, 700, 1, 999};
+	uint64_t X[4] = {10, 11, 12, 13};
+
+	GrB_Index row;
+	GrB_Index col;
+	uint64_t val;
+	bool depleted;
+
+	// Values are read off both standard and hypersparse matrices.
+	for(int hyper = 0; hyper < 2; hyper++) {
+		GrB_Matrix A;
+		GrB_Matrix_new(&A, GrB_UINT64, n, n);
+		if(hyper) GxB_Matrix_Option_set(A, GxB_HYPER, GxB_ALWAYS_HYPER);
+		for(int i = 0; i < 4; i++) GrB_Matrix_setElement_UINT64(A, X[i], I[i], J[i]);
+
+		GxB_MatrixTupleIter *iter;
+		GxB_MatrixTupleIter_new(&iter, A);
+		for(int i = 0; i < 4; i++) {
+			ASSERT_EQ(GxB_MatrixTupleIter_next_UINT64(iter, &row, &col, &val, &depleted), GrB_SUCCESS);
+			ASSERT_FALSE(depleted);
+			ASSERT_EQ(row, I[i]);
+			ASSERT_EQ(col, J[i]);
+			ASSERT_EQ(val, X[i]);
+		}
+		ASSERT_EQ(GxB_MatrixTupleIter_next_UINT64(iter, &row, &col, &val, &depleted), GrB_SUCCESS);
+		ASSERT_TRUE(depleted);
+		GxB_MatrixTupleIter_free(iter);
+		GrB_Matrix_free(&A);
+	}
+
+	// Only UINT64 matrices are supported.
+	GrB_Matrix B = CreateSquareNByNDiagonalMatrix(4);
+	GxB_MatrixTupleIter *iter;
+	GxB_MatrixTupleIter_new(&iter, B);
+	ASSERT_EQ(GxB_MatrixTupleIter_next_UINT64(iter, &row, &col, &val, &depleted), GrB_DOMAIN_MISMATCH);
+	GxB_MatrixTupleIter_free(iter);
+	GrB_Matrix_free(&B);
+}
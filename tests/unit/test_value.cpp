@@ -127,6 +127,20 @@ TEST_F(ValueTest, TestHashDouble) {
 	ASSERT_EQ(origHashCode, otherHashCode);
 }
 
+TEST_F(ValueTest, TestHashString) {
+	// Equal strings stored at different addresses share a hash code.
+	char str[] = "hash join key";
+	SIValue siString = SI_ConstStringVal(str);
+	SIValue siStringOther = SI_DuplicateStringVal("hash join key");
+	uint64_t origHashCode = SIValue_HashCode(siString);
+	uint64_t otherHashCode = SIValue_HashCode(siStringOther);
+	ASSERT_EQ(origHashCode, otherHashCode);
+
+	SIValue siStringDiff = SI_ConstStringVal((char *)"hash join kez");
+	ASSERT_NE(origHashCode, SIValue_HashCode(siStringDiff));
+	SIValue_Free(&siStringOther);
+}
+
 TEST_F(ValueTest, TestEdge) {
 	Entity entity;
 	entity.id = 0;
@@ -338,3 +352,18 @@ TEST_F(ValueTest, TestSet) {
     ASSERT_EQ(Set_Size(set), 0);
     Set_Free(set);
 }
+
+TEST_F(ValueTest, TestMakeVolatile) {
+	char s[] = "interned";
+	// Shared interned strings must not release the original's reference.
+	SIValue v = SI_InternedStringVal(s);
+	SIValue_MakeVolatile(&v);
+	ASSERT_EQ(v.allocation, M_VOLATILE);
+	ASSERT_EQ(v.stringval, s);
+
+	v = SI_DuplicateStringVal("owned");
+	char *owned = v.stringval;
+	SIValue_MakeVolatile(&v);
+	ASSERT_EQ(v.allocation, M_VOLATILE);
+	rm_free(owned);
+}